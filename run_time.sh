@@ -1,21 +1,20 @@
-ABC_CMD="./abc -c"
-ABC_PATH="/home/liujunfeng/benchmarks/arithmetic"
-LIB_PATH="/home/liujunfeng/ABC/abc_itmap/abc-itmap/asap7_clean.lib"
-ABC_PATH_C="/home/liujunfeng/benchmarks/random_control"
-
-$ABC_CMD "read $ABC_PATH/div.aig; read_lib $LIB_PATH; map -e -v; topo; stime;" >> time_map_e.txt
-$ABC_CMD "read $ABC_PATH/hyp.aig; read_lib $LIB_PATH; map -e -v; topo; stime;" >> time_map_e.txt
-$ABC_CMD "read $ABC_PATH/sqrt.aig; read_lib $LIB_PATH; map -e -v; topo; stime;" >> time_map_e.txt
-$ABC_CMD "read $ABC_PATH/multiplier.aig; read_lib $LIB_PATH; map -e -v; topo; stime;" >> time_map_e.txt
-$ABC_CMD "read $ABC_PATH_C/mem_ctrl.aig; read_lib $LIB_PATH; map -e -v; topo; stime;" >> time_map_e.txt
-
-$ABC_CMD "read $ABC_PATH/div.aig; read_lib $LIB_PATH; map  -v; topo; stime;" >> time_map.txt
-$ABC_CMD "read $ABC_PATH/hyp.aig; read_lib $LIB_PATH; map  -v; topo; stime;" >> time_map.txt
-$ABC_CMD "read $ABC_PATH/sqrt.aig; read_lib $LIB_PATH; map  -v; topo; stime;" >> time_map.txt
-$ABC_CMD "read $ABC_PATH/multiplier.aig; read_lib $LIB_PATH; map  -v; topo; stime;" >> time_map.txt
-$ABC_CMD "read $ABC_PATH_C/mem_ctrl.aig; read_lib $LIB_PATH; map  -v; topo; stime;" >> time_map.txt
-
-
+#!/bin/sh
+# Maps the bundled benchmark suites with ITMap and the classic mapper and
+# records QoR and the per-phase runtimes as CSV/JSON. If a baseline CSV is
+# given as the first argument, the results are compared against it and the
+# runtime or QoR regressions are listed at the end.
+#
+#   ./run_time.sh                   # writes bench_epfl.{csv,json}
+#   ./run_time.sh bench_base.csv    # ... and compares with the baseline
 
+ABC=${ABC:-./abc}
+LIB=${LIB:-asap7-mio.lib}
+SUITE=${SUITE:-benchmark/epfl.list}
+OUT=${OUT:-bench_epfl}
 
+BASE=""
+if [ -n "$1" ]; then
+    BASE="-B $1"
+fi
 
+$ABC -c "map_bench -L $LIB -C $OUT.csv -J $OUT.json $BASE $SUITE"
@@ -353,6 +353,7 @@ struct Jf_Par_t_
     int            fCutHashing;
     int            fCutSimple;
     int            fCutGroup;
+    int            fElaRelax;
     int            fVerbose;
     int            fVeryVerbose;
     int            nLutSizeMax;
@@ -1669,6 +1670,10 @@ extern float               Gia_ManEvaluateSwitching( Gia_Man_t * p );
 extern float               Gia_ManComputeSwitching( Gia_Man_t * p, int nFrames, int nPref, int fProbOne );
 extern Vec_Int_t *         Gia_ManComputeSwitchProbs( Gia_Man_t * pGia, int nFrames, int nPref, int fProbOne );
 extern Vec_Flt_t *         Gia_ManPrintOutputProb( Gia_Man_t * p );
+/*=== giaSwitch2.c ============================================================*/
+extern Vec_Flt_t *         Gia_ManSimSwitching( Gia_Man_t * p, Vec_Flt_t * vProbs, Vec_Wrd_t * vStims, Vec_Int_t * vStimCis, int nSteps, int nWords, int nThreads, int fVerbose );
+extern Vec_Flt_t *         Gia_ManSwiReadProbs( Gia_Man_t * p, char * pFileName );
+extern Vec_Wrd_t *         Gia_ManSwiReadVcd( Gia_Man_t * p, char * pFileName, int * pnSteps, Vec_Int_t ** pvStimCis, int fVerbose );
 /*=== giaTim.c ===========================================================*/
 extern int                 Gia_ManBoxNum( Gia_Man_t * p );
 extern int                 Gia_ManRegBoxNum( Gia_Man_t * p );
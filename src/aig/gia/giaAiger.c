@@ -23,9 +23,17 @@
 #include "misc/tim/tim.h"
 #include "base/main/main.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 #define XAIG_VERBOSE 0
+#define GIA_AIGER_CHUNK (1 << 20)   // the size of the chunks used to write the AND gates
 
 ////////////////////////////////////////////////////////////////////////
 ///                        DECLARATIONS                              ///
@@ -1000,6 +1008,55 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSi
     return pNew;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Reads the AIGER file mapped into memory.]
+
+  Description [The AIG is decoded directly from the pages of the file. 
+  The mapping is private, so only the pages of the symbol table, which 
+  are modified by the parser, are copied. The file is not mapped if its 
+  size is a multiple of the page size, because the parser relies on the 
+  zero bytes that follow the contents in the last page. Sets *pfMapped 
+  to 0 if the file is not mapped.]
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Man_t * Gia_AigerReadMapped( char * pFileName, int fGiaSimple, int fSkipStrash, int fCheck, int * pfMapped )
+{
+#ifdef _WIN32
+    *pfMapped = 0;
+    return NULL;
+#else
+    struct stat Stat;
+    Gia_Man_t * pNew;
+    char * pContents;
+    int fd = open( pFileName, O_RDONLY );
+    *pfMapped = 0;
+    if ( fd < 0 )
+        return NULL;
+    if ( fstat( fd, &Stat ) < 0 || !S_ISREG(Stat.st_mode) || Stat.st_size == 0 || 
+         Stat.st_size > 0x7FFFFFFF || Stat.st_size % getpagesize() == 0 )
+    {
+        close( fd );
+        return NULL;
+    }
+    pContents = (char *)mmap( NULL, (size_t)Stat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if ( pContents == MAP_FAILED )
+        return NULL;
+#ifdef MADV_SEQUENTIAL
+    madvise( pContents, (size_t)Stat.st_size, MADV_SEQUENTIAL );
+#endif
+    *pfMapped = 1;
+    pNew = Gia_AigerReadFromMemory( pContents, (int)Stat.st_size, fGiaSimple, fSkipStrash, fCheck );
+    munmap( pContents, (size_t)Stat.st_size );
+    return pNew;
+#endif
+}
+
 /**Function*************************************************************
 
   Synopsis    [Reads the AIG in the binary AIGER format.]
@@ -1016,19 +1073,23 @@ Gia_Man_t * Gia_AigerRead( char * pFileName, int fGiaSimple, int fSkipStrash, in
     FILE * pFile;
     Gia_Man_t * pNew;
     char * pName, * pContents;
-    int nFileSize;
+    int nFileSize, fMapped = 0;
     int RetValue;
 
-    // read the file into the buffer
     Gia_FileFixName( pFileName );
-    nFileSize = Gia_FileSize( pFileName );
-    pFile = fopen( pFileName, "rb" );
-    pContents = ABC_ALLOC( char, nFileSize );
-    RetValue = fread( pContents, nFileSize, 1, pFile );
-    fclose( pFile );
+    pNew = Gia_AigerReadMapped( pFileName, fGiaSimple, fSkipStrash, fCheck, &fMapped );
+    if ( !fMapped )
+    {
+        // read the file into the buffer
+        nFileSize = Gia_FileSize( pFileName );
+        pFile = fopen( pFileName, "rb" );
+        pContents = ABC_ALLOC( char, nFileSize );
+        RetValue = fread( pContents, nFileSize, 1, pFile );
+        fclose( pFile );
 
-    pNew = Gia_AigerReadFromMemory( pContents, nFileSize, fGiaSimple, fSkipStrash, fCheck );
-    ABC_FREE( pContents );
+        pNew = Gia_AigerReadFromMemory( pContents, nFileSize, fGiaSimple, fSkipStrash, fCheck );
+        ABC_FREE( pContents );
+    }
     if ( pNew )
     {
         ABC_FREE( pNew->pName );
@@ -1286,9 +1347,9 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
     }
     Gia_ManInvertConstraints( p );
 
-    // write the nodes into the buffer
+    // write the nodes in chunks (each node takes at most 10 bytes)
     Pos = 0;
-    nBufferSize = 8 * Gia_ManAndNum(p) + 100; // skeptically assuming 3 chars per one AIG edge
+    nBufferSize = Abc_MinInt( 10 * Gia_ManAndNum(p) + 100, GIA_AIGER_CHUNK );
     pBuffer = ABC_ALLOC( unsigned char, nBufferSize );
     Gia_ManForEachAnd( p, pObj, i )
     {
@@ -1300,16 +1361,13 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         Pos = Gia_AigerWriteUnsignedBuffer( pBuffer, Pos, uLit1 - uLit0 );
         if ( Pos > nBufferSize - 10 )
         {
-            printf( "Gia_AigerWrite(): AIGER generation has failed because the allocated buffer is too small.\n" );
-            fclose( pFile );
-            if ( p != pInit )
-                Gia_ManStop( p );
-            return;
+            fwrite( pBuffer, 1, Pos, pFile );
+            Pos = 0;
         }
     }
-    assert( Pos < nBufferSize );
+    assert( Pos <= nBufferSize );
 
-    // write the buffer
+    // write the rest of the buffer
     fwrite( pBuffer, 1, Pos, pFile );
     ABC_FREE( pBuffer );
 
@@ -20,17 +20,7 @@
 
 #include "gia.h"
 #include "misc/vec/vecSet.h"
-
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#include <unistd.h>
-#endif
-
-#endif
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -956,36 +946,19 @@ typedef struct Kf_ThData_t_
 {
     Kf_Set_t *  pSett;
     int         Id;
-    int         Status;
     abctime     clkUsed;
 } Kf_ThData_t;
-void * Kf_WorkerThread( void * pArg )
+void Kf_WorkerTask( void * pArg, int iThread, void * pScratch )
 {
     Kf_ThData_t * pThData = (Kf_ThData_t *)pArg;
     Kf_Man_t * pMan = pThData->pSett->pMan;
     int fAreaOnly = pThData->pSett->pMan->pPars->fAreaOnly;
     int fCutMin = pThData->pSett->pMan->pPars->fCutMin;
-    volatile int * pPlace = &pThData->Status;
-    abctime clk;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->Status == 1 );
-        if ( pThData->Id == -1 )
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        assert( pThData->Id >= 0 );
-        clk = Abc_Clock();
-        Kf_SetMergeOrder( pThData->pSett, Kf_ObjCuts0(pMan, pThData->Id), Kf_ObjCuts1(pMan, pThData->Id), fAreaOnly, fCutMin );
-        pThData->clkUsed += Abc_Clock() - clk;
-        pThData->Status = 0;
-//        printf( "Finished object %d\n", pThData->Id );
-    }
-    assert( 0 );
-    return NULL;
+    abctime clk = Abc_Clock();
+    assert( pThData->Id >= 0 );
+    Kf_SetMergeOrder( pThData->pSett, Kf_ObjCuts0(pMan, pThData->Id), Kf_ObjCuts1(pMan, pThData->Id), fAreaOnly, fCutMin );
+    pThData->clkUsed += Abc_Clock() - clk;
+//    printf( "Finished object %d\n", pThData->Id );
 }
 Vec_Int_t * Kf_ManCreateFaninCounts( Gia_Man_t * p )  
 {
@@ -1004,12 +977,12 @@ Vec_Int_t * Kf_ManCreateFaninCounts( Gia_Man_t * p )
 }
 void Kf_ManComputeCuts( Kf_Man_t * p )
 {
-    pthread_t WorkerThread[PAR_THR_MAX];
     Kf_ThData_t ThData[PAR_THR_MAX];
+    Util_Pool_t * pPool;
     Vec_Int_t * vStack, * vFanins;
     Gia_Obj_t * pObj;
     int nProcs = p->pPars->nProcNum;
-    int i, k, iFan, status, nCountFanins, fRunning;
+    int i, k, iFan, nCountFanins;
     abctime clk, clkUsed = 0;
     assert( nProcs <= PAR_THR_MAX );
     // start fanins
@@ -1025,60 +998,54 @@ void Kf_ManComputeCuts( Kf_Man_t * p )
     {
         ThData[i].pSett = p->pSett + i;
         ThData[i].Id = -1;
-        ThData[i].Status = 0;
         ThData[i].clkUsed = 0;
-        status = pthread_create( WorkerThread + i, NULL, Kf_WorkerThread, (void *)(ThData + i) );  assert( status == 0 );
     }
+    pPool = Util_PoolStart( nProcs, 0 );
     nCountFanins = Vec_IntSum(vFanins);
-    fRunning = 1;
-    while ( nCountFanins > 0 || Vec_IntSize(vStack) > 0 || fRunning )
+    while ( 1 )
     {
-        for ( i = 0; i < nProcs; i++ )
+        // schedule the ready nodes on the idle threads
+        while ( Vec_IntSize(vStack) > 0 && (i = Util_PoolFindIdle(pPool)) >= 0 )
         {
-            if ( ThData[i].Status )
-                continue;
-            assert( ThData[i].Status == 0 );
-            if ( ThData[i].Id >= 0 )
-            {
-                int iObj = ThData[i].Id;
-                Kf_Set_t * pSett = p->pSett + i;
-                //printf( "Closing obj %d with Thread %d:\n", iObj, i );
-                clk = Abc_Clock();
-                // finalize the results
-                Kf_ManSaveResults( pSett->ppCuts, pSett->nCuts, pSett->pCutBest, p->vTemp );
-                Vec_IntWriteEntry( &p->vTime, iObj, pSett->pCutBest->Delay + 1 );
-                Vec_FltWriteEntry( &p->vArea, iObj, (pSett->pCutBest->Area + 1)/Kf_ObjRefs(p, iObj) );
-                if ( pSett->pCutBest->nLeaves > 1 )
-                    Kf_ManStoreAddUnit( p->vTemp, iObj, Kf_ObjTime(p, iObj), Kf_ObjArea(p, iObj) );
-                Kf_ObjSetCuts( p, iObj, p->vTemp );
-                //Gia_CutSetPrint( Kf_ObjCuts(p, iObj) );
-                clkUsed += Abc_Clock() - clk;
-                // schedule other nodes
-                Gia_ObjForEachFanoutStaticId( p->pGia, iObj, iFan, k )
-                {
-                    if ( !Gia_ObjIsAnd(Gia_ManObj(p->pGia, iFan)) )
-                        continue;
-                    assert( Vec_IntEntry(vFanins, iFan) > 0 );
-                    if ( Vec_IntAddToEntry(vFanins, iFan, -1) == 0 )
-                        Vec_IntPush( vStack, iFan );
-                    assert( nCountFanins > 0 );
-                    nCountFanins--;
-                }
-                ThData[i].Id = -1;
-            }
-            if ( Vec_IntSize(vStack) > 0 )
+            assert( ThData[i].Id == -1 );
+            ThData[i].Id = Vec_IntPop( vStack );
+            Util_PoolAssign( pPool, i, Kf_WorkerTask, (void *)(ThData + i) );
+            //printf( "Scheduling %d for Thread %d\n", ThData[i].Id, i );
+        }
+        // wait till one of the nodes is computed
+        i = Util_PoolWaitAny( pPool, NULL );
+        if ( i == -1 )
+            break;
+        assert( ThData[i].Id >= 0 );
+        {
+            int iObj = ThData[i].Id;
+            Kf_Set_t * pSett = p->pSett + i;
+            //printf( "Closing obj %d with Thread %d:\n", iObj, i );
+            clk = Abc_Clock();
+            // finalize the results
+            Kf_ManSaveResults( pSett->ppCuts, pSett->nCuts, pSett->pCutBest, p->vTemp );
+            Vec_IntWriteEntry( &p->vTime, iObj, pSett->pCutBest->Delay + 1 );
+            Vec_FltWriteEntry( &p->vArea, iObj, (pSett->pCutBest->Area + 1)/Kf_ObjRefs(p, iObj) );
+            if ( pSett->pCutBest->nLeaves > 1 )
+                Kf_ManStoreAddUnit( p->vTemp, iObj, Kf_ObjTime(p, iObj), Kf_ObjArea(p, iObj) );
+            Kf_ObjSetCuts( p, iObj, p->vTemp );
+            //Gia_CutSetPrint( Kf_ObjCuts(p, iObj) );
+            clkUsed += Abc_Clock() - clk;
+            // schedule other nodes
+            Gia_ObjForEachFanoutStaticId( p->pGia, iObj, iFan, k )
             {
-                ThData[i].Id = Vec_IntPop( vStack );
-                ThData[i].Status = 1;
-                //printf( "Scheduling %d for Thread %d\n", ThData[i].Id, i );
+                if ( !Gia_ObjIsAnd(Gia_ManObj(p->pGia, iFan)) )
+                    continue;
+                assert( Vec_IntEntry(vFanins, iFan) > 0 );
+                if ( Vec_IntAddToEntry(vFanins, iFan, -1) == 0 )
+                    Vec_IntPush( vStack, iFan );
+                assert( nCountFanins > 0 );
+                nCountFanins--;
             }
+            ThData[i].Id = -1;
         }
-        fRunning = 0;
-        for ( i = 0; i < nProcs; i++ )
-            if ( ThData[i].Status == 1 || (ThData[i].Status == 0 && ThData[i].Id >= 0) )
-                fRunning = 1;
-//        printf( "fRunning %d\n", fRunning );
     }
+    assert( nCountFanins == 0 && Vec_IntSize(vStack) == 0 );
     Vec_IntForEachEntry( vFanins, iFan, k )
         if ( iFan != 0 )
         {
@@ -1087,12 +1054,7 @@ void Kf_ManComputeCuts( Kf_Man_t * p )
         }
     assert( Vec_IntSum(vFanins) == 0 );
     // stop the threads
-    for ( i = 0; i < nProcs; i++ )
-    {
-        assert( ThData[i].Status == 0 );
-        ThData[i].Id = -1;
-        ThData[i].Status = 1;
-    }
+    Util_PoolStop( pPool );
     Gia_ManStaticFanoutStop( p->pGia );
     Vec_IntFree( vStack );
     Vec_IntFree( vFanins );
@@ -30,6 +30,7 @@
 #include "opt/dau/dau.h"
 #include "misc/util/utilNam.h"
 #include "map/scl/sclCon.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -43,6 +44,11 @@ ABC_NAMESPACE_IMPL_START
 #define NF_NO_FUNC  0x3FFFFFF
 #define NF_EPSILON  0.001
 
+// the number of nodes per thread in one window of parallel area recovery
+#define NF_ELA_WINDOW   256
+// the smallest number of AND nodes worth recovering area in parallel
+#define NF_ELA_PAR_MIN 4096
+
 typedef struct Nf_Cut_t_ Nf_Cut_t; 
 struct Nf_Cut_t_
 {
@@ -109,6 +115,11 @@ struct Nf_Man_t_
     abctime         clkStart;       // starting time
     double          CutCount[6];    // cut counts
     int             nCutUseAll;     // objects with useful cuts
+    // parallel area recovery
+    Vec_Int_t *     vElaRefs;       // touched refs with their previous values
+    Vec_Int_t *     vElaReqs;       // updated required times
+    int *           pElaMarks;      // marks of the touched refs
+    int             nElaMark;       // the current mark
 };
 
 static inline int          Nf_Cfg2Int( Nf_Cfg_t Mat )                                { union { int x; Nf_Cfg_t y; } v; v.y = Mat; return v.x;           }
@@ -128,12 +139,13 @@ static inline int          Nf_ObjCutDelay( Nf_Man_t * p, int i )
 static inline void         Nf_ObjSetCutFlow( Nf_Man_t * p, int i, float a )          { Vec_FltWriteEntry(&p->vCutFlows, i, a);                          } 
 static inline void         Nf_ObjSetCutDelay( Nf_Man_t * p, int i, int d )           { Vec_IntWriteEntry(&p->vCutDelays, i, d);                         } 
 
+static inline void         Nf_ObjMapRefLog( Nf_Man_t * p, int iLit )                 { if (p->pElaMarks && p->pElaMarks[iLit] != p->nElaMark) { p->pElaMarks[iLit] = p->nElaMark; Vec_IntPushTwo(p->vElaRefs, iLit, Vec_IntEntry(&p->vMapRefs, iLit)); } }
 static inline int          Nf_ObjMapRefNum( Nf_Man_t * p, int i, int c )             { return Vec_IntEntry(&p->vMapRefs, Abc_Var2Lit(i,c));             }
-static inline int          Nf_ObjMapRefInc( Nf_Man_t * p, int i, int c )             { return (*Vec_IntEntryP(&p->vMapRefs, Abc_Var2Lit(i,c)))++;       }
-static inline int          Nf_ObjMapRefDec( Nf_Man_t * p, int i, int c )             { return --(*Vec_IntEntryP(&p->vMapRefs, Abc_Var2Lit(i,c)));       }
+static inline int          Nf_ObjMapRefInc( Nf_Man_t * p, int i, int c )             { Nf_ObjMapRefLog(p, Abc_Var2Lit(i,c)); return (*Vec_IntEntryP(&p->vMapRefs, Abc_Var2Lit(i,c)))++;       }
+static inline int          Nf_ObjMapRefDec( Nf_Man_t * p, int i, int c )             { Nf_ObjMapRefLog(p, Abc_Var2Lit(i,c)); return --(*Vec_IntEntryP(&p->vMapRefs, Abc_Var2Lit(i,c)));       }
 static inline float        Nf_ObjFlowRefs( Nf_Man_t * p, int i, int c )              { return Vec_FltEntry(&p->vFlowRefs, Abc_Var2Lit(i,c));            }
 static inline int          Nf_ObjRequired( Nf_Man_t * p, int i, int c )              { return Vec_IntEntry(&p->vRequired, Abc_Var2Lit(i,c));            }
-static inline void         Nf_ObjSetRequired( Nf_Man_t * p,int i, int c, int f )     { Vec_IntWriteEntry(&p->vRequired, Abc_Var2Lit(i,c), f);           }
+static inline void         Nf_ObjSetRequired( Nf_Man_t * p,int i, int c, int f )     { if (p->vElaReqs) Vec_IntPush(p->vElaReqs, Abc_Var2Lit(i,c)); Vec_IntWriteEntry(&p->vRequired, Abc_Var2Lit(i,c), f); }
 static inline void         Nf_ObjUpdateRequired( Nf_Man_t * p,int i, int c, int f )  { if (Nf_ObjRequired(p, i, c) > f) Nf_ObjSetRequired(p, i, c, f);  }
 
 static inline Nf_Mat_t *   Nf_ObjMatchD( Nf_Man_t * p, int i, int c )                { return &Nf_ManObj(p, i)->M[c][0];                                }
@@ -1942,24 +1954,329 @@ void Nf_ManResetMatches( Nf_Man_t * p, int Round )
         }
     }
 }
+void Nf_ManElaBufRequired( Nf_Man_t * p, Gia_Obj_t * pObj, int i )
+{
+    assert( Gia_ObjIsBuf(pObj) );
+    if ( Nf_ObjMapRefNum(p, i, 1) )
+        Nf_ObjUpdateRequired( p, i, 0, Nf_ObjRequired(p, i, 1) - p->InvDelayI );
+    Nf_ObjUpdateRequired( p, Gia_ObjFaninId0(pObj, i), Gia_ObjFaninC0(pObj), Nf_ObjRequired(p, i, 0) );
+}
+void Nf_ManElaFaninRequireds( Nf_Man_t * p, int i, Nf_Mat_t * pMb, int Required )
+{
+    Mio_Cell2_t * pCell = Nf_ManCell( p, pMb->Gate );
+    int * pCut = Nf_CutFromHandle( Nf_ObjCutSet(p, i), pMb->CutH );
+    Nf_Mat_t * pM;
+    int iVar, fCompl, k;
+    Nf_CutForEachVarCompl( pCut, pMb->Cfg, iVar, fCompl, k )
+    {
+        pM = Nf_ObjMatchBest( p, iVar, fCompl );
+        assert( pM->D <= Required - pCell->iDelays[k] );
+        Nf_ObjUpdateRequired( p, iVar, fCompl, Required - pCell->iDelays[k] );
+        if ( pM->fCompl )
+        {
+            pM = Nf_ObjMatchBest( p, iVar, !fCompl );
+            assert( pM->D <= Required - pCell->iDelays[k] - p->InvDelayI );
+            Nf_ObjUpdateRequired( p, iVar, !fCompl, Required - pCell->iDelays[k] - p->InvDelayI );
+        }
+    }
+}
+void Nf_ManElaCiRequireds( Nf_Man_t * p )
+{
+    int i, Id, Required;
+    Gia_ManForEachCiId( p->pGia, Id, i )
+        if ( Nf_ObjMapRefNum(p, Id, 1) )
+        {
+            Required = Nf_ObjRequired( p, i, 1 );
+            Nf_ObjUpdateRequired( p, Id, 0, Required - p->InvDelayI );
+        }
+}
+/**Function*************************************************************
+
+  Synopsis    [Parallel area recovery.]
+
+  Description [The nodes are visited in the same reverse topological order
+  as in the serial area recovery, in windows of NF_ELA_WINDOW nodes per
+  thread. The nodes are split among the threads by the output cones they
+  belong to. Each thread works on a private copy of the reference counters
+  and the required times, finds the best matches of its nodes in the window,
+  and records the counters it touched together with their values. After that
+  the matches are applied to the manager in the serial order. In the exact
+  mode, the match of a node is accepted if the counters it touched and its
+  required time have the same values in the manager, which guarantees the
+  same result as the serial run. Otherwise, the match is recomputed. In the
+  relaxed mode, the match is accepted if it meets the required time, which
+  is faster but the result depends on the number of threads. At the start of
+  the next window, each thread copies from the manager the counters and
+  required times changed by itself or by the manager.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Nf_ElaRes_t_ Nf_ElaRes_t; 
+struct Nf_ElaRes_t_
+{
+    int             iObj;           // node
+    int             c;              // phase
+    int             Required;       // required time
+    int             iBeg;           // the first touched ref
+    int             iEnd;           // the last touched ref
+    Nf_Mat_t        M;              // best match
+};
+typedef struct Nf_ElaThData_t_ Nf_ElaThData_t; 
+struct Nf_ElaThData_t_
+{
+    Nf_Man_t        Man;            // manager with private refs and required times
+    Nf_Man_t *      pMan;           // the shared manager
+    Vec_Int_t *     vNodes;         // nodes of the current window
+    Nf_ElaRes_t *   pRes;           // matches of these nodes
+    int             nRes;           // the number of matches
+    int             iRes;           // the next match to apply
+};
+Vec_Int_t * Nf_ManElaPartition( Nf_Man_t * p, int nParts )
+{
+    Vec_Int_t * vPart = Vec_IntStartFull( Gia_ManObjNum(p->pGia) );
+    Gia_Obj_t * pObj;
+    int i, iFanin;
+    // assign the COs to the parts in contiguous ranges
+    Gia_ManForEachCo( p->pGia, pObj, i )
+        if ( Vec_IntEntry(vPart, Gia_ObjFaninId0p(p->pGia, pObj)) == -1 )
+            Vec_IntWriteEntry( vPart, Gia_ObjFaninId0p(p->pGia, pObj), i * nParts / Gia_ManCoNum(p->pGia) );
+    // each node goes to the part of its last fanout
+    Gia_ManForEachAndReverse( p->pGia, pObj, i )
+    {
+        if ( Vec_IntEntry(vPart, i) == -1 )
+            Vec_IntWriteEntry( vPart, i, 0 );
+        iFanin = Gia_ObjFaninId0(pObj, i);
+        if ( Vec_IntEntry(vPart, iFanin) == -1 )
+            Vec_IntWriteEntry( vPart, iFanin, Vec_IntEntry(vPart, i) );
+        if ( Gia_ObjIsBuf(pObj) )
+            continue;
+        iFanin = Gia_ObjFaninId1(pObj, i);
+        if ( Vec_IntEntry(vPart, iFanin) == -1 )
+            Vec_IntWriteEntry( vPart, iFanin, Vec_IntEntry(vPart, i) );
+    }
+    return vPart;
+}
+void Nf_ManElaSync( Nf_Man_t * q, Nf_Man_t * p )
+{
+    Vec_Int_t * vRefs[2] = { q->vElaRefs, p->vElaRefs };
+    Vec_Int_t * vReqs[2] = { q->vElaReqs, p->vElaReqs };
+    int i, k, iLit, Value;
+    for ( i = 0; i < 2; i++ )
+    {
+        Vec_IntForEachEntryDouble( vRefs[i], iLit, Value, k )
+            Vec_IntWriteEntry( &q->vMapRefs, iLit, Vec_IntEntry(&p->vMapRefs, iLit) );
+        Vec_IntForEachEntry( vReqs[i], iLit, k )
+            Vec_IntWriteEntry( &q->vRequired, iLit, Vec_IntEntry(&p->vRequired, iLit) );
+    }
+    Vec_IntClear( q->vElaRefs );
+    Vec_IntClear( q->vElaReqs );
+}
+void Nf_ManElaTask( void * pArg, int iThread, void * pScratch )
+{
+    Nf_ElaThData_t * pTh = (Nf_ElaThData_t *)pArg;
+    Nf_Man_t * q = &pTh->Man;
+    Nf_ElaRes_t * pRes;
+    Nf_Mat_t * pM;
+    Gia_Obj_t * pObj;
+    int i, c, k, Required;
+    Nf_ManElaSync( q, pTh->pMan );
+    pTh->nRes = pTh->iRes = 0;
+    Vec_IntForEachEntry( pTh->vNodes, i, k )
+    {
+        pObj = Gia_ManObj( q->pGia, i );
+        if ( Gia_ObjIsBuf(pObj) )
+        {
+            Nf_ManElaBufRequired( q, pObj, i );
+            continue;
+        }
+        for ( c = 0; c < 2; c++ )
+        if ( Nf_ObjMapRefNum(q, i, c) )
+        {
+            pM = Nf_ObjMatchBest( q, i, c );
+            Required = Nf_ObjRequired( q, i, c );
+            if ( pM->fCompl )
+                continue;
+            // find the best match using the private refs
+            pRes = pTh->pRes + pTh->nRes++;
+            pRes->iObj = i;
+            pRes->c = c;
+            pRes->Required = Required;
+            pRes->iBeg = Vec_IntSize( q->vElaRefs );
+            q->nElaMark++;
+            Nf_MatchDeref_rec( q, i, c, pM );
+            Nf_ManElaBestMatch( q, i, c, &pRes->M, Required );
+            Nf_MatchRef_rec( q, i, c, &pRes->M, Required, NULL );
+            pRes->iEnd = Vec_IntSize( q->vElaRefs );
+            Nf_ManElaFaninRequireds( q, i, &pRes->M, Required );
+        }
+    }
+}
+int Nf_ManElaResIsValid( Nf_Man_t * p, Nf_ElaThData_t * pTh, Nf_ElaRes_t * pRes, int Required )
+{
+    int k, * pRefs = Vec_IntArray( pTh->Man.vElaRefs );
+    if ( p->pPars->fElaRelax )
+        return pRes->M.D <= Required;
+    if ( pRes->Required != Required )
+        return 0;
+    for ( k = pRes->iBeg; k < pRes->iEnd; k += 2 )
+        if ( Vec_IntEntry(&p->vMapRefs, pRefs[k]) != pRefs[k+1] )
+            return 0;
+    return 1;
+}
+void Nf_ManComputeMappingElaPar( Nf_Man_t * p )
+{
+    int nProcs = p->pPars->nProcNum;
+    int nWindow = NF_ELA_WINDOW * nProcs;
+    int nObjs = Gia_ManObjNum( p->pGia );
+    Vec_Int_t * vOrder = Vec_IntAlloc( Gia_ManAndNum(p->pGia) );
+    Vec_Int_t * vPart = Nf_ManElaPartition( p, nProcs );
+    Nf_ElaThData_t * pThData = ABC_CALLOC( Nf_ElaThData_t, nProcs ), * pTh;
+    Util_Pool_t * pPool = Util_PoolStart( nProcs, 0 );
+    Nf_ElaRes_t * pRes;
+    Nf_Mat_t Mb, * pM;
+    Gia_Obj_t * pObj;
+    int i, c, k, iStart, Required, nAccepts = 0, nRedos = 0;
+    Gia_ManForEachAndReverse( p->pGia, pObj, i )
+        Vec_IntPush( vOrder, i );
+    // start the logs of the manager
+    p->vElaRefs  = Vec_IntAlloc( 1000 );
+    p->vElaReqs  = Vec_IntAlloc( 1000 );
+    p->pElaMarks = ABC_CALLOC( int, 2 * nObjs );
+    p->nElaMark  = 0;
+    // create private copies of the refs and required times
+    for ( k = 0; k < nProcs; k++ )
+    {
+        pTh = pThData + k;
+        pTh->Man = *p;
+        pTh->pMan = p;
+        pTh->Man.vMapRefs.pArray  = ABC_ALLOC( int, Vec_IntCap(&p->vMapRefs) );
+        pTh->Man.vRequired.pArray = ABC_ALLOC( int, Vec_IntCap(&p->vRequired) );
+        memcpy( pTh->Man.vMapRefs.pArray,  Vec_IntArray(&p->vMapRefs),  sizeof(int) * Vec_IntSize(&p->vMapRefs) );
+        memcpy( pTh->Man.vRequired.pArray, Vec_IntArray(&p->vRequired), sizeof(int) * Vec_IntSize(&p->vRequired) );
+        memset( &pTh->Man.vBackup, 0, sizeof(Vec_Int_t) );
+        Vec_IntGrow( &pTh->Man.vBackup, 1000 );
+        pTh->Man.vElaRefs  = Vec_IntAlloc( 1000 );
+        pTh->Man.vElaReqs  = Vec_IntAlloc( 1000 );
+        pTh->Man.pElaMarks = ABC_CALLOC( int, 2 * nObjs );
+        pTh->vNodes = Vec_IntAlloc( nWindow );
+        pTh->pRes = ABC_ALLOC( Nf_ElaRes_t, 2 * nWindow );
+    }
+    for ( iStart = 0; iStart < Vec_IntSize(vOrder); iStart += nWindow )
+    {
+        // find the matches of the window in parallel
+        for ( k = 0; k < nProcs; k++ )
+            Vec_IntClear( pThData[k].vNodes );
+        Vec_IntForEachEntryStartStop( vOrder, i, k, iStart, Abc_MinInt(iStart + nWindow, Vec_IntSize(vOrder)) )
+            Vec_IntPush( pThData[Vec_IntEntry(vPart, i)].vNodes, i );
+        for ( k = 0; k < nProcs; k++ )
+            Util_PoolAssign( pPool, k, Nf_ManElaTask, (void *)(pThData + k) );
+        Util_PoolWaitAll( pPool );
+        // apply the matches in the serial order
+        Vec_IntClear( p->vElaRefs );
+        Vec_IntClear( p->vElaReqs );
+        p->nElaMark++;
+        Vec_IntForEachEntryStartStop( vOrder, i, k, iStart, Abc_MinInt(iStart + nWindow, Vec_IntSize(vOrder)) )
+        {
+            pObj = Gia_ManObj( p->pGia, i );
+            if ( Gia_ObjIsBuf(pObj) )
+            {
+                Nf_ManElaBufRequired( p, pObj, i );
+                continue;
+            }
+            pTh = pThData + Vec_IntEntry( vPart, i );
+            for ( c = 0; c < 2; c++ )
+            {
+                pRes = NULL;
+                if ( pTh->iRes < pTh->nRes && pTh->pRes[pTh->iRes].iObj == i && pTh->pRes[pTh->iRes].c == c )
+                    pRes = pTh->pRes + pTh->iRes++;
+                if ( !Nf_ObjMapRefNum(p, i, c) )
+                    continue;
+                pM = Nf_ObjMatchBest( p, i, c );
+                Required = Nf_ObjRequired( p, i, c );
+                assert( pM->D <= Required );
+                if ( pM->fCompl )
+                    continue;
+                if ( pRes && Nf_ManElaResIsValid(p, pTh, pRes, Required) )
+                {
+                    Nf_MatchDeref_rec( p, i, c, pM );
+                    Mb = pRes->M;
+                    nAccepts++;
+                }
+                else
+                {
+                    Nf_MatchDeref_rec( p, i, c, pM );
+                    Nf_ManElaBestMatch( p, i, c, &Mb, Required );
+                    nRedos++;
+                }
+                Nf_MatchRef_rec( p, i, c, &Mb, Required, NULL );
+                assert( Mb.fBest );
+                assert( Mb.D <= Required );
+                *pM = Mb;
+                Nf_ManElaFaninRequireds( p, i, &Mb, Required );
+            }
+        }
+    }
+    if ( p->pPars->fVeryVerbose )
+        printf( "Area recovery with %d threads (%s mode): Accepted = %d. Recomputed = %d.\n", 
+            nProcs, p->pPars->fElaRelax ? "relaxed" : "exact", nAccepts, nRedos );
+    // cleanup
+    Util_PoolStop( pPool );
+    for ( k = 0; k < nProcs; k++ )
+    {
+        pTh = pThData + k;
+        ABC_FREE( pTh->Man.vMapRefs.pArray );
+        ABC_FREE( pTh->Man.vRequired.pArray );
+        ABC_FREE( pTh->Man.vBackup.pArray );
+        Vec_IntFree( pTh->Man.vElaRefs );
+        Vec_IntFree( pTh->Man.vElaReqs );
+        ABC_FREE( pTh->Man.pElaMarks );
+        Vec_IntFree( pTh->vNodes );
+        ABC_FREE( pTh->pRes );
+    }
+    ABC_FREE( pThData );
+    Vec_IntFreeP( &p->vElaRefs );
+    Vec_IntFreeP( &p->vElaReqs );
+    ABC_FREE( p->pElaMarks );
+    Vec_IntFree( vPart );
+    Vec_IntFree( vOrder );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Area recovery.]
+
+  Description [Runs the parallel version if several threads are requested
+  and the network is large enough.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
 void Nf_ManComputeMappingEla( Nf_Man_t * p )
 {
     int fVerbose = 0;
     Gia_Obj_t * pObj;
-    Mio_Cell2_t * pCell;
     Nf_Mat_t Mb, * pMb = &Mb, * pM;
     word AreaBef, AreaAft, Gain = 0;
-    int i, c, iVar, Id, fCompl, k, * pCut;
+    int i, c;
     int Required;
     Nf_ManSetOutputRequireds( p, 1 );
     Nf_ManResetMatches( p, p->Iter - p->pPars->nRounds );
+    if ( p->pPars->nProcNum > 1 && Gia_ManAndNum(p->pGia) >= NF_ELA_PAR_MIN )
+    {
+        Nf_ManComputeMappingElaPar( p );
+        Nf_ManElaCiRequireds( p );
+        return;
+    }
     Gia_ManForEachAndReverse( p->pGia, pObj, i )
     {
         if ( Gia_ObjIsBuf(pObj) )
         {
-            if ( Nf_ObjMapRefNum(p, i, 1) )
-                Nf_ObjUpdateRequired( p, i, 0, Nf_ObjRequired(p, i, 1) - p->InvDelayI );
-            Nf_ObjUpdateRequired( p, Gia_ObjFaninId0(pObj, i), Gia_ObjFaninC0(pObj), Nf_ObjRequired(p, i, 0) );
+            Nf_ManElaBufRequired( p, pObj, i );
             continue;
         }
         for ( c = 0; c < 2; c++ )
@@ -1996,28 +2313,10 @@ void Nf_ManComputeMappingEla( Nf_Man_t * p )
             //assert( AreaBef >= AreaAft );
             *pM = *pMb;
             // update timing
-            pCell = Nf_ManCell( p, pMb->Gate );
-            pCut = Nf_CutFromHandle( Nf_ObjCutSet(p, i), pMb->CutH );
-            Nf_CutForEachVarCompl( pCut, pMb->Cfg, iVar, fCompl, k )
-            {
-                pM = Nf_ObjMatchBest( p, iVar, fCompl );
-                assert( pM->D <= Required - pCell->iDelays[k] );
-                Nf_ObjUpdateRequired( p, iVar, fCompl, Required - pCell->iDelays[k] );
-                if ( pM->fCompl )
-                {
-                    pM = Nf_ObjMatchBest( p, iVar, !fCompl );
-                    assert( pM->D <= Required - pCell->iDelays[k] - p->InvDelayI );
-                    Nf_ObjUpdateRequired( p, iVar, !fCompl, Required - pCell->iDelays[k] - p->InvDelayI );
-                }
-            }
+            Nf_ManElaFaninRequireds( p, i, pMb, Required );
         }
     }
-    Gia_ManForEachCiId( p->pGia, Id, i )
-        if ( Nf_ObjMapRefNum(p, Id, 1) )
-        {
-            Required = Nf_ObjRequired( p, i, 1 );
-            Nf_ObjUpdateRequired( p, Id, 0, Required - p->InvDelayI );
-        }
+    Nf_ManElaCiRequireds( p );
 }
 void Nf_ManFixPoDrivers( Nf_Man_t * p )
 {
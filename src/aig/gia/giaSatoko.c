@@ -22,6 +22,7 @@
 #include "sat/cnf/cnf.h"
 #include "misc/extra/extra.h"
 #include "sat/satoko/satoko.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -30,6 +31,34 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define GIA_SAT_RING_SIZE  (1 << 16)           // the number of words in the ring of one solver
+#define GIA_SAT_RING_MASK  (GIA_SAT_RING_SIZE-1)
+#define GIA_SAT_ENTRY_MAX  34                  // the largest entry (size, LBD, and 32 literals)
+
+// the learnt clauses exported by one solver
+typedef struct Gia_SatRing_t_ Gia_SatRing_t;
+struct Gia_SatRing_t_
+{
+    unsigned *       pData;          // the entries (size, LBD, literals)
+    word             nHead;          // the number of words written by the owner
+    word             nExported;      // the number of clauses written by the owner
+    word             pPad[5];        // keeps the heads of the rings in different cache lines
+};
+
+// the portfolio of solvers
+typedef struct Gia_SatPort_t_ Gia_SatPort_t;
+struct Gia_SatPort_t_
+{
+    int              nSolvers;       // the number of solvers
+    satoko_t **      pSats;          // the solvers
+    Gia_SatRing_t *  pRings;         // the ring of each solver
+    word *           pCursors;       // the read position of each solver in each ring
+    int *            pStatus;        // the result of each solver
+    word *           pImported;      // the number of clauses imported by each solver
+    int              fStop;          // set by the first solver that finishes
+    int              iWinner;        // the first solver that finishes
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -147,9 +176,17 @@ satoko_t * Gia_ManSatokoFromDimacs( char * pFileName, satoko_opts_t * opts )
 }
 void Gia_ManSatokoDimacs( char * pFileName, satoko_opts_t * opts )
 {
+    extern int Gia_ManSatokoDimacsPar( char * pFileName, satoko_opts_t * opts );
     abctime clk = Abc_Clock();  
     int status = SATOKO_UNSAT;
-    satoko_t * pSat = Gia_ManSatokoFromDimacs( pFileName, opts );
+    satoko_t * pSat;
+    if ( opts->n_threads > 1 )
+    {
+        status = Gia_ManSatokoDimacsPar( pFileName, opts );
+        Gia_ManSatokoReport( -1, status, Abc_Clock() - clk );
+        return;
+    }
+    pSat = Gia_ManSatokoFromDimacs( pFileName, opts );
     if ( pSat )
     {
         status = satoko_solve( pSat );
@@ -196,11 +233,272 @@ satoko_t * Gia_ManSatokoCreate( Gia_Man_t * p, satoko_opts_t * opts )
     satoko_destroy( pSat );
     return NULL;
 }
+
+/**Function*************************************************************
+
+  Synopsis    [Diversifies the options of the solvers in the portfolio.]
+
+  Description [The first solver uses the options given by the user.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Gia_ManSatokoDiversify( satoko_opts_t * opts, int iSolver )
+{
+    static double pVarDecay[4] = { 0.95, 0.85, 0.99, 0.90 };
+    static double pRstF[4]     = { 0.80, 0.70, 0.90, 0.75 };
+    static double pRstB[2]     = { 1.40, 1.20 };
+    if ( iSolver == 0 )
+        return;
+    opts->var_decay         = pVarDecay[iSolver % 4];
+    opts->f_rst             = pRstF[(iSolver / 4) % 4];
+    opts->b_rst             = pRstB[(iSolver / 2) % 2];
+    opts->clause_decay      = (iSolver & 1) ? 0.999 : 0.995;
+    opts->lbd_freeze_clause = 30 - 5 * (iSolver % 3);
+    opts->verbose           = 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Lock-free exchange of learnt clauses.]
+
+  Description [Each solver appends its short learnt clauses to its own 
+  ring and publishes the new head. Other solvers read the rings at their 
+  own pace. The reader detects the entries that may have been overwritten 
+  while they were copied by checking the head again, and skips them, 
+  together with the entries already overwritten when it gets to them.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Gia_ManSatokoExport( void * pShare, int iSolver, unsigned * pLits, unsigned nLits, unsigned Lbd )
+{
+    Gia_SatPort_t * p = (Gia_SatPort_t *)pShare;
+    Gia_SatRing_t * pRing = p->pRings + iSolver;
+    word nHead = pRing->nHead;
+    unsigned i;
+    if ( nLits + 2 > GIA_SAT_ENTRY_MAX )
+        return;
+    pRing->nExported++;
+    __atomic_store_n( pRing->pData + (nHead++ & GIA_SAT_RING_MASK), nLits, __ATOMIC_RELAXED );
+    __atomic_store_n( pRing->pData + (nHead++ & GIA_SAT_RING_MASK), Lbd, __ATOMIC_RELAXED );
+    for ( i = 0; i < nLits; i++ )
+        __atomic_store_n( pRing->pData + (nHead++ & GIA_SAT_RING_MASK), pLits[i], __ATOMIC_RELAXED );
+    __atomic_store_n( &pRing->nHead, nHead, __ATOMIC_RELEASE );
+}
+int Gia_ManSatokoImport( void * pShare, int iSolver, satoko_t * pSat )
+{
+    Gia_SatPort_t * p = (Gia_SatPort_t *)pShare;
+    int pLits[GIA_SAT_ENTRY_MAX];
+    int k, i, nLits, Lbd, nImported = 0;
+    for ( k = 0; k < p->nSolvers; k++ )
+    {
+        Gia_SatRing_t * pRing = p->pRings + k;
+        word * pCursor = p->pCursors + iSolver * p->nSolvers + k;
+        word nHead = __atomic_load_n( &pRing->nHead, __ATOMIC_ACQUIRE );
+        if ( k == iSolver )
+            continue;
+        // skip the entries that may have been overwritten
+        if ( nHead - *pCursor > GIA_SAT_RING_SIZE - GIA_SAT_ENTRY_MAX )
+            *pCursor = nHead;
+        while ( *pCursor < nHead )
+        {
+            word nPos = *pCursor;
+            nLits = (int)__atomic_load_n( pRing->pData + (nPos++ & GIA_SAT_RING_MASK), __ATOMIC_RELAXED );
+            Lbd   = (int)__atomic_load_n( pRing->pData + (nPos++ & GIA_SAT_RING_MASK), __ATOMIC_RELAXED );
+            if ( nLits < 1 || nLits + 2 > GIA_SAT_ENTRY_MAX )
+                break;
+            for ( i = 0; i < nLits; i++ )
+                pLits[i] = (int)__atomic_load_n( pRing->pData + (nPos++ & GIA_SAT_RING_MASK), __ATOMIC_RELAXED );
+            // make sure the owner did not overwrite the entry while it was copied
+            __atomic_thread_fence( __ATOMIC_ACQUIRE );
+            if ( __atomic_load_n( &pRing->nHead, __ATOMIC_RELAXED ) - *pCursor > GIA_SAT_RING_SIZE - GIA_SAT_ENTRY_MAX )
+                break;
+            *pCursor = nPos;
+            nImported++;
+            if ( !satoko_add_learnt( pSat, pLits, nLits, Lbd ) )
+                return -1;
+        }
+        if ( *pCursor < nHead )
+            *pCursor = __atomic_load_n( &pRing->nHead, __ATOMIC_ACQUIRE );
+    }
+    p->pImported[iSolver] += nImported;
+    return nImported;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs the portfolio of solvers.]
+
+  Description [The solvers should be loaded with the same CNF. They run 
+  in parallel, sharing the learnt clauses, until one of them finishes. 
+  Returns the status and the index of this solver.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifndef ABC_USE_PTHREADS
+
+int Gia_ManSatokoSolvePar( satoko_t ** pSats, int nSolvers, int * piWinner, int fVerbose )
+{
+    *piWinner = 0;
+    return satoko_solve( pSats[0] );
+}
+
+#else // pthreads are used
+
+void Gia_ManSatokoSolveTask( void * pArg, int iThread, void * pScratch )
+{
+    Gia_SatPort_t * p = (Gia_SatPort_t *)pArg;
+    int Status = satoko_solve( p->pSats[iThread] ), iWinner = -1;
+    p->pStatus[iThread] = Status;
+    if ( Status == SATOKO_UNDEC )
+        return;
+    if ( __atomic_compare_exchange_n( &p->iWinner, &iWinner, iThread, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ) )
+        __atomic_store_n( &p->fStop, 1, __ATOMIC_RELEASE );
+}
+int Gia_ManSatokoSolvePar( satoko_t ** pSats, int nSolvers, int * piWinner, int fVerbose )
+{
+    Gia_SatPort_t Port, * p = &Port;
+    Util_Pool_t * pPool;
+    int i, Status;
+    memset( p, 0, sizeof(Gia_SatPort_t) );
+    p->nSolvers  = nSolvers;
+    p->pSats     = pSats;
+    p->pRings    = ABC_CALLOC( Gia_SatRing_t, nSolvers );
+    p->pCursors  = ABC_CALLOC( word, nSolvers * nSolvers );
+    p->pStatus   = ABC_CALLOC( int, nSolvers );
+    p->pImported = ABC_CALLOC( word, nSolvers );
+    p->iWinner   = -1;
+    for ( i = 0; i < nSolvers; i++ )
+    {
+        p->pRings[i].pData = ABC_CALLOC( unsigned, GIA_SAT_RING_SIZE );
+        satoko_set_runid( pSats[i], i );
+        satoko_set_stop( pSats[i], &p->fStop );
+        satoko_set_share( pSats[i], p, Gia_ManSatokoExport, Gia_ManSatokoImport );
+    }
+    // solver i is run by thread i
+    pPool = Util_PoolStart( nSolvers, 0 );
+    for ( i = 0; i < nSolvers; i++ )
+        Util_PoolAssign( pPool, i, Gia_ManSatokoSolveTask, (void *)p );
+    Util_PoolWaitAll( pPool );
+    Util_PoolStop( pPool );
+    *piWinner = p->iWinner >= 0 ? p->iWinner : 0;
+    Status = p->pStatus[*piWinner];
+    if ( fVerbose )
+    {
+        printf( "Portfolio of %d solvers: ", nSolvers );
+        if ( p->iWinner >= 0 )
+            printf( "solver %d finished first after %ld conflicts.\n", p->iWinner, satoko_stats(pSats[p->iWinner])->n_conflicts );
+        else
+            printf( "no solver finished.\n" );
+        for ( i = 0; i < nSolvers; i++ )
+            printf( "Solver %2d : Conflicts = %9ld.  Exported = %9.0f.  Imported = %9.0f.\n", i, 
+                satoko_stats(pSats[i])->n_conflicts, (double)p->pRings[i].nExported, (double)p->pImported[i] );
+    }
+    for ( i = 0; i < nSolvers; i++ )
+    {
+        satoko_set_stop( pSats[i], NULL );
+        satoko_set_share( pSats[i], NULL, NULL, NULL );
+        ABC_FREE( p->pRings[i].pData );
+    }
+    ABC_FREE( p->pRings );
+    ABC_FREE( p->pCursors );
+    ABC_FREE( p->pStatus );
+    ABC_FREE( p->pImported );
+    return Status;
+}
+
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Solves the AIG with the portfolio of solvers.]
+
+  Description [Returns the number of conflicts of the solver that has 
+  finished first.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Gia_ManSatokoCallPar( Gia_Man_t * p, satoko_opts_t * opts, int iOutput )
+{
+    abctime clk = Abc_Clock();
+    Cnf_Dat_t * pCnf = (Cnf_Dat_t *)Mf_ManGenerateCnf( p, 8, 0, 1, 0, 0 );
+    satoko_t ** pSats = ABC_CALLOC( satoko_t *, opts->n_threads );
+    satoko_opts_t Opts;
+    int i, iWinner, status = SATOKO_UNSAT, Cost = 0;
+    for ( i = 0; i < (int)opts->n_threads; i++ )
+    {
+        Opts = *opts;
+        Gia_ManSatokoDiversify( &Opts, i );
+        pSats[i] = Gia_ManSatokoInit( pCnf, &Opts );
+        if ( pSats[i] == NULL || satoko_simplify(pSats[i]) != SATOKO_OK )
+            break;
+    }
+    if ( i == (int)opts->n_threads )
+    {
+        status = Gia_ManSatokoSolvePar( pSats, opts->n_threads, &iWinner, opts->verbose );
+        Cost = satoko_stats(pSats[iWinner])->n_conflicts;
+    }
+    for ( i = 0; i < (int)opts->n_threads; i++ )
+        if ( pSats[i] )
+            satoko_destroy( pSats[i] );
+    ABC_FREE( pSats );
+    Cnf_DataFree( pCnf );
+    Gia_ManSatokoReport( iOutput, status, Abc_Clock() - clk );
+    return Cost;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Solves the CNF file with the portfolio of solvers.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Gia_ManSatokoDimacsPar( char * pFileName, satoko_opts_t * opts )
+{
+    satoko_t ** pSats = ABC_CALLOC( satoko_t *, opts->n_threads );
+    satoko_opts_t Opts;
+    int i, iWinner, status = SATOKO_UNSAT;
+    for ( i = 0; i < (int)opts->n_threads; i++ )
+    {
+        pSats[i] = Gia_ManSatokoFromDimacs( pFileName, opts );
+        if ( pSats[i] == NULL )
+            break;
+        Opts = *opts;
+        Gia_ManSatokoDiversify( &Opts, i );
+        satoko_configure( pSats[i], &Opts );
+    }
+    if ( i == (int)opts->n_threads )
+        status = Gia_ManSatokoSolvePar( pSats, opts->n_threads, &iWinner, opts->verbose );
+    for ( i = 0; i < (int)opts->n_threads; i++ )
+        if ( pSats[i] )
+            satoko_destroy( pSats[i] );
+    ABC_FREE( pSats );
+    return status;
+}
+
 int Gia_ManSatokoCallOne( Gia_Man_t * p, satoko_opts_t * opts, int iOutput )
 {
     abctime clk = Abc_Clock();
     satoko_t * pSat;
     int status = SATOKO_UNSAT, Cost = 0;
+    if ( opts->n_threads > 1 )
+        return Gia_ManSatokoCallPar( p, opts, iOutput );
     pSat = Gia_ManSatokoCreate( p, opts );
     if ( pSat )
     {
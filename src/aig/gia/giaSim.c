@@ -20,6 +20,7 @@
 
 #include "gia.h"
 #include "misc/util/utilTruth.h"
+#include "misc/util/utilSimd.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -395,25 +396,7 @@ static inline void Gia_ManSimulateNode( Gia_ManSim_t * p, Gia_Obj_t * pObj )
     unsigned * pInfo  = Gia_SimData( p, Gia_ObjValue(pObj) );
     unsigned * pInfo0 = Gia_SimData( p, Gia_ObjDiff0(pObj) );
     unsigned * pInfo1 = Gia_SimData( p, Gia_ObjDiff1(pObj) );
-    int w;
-    if ( Gia_ObjFaninC0(pObj) )
-    {
-        if (  Gia_ObjFaninC1(pObj) )
-            for ( w = p->nWords-1; w >= 0; w-- )
-                pInfo[w] = ~(pInfo0[w] | pInfo1[w]);
-        else 
-            for ( w = p->nWords-1; w >= 0; w-- )
-                pInfo[w] = ~pInfo0[w] & pInfo1[w];
-    }
-    else 
-    {
-        if (  Gia_ObjFaninC1(pObj) )
-            for ( w = p->nWords-1; w >= 0; w-- )
-                pInfo[w] = pInfo0[w] & ~pInfo1[w];
-        else 
-            for ( w = p->nWords-1; w >= 0; w-- )
-                pInfo[w] = pInfo0[w] & pInfo1[w];
-    }
+    Util_SimdAndUns( pInfo, pInfo0, pInfo1, Gia_ObjFaninC0(pObj), Gia_ObjFaninC1(pObj), p->nWords );
 }
 
 /**Function*************************************************************
@@ -796,29 +779,12 @@ void Gia_ManBuiltInSimStart( Gia_Man_t * p, int nWords, int nObjs )
 }
 void Gia_ManBuiltInSimPerformInt( Gia_Man_t * p, int iObj )
 {
-    Gia_Obj_t * pObj = Gia_ManObj( p, iObj ); int w;
+    Gia_Obj_t * pObj = Gia_ManObj( p, iObj );
     word * pInfo  = Gia_ManBuiltInData( p, iObj ); 
     word * pInfo0 = Gia_ManBuiltInData( p, Gia_ObjFaninId0(pObj, iObj) );
     word * pInfo1 = Gia_ManBuiltInData( p, Gia_ObjFaninId1(pObj, iObj) ); 
     assert( p->fBuiltInSim || p->fIncrSim );
-    if ( Gia_ObjFaninC0(pObj) )
-    {
-        if (  Gia_ObjFaninC1(pObj) )
-            for ( w = 0; w < p->nSimWords; w++ )
-                pInfo[w] = ~(pInfo0[w] | pInfo1[w]);
-        else 
-            for ( w = 0; w < p->nSimWords; w++ )
-                pInfo[w] = ~pInfo0[w] & pInfo1[w];
-    }
-    else 
-    {
-        if (  Gia_ObjFaninC1(pObj) )
-            for ( w = 0; w < p->nSimWords; w++ )
-                pInfo[w] = pInfo0[w] & ~pInfo1[w];
-        else 
-            for ( w = 0; w < p->nSimWords; w++ )
-                pInfo[w] = pInfo0[w] & pInfo1[w];
-    }
+    Util_SimdAnd( pInfo, pInfo0, pInfo1, Gia_ObjFaninC0(pObj), Gia_ObjFaninC1(pObj), p->nSimWords );
     assert( Vec_WrdSize(p->vSims) == Gia_ManObjNum(p) * p->nSimWords );
 }
 void Gia_ManBuiltInSimPerform( Gia_Man_t * p, int iObj )
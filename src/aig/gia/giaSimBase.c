@@ -21,7 +21,7 @@
 #include "gia.h"
 #include "misc/util/utilTruth.h"
 #include "misc/extra/extra.h"
-//#include <immintrin.h>
+#include "misc/util/utilSimd.h"
 #include "aig/miniaig/miniaig.h"
 
 ABC_NAMESPACE_IMPL_START
@@ -92,19 +92,14 @@ void Gia_ManSimPatAssignInputs( Gia_Man_t * p, int nWords, Vec_Wrd_t * vSims, Ve
 }
 static inline void Gia_ManSimPatSimAnd( Gia_Man_t * p, int i, Gia_Obj_t * pObj, int nWords, Vec_Wrd_t * vSims )
 {
-    word pComps[2] = { 0, ~(word)0 };
-    word Diff0 = pComps[Gia_ObjFaninC0(pObj)];
-    word Diff1 = pComps[Gia_ObjFaninC1(pObj)];
     word * pSims  = Vec_WrdArray(vSims);
     word * pSims0 = pSims + nWords*Gia_ObjFaninId0(pObj, i);
     word * pSims1 = pSims + nWords*Gia_ObjFaninId1(pObj, i);
-    word * pSims2 = pSims + nWords*i; int w;
+    word * pSims2 = pSims + nWords*i;
     if ( Gia_ObjIsXor(pObj) )
-        for ( w = 0; w < nWords; w++ )
-            pSims2[w] = (pSims0[w] ^ Diff0) ^ (pSims1[w] ^ Diff1);
+        Util_SimdXor( pSims2, pSims0, pSims1, Gia_ObjFaninC0(pObj) ^ Gia_ObjFaninC1(pObj), nWords );
     else
-        for ( w = 0; w < nWords; w++ )
-            pSims2[w] = (pSims0[w] ^ Diff0) & (pSims1[w] ^ Diff1);
+        Util_SimdAnd( pSims2, pSims0, pSims1, Gia_ObjFaninC0(pObj), Gia_ObjFaninC1(pObj), nWords );
 }
 static inline void Gia_ManSimPatSimPo( Gia_Man_t * p, int i, Gia_Obj_t * pObj, int nWords, Vec_Wrd_t * vSims )
 {
@@ -154,6 +149,53 @@ Vec_Wrd_t * Gia_ManSimPatSimOut( Gia_Man_t * pGia, Vec_Wrd_t * vSimsPi, int fOut
     Vec_WrdFree( vSims );
     return vSimsCo;
 }
+
+/**Function*************************************************************
+
+  Synopsis    [Compares the simulation kernels on the given AIG.]
+
+  Description [Simulates the AIG with nWords random words per input using
+  the kernels of each level supported by the CPU, checks that the results
+  are equal and prints the runtime.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Gia_ManSimPatBench( Gia_Man_t * p, int nWords, int nIters, int fVerbose )
+{
+    Vec_Wrd_t * vSimsPi = Vec_WrdStartRandom( Gia_ManCiNum(p) * nWords );
+    Vec_Wrd_t * vSims, * vSimsGold = NULL;
+    int Level, i, LevelOld = Util_SimdLevel();
+    abctime clk, clkScalar = 0;
+    printf( "Simulating %d objects with %d words (%d iterations).\n", Gia_ManObjNum(p), nWords, nIters );
+    for ( Level = UTIL_SIMD_SCALAR; Level <= Util_SimdLevelMax(); Level++ )
+    {
+        Util_SimdSetLevel( Level );
+        vSims = NULL;
+        clk = Abc_Clock();
+        for ( i = 0; i < nIters; i++ )
+        {
+            Vec_WrdFreeP( &vSims );
+            vSims = Gia_ManSimPatSimOut( p, vSimsPi, 0 );
+        }
+        clk = Abc_Clock() - clk;
+        if ( Level == UTIL_SIMD_SCALAR )
+            clkScalar = clk;
+        printf( "%-8s : ", Util_SimdLevelName(Level) );
+        printf( "Speedup = %5.2f  ", clk ? 1.0 * clkScalar / clk : 0.0 );
+        printf( "%s  ", vSimsGold == NULL || Vec_WrdEqual(vSims, vSimsGold) ? "Verified" : "MISMATCH" );
+        Abc_PrintTime( 1, "Time", clk );
+        if ( vSimsGold == NULL )
+            vSimsGold = vSims;
+        else
+            Vec_WrdFree( vSims );
+    }
+    Util_SimdSetLevel( LevelOld );
+    Vec_WrdFreeP( &vSimsGold );
+    Vec_WrdFree( vSimsPi );
+}
 static inline void Gia_ManSimPatSimAnd3( Gia_Man_t * p, int i, Gia_Obj_t * pObj, int nWords, Vec_Wrd_t * vSims, Vec_Wrd_t * vSimsC )
 {
     word pComps[2] = { ~(word)0, 0 };
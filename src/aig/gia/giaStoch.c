@@ -21,7 +21,7 @@
 #include "gia.h"
 #include "base/main/main.h"
 #include "base/cmd/cmd.h"
-
+#include "misc/util/utilPool.h"
 
 #ifdef ABC_USE_PTHREADS
 
@@ -124,39 +124,24 @@ typedef struct Gia_StochThData_t_
     int          Index;
     int          Rand;
     int          nTimeOut;
-    int          fWorking;
 } Gia_StochThData_t;
 
-void * Gia_StochWorkerThread( void * pArg )
+void Gia_StochWorkerTask( void * pArg, int iThread, void * pScratch )
 {
     Gia_StochThData_t * pThData = (Gia_StochThData_t *)pArg;
-    volatile int * pPlace = &pThData->fWorking;
     Gia_Man_t * pGia, * pNew;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->fWorking );
-        if ( pThData->Index == -1 )
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        pGia = (Gia_Man_t *)Vec_PtrEntry( pThData->vGias, pThData->Index );
-        pNew = Gia_StochProcessOne( pGia, pThData->pScript, pThData->Rand, pThData->nTimeOut );
-        Gia_ManStop( pGia );
-        Vec_PtrWriteEntry( pThData->vGias, pThData->Index, pNew );
-        pThData->fWorking = 0;
-    }
-    assert( 0 );
-    return NULL;
+    assert( pThData->Index >= 0 );
+    pGia = (Gia_Man_t *)Vec_PtrEntry( pThData->vGias, pThData->Index );
+    pNew = Gia_StochProcessOne( pGia, pThData->pScript, pThData->Rand, pThData->nTimeOut );
+    Gia_ManStop( pGia );
+    Vec_PtrWriteEntry( pThData->vGias, pThData->Index, pNew );
 }
 
 void Gia_StochProcess( Vec_Ptr_t * vGias, char * pScript, int nProcs, int TimeSecs, int fVerbose )
 {
     Gia_StochThData_t ThData[PAR_THR_MAX];
-    pthread_t WorkerThread[PAR_THR_MAX];
-    int i, k, status;
+    Util_Pool_t * pPool;
+    int i, k;
     if ( fVerbose )
         printf( "Running concurrent synthesis with %d processes.\n", nProcs );
     fflush( stdout );
@@ -174,35 +159,19 @@ void Gia_StochProcess( Vec_Ptr_t * vGias, char * pScript, int nProcs, int TimeSe
         ThData[i].Index    = -1;
         ThData[i].Rand     = Abc_Random(0) % 0x1000000;
         ThData[i].nTimeOut = TimeSecs;
-        ThData[i].fWorking = 0;
-        status = pthread_create( WorkerThread + i, NULL, Gia_StochWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
     }
+    pPool = Util_PoolStart( nProcs, 0 );
     // look at the threads
     for ( k = 0; k < Vec_PtrSize(vGias); k++ )
     {
-        for ( i = 0; i < nProcs; i++ )
-        {
-            if ( ThData[i].fWorking )
-                continue;
-            ThData[i].Index = k;
-            ThData[i].fWorking = 1;   
-            break;
-        }
-        if ( i == nProcs )
-            k--;
-    }
-    // wait till threads finish
-    for ( i = 0; i < nProcs; i++ )
-        if ( ThData[i].fWorking )
-            i = -1;
-    // stop threads
-    for ( i = 0; i < nProcs; i++ )
-    {
-        assert( !ThData[i].fWorking );
-        // stop
-        ThData[i].Index = -1;
-        ThData[i].fWorking = 1;
+        i = Util_PoolFindIdle( pPool );
+        if ( i == -1 )
+            i = Util_PoolWaitAny( pPool, NULL );
+        ThData[i].Index = k;
+        Util_PoolAssign( pPool, i, Gia_StochWorkerTask, (void *)(ThData + i) );
     }
+    // wait till threads finish and stop them
+    Util_PoolStop( pPool );
 }
 
 #endif // pthreads are used
@@ -0,0 +1,628 @@
+/**CFile****************************************************************
+
+  FileName    [giaSwitch2.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Scalable AIG package.]
+
+  Synopsis    [Multi-threaded switching activity estimation for mapping.]
+
+  Author      []
+
+  Affiliation []
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: giaSwitch2.c,v 1.00 2026/10/18 00:00:00 Exp $]
+
+***********************************************************************/
+
+#include "gia.h"
+#include "misc/util/utilNam.h"
+#include "misc/util/utilPool.h"
+#include "misc/util/utilTruth.h"
+#include "misc/extra/extra.h"
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+/*
+    The combinational logic is simulated with 64-bit words. The patterns
+    are divided into blocks of GIA_SWI_BLOCK words, which are simulated
+    independently by the worker threads. The scratch memory of each
+    worker of the pool keeps the simulation info of one block for all
+    objects, followed by the counters accumulated by this worker, which
+    are added up at the end, so the result does not depend on the
+    number of threads.
+
+    Without stimuli, the patterns are random (the probability of one of
+    each CI can be given by the user) and the switching activity is
+    2 * P1 * (1 - P1), as in Sim_NtkComputeSwitching(). With stimuli
+    (for example, read from a VCD file), bit t of the pattern stream is
+    the value in time step t, and the switching activity is the number
+    of toggles divided by the number of steps minus one. To count the
+    toggles across the block boundaries, each block except the first one
+    also simulates the last word of the previous block. The toggles in the
+    unused bits of the last word (after nSteps) are not counted. The random
+    word of a CI is generated from the seed derived from the CI and the
+    word index, so the patterns (including the repeated last word of the
+    previous block) do not depend on how the words are divided into
+    blocks or on the order, in which the blocks are simulated.
+*/
+
+#define GIA_SWI_BLOCK    8       // the number of words in one block
+
+typedef struct Gia_SwiSim_t_ Gia_SwiSim_t;
+struct Gia_SwiSim_t_
+{
+    Gia_Man_t *    p;            // the AIG
+    Vec_Int_t *    vProbs;       // the probability of one of each CI (16-bit fixed point)
+    Vec_Wrd_t *    vStims;       // the stimuli of the CIs (or NULL)
+    Vec_Int_t *    vStimCis;     // marks the CIs having stimuli
+    int            nStimWords;   // the number of stimuli words for each CI
+    int            nSteps;       // the number of time steps of the stimuli
+    int            nWords;       // the total number of words
+    int            nBlocks;      // the number of blocks
+};
+
+typedef struct Gia_SwiTask_t_ Gia_SwiTask_t;
+struct Gia_SwiTask_t_
+{
+    Gia_SwiSim_t * pMan;         // the simulation manager
+    int            iBlock;       // the block to simulate
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Random number generation.]
+
+  Description [Each word of each CI has its own generator, whose state is
+  derived from the CI and the word index. The biased word is built from
+  the binary digits of the probability, starting from the least 
+  significant one.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline word Gia_SwiSeed( int iCi, int iWord )
+{
+    word z = ABC_CONST(0x9E3779B97F4A7C15) * ((((word)iCi) << 32) + (word)iWord + 1);
+    z = (z ^ (z >> 30)) * ABC_CONST(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * ABC_CONST(0x94D049BB133111EB);
+    z ^= z >> 31;
+    return z ? z : 1;
+}
+static inline word Gia_SwiRandom( word * pState )
+{
+    word x = *pState;
+    x ^= x >> 12;  x ^= x << 25;  x ^= x >> 27;
+    *pState = x;
+    return x * ABC_CONST(0x2545F4914F6CDD1D);
+}
+static inline word Gia_SwiRandomBiased( word * pState, int Prob )
+{
+    word Res = 0;
+    int k;
+    if ( Prob <= 0 )
+        return 0;
+    if ( Prob >= (1 << 16) )
+        return ~(word)0;
+    for ( k = 0; !((Prob >> k) & 1); k++ );
+    for ( ; k < 16; k++ )
+        Res = ((Prob >> k) & 1) ? (Res | Gia_SwiRandom(pState)) : (Res & Gia_SwiRandom(pState));
+    return Res;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Simulates one block of patterns.]
+
+  Description [Runs in a worker thread.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_ManSwiSimBlock( void * pArg, int iThread, void * pScratch )
+{
+    Gia_SwiTask_t * pTask = (Gia_SwiTask_t *)pArg;
+    Gia_SwiSim_t * pMan = pTask->pMan;
+    Gia_Man_t * p = pMan->p;
+    int nStride = GIA_SWI_BLOCK + 1;
+    word * pSims = (word *)pScratch;
+    int * pCounts = (int *)(pSims + nStride * Gia_ManObjNum(p));
+    int iStart  = pTask->iBlock * GIA_SWI_BLOCK;
+    int nLimit  = Abc_MinInt( GIA_SWI_BLOCK, pMan->nWords - iStart );
+    int fPrev   = pMan->vStims && pTask->iBlock > 0;
+    int nLocal  = nLimit + fPrev;
+    int iLast   = pMan->vStims ? pMan->nStimWords - 1 - (iStart - fPrev) : -1;
+    word MaskLast = (pMan->vStims && pMan->nSteps % 64) ? (((word)1 << (pMan->nSteps % 64)) - 1) : ~(word)0;
+    word State;
+    Gia_Obj_t * pObj;
+    int i, k, Id;
+    // assign the CIs
+    memset( pSims, 0, sizeof(word) * nStride );
+    Gia_ManForEachCi( p, pObj, i )
+    {
+        word * pSim = pSims + nStride * Gia_ObjId(p, pObj);
+        if ( pMan->vStims && Vec_IntEntry(pMan->vStimCis, i) )
+        {
+            word * pStim = Vec_WrdEntryP( pMan->vStims, i * pMan->nStimWords ) + iStart - fPrev;
+            memcpy( pSim, pStim, sizeof(word) * nLocal );
+        }
+        else
+        {
+            int Prob = Vec_IntEntry( pMan->vProbs, i );
+            for ( k = 0; k < nLocal; k++ )
+            {
+                State = Gia_SwiSeed( i, iStart - fPrev + k );
+                pSim[k] = Gia_SwiRandomBiased( &State, Prob );
+            }
+        }
+    }
+    // simulate the internal nodes
+    Gia_ManForEachAnd( p, pObj, Id )
+    {
+        word * pSim  = pSims + nStride * Id;
+        word * pSim0 = pSims + nStride * Gia_ObjFaninId0(pObj, Id);
+        word * pSim1 = pSims + nStride * Gia_ObjFaninId1(pObj, Id);
+        word Mask0 = Gia_ObjFaninC0(pObj) ? ~(word)0 : 0;
+        word Mask1 = Gia_ObjFaninC1(pObj) ? ~(word)0 : 0;
+        for ( k = 0; k < nLocal; k++ )
+            pSim[k] = (pSim0[k] ^ Mask0) & (pSim1[k] ^ Mask1);
+    }
+    // count ones or toggles
+    Gia_ManForEachObj1( p, pObj, Id )
+    {
+        word * pSim = pSims + nStride * Id;
+        if ( Gia_ObjIsCo(pObj) )
+            continue;
+        if ( pMan->vStims == NULL )
+        {
+            pCounts[Id] += Abc_TtCountOnesVec( pSim, nLocal );
+            continue;
+        }
+        for ( k = fPrev; k < nLocal; k++ )
+        {
+            word Toggles = pSim[k] ^ ((pSim[k] << 1) | (k ? pSim[k-1] >> 63 : 0));
+            if ( k == 0 )
+                Toggles &= ~(word)1;
+            if ( k == iLast )
+                Toggles &= MaskLast;
+            pCounts[Id] += Abc_TtCountOnes( Toggles );
+        }
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes switching activity of all objects.]
+
+  Description [Simulates 64 * nWords random patterns, or the stimuli
+  (nSteps time steps for the CIs marked in vStimCis; vStims has
+  (nSteps + 63) / 64 words for each CI, where the unused bits repeat the
+  last value). vProbs (if not NULL) gives the probability of one of the
+  CIs that are simulated randomly. Returns the switching activity of
+  each object; the CO has the same activity as its driver.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Flt_t * Gia_ManSimSwitching( Gia_Man_t * p, Vec_Flt_t * vProbs, Vec_Wrd_t * vStims, Vec_Int_t * vStimCis, int nSteps, int nWords, int nThreads, int fVerbose )
+{
+    abctime clk = Abc_Clock();
+    Gia_SwiSim_t Man, * pMan = &Man;
+    Gia_SwiTask_t * pTasks;
+    Util_Pool_t * pPool;
+    Vec_Flt_t * vSwitching;
+    Gia_Obj_t * pObj;
+    int * pCounts;
+    int i, k, Id, nTotal, nScratch;
+    assert( vProbs == NULL || Vec_FltSize(vProbs) == Gia_ManCiNum(p) );
+    assert( vStims == NULL || (vStimCis && Vec_IntSize(vStimCis) == Gia_ManCiNum(p)) );
+    memset( pMan, 0, sizeof(Gia_SwiSim_t) );
+    pMan->p        = p;
+    pMan->vProbs   = Vec_IntAlloc( Gia_ManCiNum(p) );
+    for ( i = 0; i < Gia_ManCiNum(p); i++ )
+        Vec_IntPush( pMan->vProbs, vProbs ? (int)(Abc_MaxFloat(0, Abc_MinFloat(1, Vec_FltEntry(vProbs, i))) * (1 << 16) + 0.5) : (1 << 15) );
+    if ( vStims && nSteps > 1 )
+    {
+        pMan->vStims     = vStims;
+        pMan->vStimCis   = vStimCis;
+        pMan->nStimWords = Vec_WrdSize(vStims) / Gia_ManCiNum(p);
+        pMan->nSteps     = nSteps;
+        pMan->nWords     = pMan->nStimWords;
+        assert( pMan->nStimWords == (nSteps + 63) / 64 );
+    }
+    else
+        pMan->nWords = Abc_MaxInt( 1, nWords );
+    pMan->nBlocks = (pMan->nWords + GIA_SWI_BLOCK - 1) / GIA_SWI_BLOCK;
+    nThreads = Abc_MaxInt( 1, Abc_MinInt(nThreads, pMan->nBlocks) );
+    // each worker gets the simulation info of one block and its counters
+    nScratch = (sizeof(word) * (GIA_SWI_BLOCK + 1) + sizeof(int)) * Gia_ManObjNum(p);
+    // simulate the blocks
+    pTasks = ABC_CALLOC( Gia_SwiTask_t, pMan->nBlocks );
+    pPool = Util_PoolStart( nThreads, nScratch );
+    for ( i = 0; i < pMan->nBlocks; i++ )
+    {
+        pTasks[i].pMan   = pMan;
+        pTasks[i].iBlock = i;
+        if ( (k = Util_PoolFindIdle(pPool)) < 0 )
+            k = Util_PoolWaitAny( pPool, NULL );
+        Util_PoolAssign( pPool, k, Gia_ManSwiSimBlock, (void *)(pTasks + i) );
+    }
+    Util_PoolWaitAll( pPool );
+    // combine the counters
+    pCounts = ABC_CALLOC( int, Gia_ManObjNum(p) );
+    for ( k = 0; k < nThreads; k++ )
+    {
+        word * pSims = (word *)Util_PoolScratch( pPool, k );
+        int * pCountsThis = (int *)(pSims + (GIA_SWI_BLOCK + 1) * Gia_ManObjNum(p));
+        for ( Id = 0; Id < Gia_ManObjNum(p); Id++ )
+            pCounts[Id] += pCountsThis[Id];
+    }
+    Util_PoolStop( pPool );
+    // compute the switching activity
+    nTotal = pMan->vStims ? nSteps - 1 : 64 * pMan->nWords;
+    vSwitching = Vec_FltStart( Gia_ManObjNum(p) );
+    Gia_ManForEachObj1( p, pObj, Id )
+    {
+        float Prob;
+        if ( Gia_ObjIsCo(pObj) )
+        {
+            Vec_FltWriteEntry( vSwitching, Id, Vec_FltEntry(vSwitching, Gia_ObjFaninId0(pObj, Id)) );
+            continue;
+        }
+        Prob = (float)pCounts[Id] / nTotal;
+        Vec_FltWriteEntry( vSwitching, Id, pMan->vStims ? Prob : (float)2.0 * Prob * (1 - Prob) );
+    }
+    if ( fVerbose )
+    {
+        printf( "Simulated %d %s of %d objects in %d blocks using %d threads.  ",
+            pMan->vStims ? nSteps : 64 * pMan->nWords, pMan->vStims ? "time steps" : "random patterns",
+            Gia_ManObjNum(p), pMan->nBlocks, nThreads );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    // cleanup
+    ABC_FREE( pCounts );
+    ABC_FREE( pTasks );
+    Vec_IntFree( pMan->vProbs );
+    return vSwitching;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Maps the names of the CIs into their indexes.]
+
+  Description [The CI with index i gets the name ID i+1.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Abc_Nam_t * Gia_ManSwiCiNames( Gia_Man_t * p )
+{
+    Abc_Nam_t * pNames;
+    int i;
+    if ( p->vNamesIn == NULL )
+        return NULL;
+    pNames = Abc_NamStart( Gia_ManCiNum(p), 16 );
+    for ( i = 0; i < Gia_ManCiNum(p); i++ )
+        Abc_NamStrFindOrAdd( pNames, (char *)Vec_PtrEntry(p->vNamesIn, i), NULL );
+    return pNames;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the probabilities of one of the CIs.]
+
+  Description [Each line is either "<name> <probability>" or only the
+  probability, in which case the lines follow the order of the CIs.
+  The CIs not listed have probability 0.5. Lines starting with '#' are
+  comments.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Flt_t * Gia_ManSwiReadProbs( Gia_Man_t * p, char * pFileName )
+{
+    Abc_Nam_t * pNames = Gia_ManSwiCiNames( p );
+    Vec_Flt_t * vProbs;
+    char Buffer[1000], * pToken, * pToken2;
+    int iCi = 0, nLines = 0;
+    FILE * pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open file \"%s\" with input probabilities.\n", pFileName );
+        if ( pNames ) Abc_NamStop( pNames );
+        return NULL;
+    }
+    vProbs = Vec_FltAlloc( Gia_ManCiNum(p) );
+    Vec_FltFill( vProbs, Gia_ManCiNum(p), 0.5 );
+    while ( fgets( Buffer, 1000, pFile ) )
+    {
+        nLines++;
+        pToken = strtok( Buffer, " \t\r\n" );
+        if ( pToken == NULL || pToken[0] == '#' )
+            continue;
+        pToken2 = strtok( NULL, " \t\r\n" );
+        if ( pToken2 == NULL ) // the probability only
+        {
+            if ( iCi < Gia_ManCiNum(p) )
+                Vec_FltWriteEntry( vProbs, iCi++, (float)atof(pToken) );
+            continue;
+        }
+        iCi = pNames ? Abc_NamStrFind( pNames, pToken ) - 1 : -1;
+        if ( iCi < 0 )
+            printf( "Line %d: Cannot find CI \"%s\".\n", nLines, pToken );
+        else
+            Vec_FltWriteEntry( vProbs, iCi++, (float)atof(pToken2) );
+    }
+    fclose( pFile );
+    if ( pNames ) Abc_NamStop( pNames );
+    return vProbs;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Finds the CI corresponding to one bit of a VCD variable.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Gia_ManSwiVcdFindCi( Abc_Nam_t * pNames, char * pRef, int Index )
+{
+    char Buffer[1000];
+    int Id;
+    if ( Index >= 0 )
+    {
+        snprintf( Buffer, 1000, "%s[%d]", pRef, Index );
+        if ( (Id = Abc_NamStrFind( pNames, Buffer )) )
+            return Id - 1;
+    }
+    return Abc_NamStrFind( pNames, pRef ) - 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the stimuli of the CIs from a VCD file.]
+
+  Description [The variables are matched with the CIs by their names
+  (the scope is ignored; bit i of vector "x" corresponds to CI "x[i]").
+  Each timestamp gives one time step, which holds the values after all
+  changes at that time. The values x and z are treated as 0. Returns
+  the stimuli in the format of Gia_ManSimSwitching(), the number of
+  time steps and the CIs that have stimuli.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Wrd_t * Gia_ManSwiReadVcd( Gia_Man_t * p, char * pFileName, int * pnSteps, Vec_Int_t ** pvStimCis, int fVerbose )
+{
+    Abc_Nam_t * pNames = Gia_ManSwiCiNames( p );
+    Abc_Nam_t * pCodes;
+    Vec_Wec_t * vCode2Cis;      // for each code, pairs (CI, bit position from MSB)
+    Vec_Int_t * vCodeSizes;     // for each code, the size of the variable
+    Vec_Wrd_t * vRows, * vStims = NULL;
+    Vec_Int_t * vStimCis;
+    char * pContents, * pCur, * pToken, * pValue;
+    char * pVals;
+    int nCis = Gia_ManCiNum(p), nCiWords = Abc_Bit6WordNum(Gia_ManCiNum(p));
+    int i, t, k, fDefs = 1, fStarted = 0, nSteps = 0, nMatched = 0;
+    *pnSteps = 0;
+    *pvStimCis = NULL;
+    if ( pNames == NULL )
+    {
+        printf( "The CI names are not available.\n" );
+        return NULL;
+    }
+    pContents = Extra_FileReadContents( pFileName );
+    if ( pContents == NULL )
+    {
+        printf( "Cannot open VCD file \"%s\".\n", pFileName );
+        Abc_NamStop( pNames );
+        return NULL;
+    }
+    pCodes     = Abc_NamStart( 1000, 4 );
+    vCode2Cis  = Vec_WecStart( 1 );
+    vCodeSizes = Vec_IntStart( 1 );
+    vStimCis   = Vec_IntStart( nCis );
+    vRows      = Vec_WrdAlloc( 1000 );
+    pVals      = ABC_CALLOC( char, nCis );
+    for ( pCur = pContents; ; )
+    {
+        // get the next token
+        while ( *pCur == ' ' || *pCur == '\t' || *pCur == '\r' || *pCur == '\n' )
+            pCur++;
+        if ( *pCur == 0 )
+            break;
+        pToken = pCur;
+        while ( *pCur && *pCur != ' ' && *pCur != '\t' && *pCur != '\r' && *pCur != '\n' )
+            pCur++;
+        if ( *pCur )
+            *pCur++ = 0;
+        if ( fDefs )
+        {
+            // $var <type> <size> <code> <reference> [<range>] $end
+            if ( !strcmp(pToken, "$var") )
+            {
+                char * pTokens[6] = { NULL };
+                int nTokens = 0, Size, Msb = -1, Lsb = -1, iCode;
+                while ( nTokens < 6 )
+                {
+                    while ( *pCur == ' ' || *pCur == '\t' || *pCur == '\r' || *pCur == '\n' )
+                        pCur++;
+                    pTokens[nTokens] = pCur;
+                    while ( *pCur && *pCur != ' ' && *pCur != '\t' && *pCur != '\r' && *pCur != '\n' )
+                        pCur++;
+                    if ( *pCur )
+                        *pCur++ = 0;
+                    if ( !strcmp(pTokens[nTokens], "$end") || *pTokens[nTokens] == 0 )
+                        break;
+                    nTokens++;
+                }
+                if ( nTokens < 4 )
+                    continue;
+                Size = atoi( pTokens[1] );
+                if ( nTokens > 4 && pTokens[4][0] == '[' )
+                {
+                    Msb = Lsb = atoi( pTokens[4] + 1 );
+                    if ( strchr(pTokens[4], ':') )
+                        Lsb = atoi( strchr(pTokens[4], ':') + 1 );
+                }
+                else if ( Size > 1 )
+                    Msb = Size - 1, Lsb = 0;
+                iCode = Abc_NamStrFindOrAdd( pCodes, pTokens[2], NULL );
+                if ( iCode == Vec_WecSize(vCode2Cis) )
+                {
+                    Vec_WecPushLevel( vCode2Cis );
+                    Vec_IntPush( vCodeSizes, Size );
+                }
+                for ( k = 0; k < Size; k++ )
+                {
+                    int Index = Msb < 0 ? -1 : (Msb >= Lsb ? Msb - k : Msb + k);
+                    int iCi = Gia_ManSwiVcdFindCi( pNames, pTokens[3], Index );
+                    if ( iCi < 0 || Vec_IntEntry(vStimCis, iCi) )
+                        continue;
+                    Vec_IntWriteEntry( vStimCis, iCi, 1 );
+                    Vec_WecPush( vCode2Cis, iCode, iCi );
+                    Vec_WecPush( vCode2Cis, iCode, k );
+                    nMatched++;
+                }
+            }
+            else if ( !strcmp(pToken, "$enddefinitions") )
+                fDefs = 0;
+            continue;
+        }
+        if ( pToken[0] == '#' )
+        {
+            // save the values of the previous time step
+            if ( fStarted )
+            {
+                for ( i = 0; i < nCiWords; i++ )
+                    Vec_WrdPush( vRows, 0 );
+                for ( i = 0; i < nCis; i++ )
+                    if ( pVals[i] )
+                        Abc_TtSetBit( Vec_WrdLimit(vRows) - nCiWords, i );
+                nSteps++;
+            }
+            fStarted = 1;
+            continue;
+        }
+        if ( pToken[0] == '$' )
+        {
+            if ( !strcmp(pToken, "$comment") )
+                while ( *pCur && strncmp(pCur, "$end", 4) )
+                    pCur++;
+            continue;
+        }
+        if ( pToken[0] == 'r' || pToken[0] == 'R' || pToken[0] == 'b' || pToken[0] == 'B' )
+        {
+            // the value is followed by the code
+            pValue = pToken + 1;
+            while ( *pCur == ' ' || *pCur == '\t' || *pCur == '\r' || *pCur == '\n' )
+                pCur++;
+            pToken = pCur;
+            while ( *pCur && *pCur != ' ' && *pCur != '\t' && *pCur != '\r' && *pCur != '\n' )
+                pCur++;
+            if ( *pCur )
+                *pCur++ = 0;
+            if ( pValue[-1] == 'r' || pValue[-1] == 'R' )
+                continue;
+        }
+        else
+        {
+            // the scalar value is immediately followed by the code
+            pValue = pToken++;
+        }
+        {
+            int iCode = Abc_NamStrFind( pCodes, pToken );
+            int Size, nLen, iCi, Pos;
+            Vec_Int_t * vPairs;
+            if ( iCode == 0 )
+                continue;
+            Size   = Vec_IntEntry( vCodeSizes, iCode );
+            nLen   = pValue == pToken - 1 ? 1 : (int)strlen(pValue);
+            vPairs = Vec_WecEntry( vCode2Cis, iCode );
+            Vec_IntForEachEntryDouble( vPairs, iCi, k, i )
+            {
+                // the vector values are extended with zeros on the left
+                Pos = k - (Size - nLen);
+                pVals[iCi] = (char)(Pos >= 0 && pValue[Pos] == '1');
+            }
+        }
+    }
+    if ( fStarted )
+    {
+        for ( i = 0; i < nCiWords; i++ )
+            Vec_WrdPush( vRows, 0 );
+        for ( i = 0; i < nCis; i++ )
+            if ( pVals[i] )
+                Abc_TtSetBit( Vec_WrdLimit(vRows) - nCiWords, i );
+        nSteps++;
+    }
+    if ( nMatched == 0 || nSteps < 2 )
+        printf( "VCD file \"%s\" has %d time steps for %d CIs, which is not enough for simulation.\n", pFileName, nSteps, nMatched );
+    else
+    {
+        // transpose the time steps into the stimuli of the CIs
+        int nStimWords = (nSteps + 63) / 64;
+        vStims = Vec_WrdStart( nCis * nStimWords );
+        for ( i = 0; i < nCis; i++ )
+        {
+            word * pStim = Vec_WrdEntryP( vStims, i * nStimWords );
+            for ( t = 0; t < nSteps; t++ )
+                if ( Abc_TtGetBit( Vec_WrdEntryP(vRows, t * nCiWords), i ) )
+                    Abc_TtSetBit( pStim, t );
+            // repeat the last value in the unused bits
+            if ( Abc_TtGetBit( pStim, nSteps - 1 ) )
+                for ( t = nSteps; t < 64 * nStimWords; t++ )
+                    Abc_TtSetBit( pStim, t );
+        }
+        *pnSteps   = nSteps;
+        *pvStimCis = vStimCis;
+        vStimCis   = NULL;
+        if ( fVerbose )
+            printf( "VCD file \"%s\" has %d time steps for %d (out of %d) CIs.\n", pFileName, nSteps, nMatched, nCis );
+    }
+    Vec_IntFreeP( &vStimCis );
+    Vec_WrdFree( vRows );
+    Vec_WecFree( vCode2Cis );
+    Vec_IntFree( vCodeSizes );
+    Abc_NamStop( pCodes );
+    Abc_NamStop( pNames );
+    ABC_FREE( pContents );
+    ABC_FREE( pVals );
+    return vStims;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
+
@@ -1558,6 +1558,14 @@ Abc_Ntk_t * Abc_NtkDRewrite( Abc_Ntk_t * pNtk, Dar_RwrPar_t * pPars )
         Vec_VecFree( vParts );
     }
 */
+    if ( pPars->nProcs > 1 )
+    {
+        pMan = Dar_ManRewritePar( pTemp = pMan, pPars );
+        Aig_ManStop( pTemp );
+        pNtkAig = Abc_NtkFromDar( pNtk, pMan );
+        Aig_ManStop( pMan );
+        return pNtkAig;
+    }
     Dar_ManRewrite( pMan, pPars );
 //    pMan = Dar_ManBalance( pTemp = pMan, pPars->fUpdateLevel );
 //    Aig_ManStop( pTemp );
@@ -1838,7 +1846,7 @@ Abc_Ntk_t * Abc_NtkConstructFromCnf( Abc_Ntk_t * pNtk, Cnf_Man_t * p, Vec_Ptr_t
   SeeAlso     []
 
 ***********************************************************************/
-Abc_Ntk_t * Abc_NtkDarToCnf( Abc_Ntk_t * pNtk, char * pFileName, int fFastAlgo, int fChangePol, int fVerbose )
+Abc_Ntk_t * Abc_NtkDarToCnf( Abc_Ntk_t * pNtk, char * pFileName, int fFastAlgo, int fChangePol, int nProcs, int fVerbose )
 {
 //    Vec_Ptr_t * vMapped = NULL;
     Aig_Man_t * pMan;
@@ -1864,7 +1872,7 @@ Abc_Ntk_t * Abc_NtkDarToCnf( Abc_Ntk_t * pNtk, char * pFileName, int fFastAlgo,
 
     // derive CNF
     if ( fFastAlgo )
-        pCnf = Cnf_DeriveFast( pMan, 0 );
+        pCnf = Cnf_DeriveFastPar( pMan, 0, nProcs );
     else
         pCnf = Cnf_Derive( pMan, 0 );
 
@@ -241,18 +241,62 @@ void call_python(){
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
 
+/**Function*************************************************************
+
+  Synopsis    [Derives the libraries for mapping from the Liberty library.]
+
+  Description [Derives the genlib library from the current Liberty library,
+  updates the delays of the current genlib library, and derives the
+  supergate library. The supergate library remembers the parameters, so 
+  that the next calls with the same parameters reuse both libraries (for
+  example, the jobs of the ABC server reuse the libraries derived by the 
+  server). Returns the genlib library used for mapping, or NULL if the 
+  libraries cannot be derived.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Mio_Library_t * Abc_NtkMapDeriveLibs( float Slew, float Gain, int nGatesMin, int fVerbose )
+{
+    Map_SuperLib_t * pSuperLib = (Map_SuperLib_t *)Abc_FrameReadLibSuper();
+    Mio_Library_t * pLib;
+    if ( Map_SuperLibCheckScl( pSuperLib, Abc_FrameReadLibScl(), Slew, Gain, nGatesMin ) )
+        return Map_SuperLibReadGenLib( pSuperLib );
+    // junfeng: 1. compute LD and PD, 2. write LD PD to the string, 3. parse LD PD from the string and set their to Mio_Pin_t
+    pLib = Abc_SclDeriveGenlib( Abc_FrameReadLibScl(), NULL, Slew, Gain, nGatesMin, fVerbose );
+    if ( pLib == NULL )
+        return NULL;
+    if ( Abc_FrameReadLibGen() )
+    {
+        // junfeng: update the load independent delay, LD and DP to Abc_FrameReadLibGen;
+        Mio_LibraryTransferDelays( (Mio_Library_t *)Abc_FrameReadLibGen(), pLib );
+        Mio_LibraryTransferProfile( pLib, (Mio_Library_t *)Abc_FrameReadLibGen() );
+    }
+    // replace the supergate library (the new one owns the derived genlib library)
+    Map_SuperLibFree( pSuperLib );
+    Abc_FrameSetLibSuper( NULL );
+    Map_SuperLibDeriveFromGenlib( pLib, fVerbose );
+    if ( Abc_FrameReadLibSuper() == NULL )
+        return NULL;
+    Map_SuperLibSetScl( (Map_SuperLib_t *)Abc_FrameReadLibSuper(), Abc_FrameReadLibScl(), Slew, Gain, nGatesMin );
+    return pLib;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Interface with the mapping package.]
 
-  Description []
+  Description [If pItStats is not NULL, the runtime profile of ITMap is
+  recorded there.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-Abc_Ntk_t * Abc_NtkMap( Abc_Ntk_t * pNtk, double DelayTarget, double AreaMulti, double DelayMulti, float LogFan, float Slew, float Gain, int nGatesMin, int fRecovery, int fSwitching, int fSkipFanout, int fUseProfile, int fUseBuffs, int fVerbose, int usingExp, int fGradient )
+Abc_Ntk_t * Abc_NtkMap( Abc_Ntk_t * pNtk, double DelayTarget, double AreaMulti, double DelayMulti, float LogFan, float Slew, float Gain, int nGatesMin, int fRecovery, int fSwitching, int fSkipFanout, int fUseProfile, int fUseBuffs, int fVerbose, int usingExp, int fGradient, float FidRatio, int fPrintProf, char * pActFile, int nThreads, Map_ItStats_t * pItStats )
 {   
     // test_bayes2();
     // call_python(); 
@@ -266,9 +310,14 @@ Abc_Ntk_t * Abc_NtkMap( Abc_Ntk_t * pNtk, double DelayTarget, double AreaMulti,
     Mio_Library_t * pLib = (Mio_Library_t *)Abc_FrameReadLibGen();
 
     assert( Abc_NtkIsStrash(pNtk) );
+    if ( pItStats )
+        memset( pItStats, 0, sizeof(Map_ItStats_t) );
     // derive library from SCL
     // if the library is created here, it will be deleted when pSuperLib is deleted in Map_SuperLibFree()
-    if ( Abc_FrameReadLibScl() && Abc_SclHasDelayInfo( Abc_FrameReadLibScl() ) )
+    if ( Abc_FrameReadLibScl() && Abc_SclHasDelayInfo( Abc_FrameReadLibScl() ) && 
+         !fUseMulti && AreaMulti == 0.0 && DelayMulti == 0.0 && !(pLib && Mio_LibraryHasProfile(pLib)) )
+        pLib = Abc_NtkMapDeriveLibs( Slew, Gain, nGatesMin, fVerbose );
+    else if ( Abc_FrameReadLibScl() && Abc_SclHasDelayInfo( Abc_FrameReadLibScl() ) )
     {
         if ( pLib && Mio_LibraryHasProfile(pLib) )
             pLib = Abc_SclDeriveGenlib( Abc_FrameReadLibScl(), pLib, Slew, Gain, nGatesMin, fVerbose );
@@ -328,8 +377,8 @@ Abc_Ntk_t * Abc_NtkMap( Abc_Ntk_t * pNtk, double DelayTarget, double AreaMulti,
     fShowSwitching |= fSwitching;
     if ( fShowSwitching )
     {
-        extern Vec_Int_t * Sim_NtkComputeSwitching( Abc_Ntk_t * pNtk, int nPatterns );
-        vSwitching = Sim_NtkComputeSwitching( pNtk, 4096 );
+        extern Vec_Int_t * Sim_NtkComputeSwitchingExt( Abc_Ntk_t * pNtk, int nPatterns, char * pActFile, int nThreads, int fVerbose );
+        vSwitching = Sim_NtkComputeSwitchingExt( pNtk, 4096, pActFile, nThreads, fVerbose );
         pSwitching = (float *)vSwitching->pArray;
     }
  
@@ -363,6 +412,8 @@ Abc_Ntk_t * Abc_NtkMap( Abc_Ntk_t * pNtk, double DelayTarget, double AreaMulti,
 clk = Abc_Clock();
     Map_ManSetSwitching( pMan, fSwitching );
     Map_ManSetSkipFanout( pMan, fSkipFanout );
+    Map_ManSetItStats( pMan, pItStats );
+    Map_ManSetPrintProf( pMan, fPrintProf );
     if ( fUseProfile )
         Map_ManSetUseProfile( pMan );
     if ( LogFan != 0 )
@@ -381,15 +432,24 @@ clk = Abc_Clock();
             return NULL;
         }
     } else {
-        if ( !Map_MappingHeboIt( pMan, pNtk, pLib,  1, DelayTarget, fUseBuffs, fGradient)){
+        // collect the non-dominated candidates into a new archive
+        Map_Arch_t * pArch = Abc_FrameReadLibGen() ? Map_ArchStart( pNtk, (Mio_Library_t *)Abc_FrameReadLibGen() ) : NULL;
+        Map_ManSetArchive( pMan, pArch );
+        if ( !Map_MappingHeboIt( pMan, pNtk, pLib,  1, DelayTarget, fUseBuffs, fGradient, FidRatio )){
+            Map_ArchStop( pArch );
             Map_ManFree( pMan );
             return NULL;
         }
+        Map_ArchStop( (Map_Arch_t *)Abc_FrameReadMapArch() );
+        Abc_FrameSetMapArch( pArch );
     }
      
     
 //    Map_ManPrintStatsToFile( pNtk->pSpec, Map_ManReadAreaFinal(pMan), Map_ManReadRequiredGlo(pMan), Abc_Clock()-clk );
 
+    if ( fPrintProf )
+        Map_ManProfPrint( pMan );
+
     // reconstruct the network after mapping (use buffers when user requested or in the area mode)
     pNtkNew = Abc_NtkFromMap( pMan, pNtk, fUseBuffs || (DelayTarget == (double)ABC_INFINITY) );
     if ( Mio_LibraryHasProfile(pLib) )
@@ -400,6 +460,8 @@ clk = Abc_Clock();
 
     if ( pNtk->pExdc )
         pNtkNew->pExdc = Abc_NtkDup( pNtk->pExdc );
+    if ( pItStats )
+        pItStats->clkTotal = Abc_Clock() - clkTotal;
 if ( fVerbose )
 {
 ABC_PRT( "Total runtime", Abc_Clock() - clkTotal );
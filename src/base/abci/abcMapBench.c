@@ -0,0 +1,427 @@
+/**CFile****************************************************************
+
+  FileName    [abcMapBench.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Network and node package.]
+
+  Synopsis    [Benchmarking standard-cell mapping over a suite of designs.]
+
+  Author      []
+
+  Affiliation []
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: abcMapBench.c,v 1.00 2026/10/18 00:00:00 Exp $]
+
+***********************************************************************/
+
+#include "base/abc/abc.h"
+#include "base/main/mainInt.h"
+#include "base/cmd/cmd.h"
+#include "map/mio/mio.h"
+#include "map/mapper/mapper.h"
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#define ABC_BENCH_TIMES  10
+
+// the runtimes recorded for each run (in this order)
+static const char * s_BenchTimeNames[ABC_BENCH_TIMES] = {
+    "total", "map_tt", "init_py", "iter_exp", "deter_para",
+    "iter_bayes", "gradient", "delay_map", "area_recovery", "sta"
+};
+
+// the mapping modes
+static const char * s_BenchModeNames[2] = { "itmap", "classic" };
+static const char * s_BenchModeCmds[2]  = { "map",   "map -e"  };
+
+typedef struct Abc_BenchRes_t_ Abc_BenchRes_t;
+struct Abc_BenchRes_t_
+{
+    char *         pName;        // the benchmark file
+    const char *   pMode;        // the mapping mode
+    int            fOk;          // the run has succeeded
+    double         Delay;        // the delay after STA (ps)
+    double         Area;         // the area after STA
+    int            nGates;       // the number of gates
+    double         Times[ABC_BENCH_TIMES]; // the runtimes (sec)
+    int            nEvals[3];    // the ITMap evaluations per fidelity tier
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the list of benchmarks.]
+
+  Description [The list contains one file per line. Empty lines and lines
+  starting with '#' are skipped. Relative names, which cannot be opened
+  from the current directory, are taken relative to the list.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Vec_Ptr_t * Abc_NtkMapBenchReadList( char * pFileName )
+{
+    Vec_Ptr_t * vNames;
+    FILE * pFile, * pTemp = NULL;
+    char Buffer[1000], * pName, * pEnd, * pSlash;
+    int nDirLen;
+    pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open the benchmark list \"%s\".\n", pFileName );
+        return NULL;
+    }
+    pSlash  = strrchr( pFileName, '/' );
+    nDirLen = pSlash ? (int)(pSlash - pFileName) + 1 : 0;
+    vNames  = Vec_PtrAlloc( 100 );
+    while ( fgets( Buffer, 1000, pFile ) )
+    {
+        for ( pName = Buffer; *pName == ' ' || *pName == '\t'; pName++ );
+        for ( pEnd = pName + strlen(pName); pEnd > pName && (pEnd[-1] == '\n' || pEnd[-1] == '\r' || pEnd[-1] == ' ' || pEnd[-1] == '\t'); pEnd-- );
+        *pEnd = 0;
+        if ( *pName == 0 || *pName == '#' )
+            continue;
+        if ( *pName != '/' && nDirLen > 0 && (pTemp = fopen( pName, "rb" )) == NULL )
+        {
+            char * pPath = ABC_ALLOC( char, nDirLen + strlen(pName) + 1 );
+            strncpy( pPath, pFileName, nDirLen );
+            strcpy( pPath + nDirLen, pName );
+            Vec_PtrPush( vNames, pPath );
+            continue;
+        }
+        if ( pTemp )
+            fclose( pTemp ), pTemp = NULL;
+        Vec_PtrPush( vNames, Abc_UtilStrsav(pName) );
+    }
+    fclose( pFile );
+    return vNames;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Maps one benchmark and records QoR and runtimes.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_NtkMapBenchRunOne( Abc_Frame_t * pAbc, Abc_BenchRes_t * pRes, int iMode, char * pMapArgs, int fVerbose )
+{
+    Map_ItStats_t * pStats;
+    Abc_Ntk_t * pNtk;
+    char * pCommand;
+    abctime clk;
+    int Length;
+    Length   = strlen(pRes->pName) + (pMapArgs ? strlen(pMapArgs) : 0) + 100;
+    pCommand = ABC_ALLOC( char, Length );
+    // read the benchmark
+    sprintf( pCommand, "read %s; strash", pRes->pName );
+    if ( Cmd_CommandExecute( pAbc, pCommand ) )
+        goto finish;
+    // map it
+    sprintf( pCommand, "%s%s %s", s_BenchModeCmds[iMode], fVerbose ? " -v" : "", pMapArgs ? pMapArgs : "" );
+    clk = Abc_Clock();
+    if ( Cmd_CommandExecute( pAbc, pCommand ) )
+        goto finish;
+    pRes->Times[0] = 1.0*(Abc_Clock() - clk)/CLOCKS_PER_SEC;
+    pStats = (Map_ItStats_t *)pAbc->pMapItStats;
+    pNtk = Abc_FrameReadNtk( pAbc );
+    if ( pNtk == NULL || !Abc_NtkHasMapping(pNtk) )
+        goto finish;
+    // time it
+    if ( Cmd_CommandExecute( pAbc, "topo; stime" ) )
+        goto finish;
+    pNtk = Abc_FrameReadNtk( pAbc );
+    pRes->Delay  = pNtk->MaxDelay;
+    pRes->Area   = pNtk->SumArea;
+    pRes->nGates = Abc_NtkNodeNum( pNtk );
+    pRes->Times[1] = 1.0*pStats->clkmapTT/CLOCKS_PER_SEC;
+    pRes->Times[2] = 1.0*pStats->clkInitPy/CLOCKS_PER_SEC;
+    pRes->Times[3] = 1.0*pStats->clkIterExp/CLOCKS_PER_SEC;
+    pRes->Times[4] = 1.0*pStats->clkDeterPara/CLOCKS_PER_SEC;
+    pRes->Times[5] = 1.0*pStats->clkIterBayes/CLOCKS_PER_SEC;
+    pRes->Times[6] = 1.0*pStats->clkGradient/CLOCKS_PER_SEC;
+    pRes->Times[7] = 1.0*pStats->clkDelayMap/CLOCKS_PER_SEC;
+    pRes->Times[8] = 1.0*pStats->clkAreaRecovery/CLOCKS_PER_SEC;
+    pRes->Times[9] = 1.0*pStats->clkSTA/CLOCKS_PER_SEC;
+    memcpy( pRes->nEvals, pStats->nEvals, sizeof(int) * 3 );
+    pRes->fOk = 1;
+finish:
+    ABC_FREE( pCommand );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the results into a CSV file.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_NtkMapBenchWriteCsv( Abc_BenchRes_t * pRes, int nRes, char * pFileName )
+{
+    FILE * pFile = fopen( pFileName, "wb" );
+    int i, k;
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open file \"%s\" for writing.\n", pFileName );
+        return;
+    }
+    fprintf( pFile, "bench,mode,status,delay,area,gates" );
+    for ( k = 0; k < ABC_BENCH_TIMES; k++ )
+        fprintf( pFile, ",%s", s_BenchTimeNames[k] );
+    fprintf( pFile, ",evals_est,evals_sta,evals_full\n" );
+    for ( i = 0; i < nRes; i++ )
+    {
+        fprintf( pFile, "%s,%s,%s,%.2f,%.2f,%d", pRes[i].pName, pRes[i].pMode, pRes[i].fOk ? "ok" : "fail", pRes[i].Delay, pRes[i].Area, pRes[i].nGates );
+        for ( k = 0; k < ABC_BENCH_TIMES; k++ )
+            fprintf( pFile, ",%.3f", pRes[i].Times[k] );
+        fprintf( pFile, ",%d,%d,%d\n", pRes[i].nEvals[0], pRes[i].nEvals[1], pRes[i].nEvals[2] );
+    }
+    fclose( pFile );
+    printf( "The results were written into CSV file \"%s\".\n", pFileName );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the results into a JSON file.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_NtkMapBenchWriteString( FILE * pFile, const char * pStr )
+{
+    fputc( '\"', pFile );
+    for ( ; *pStr; pStr++ )
+    {
+        if ( *pStr == '\"' || *pStr == '\\' )
+            fputc( '\\', pFile );
+        fputc( *pStr, pFile );
+    }
+    fputc( '\"', pFile );
+}
+static void Abc_NtkMapBenchWriteJson( Abc_BenchRes_t * pRes, int nRes, char * pFileName, char * pLibName, char * pMapArgs )
+{
+    FILE * pFile = fopen( pFileName, "wb" );
+    int i, k;
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open file \"%s\" for writing.\n", pFileName );
+        return;
+    }
+    fprintf( pFile, "{\n  \"library\": " );
+    Abc_NtkMapBenchWriteString( pFile, pLibName ? pLibName : "" );
+    fprintf( pFile, ",\n  \"map_args\": " );
+    Abc_NtkMapBenchWriteString( pFile, pMapArgs ? pMapArgs : "" );
+    fprintf( pFile, ",\n  \"results\": [\n" );
+    for ( i = 0; i < nRes; i++ )
+    {
+        fprintf( pFile, "    { \"bench\": " );
+        Abc_NtkMapBenchWriteString( pFile, pRes[i].pName );
+        fprintf( pFile, ", \"mode\": \"%s\", \"status\": \"%s\", \"delay\": %.2f, \"area\": %.2f, \"gates\": %d,\n",
+            pRes[i].pMode, pRes[i].fOk ? "ok" : "fail", pRes[i].Delay, pRes[i].Area, pRes[i].nGates );
+        fprintf( pFile, "      \"runtime\": {" );
+        for ( k = 0; k < ABC_BENCH_TIMES; k++ )
+            fprintf( pFile, "%s \"%s\": %.3f", k ? "," : "", s_BenchTimeNames[k], pRes[i].Times[k] );
+        fprintf( pFile, " },\n      \"evals\": { \"est\": %d, \"sta\": %d, \"full\": %d } }%s\n",
+            pRes[i].nEvals[0], pRes[i].nEvals[1], pRes[i].nEvals[2], i < nRes-1 ? "," : "" );
+    }
+    fprintf( pFile, "  ]\n}\n" );
+    fclose( pFile );
+    printf( "The results were written into JSON file \"%s\".\n", pFileName );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Compares the results with the baseline CSV file.]
+
+  Description [The baseline is a CSV file written by this command.
+  Returns the number of regressions, or -1 if the file cannot be read.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Abc_NtkMapBenchCompare( Abc_BenchRes_t * pRes, int nRes, char * pFileName, float TimeTol, float QorTol )
+{
+    char * pTokens[32], * pToken, * pBuffer;
+    int iBench = -1, iMode = -1, iStatus = -1, iDelay = -1, iArea = -1, iTotal = -1;
+    int i, nTokens, nFound = 0, nRegs = 0, fHeader = 1;
+    FILE * pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open the baseline file \"%s\".\n", pFileName );
+        return -1;
+    }
+    pBuffer = ABC_ALLOC( char, 10000 );
+    printf( "Comparing with baseline \"%s\" (runtime tolerance = %.1f %%, QoR tolerance = %.1f %%):\n", pFileName, TimeTol, QorTol );
+    while ( fgets( pBuffer, 10000, pFile ) )
+    {
+        nTokens = 0;
+        for ( pToken = strtok( pBuffer, ",\r\n" ); pToken && nTokens < 32; pToken = strtok( NULL, ",\r\n" ) )
+            pTokens[nTokens++] = pToken;
+        if ( nTokens == 0 )
+            continue;
+        if ( fHeader )
+        {
+            for ( i = 0; i < nTokens; i++ )
+                if ( !strcmp(pTokens[i], "bench") )       iBench  = i;
+                else if ( !strcmp(pTokens[i], "mode") )   iMode   = i;
+                else if ( !strcmp(pTokens[i], "status") ) iStatus = i;
+                else if ( !strcmp(pTokens[i], "delay") )  iDelay  = i;
+                else if ( !strcmp(pTokens[i], "area") )   iArea   = i;
+                else if ( !strcmp(pTokens[i], "total") )  iTotal  = i;
+            if ( iBench == -1 || iMode == -1 || iStatus == -1 || iDelay == -1 || iArea == -1 || iTotal == -1 )
+            {
+                printf( "The baseline file \"%s\" does not have the expected header.\n", pFileName );
+                ABC_FREE( pBuffer );
+                fclose( pFile );
+                return -1;
+            }
+            fHeader = 0;
+            continue;
+        }
+        if ( nTokens <= Abc_MaxInt(Abc_MaxInt(iBench, iMode), Abc_MaxInt(Abc_MaxInt(iDelay, iArea), Abc_MaxInt(iTotal, iStatus))) )
+            continue;
+        for ( i = 0; i < nRes; i++ )
+            if ( !strcmp(pRes[i].pName, pTokens[iBench]) && !strcmp(pRes[i].pMode, pTokens[iMode]) )
+                break;
+        if ( i == nRes )
+            continue;
+        nFound++;
+        if ( strcmp(pTokens[iStatus], "ok") )
+            continue;
+        if ( !pRes[i].fOk )
+        {
+            printf( "%-40s %-8s : REGRESSION (failed)\n", pRes[i].pName, pRes[i].pMode );
+            nRegs++;
+        }
+        else
+        {
+            double Time  = atof(pTokens[iTotal]);
+            double Delay = atof(pTokens[iDelay]);
+            double Area  = atof(pTokens[iArea]);
+            double dTime  = Time  > 0 ? 100.0 * (pRes[i].Times[0] - Time) / Time : 0;
+            double dDelay = Delay > 0 ? 100.0 * (pRes[i].Delay - Delay) / Delay : 0;
+            double dArea  = Area  > 0 ? 100.0 * (pRes[i].Area - Area) / Area : 0;
+            int fRegTime = dTime > TimeTol && pRes[i].Times[0] - Time > 0.1;
+            int fRegQor  = dDelay > QorTol || dArea > QorTol;
+            printf( "%-40s %-8s : Time %8.2f -> %8.2f (%+6.1f %%)  Delay %10.2f -> %10.2f (%+6.1f %%)  Area %12.2f -> %12.2f (%+6.1f %%)%s\n",
+                pRes[i].pName, pRes[i].pMode, Time, pRes[i].Times[0], dTime, Delay, pRes[i].Delay, dDelay, Area, pRes[i].Area, dArea,
+                (fRegTime || fRegQor) ? "  REGRESSION" : "" );
+            nRegs += (fRegTime || fRegQor);
+        }
+    }
+    ABC_FREE( pBuffer );
+    fclose( pFile );
+    printf( "Compared %d out of %d runs with the baseline. Regressions = %d.\n", nFound, nRes, nRegs );
+    return nRegs;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Maps the benchmarks of the suite and reports the results.]
+
+  Description [Modes is a bit-mask: 1 = ITMap (map), 2 = classic (map -e).
+  Returns the number of regressions against the baseline, or -1 on error.]
+
+  SideEffects [Replaces the current network.]
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkMapBench( Abc_Frame_t * pAbc, char * pFileList, char * pFileLib, char * pMapArgs, char * pFileBase, char * pFileJson, char * pFileCsv, int Modes, float TimeTol, float QorTol, int fVerbose )
+{
+    Abc_BenchRes_t * pRes;
+    Vec_Ptr_t * vNames;
+    char * pName, * pCommand;
+    int i, m, nRes = 0, nRegs = 0;
+    abctime clk = Abc_Clock();
+    // read the library
+    if ( pFileLib )
+    {
+        pCommand = ABC_ALLOC( char, strlen(pFileLib) + 20 );
+        sprintf( pCommand, "read_lib %s", pFileLib );
+        if ( Cmd_CommandExecute( pAbc, pCommand ) )
+        {
+            ABC_FREE( pCommand );
+            return -1;
+        }
+        ABC_FREE( pCommand );
+    }
+    if ( Abc_FrameReadLibScl() == NULL )
+    {
+        printf( "The Liberty library is not available (use \"read_lib\" or \"-L file\").\n" );
+        return -1;
+    }
+    // read the list
+    vNames = Abc_NtkMapBenchReadList( pFileList );
+    if ( vNames == NULL )
+        return -1;
+    pRes = ABC_CALLOC( Abc_BenchRes_t, 2 * Vec_PtrSize(vNames) );
+    Vec_PtrForEachEntry( char *, vNames, pName, i )
+        for ( m = 0; m < 2; m++ )
+        {
+            if ( !((Modes >> m) & 1) )
+                continue;
+            printf( "==== [%d/%d] %s (%s)\n", i+1, Vec_PtrSize(vNames), pName, s_BenchModeNames[m] );
+            fflush( stdout );
+            pRes[nRes].pName = pName;
+            pRes[nRes].pMode = s_BenchModeNames[m];
+            Abc_NtkMapBenchRunOne( pAbc, pRes + nRes, m, pMapArgs, fVerbose );
+            if ( !pRes[nRes].fOk )
+                printf( "Mapping \"%s\" has failed.\n", pName );
+            nRes++;
+        }
+    // print the summary
+    printf( "\n%-40s %-8s %12s %14s %8s %10s\n", "Benchmark", "Mode", "Delay", "Area", "Gates", "Time" );
+    for ( i = 0; i < nRes; i++ )
+        if ( pRes[i].fOk )
+            printf( "%-40s %-8s %12.2f %14.2f %8d %10.2f\n", pRes[i].pName, pRes[i].pMode, pRes[i].Delay, pRes[i].Area, pRes[i].nGates, pRes[i].Times[0] );
+        else
+            printf( "%-40s %-8s %12s\n", pRes[i].pName, pRes[i].pMode, "failed" );
+    ABC_PRT( "Total benchmarking time", Abc_Clock() - clk );
+    // write the results
+    if ( pFileCsv )
+        Abc_NtkMapBenchWriteCsv( pRes, nRes, pFileCsv );
+    if ( pFileJson )
+        Abc_NtkMapBenchWriteJson( pRes, nRes, pFileJson, pFileLib, pMapArgs );
+    if ( pFileBase )
+        nRegs = Abc_NtkMapBenchCompare( pRes, nRes, pFileBase, TimeTol, QorTol );
+    ABC_FREE( pRes );
+    Vec_PtrFreeFree( vNames );
+    return nRegs;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
+
@@ -61,6 +61,7 @@ static int CmdCommandMvsis         ( Abc_Frame_t * pAbc, int argc, char ** argv
 static int CmdCommandCapo          ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int CmdCommandStarter       ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int CmdCommandAutoTuner     ( Abc_Frame_t * pAbc, int argc, char ** argv );
+static int CmdCommandServer        ( Abc_Frame_t * pAbc, int argc, char ** argv );
 
 extern int Cmd_CommandAbcLoadPlugIn( Abc_Frame_t * pAbc, int argc, char ** argv );
 
@@ -112,6 +113,7 @@ void Cmd_Init( Abc_Frame_t * pAbc )
     Cmd_CommandAdd( pAbc, "Various", "capo",        CmdCommandCapo,            0 );
     Cmd_CommandAdd( pAbc, "Various", "starter",     CmdCommandStarter,         0 );
     Cmd_CommandAdd( pAbc, "Various", "autotuner",   CmdCommandAutoTuner,       0 );
+    Cmd_CommandAdd( pAbc, "Various", "server",      CmdCommandServer,          0 );
 
     Cmd_CommandAdd( pAbc, "Various", "load_plugin", Cmd_CommandAbcLoadPlugIn,  0 );
 }
@@ -2453,6 +2455,84 @@ usage:
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Runs the persistent server or sends a script to it.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int CmdCommandServer( Abc_Frame_t * pAbc, int argc, char ** argv )
+{
+    extern int Cmd_RunServer( Abc_Frame_t * pAbc, char * pSocket, int nJobsMax, int fPython, int fVerbose );
+    extern int Cmd_RunClient( char * pSocket, char * pScript );
+    char * pScript = NULL;
+    int c, nJobsMax  =  4;
+    int fPython      =  0;
+    int fVerbose     =  0;
+    Extra_UtilGetoptReset();
+    while ( ( c = Extra_UtilGetopt( argc, argv, "NCpvh" ) ) != EOF )
+    {
+        switch ( c )
+        {
+        case 'N':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-N\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nJobsMax = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nJobsMax <= 0 ) 
+                goto usage;
+            break;
+        case 'C':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-C\" should be followed by a string (possibly in quotes).\n" );
+                goto usage;
+            }
+            pScript = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'p':
+            fPython ^= 1;
+            break;
+        case 'v':
+            fVerbose ^= 1;
+            break;
+        case 'h':
+            goto usage;
+        default:
+            goto usage;
+        }
+    }
+    if ( argc != globalUtilOptind + 1 )
+    {
+        Abc_Print( -2, "The socket file name should be given on the command line.\n" );
+        return 1;
+    }
+    if ( pScript )
+        return Cmd_RunClient( argv[globalUtilOptind], pScript ) != 0;
+    return Cmd_RunServer( pAbc, argv[globalUtilOptind], nJobsMax, fPython, fVerbose );
+
+usage:
+    Abc_Print( -2, "usage: server [-N num] [-C cmd] [-pvh] <socket>\n" );
+    Abc_Print( -2, "\t         serves ABC scripts sent to a UNIX socket, keeping the libraries loaded\n" );
+    Abc_Print( -2, "\t         in the current frame resident (each job runs in a forked copy of the frame)\n" );
+    Abc_Print( -2, "\t-N num : the number of concurrent jobs [default = %d]\n", nJobsMax );
+    Abc_Print( -2, "\t-C cmd : (optional) send the script to the running server and print its output\n" );
+    Abc_Print( -2, "\t-p     : toggle preloading the Python optimizer of ITMap [default = %s]\n", fPython? "yes": "no" );
+    Abc_Print( -2, "\t-v     : toggle printing verbose information [default = %s]\n", fVerbose? "yes": "no" );
+    Abc_Print( -2, "\t-h     : print the command usage\n");
+    Abc_Print( -2, "\t<socket>: the file name of the UNIX socket\n");
+    return 1;
+}
+
 /**Function*************************************************************
 
   Synopsis    []
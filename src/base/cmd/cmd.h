@@ -43,6 +43,10 @@ typedef struct MvAlias      Abc_Alias;    // one alias
 ///                       MACRO DEFINITIONS                          ///
 ////////////////////////////////////////////////////////////////////////
 
+// the flags of Cmd_CommandAdd() telling what the command changes
+#define CMD_CHANGES_NTK     1   // the current network (a backup copy is saved)
+#define CMD_CHANGES_LIB     2   // the libraries shared by the sessions with the base frame
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -80,7 +80,8 @@ void Cmd_CommandAdd( Abc_Frame_t * pAbc, const char * sGroup, const char * sName
     pCommand->sName   = Extra_UtilStrsav( sName );
     pCommand->sGroup  = Extra_UtilStrsav( sGroup );
     pCommand->pFunc   = pFunc;
-    pCommand->fChange = fChanges;
+    pCommand->fChange = (fChanges & CMD_CHANGES_NTK) != 0;
+    pCommand->fChangeLib = (fChanges & CMD_CHANGES_LIB) != 0;
     fStatus = st__insert( pAbc->tCommands, pCommand->sName, (char *)pCommand );
     assert( !fStatus );  // the command should not be in the table
 }
@@ -195,6 +196,10 @@ int Cmd_CommandExecute( Abc_Frame_t * pAbc, const char * sCommand )
     int fStatus = 0, argc, loop;
     const char * sCommandNext;
     char **argv;
+    Abc_Frame_t * pOld;
+    // wait for the scripts of other frames, then make the frame current in this thread
+    Abc_FrameLockSessions();
+    pOld = Abc_FrameSetSession( pAbc );
 
     if ( !pAbc->fAutoexac && !pAbc->fSource ) 
         Cmd_HistoryAddCommand(pAbc, sCommand);
@@ -211,6 +216,8 @@ int Cmd_CommandExecute( Abc_Frame_t * pAbc, const char * sCommand )
         CmdFreeArgv( argc, argv );
     } 
     while ( fStatus == 0 && *sCommandNext != '\0' );
+    Abc_FrameSetSession( pOld );
+    Abc_FrameUnlockSessions();
     return fStatus;
 }
 
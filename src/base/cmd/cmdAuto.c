@@ -26,17 +26,7 @@
 #include "misc/extra/extra.h"
 #include "aig/gia/gia.h"
 #include "sat/satoko/satoko.h"
-
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#include <unistd.h>
-#endif
-
-#endif
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -124,35 +114,20 @@ typedef struct Cmd_AutoData_t_
     satoko_opts_t * pOpts;
     int             iThread;
     int             nTimeOut;
-    int             fWorking;
     int             Result;
 } Cmd_AutoData_t;
 
-void * Cmd_RunAutoTunerEvalWorkerThread( void * pArg )
+void Cmd_RunAutoTunerEvalWorkerTask( void * pArg, int iThread, void * pScratch )
 {
     Cmd_AutoData_t * pThData = (Cmd_AutoData_t *)pArg;
-    volatile int * pPlace = &pThData->fWorking;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->fWorking );
-        if ( pThData->pGia == NULL ) // kills itself when there is nothing to do
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        pThData->Result = Gia_ManSatokoCallOne( pThData->pGia, pThData->pOpts, -1 );
-        pThData->fWorking = 0;
-    }
-    assert( 0 );
-    return NULL;
+    assert( pThData->pGia != NULL );
+    pThData->Result = Gia_ManSatokoCallOne( pThData->pGia, pThData->pOpts, -1 );
 }
 int Cmd_RunAutoTunerEval( Vec_Ptr_t * vAigs, satoko_opts_t * pOpts, int nProcs )
 {
     Cmd_AutoData_t ThData[CMD_THR_MAX];
-    pthread_t WorkerThread[CMD_THR_MAX];
-    int i, status, fWorkToDo = 1, TotalCost = 0;
+    Util_Pool_t * pPool;
+    int i, TotalCost = 0;
     Vec_Ptr_t * vStack;
     if ( nProcs == 1 )
         return Cmd_RunAutoTunerEvalSimple( vAigs, pOpts );
@@ -166,47 +141,31 @@ int Cmd_RunAutoTunerEval( Vec_Ptr_t * vAigs, satoko_opts_t * pOpts, int nProcs )
         ThData[i].pOpts    = pOpts;
         ThData[i].iThread  = i;
         ThData[i].nTimeOut = -1;
-        ThData[i].fWorking = 0;
         ThData[i].Result   = -1;
-        status = pthread_create( WorkerThread + i, NULL,Cmd_RunAutoTunerEvalWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
     }
+    pPool = Util_PoolStart( nProcs, 0 );
     // look at the threads
     vStack = Vec_PtrDup(vAigs);
-    while ( fWorkToDo )
+    while ( 1 )
     {
-        fWorkToDo = (int)(Vec_PtrSize(vStack) > 0);
-        for ( i = 0; i < nProcs; i++ )
+        // give the idle threads new jobs
+        while ( Vec_PtrSize(vStack) > 0 && (i = Util_PoolFindIdle(pPool)) >= 0 )
         {
-            // check if this thread is working
-            if ( ThData[i].fWorking )
-            {
-                fWorkToDo = 1;
-                continue;
-            }
-            // check if this thread has recently finished
-            if ( ThData[i].pGia != NULL )
-            {
-                assert( ThData[i].Result >= 0 );
-                TotalCost += ThData[i].Result;
-                ThData[i].pGia = NULL;
-            }
-            if ( Vec_PtrSize(vStack) == 0 )
-                continue;
-            // give this thread a new job
             assert( ThData[i].pGia == NULL );
             ThData[i].pGia = (Gia_Man_t *)Vec_PtrPop( vStack );
-            ThData[i].fWorking = 1;
+            Util_PoolAssign( pPool, i, Cmd_RunAutoTunerEvalWorkerTask, (void *)(ThData + i) );
         }
+        // wait till one of the threads finishes
+        i = Util_PoolWaitAny( pPool, NULL );
+        if ( i == -1 )
+            break;
+        assert( ThData[i].Result >= 0 );
+        TotalCost += ThData[i].Result;
+        ThData[i].pGia = NULL;
     }
     Vec_PtrFree( vStack );
     // stop threads
-    for ( i = 0; i < nProcs; i++ )
-    {
-        assert( !ThData[i].fWorking );
-        // stop
-        ThData[i].pGia = NULL;
-        ThData[i].fWorking = 1;
-    }
+    Util_PoolStop( pPool );
     return TotalCost;
 }
 
@@ -46,6 +46,7 @@ struct MvCommand
     char *        sGroup;      // the group name  
     Cmd_CommandFuncType        pFunc;       // the function to execute the command
     int           fChange;     // set to 1 to mark that the network is changed
+    int           fChangeLib;  // set to 1 to mark that the shared libraries are changed
 };
 
 struct MvAlias
@@ -0,0 +1,422 @@
+/**CFile****************************************************************
+
+  FileName    [cmdServer.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Command processing package.]
+
+  Synopsis    [Persistent server executing scripts received over a UNIX socket.]
+
+  Author      []
+
+  Affiliation []
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: cmdServer.c,v 1.00 2026/10/18 00:00:00 Exp $]
+
+***********************************************************************/
+
+#include <Python.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <poll.h>
+#endif
+
+#include "base/abc/abc.h"
+#include "base/main/mainInt.h"
+#include "map/mio/mio.h"
+#include "cmdInt.h"
+
+ABC_NAMESPACE_IMPL_START
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+/*
+    The server is started from a frame that already holds the libraries
+    (for example, "read_lib asap7.lib; server /tmp/abc.sock"). Each client
+    connects to the socket, sends the script and closes its sending side.
+    Before accepting the jobs, the server derives the genlib and supergate
+    libraries used by 'map' with its default parameters. The server forks
+    a child for each job. The child inherits the resident Liberty library,
+    genlib, supergates and the Python interpreter without copying them,
+    runs the script in its own copy of the frame, sends the output back
+    and terminates with the status of the script. The last line of the
+    output is "ABC_SERVER_STATUS <n>", where <n> is the status of the script.
+*/
+
+#define CMD_SERVER_STATUS   "ABC_SERVER_STATUS"
+#define CMD_SERVER_MAX_SIZE (1 << 24)   // the largest script accepted
+#define CMD_SERVER_POLL_MS  100         // how often the finished jobs are collected
+
+#ifndef _WIN32
+static volatile sig_atomic_t s_fServerStop = 0;
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+
+int Cmd_RunServer( Abc_Frame_t * pAbc, char * pSocket, int nJobsMax, int fPython, int fVerbose )
+{
+    Abc_Print( -1, "The server is not supported on Windows.\n" );
+    return 1;
+}
+int Cmd_RunClient( char * pSocket, char * pScript )
+{
+    Abc_Print( -1, "The server is not supported on Windows.\n" );
+    return 1;
+}
+
+#else
+
+/**Function*************************************************************
+
+  Synopsis    [Signal handler stopping the server.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Cmd_ServerSigHandler( int Signal )
+{
+    s_fServerStop = 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the data from the descriptor till the end of file.]
+
+  Description [Returns NULL if reading failed or the data is too large.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static char * Cmd_ServerReadAll( int fd )
+{
+    Vec_Str_t * vData = Vec_StrAlloc( 1000 );
+    char Buffer[4096], * pData;
+    ssize_t nRead;
+    while ( 1 )
+    {
+        nRead = read( fd, Buffer, sizeof(Buffer) );
+        if ( nRead < 0 && errno == EINTR )
+            continue;
+        if ( nRead <= 0 )
+            break;
+        Vec_StrPushBuffer( vData, Buffer, (int)nRead );
+        if ( Vec_StrSize(vData) > CMD_SERVER_MAX_SIZE )
+            break;
+    }
+    if ( nRead < 0 || Vec_StrSize(vData) > CMD_SERVER_MAX_SIZE )
+    {
+        Vec_StrFree( vData );
+        return NULL;
+    }
+    Vec_StrPush( vData, '\0' );
+    pData = Vec_StrReleaseArray( vData );
+    Vec_StrFree( vData );
+    return pData;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the buffer into the descriptor.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Cmd_ServerWriteAll( int fd, char * pBuffer, int nSize )
+{
+    ssize_t nWritten;
+    while ( nSize > 0 )
+    {
+        nWritten = write( fd, pBuffer, nSize );
+        if ( nWritten < 0 && errno == EINTR )
+            continue;
+        if ( nWritten <= 0 )
+            return 0;
+        pBuffer += nWritten;
+        nSize   -= (int)nWritten;
+    }
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Fills in the socket address.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Cmd_ServerAddress( char * pSocket, struct sockaddr_un * pAddr )
+{
+    memset( pAddr, 0, sizeof(struct sockaddr_un) );
+    pAddr->sun_family = AF_UNIX;
+    if ( strlen(pSocket) >= sizeof(pAddr->sun_path) )
+    {
+        Abc_Print( -1, "The socket path \"%s\" is too long.\n", pSocket );
+        return 0;
+    }
+    strcpy( pAddr->sun_path, pSocket );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs one job in the forked child.]
+
+  Description [Reads the script from the connection, redirects the standard
+  output and error into the connection, executes the script and reports
+  its status. Never returns; the exit code is the status of the script.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Cmd_ServerRunJob( Abc_Frame_t * pAbc, int fdConn )
+{
+    char * pScript;
+    int Status = 1;
+    // the interpreter lock was taken before forking
+    if ( Py_IsInitialized() )
+    {
+        PyOS_AfterFork_Child();
+        PyEval_SaveThread();
+    }
+    signal( SIGINT,  SIG_DFL );
+    signal( SIGTERM, SIG_DFL );
+    pScript = Cmd_ServerReadAll( fdConn );
+    fflush( stdout );
+    fflush( stderr );
+    dup2( fdConn, 1 );
+    dup2( fdConn, 2 );
+    close( fdConn );
+    if ( pScript == NULL )
+        printf( "Cannot read the script.\n" );
+    else
+        Status = Cmd_CommandExecute( pAbc, pScript );
+    printf( "%s %d\n", CMD_SERVER_STATUS, Status );
+    fflush( stdout );
+    fflush( stderr );
+    // skip the cleanup of the inherited frame
+    _exit( Status );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs the server.]
+
+  Description [Accepts the connections on the UNIX socket and runs up to
+  nJobsMax jobs concurrently. The libraries for mapping are derived from
+  the Liberty library before forking, so that the jobs share them. If 
+  fPython is set, the Python module of the optimizer is also imported 
+  before forking. Stops on SIGINT or SIGTERM.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Cmd_RunServer( Abc_Frame_t * pAbc, char * pSocket, int nJobsMax, int fPython, int fVerbose )
+{
+    extern int Map_MappingPyPreload();
+    extern Mio_Library_t * Abc_NtkMapDeriveLibs( float Slew, float Gain, int nGatesMin, int fVerbose );
+    struct sockaddr_un Addr;
+    struct pollfd Poll;
+    struct sigaction Action, ActionInt, ActionTerm;
+    struct stat Stat;
+    abctime clk = Abc_Clock();
+    int fdListen, fdConn, nRunning = 0, nJobs = 0;
+    pid_t Pid;
+    PyGILState_STATE PyState = PyGILState_UNLOCKED;
+    if ( !Cmd_ServerAddress( pSocket, &Addr ) )
+        return 1;
+    // remove the stale socket left by a previous server
+    if ( stat( pSocket, &Stat ) == 0 )
+    {
+        if ( !S_ISSOCK(Stat.st_mode) )
+        {
+            Abc_Print( -1, "File \"%s\" exists and is not a socket.\n", pSocket );
+            return 1;
+        }
+        unlink( pSocket );
+    }
+    // derive the libraries with the default parameters of 'map'
+    if ( Abc_FrameReadLibScl() && Abc_SclHasDelayInfo( Abc_FrameReadLibScl() ) && !Abc_NtkMapDeriveLibs( 0, 250, 0, fVerbose ) )
+        Abc_Print( 0, "Deriving the libraries for mapping has failed.\n" );
+    if ( fPython && !Map_MappingPyPreload() )
+        Abc_Print( 0, "Preloading the Python optimizer has failed.\n" );
+    fdListen = socket( AF_UNIX, SOCK_STREAM, 0 );
+    if ( fdListen < 0 )
+    {
+        Abc_Print( -1, "Cannot create the socket.\n" );
+        return 1;
+    }
+    if ( bind( fdListen, (struct sockaddr *)&Addr, sizeof(Addr) ) < 0 || listen( fdListen, 64 ) < 0 )
+    {
+        Abc_Print( -1, "Cannot listen on socket \"%s\".\n", pSocket );
+        close( fdListen );
+        return 1;
+    }
+    // stop gracefully on SIGINT and SIGTERM (no restart, so that accept() returns)
+    memset( &Action, 0, sizeof(Action) );
+    Action.sa_handler = Cmd_ServerSigHandler;
+    sigemptyset( &Action.sa_mask );
+    sigaction( SIGINT,  &Action, &ActionInt );
+    sigaction( SIGTERM, &Action, &ActionTerm );
+    s_fServerStop = 0;
+    printf( "ABC server is listening on \"%s\" (up to %d concurrent jobs).\n", pSocket, nJobsMax );
+    fflush( stdout );
+    while ( !s_fServerStop )
+    {
+        // collect the finished jobs
+        while ( nRunning > 0 && waitpid( -1, NULL, WNOHANG ) > 0 )
+            nRunning--;
+        // wait for a connection for a while (only for the jobs to finish if all slots are busy)
+        Poll.fd      = fdListen;
+        Poll.events  = POLLIN;
+        Poll.revents = 0;
+        if ( poll( &Poll, nRunning < nJobsMax, CMD_SERVER_POLL_MS ) <= 0 || !(Poll.revents & POLLIN) )
+            continue;
+        fdConn = accept( fdListen, NULL, NULL );
+        if ( fdConn < 0 )
+            continue;
+        fflush( stdout );
+        fflush( stderr );
+        // the interpreter should be forked in a consistent state
+        if ( Py_IsInitialized() )
+        {
+            PyState = PyGILState_Ensure();
+            PyOS_BeforeFork();
+        }
+        Pid = fork();
+        if ( Pid == 0 )
+        {
+            close( fdListen );
+            Cmd_ServerRunJob( pAbc, fdConn );
+        }
+        if ( Py_IsInitialized() )
+        {
+            PyOS_AfterFork_Parent();
+            PyGILState_Release( PyState );
+        }
+        close( fdConn );
+        if ( Pid < 0 )
+        {
+            Abc_Print( -1, "Cannot fork the job.\n" );
+            continue;
+        }
+        nRunning++;
+        nJobs++;
+        if ( fVerbose )
+            printf( "Started job %d (pid %d). Running jobs = %d.\n", nJobs, (int)Pid, nRunning );
+    }
+    close( fdListen );
+    unlink( pSocket );
+    // wait for the running jobs
+    while ( nRunning > 0 && waitpid( -1, NULL, 0 ) > 0 )
+        nRunning--;
+    sigaction( SIGINT,  &ActionInt,  NULL );
+    sigaction( SIGTERM, &ActionTerm, NULL );
+    printf( "ABC server has finished %d jobs.  ", nJobs );
+    Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    return 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Sends the script to the server and prints its output.]
+
+  Description [Returns the status of the script.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Cmd_RunClient( char * pSocket, char * pScript )
+{
+    struct sockaddr_un Addr;
+    char * pOutput, * pStatus;
+    int fd, Status = 1;
+    if ( !Cmd_ServerAddress( pSocket, &Addr ) )
+        return 1;
+    fd = socket( AF_UNIX, SOCK_STREAM, 0 );
+    if ( fd < 0 || connect( fd, (struct sockaddr *)&Addr, sizeof(Addr) ) < 0 )
+    {
+        Abc_Print( -1, "Cannot connect to the server on socket \"%s\".\n", pSocket );
+        if ( fd >= 0 )
+            close( fd );
+        return 1;
+    }
+    if ( !Cmd_ServerWriteAll( fd, pScript, (int)strlen(pScript) ) )
+    {
+        Abc_Print( -1, "Cannot send the script to the server.\n" );
+        close( fd );
+        return 1;
+    }
+    shutdown( fd, SHUT_WR );
+    pOutput = Cmd_ServerReadAll( fd );
+    close( fd );
+    if ( pOutput == NULL )
+    {
+        Abc_Print( -1, "Cannot read the output of the server.\n" );
+        return 1;
+    }
+    // separate the status line
+    pStatus = strstr( pOutput, CMD_SERVER_STATUS );
+    while ( pStatus && strstr( pStatus + 1, CMD_SERVER_STATUS ) )
+        pStatus = strstr( pStatus + 1, CMD_SERVER_STATUS );
+    if ( pStatus )
+    {
+        Status = atoi( pStatus + strlen(CMD_SERVER_STATUS) );
+        *pStatus = '\0';
+    }
+    else
+        Abc_Print( -1, "The job was terminated by the server.\n" );
+    fputs( pOutput, stdout );
+    fflush( stdout );
+    ABC_FREE( pOutput );
+    return Status;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
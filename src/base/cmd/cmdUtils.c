@@ -135,6 +135,13 @@ int CmdCommandDispatch( Abc_Frame_t * pAbc, int * pargc, char *** pargv )
         }
     }
 
+    // the libraries shared by the sessions with their base frame cannot be changed
+    if ( pCommand->fChangeLib && (pAbc->pBase || pAbc->nSessions) )
+    {
+        fprintf( pAbc->Err, "** cmd error: command '%s' cannot be used while the libraries are shared by the sessions\n", argv[0] );
+        return 1;
+    }
+
     // get the backup network if the command is going to change the network
     if ( pCommand->fChange ) 
     {
@@ -2165,18 +2165,31 @@ int IoCommandWriteCnf( Abc_Frame_t * pAbc, int argc, char **argv )
     int fAllPrimes;
     int fChangePol;
     int fVerbose;
-    extern Abc_Ntk_t * Abc_NtkDarToCnf( Abc_Ntk_t * pNtk, char * pFileName, int fFastAlgo, int fChangePol, int fVerbose );
+    int nProcs;
+    extern Abc_Ntk_t * Abc_NtkDarToCnf( Abc_Ntk_t * pNtk, char * pFileName, int fFastAlgo, int fChangePol, int nProcs, int fVerbose );
 
     fNewAlgo = 1;
     fFastAlgo = 0;
     fAllPrimes = 0;
     fChangePol = 1;
     fVerbose = 0;
+    nProcs = 1;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "nfpcvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "Pnfpcvh" ) ) != EOF )
     {
         switch ( c )
         {
+            case 'P':
+                if ( globalUtilOptind >= argc )
+                {
+                    fprintf( pAbc->Err, "Command line switch \"-P\" should be followed by an integer.\n" );
+                    goto usage;
+                }
+                nProcs = atoi(argv[globalUtilOptind]);
+                globalUtilOptind++;
+                if ( nProcs <= 0 )
+                    goto usage;
+                break;
             case 'n':
                 fNewAlgo ^= 1;
                 break;
@@ -2215,9 +2228,9 @@ int IoCommandWriteCnf( Abc_Frame_t * pAbc, int argc, char **argv )
     }
     // call the corresponding file writer
     if ( fFastAlgo )
-        Abc_NtkDarToCnf( pAbc->pNtkCur, pFileName, 1, fChangePol, fVerbose );
+        Abc_NtkDarToCnf( pAbc->pNtkCur, pFileName, 1, fChangePol, nProcs, fVerbose );
     else if ( fNewAlgo )
-        Abc_NtkDarToCnf( pAbc->pNtkCur, pFileName, 0, fChangePol, fVerbose );
+        Abc_NtkDarToCnf( pAbc->pNtkCur, pFileName, 0, fChangePol, nProcs, fVerbose );
     else if ( fAllPrimes )
         Io_WriteCnf( pAbc->pNtkCur, pFileName, 1 );
     else
@@ -2225,8 +2238,9 @@ int IoCommandWriteCnf( Abc_Frame_t * pAbc, int argc, char **argv )
     return 0;
 
 usage:
-    fprintf( pAbc->Err, "usage: write_cnf [-nfpcvh] <file>\n" );
+    fprintf( pAbc->Err, "usage: write_cnf [-P num] [-nfpcvh] <file>\n" );
     fprintf( pAbc->Err, "\t         generates CNF for the miter (see also \"&write_cnf\")\n" );
+    fprintf( pAbc->Err, "\t-P num : the number of threads deriving the fast CNF [default = %d]\n", nProcs );
     fprintf( pAbc->Err, "\t-n     : toggle using new algorithm [default = %s]\n", fNewAlgo? "yes" : "no" );
     fprintf( pAbc->Err, "\t-f     : toggle using fast algorithm [default = %s]\n", fFastAlgo? "yes" : "no" );
     fprintf( pAbc->Err, "\t-p     : toggle using all primes to enhance implicativity [default = %s]\n", fAllPrimes? "yes" : "no" );
@@ -3060,10 +3074,10 @@ int IoCommandWriteVerilog( Abc_Frame_t * pAbc, int argc, char **argv )
     extern void Io_WriteVerilogLut( Abc_Ntk_t * pNtk, char * pFileName, int nLutSize, int fFixed, int fNoModules );
     char * pFileName;
     int c, fFixed = 0, fOnlyAnds = 0, fNoModules = 0;
-    int nLutSize = -1;
+    int nLutSize = -1, nThreads = 1;
 
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "Kfamh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "KPfamh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -3078,6 +3092,17 @@ int IoCommandWriteVerilog( Abc_Frame_t * pAbc, int argc, char **argv )
                 if ( nLutSize < 2 || nLutSize > 6 )
                     goto usage;
                 break;
+            case 'P':
+                if ( globalUtilOptind >= argc )
+                {
+                    Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                    goto usage;
+                }
+                nThreads = atoi(argv[globalUtilOptind]);
+                globalUtilOptind++;
+                if ( nThreads < 1 )
+                    goto usage;
+                break;
             case 'f':
                 fFixed ^= 1;
                 break;
@@ -3105,24 +3130,28 @@ int IoCommandWriteVerilog( Abc_Frame_t * pAbc, int argc, char **argv )
     // get the output file name
     pFileName = argv[globalUtilOptind];
     // call the corresponding file writer
-    if ( fOnlyAnds )
+    if ( !fOnlyAnds && nLutSize >= 2 && nLutSize <= 6 )
+        Io_WriteVerilogLut( pAbc->pNtkCur, pFileName, nLutSize, fFixed, fNoModules );
+    else
     {
         Abc_Ntk_t * pNtkTemp = Abc_NtkToNetlist( pAbc->pNtkCur );
+        if ( pNtkTemp == NULL )
+        {
+            fprintf( pAbc->Err, "Converting to netlist has failed.\n" );
+            return 1;
+        }
         if ( !Abc_NtkHasAig(pNtkTemp) && !Abc_NtkHasMapping(pNtkTemp) )
             Abc_NtkToAig( pNtkTemp );
-        Io_WriteVerilog( pNtkTemp, pFileName, 1 );
+        Io_WriteVerilog( pNtkTemp, pFileName, fOnlyAnds, nThreads );
         Abc_NtkDelete( pNtkTemp );
     }
-    else if ( nLutSize >= 2 && nLutSize <= 6 )
-        Io_WriteVerilogLut( pAbc->pNtkCur, pFileName, nLutSize, fFixed, fNoModules );
-    else
-        Io_Write( pAbc->pNtkCur, pFileName, IO_FILE_VERILOG );
     return 0;
 
 usage:
-    fprintf( pAbc->Err, "usage: write_verilog [-K num] [-famh] <file>\n" );
+    fprintf( pAbc->Err, "usage: write_verilog [-K num] [-P num] [-famh] <file>\n" );
     fprintf( pAbc->Err, "\t         writes the current network in Verilog format\n" );
     fprintf( pAbc->Err, "\t-K num : write the network using instances of K-LUTs (2 <= K <= 6) [default = not used]\n" );
+    fprintf( pAbc->Err, "\t-P num : the number of threads formatting the gates of a mapped netlist [default = %d]\n", nThreads );
     fprintf( pAbc->Err, "\t-f     : toggle using fixed format [default = %s]\n", fFixed? "yes":"no" );
     fprintf( pAbc->Err, "\t-a     : toggle writing expressions with only ANDs (without XORs and MUXes) [default = %s]\n", fOnlyAnds? "yes":"no" );
     fprintf( pAbc->Err, "\t-m     : toggle writing additional modules [default = %s]\n", !fNoModules? "yes":"no" );
@@ -87,6 +87,11 @@ struct Io_MvMan_t_
     Vec_Ptr_t *          vTokens;      // the current tokens
     Vec_Ptr_t *          vTokens2;     // the current tokens
     Vec_Str_t *          vFunc;        // the local function
+    // net names of the current model (open addressing)
+    char **              pNetNames;    // the names hashed into the bins
+    int *                pNetIds;      // the IDs of the nets with these names
+    int                  nNetBins;     // the number of bins (power of two)
+    int                  nNetEntries;  // the number of used bins
     // error reporting
     char                 sError[512];  // the error string generated during parsing
     // statistics 
@@ -119,7 +124,7 @@ static int                 Io_MvParseLineLtlProperty( Io_MvMod_t * p, char * pLi
 static int               Io_MvParseLineGateBlif( Io_MvMod_t * p, Vec_Ptr_t * vTokens );
 static Io_MvVar_t *      Abc_NtkMvVarDup( Abc_Ntk_t * pNtk, Io_MvVar_t * pVar );
 
-static int               Io_MvCharIsSpace( char s )  { return s == ' ' || s == '\t' || s == '\r' || s == '\n';  }
+static int               Io_MvCharIsSpace( char s )  { return (unsigned char)s <= ' ' && (s == ' ' || s == '\t' || s == '\r' || s == '\n');  }
 static int               Io_MvCharIsMvSymb( char s ) { return s == '(' || s == ')' || s == '{' || s == '}' || s == '-' || s == ',' || s == '!';  }
 
 extern void              Abc_NtkStartMvVars( Abc_Ntk_t * pNtk );
@@ -448,7 +453,7 @@ static void Io_MvCollectTokens( Vec_Ptr_t * vTokens, char * pInput, char * pOutp
 
   Synopsis    [Splits the line into tokens.]
 
-  Description []
+  Description [Clears the spaces and collects the tokens in one pass.]
   
   SideEffects []
 
@@ -457,13 +462,19 @@ static void Io_MvCollectTokens( Vec_Ptr_t * vTokens, char * pInput, char * pOutp
 ***********************************************************************/
 static void Io_MvSplitIntoTokens( Vec_Ptr_t * vTokens, char * pLine, char Stop )
 {
-    char * pCur;
-    // clear spaces
-    for ( pCur = pLine; *pCur != Stop; pCur++ )
-        if ( Io_MvCharIsSpace(*pCur) )
+    char * pCur = pLine;
+    Vec_PtrClear( vTokens );
+    while ( 1 )
+    {
+        // clear spaces before the token
+        for ( ; *pCur != Stop && (*pCur == 0 || Io_MvCharIsSpace(*pCur)); pCur++ )
             *pCur = 0;
-    // collect tokens
-    Io_MvCollectTokens( vTokens, pLine, pCur );
+        if ( *pCur == Stop )
+            break;
+        Vec_PtrPush( vTokens, pCur );
+        // skip the token
+        for ( pCur++; *pCur != Stop && *pCur != 0 && !Io_MvCharIsSpace(*pCur); pCur++ );
+    }
 }
 
 /**Function*************************************************************
@@ -531,6 +542,126 @@ static int Io_MvGetLine( Io_MvMan_t * p, char * pToken )
     return -1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Hashes the net name.]
+
+  Description []
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline unsigned Io_MvNetHash( char * pName )
+{
+    unsigned Key = 2166136261u;
+    for ( ; *pName; pName++ )
+        Key = (Key ^ (unsigned char)*pName) * 16777619u;
+    return Key ^ (Key >> 15);
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts the table of net names for the current model.]
+
+  Description [The table caches the nets found or created while parsing 
+  the nodes, so that each fanin name is matched by probing a flat array 
+  rather than going through the name manager of the network. The names 
+  are not copied; they point into the file buffer.]
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Io_MvNetsStart( Io_MvMan_t * p, int nNets )
+{
+    assert( p->pNetNames == NULL );
+    for ( p->nNetBins = 1024; p->nNetBins < 2 * nNets; p->nNetBins <<= 1 );
+    p->pNetNames   = ABC_CALLOC( char *, p->nNetBins );
+    p->pNetIds     = ABC_ALLOC( int, p->nNetBins );
+    p->nNetEntries = 0;
+}
+static void Io_MvNetsStop( Io_MvMan_t * p )
+{
+    ABC_FREE( p->pNetNames );
+    ABC_FREE( p->pNetIds );
+    p->nNetBins = p->nNetEntries = 0;
+}
+static void Io_MvNetsResize( Io_MvMan_t * p )
+{
+    char ** pNamesOld = p->pNetNames;
+    int * pIdsOld = p->pNetIds, nBinsOld = p->nNetBins, i, k;
+    p->nNetBins  *= 2;
+    p->pNetNames  = ABC_CALLOC( char *, p->nNetBins );
+    p->pNetIds    = ABC_ALLOC( int, p->nNetBins );
+    for ( i = 0; i < nBinsOld; i++ )
+    {
+        if ( pNamesOld[i] == NULL )
+            continue;
+        for ( k = Io_MvNetHash(pNamesOld[i]) & (p->nNetBins - 1); p->pNetNames[k]; k = (k + 1) & (p->nNetBins - 1) );
+        p->pNetNames[k] = pNamesOld[i];
+        p->pNetIds[k]   = pIdsOld[i];
+    }
+    ABC_FREE( pNamesOld );
+    ABC_FREE( pIdsOld );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Finds or creates the net with the given name.]
+
+  Description [Uses the table of net names when it is started. Nets that
+  are not in the table are looked up in the network and added to the table,
+  which keeps the IDs of the created objects the same as without the table.]
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Abc_Obj_t * Io_MvFindOrCreateNet( Io_MvMod_t * p, char * pName )
+{
+    Io_MvMan_t * pMan = p->pMan;
+    Abc_Obj_t * pNet;
+    int k;
+    if ( pMan->pNetNames == NULL )
+        return Abc_NtkFindOrCreateNet( p->pNtk, pName );
+    for ( k = Io_MvNetHash(pName) & (pMan->nNetBins - 1); pMan->pNetNames[k]; k = (k + 1) & (pMan->nNetBins - 1) )
+        if ( !strcmp(pMan->pNetNames[k], pName) )
+            return Abc_NtkObj( p->pNtk, pMan->pNetIds[k] );
+    pNet = Abc_NtkFindOrCreateNet( p->pNtk, pName );
+    pMan->pNetNames[k] = pName;
+    pMan->pNetIds[k]   = Abc_ObjId( pNet );
+    if ( ++pMan->nNetEntries > pMan->nNetBins / 2 )
+        Io_MvNetsResize( pMan );
+    return pNet;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Creates the node and the net driven by it.]
+
+  Description [Same as Io_ReadCreateNode() but finds the nets using the 
+  table of net names.]
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Abc_Obj_t * Io_MvCreateNode( Io_MvMod_t * p, char * pNameOut, char * pNamesIn[], int nInputs )
+{
+    Abc_Obj_t * pNode;
+    int i;
+    pNode = Abc_NtkCreateNode( p->pNtk );
+    for ( i = 0; i < nInputs; i++ )
+        Abc_ObjAddFanin( pNode, Io_MvFindOrCreateNet(p, pNamesIn[i]) );
+    Abc_ObjAddFanin( Io_MvFindOrCreateNet(p, pNameOut), pNode );
+    return pNode;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Reads the file into a character buffer.]
@@ -715,25 +846,24 @@ static char * Io_MvLoadFile( char * pFileName )
 ***********************************************************************/
 static void Io_MvReadPreparse( Io_MvMan_t * p )
 {
-    char * pCur, * pPrev;
-    int i, fComment = 0;
+    char * pCur, * pPrev, * pNext, * pStop;
+    int i;
     // parse the buffer into lines and remove comments
     Vec_PtrPush( p->vLines, p->pBuffer );
-    for ( pCur = p->pBuffer; *pCur; pCur++ )
+    pStop = p->pBuffer + strlen( p->pBuffer );
+    for ( pCur = p->pBuffer; pCur < pStop; pCur = pNext + 1 )
     {
-        if ( *pCur == '\n' )
-        {
-            *pCur = 0;
-//            if ( *(pCur-1) == '\r' )
-//                *(pCur-1) = 0;
-            fComment = 0;
-            Vec_PtrPush( p->vLines, pCur + 1 );
-        }
-        else if ( *pCur == '#' )
-            fComment = 1;
-        // remove comments
-        if ( fComment )
-            *pCur = 0;
+        pNext = (char *)memchr( pCur, '\n', pStop - pCur );
+        if ( pNext == NULL )
+            pNext = pStop;
+        // remove the comment
+        pPrev = (char *)memchr( pCur, '#', pNext - pCur );
+        if ( pPrev )
+            memset( pPrev, 0, pNext - pPrev );
+        if ( pNext == pStop )
+            break;
+        *pNext = 0;
+        Vec_PtrPush( p->vLines, pNext + 1 );
     }
 
     // unfold the line extensions and sort lines by directive
@@ -956,9 +1086,14 @@ static Abc_Des_t * Io_MvParse( Io_MvMan_t * p )
         }
         else
         {
+            Io_MvNetsStart( p, Vec_PtrSize(pMod->vNames) + Abc_NtkCiNum(pMod->pNtk) );
             Vec_PtrForEachEntry( char *, pMod->vNames, pLine, k )
                 if ( !Io_MvParseLineNamesBlif( pMod, pLine ) )
+                {
+                    Io_MvNetsStop( p );
                     return NULL;
+                }
+            Io_MvNetsStop( p );
             Vec_PtrForEachEntry( char *, pMod->vShorts, pLine, k )
                 if ( !Io_MvParseLineShortBlif( pMod, pLine ) )
                     return NULL;
@@ -2084,14 +2219,14 @@ static int Io_MvParseLineNamesBlif( Io_MvMod_t * p, char * pLine )
     // parse the regular name line
     assert( !strcmp((char *)Vec_PtrEntry(vTokens,0), "names") );
     pName = (char *)Vec_PtrEntryLast( vTokens );
-    pNet = Abc_NtkFindOrCreateNet( p->pNtk, pName );
+    pNet = Io_MvFindOrCreateNet( p, pName );
     if ( Abc_ObjFaninNum(pNet) > 0 )
     {
         sprintf( p->pMan->sError, "Line %d: Signal \"%s\" is defined more than once.", Io_MvGetLine(p->pMan, pName), pName );
         return 0;
     }
     // create fanins
-    pNode = Io_ReadCreateNode( p->pNtk, pName, (char **)(vTokens->pArray + 1), Vec_PtrSize(vTokens) - 2 );
+    pNode = Io_MvCreateNode( p, pName, (char **)(vTokens->pArray + 1), Vec_PtrSize(vTokens) - 2 );
     // parse the table of this node
     pNode->pData = Io_MvParseTableBlif( p, pName + strlen(pName), Abc_ObjFaninNum(pNode) );
     if ( pNode->pData == NULL )
@@ -2315,7 +2450,7 @@ static int Io_MvParseLineGateBlif( Io_MvMod_t * p, Vec_Ptr_t * vTokens )
     {
         nNames  = vTokens->nSize - 3;
         ppNames = (char **)vTokens->pArray + 2;
-        pNode   = Io_ReadCreateNode( p->pNtk, ppNames[nNames], ppNames, nNames );
+        pNode   = Io_MvCreateNode( p, ppNames[nNames], ppNames, nNames );
         Abc_ObjSetData( pNode, pGate );
     }
     else
@@ -2325,12 +2460,12 @@ static int Io_MvParseLineGateBlif( Io_MvMod_t * p, Vec_Ptr_t * vTokens )
         assert( ppNames[nNames] != NULL || ppNames[nNames+1] != NULL );
         if ( ppNames[nNames] )
         {
-            pNode   = Io_ReadCreateNode( p->pNtk, ppNames[nNames], ppNames, nNames );
+            pNode   = Io_MvCreateNode( p, ppNames[nNames], ppNames, nNames );
             Abc_ObjSetData( pNode, pGate );
         }
         if ( ppNames[nNames+1] )
         {
-            pNode   = Io_ReadCreateNode( p->pNtk, ppNames[nNames+1], ppNames, nNames );
+            pNode   = Io_MvCreateNode( p, ppNames[nNames+1], ppNames, nNames );
             Abc_ObjSetData( pNode, Mio_GateReadTwin(pGate) );
         }
     }
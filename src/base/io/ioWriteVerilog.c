@@ -21,6 +21,7 @@
 #include "ioAbc.h"
 #include "base/main/main.h"
 #include "map/mio/mio.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -29,15 +30,33 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-static void Io_WriteVerilogInt( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds );
+static void Io_WriteVerilogInt( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds, int nThreads );
 static void Io_WriteVerilogPis( FILE * pFile, Abc_Ntk_t * pNtk, int Start );
 static void Io_WriteVerilogPos( FILE * pFile, Abc_Ntk_t * pNtk, int Start );
 static void Io_WriteVerilogWires( FILE * pFile, Abc_Ntk_t * pNtk, int Start );
 static void Io_WriteVerilogRegs( FILE * pFile, Abc_Ntk_t * pNtk, int Start );
 static void Io_WriteVerilogLatches( FILE * pFile, Abc_Ntk_t * pNtk );
-static void Io_WriteVerilogObjects( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds );
+static void Io_WriteVerilogObjects( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds, int nThreads );
 static int  Io_WriteVerilogWiresCount( Abc_Ntk_t * pNtk );
 static char * Io_WriteVerilogGetName( char * pName );
+static void Io_WriteVerilogGates( FILE * pFile, Abc_Ntk_t * pNtk, int Length, int nDigits, int nThreads );
+
+#define IO_VERILOG_CHUNK (1 << 14)   // the number of object IDs formatted by one task
+
+// formatting the gates in one chunk of object IDs
+typedef struct Io_VerTask_t_ Io_VerTask_t;
+struct Io_VerTask_t_
+{
+    Abc_Ntk_t *      pNtk;          // the mapped netlist
+    Vec_Str_t *      vNames;        // the Verilog names of the nets
+    Vec_Int_t *      vOffsets;      // the offsets of the names by net ID
+    int              iStart;        // the first object ID
+    int              iStop;         // the last object ID plus one
+    int              Counter;       // the number of the first gate
+    int              Length;        // the width of the gate name column
+    int              nDigits;       // the number of digits in the gate number
+    Vec_Str_t *      vOut;          // the formatted text
+};
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -47,14 +66,15 @@ static char * Io_WriteVerilogGetName( char * pName );
 
   Synopsis    [Write verilog.]
 
-  Description []
+  Description [The gates of a mapped netlist are formatted by nThreads 
+  threads.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Io_WriteVerilog( Abc_Ntk_t * pNtk, char * pFileName, int fOnlyAnds )
+void Io_WriteVerilog( Abc_Ntk_t * pNtk, char * pFileName, int fOnlyAnds, int nThreads )
 {
     Abc_Ntk_t * pNetlist;
     FILE * pFile;
@@ -81,7 +101,7 @@ void Io_WriteVerilog( Abc_Ntk_t * pNtk, char * pFileName, int fOnlyAnds )
     if ( pNtk->pDesign )
     {
         // write the network first
-        Io_WriteVerilogInt( pFile, pNtk, fOnlyAnds );
+        Io_WriteVerilogInt( pFile, pNtk, fOnlyAnds, nThreads );
         // write other things
         Vec_PtrForEachEntry( Abc_Ntk_t *, pNtk->pDesign->vModules, pNetlist, i )
         {
@@ -89,12 +109,12 @@ void Io_WriteVerilog( Abc_Ntk_t * pNtk, char * pFileName, int fOnlyAnds )
             if ( pNetlist == pNtk )
                 continue;
             fprintf( pFile, "\n" );
-            Io_WriteVerilogInt( pFile, pNetlist, fOnlyAnds );
+            Io_WriteVerilogInt( pFile, pNetlist, fOnlyAnds, nThreads );
         }
     }
     else
     {
-        Io_WriteVerilogInt( pFile, pNtk, fOnlyAnds );
+        Io_WriteVerilogInt( pFile, pNtk, fOnlyAnds, nThreads );
     }
 
     fprintf( pFile, "\n" );
@@ -112,7 +132,7 @@ void Io_WriteVerilog( Abc_Ntk_t * pNtk, char * pFileName, int fOnlyAnds )
   SeeAlso     []
 
 ***********************************************************************/
-void Io_WriteVerilogInt( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds )
+void Io_WriteVerilogInt( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds, int nThreads )
 {
     // write inputs and outputs
 //    fprintf( pFile, "module %s ( gclk,\n   ", Abc_NtkName(pNtk) );
@@ -163,7 +183,7 @@ void Io_WriteVerilogInt( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds )
             fprintf( pFile, ";\n" );
         }
         // write nodes
-        Io_WriteVerilogObjects( pFile, pNtk, fOnlyAnds );        
+        Io_WriteVerilogObjects( pFile, pNtk, fOnlyAnds, nThreads );        
         // write registers
         if ( Abc_NtkLatchNum(pNtk) > 0 )
             Io_WriteVerilogLatches( pFile, pNtk );
@@ -288,6 +308,7 @@ void Io_WriteVerilogPos( FILE * pFile, Abc_Ntk_t * pNtk, int Start )
 void Io_WriteVerilogWires( FILE * pFile, Abc_Ntk_t * pNtk, int Start )
 {
     Abc_Obj_t * pObj, * pNet, * pBox, * pTerm;
+    char * pName;
     int LineLength;
     int AddedLength;
     int NameCounter;
@@ -309,7 +330,8 @@ void Io_WriteVerilogWires( FILE * pFile, Abc_Ntk_t * pNtk, int Start )
             continue;
         Counter++;
         // get the line length after this name is written
-        AddedLength = strlen(Io_WriteVerilogGetName(Abc_ObjName(pNet))) + 2;
+        pName = Io_WriteVerilogGetName(Abc_ObjName(pNet));
+        AddedLength = strlen(pName) + 2;
         if ( NameCounter && LineLength + AddedLength + 3 > IO_WRITE_LINE_LENGTH )
         { // write the line extender
             fprintf( pFile, "\n   " );
@@ -317,7 +339,7 @@ void Io_WriteVerilogWires( FILE * pFile, Abc_Ntk_t * pNtk, int Start )
             LineLength  = 3;
             NameCounter = 0;
         }
-        fprintf( pFile, " %s%s", Io_WriteVerilogGetName(Abc_ObjName(pNet)), (Counter==nNodes)? "" : "," );
+        fprintf( pFile, " %s%s", pName, (Counter==nNodes)? "" : "," );
         LineLength += AddedLength;
         NameCounter++;
     }
@@ -326,7 +348,8 @@ void Io_WriteVerilogWires( FILE * pFile, Abc_Ntk_t * pNtk, int Start )
         pNet = Abc_ObjFanin0(Abc_ObjFanin0(pObj));
         Counter++;
         // get the line length after this name is written
-        AddedLength = strlen(Io_WriteVerilogGetName(Abc_ObjName(pNet))) + 2;
+        pName = Io_WriteVerilogGetName(Abc_ObjName(pNet));
+        AddedLength = strlen(pName) + 2;
         if ( NameCounter && LineLength + AddedLength + 3 > IO_WRITE_LINE_LENGTH )
         { // write the line extender
             fprintf( pFile, "\n   " );
@@ -334,7 +357,7 @@ void Io_WriteVerilogWires( FILE * pFile, Abc_Ntk_t * pNtk, int Start )
             LineLength  = 3;
             NameCounter = 0;
         }
-        fprintf( pFile, " %s%s", Io_WriteVerilogGetName(Abc_ObjName(pNet)), (Counter==nNodes)? "" : "," );
+        fprintf( pFile, " %s%s", pName, (Counter==nNodes)? "" : "," );
         LineLength += AddedLength;
         NameCounter++;
     }
@@ -347,7 +370,8 @@ void Io_WriteVerilogWires( FILE * pFile, Abc_Ntk_t * pNtk, int Start )
             pNet = Abc_ObjFanin0(pTerm);
             Counter++;
             // get the line length after this name is written
-            AddedLength = strlen(Io_WriteVerilogGetName(Abc_ObjName(pNet))) + 2;
+            pName = Io_WriteVerilogGetName(Abc_ObjName(pNet));
+            AddedLength = strlen(pName) + 2;
             if ( NameCounter && LineLength + AddedLength + 3 > IO_WRITE_LINE_LENGTH )
             { // write the line extender
                 fprintf( pFile, "\n   " );
@@ -355,7 +379,7 @@ void Io_WriteVerilogWires( FILE * pFile, Abc_Ntk_t * pNtk, int Start )
                 LineLength  = 3;
                 NameCounter = 0;
             }
-            fprintf( pFile, " %s%s", Io_WriteVerilogGetName(Abc_ObjName(pNet)), (Counter==nNodes)? "" : "," );
+            fprintf( pFile, " %s%s", pName, (Counter==nNodes)? "" : "," );
             LineLength += AddedLength;
             NameCounter++;
         }
@@ -366,7 +390,8 @@ void Io_WriteVerilogWires( FILE * pFile, Abc_Ntk_t * pNtk, int Start )
                 continue;
             Counter++;
             // get the line length after this name is written
-            AddedLength = strlen(Io_WriteVerilogGetName(Abc_ObjName(pNet))) + 2;
+            pName = Io_WriteVerilogGetName(Abc_ObjName(pNet));
+            AddedLength = strlen(pName) + 2;
             if ( NameCounter && LineLength + AddedLength + 3 > IO_WRITE_LINE_LENGTH )
             { // write the line extender
                 fprintf( pFile, "\n   " );
@@ -374,7 +399,7 @@ void Io_WriteVerilogWires( FILE * pFile, Abc_Ntk_t * pNtk, int Start )
                 LineLength  = 3;
                 NameCounter = 0;
             }
-            fprintf( pFile, " %s%s", Io_WriteVerilogGetName(Abc_ObjName(pNet)), (Counter==nNodes)? "" : "," );
+            fprintf( pFile, " %s%s", pName, (Counter==nNodes)? "" : "," );
             LineLength += AddedLength;
             NameCounter++;
         }
@@ -483,7 +508,7 @@ void Io_WriteVerilogLatches( FILE * pFile, Abc_Ntk_t * pNtk )
   SeeAlso     []
 
 ***********************************************************************/
-void Io_WriteVerilogObjects( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds )
+void Io_WriteVerilogObjects( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds, int nThreads )
 {
     int fUseSimpleGateNames = 0;
     Vec_Vec_t * vLevels;
@@ -515,11 +540,15 @@ void Io_WriteVerilogObjects( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds )
         fprintf( pFile, ");\n" );
     }
     // write nodes
-    if ( Abc_NtkHasMapping(pNtk) )
+    if ( Abc_NtkHasMapping(pNtk) && !fUseSimpleGateNames )
     {
         Length  = Mio_LibraryReadGateNameMax((Mio_Library_t *)pNtk->pManFunc);
         nDigits = Abc_Base10Log( Abc_NtkNodeNum(pNtk) );
-        Counter = 0;
+        Io_WriteVerilogGates( pFile, pNtk, Length, nDigits, nThreads );
+    }
+    else if ( Abc_NtkHasMapping(pNtk) )
+    {
+        Length  = Mio_LibraryReadGateNameMax((Mio_Library_t *)pNtk->pManFunc);
         Abc_NtkForEachNode( pNtk, pObj, k )
         {
             Mio_Gate_t * pGate = (Mio_Gate_t *)pObj->pData;
@@ -530,29 +559,12 @@ void Io_WriteVerilogObjects( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds )
                 continue;
             }
             // write the node
-            if ( fUseSimpleGateNames )
-            {
-                fprintf( pFile, "%-*s ", Length, Mio_GateReadName(pGate) );
-                fprintf( pFile, "( %s", Io_WriteVerilogGetName(Abc_ObjName( Abc_ObjFanout0(pObj) )) );
-                for ( pGatePin = Mio_GateReadPins(pGate), i = 0; pGatePin; pGatePin = Mio_PinReadNext(pGatePin), i++ )
-                    fprintf( pFile, ", %s", Io_WriteVerilogGetName(Abc_ObjName( Abc_ObjFanin(pObj,i) )) );
-                assert ( i == Abc_ObjFaninNum(pObj) );
-                fprintf( pFile, " );\n" );
-            }
-            else
-            {
-                fprintf( pFile, "  %-*s g%0*d", Length, Mio_GateReadName(pGate), nDigits, Counter++ );
-                fprintf( pFile, "(" );
-                for ( pGatePin = Mio_GateReadPins(pGate), i = 0; pGatePin; pGatePin = Mio_PinReadNext(pGatePin), i++ )
-                {
-                    fprintf( pFile, ".%s", Io_WriteVerilogGetName(Mio_PinReadName(pGatePin)) );
-                    fprintf( pFile, "(%s), ", Io_WriteVerilogGetName(Abc_ObjName( Abc_ObjFanin(pObj,i) )) );
-                }
-                assert ( i == Abc_ObjFaninNum(pObj) );
-                fprintf( pFile, ".%s", Io_WriteVerilogGetName(Mio_GateReadOutName(pGate)) );
-                fprintf( pFile, "(%s)", Io_WriteVerilogGetName(Abc_ObjName( Abc_ObjFanout0(pObj) )) );
-                fprintf( pFile, ");\n" );
-            }
+            fprintf( pFile, "%-*s ", Length, Mio_GateReadName(pGate) );
+            fprintf( pFile, "( %s", Io_WriteVerilogGetName(Abc_ObjName( Abc_ObjFanout0(pObj) )) );
+            for ( pGatePin = Mio_GateReadPins(pGate), i = 0; pGatePin; pGatePin = Mio_PinReadNext(pGatePin), i++ )
+                fprintf( pFile, ", %s", Io_WriteVerilogGetName(Abc_ObjName( Abc_ObjFanin(pObj,i) )) );
+            assert ( i == Abc_ObjFaninNum(pObj) );
+            fprintf( pFile, " );\n" );
         }
     }
     else
@@ -607,6 +619,207 @@ void Io_WriteVerilogObjects( FILE * pFile, Abc_Ntk_t * pNtk, int fOnlyAnds )
     }
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Appends the name prepared for writing the Verilog file.]
+
+  Description [Same as Io_WriteVerilogGetName() but does not use the static
+  buffer, so it can be called by several threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Io_WriteVerilogAppendName( Vec_Str_t * vStr, char * pName )
+{
+    int i, Length = strlen(pName);
+    if ( pName[0] < '0' || pName[0] > '9' )
+    {
+        for ( i = 0; i < Length; i++ )
+            if ( !((pName[i] >= 'a' && pName[i] <= 'z') || 
+                 (pName[i] >= 'A' && pName[i] <= 'Z') || 
+                 (pName[i] >= '0' && pName[i] <= '9') || pName[i] == '_') )
+                 break;
+        if ( i == Length )
+        {
+            Vec_StrPushBuffer( vStr, pName, Length );
+            return;
+        }
+    }
+    Vec_StrPush( vStr, '\\' );
+    Vec_StrPushBuffer( vStr, pName, Length );
+    Vec_StrPush( vStr, ' ' );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Collects the Verilog names of the nets.]
+
+  Description [The names are written one after another into vNames.
+  Returns the array mapping the net IDs into the name offsets.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Vec_Int_t * Io_WriteVerilogNetNames( Abc_Ntk_t * pNtk, Vec_Str_t * vNames )
+{
+    Vec_Int_t * vOffsets = Vec_IntStartFull( Abc_NtkObjNumMax(pNtk) );
+    Abc_Obj_t * pNet;
+    int i;
+    Abc_NtkForEachNet( pNtk, pNet, i )
+    {
+        Vec_IntWriteEntry( vOffsets, i, Vec_StrSize(vNames) );
+        Io_WriteVerilogAppendName( vNames, Abc_ObjName(pNet) );
+        Vec_StrPush( vNames, '\0' );
+    }
+    return vOffsets;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Formats the gates whose IDs fall into one chunk.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Io_WriteVerilogPad( Vec_Str_t * vOut, char * pStr, int Length )
+{
+    int i, nChars = strlen(pStr);
+    Vec_StrPushBuffer( vOut, pStr, nChars );
+    for ( i = nChars; i < Length; i++ )
+        Vec_StrPush( vOut, ' ' );
+}
+static inline char * Io_WriteVerilogNetName( Io_VerTask_t * p, Abc_Obj_t * pNet )
+{
+    return Vec_StrEntryP( p->vNames, Vec_IntEntry(p->vOffsets, Abc_ObjId(pNet)) );
+}
+static void Io_WriteVerilogGatesChunk( void * pArg, int iThread, void * pScratch )
+{
+    Io_VerTask_t * p = (Io_VerTask_t *)pArg;
+    Vec_Str_t * vOut = p->vOut;
+    Mio_Gate_t * pGate;
+    Mio_Pin_t * pGatePin;
+    Abc_Obj_t * pObj;
+    char * pName;
+    int i, k, Counter = p->Counter;
+    Vec_StrClear( vOut );
+    for ( k = p->iStart; k < p->iStop; k++ )
+    {
+        pObj = Abc_NtkObj( p->pNtk, k );
+        if ( pObj == NULL || !Abc_ObjIsNode(pObj) )
+            continue;
+        pGate = (Mio_Gate_t *)pObj->pData;
+        if ( Abc_ObjFaninNum(pObj) == 0 && (!strcmp(Mio_GateReadName(pGate), "_const0_") || !strcmp(Mio_GateReadName(pGate), "_const1_")) )
+        {
+            Vec_StrPrintStr( vOut, "  " );
+            Io_WriteVerilogPad( vOut, "assign", p->Length );
+            Vec_StrPush( vOut, ' ' );
+            Vec_StrPrintStr( vOut, Io_WriteVerilogNetName(p, Abc_ObjFanout0(pObj)) );
+            Vec_StrPrintStr( vOut, " = 1\'b" );
+            Vec_StrPush( vOut, (char)('0' + !strcmp(Mio_GateReadName(pGate), "_const1_")) );
+            Vec_StrPrintStr( vOut, ";\n" );
+            continue;
+        }
+        Vec_StrPrintStr( vOut, "  " );
+        Io_WriteVerilogPad( vOut, Mio_GateReadName(pGate), p->Length );
+        Vec_StrPrintStr( vOut, " g" );
+        Vec_StrPrintNumStar( vOut, Counter++, Abc_MaxInt(p->nDigits, 1) );
+        Vec_StrPush( vOut, '(' );
+        for ( pGatePin = Mio_GateReadPins(pGate), i = 0; pGatePin; pGatePin = Mio_PinReadNext(pGatePin), i++ )
+        {
+            Vec_StrPush( vOut, '.' );
+            Io_WriteVerilogAppendName( vOut, Mio_PinReadName(pGatePin) );
+            Vec_StrPush( vOut, '(' );
+            pName = Io_WriteVerilogNetName( p, Abc_ObjFanin(pObj,i) );
+            Vec_StrPushBuffer( vOut, pName, strlen(pName) );
+            Vec_StrPrintStr( vOut, "), " );
+        }
+        assert ( i == Abc_ObjFaninNum(pObj) );
+        Vec_StrPush( vOut, '.' );
+        Io_WriteVerilogAppendName( vOut, Mio_GateReadOutName(pGate) );
+        Vec_StrPush( vOut, '(' );
+        pName = Io_WriteVerilogNetName( p, Abc_ObjFanout0(pObj) );
+        Vec_StrPushBuffer( vOut, pName, strlen(pName) );
+        Vec_StrPrintStr( vOut, "));\n" );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the gates of the mapped netlist.]
+
+  Description [The net names are prepared once. The node array is divided 
+  into chunks, which are formatted into separate buffers by the threads 
+  and written into the file in their original order. The output is the 
+  same as when the gates are printed one by one.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Io_WriteVerilogGates( FILE * pFile, Abc_Ntk_t * pNtk, int Length, int nDigits, int nThreads )
+{
+    Util_Pool_t * pPool;
+    Io_VerTask_t * pTasks;
+    Vec_Str_t * vNames = Vec_StrAlloc( 16 * Abc_NtkObjNumMax(pNtk) + 16 );
+    Vec_Int_t * vOffsets = Io_WriteVerilogNetNames( pNtk, vNames );
+    Abc_Obj_t * pObj;
+    int nChunks = (Abc_NtkObjNumMax(pNtk) + IO_VERILOG_CHUNK - 1) / IO_VERILOG_CHUNK;
+    int i, k, Counter = 0;
+    nThreads = Abc_MaxInt( 1, Abc_MinInt(nThreads, nChunks) );
+    // divide the nodes into chunks and find the first gate number of each chunk
+    pTasks = ABC_CALLOC( Io_VerTask_t, nChunks );
+    for ( i = 0; i < nChunks; i++ )
+    {
+        pTasks[i].pNtk     = pNtk;
+        pTasks[i].vNames   = vNames;
+        pTasks[i].vOffsets = vOffsets;
+        pTasks[i].iStart   = i * IO_VERILOG_CHUNK;
+        pTasks[i].iStop    = Abc_MinInt( (i + 1) * IO_VERILOG_CHUNK, Abc_NtkObjNumMax(pNtk) );
+        pTasks[i].Counter  = Counter;
+        pTasks[i].Length   = Length;
+        pTasks[i].nDigits  = nDigits;
+        for ( k = pTasks[i].iStart; k < pTasks[i].iStop; k++ )
+        {
+            pObj = Abc_NtkObj( pNtk, k );
+            if ( pObj == NULL || !Abc_ObjIsNode(pObj) )
+                continue;
+            if ( Abc_ObjFaninNum(pObj) == 0 && (!strcmp(Mio_GateReadName((Mio_Gate_t *)pObj->pData), "_const0_") || !strcmp(Mio_GateReadName((Mio_Gate_t *)pObj->pData), "_const1_")) )
+                continue;
+            Counter++;
+        }
+    }
+    // format the chunks in rounds, reusing one buffer per thread
+    pPool = Util_PoolStart( nThreads, 0 );
+    for ( i = 0; i < nThreads; i++ )
+        pTasks[i].vOut = Vec_StrAlloc( 64 * IO_VERILOG_CHUNK );
+    for ( i = 0; i < nChunks; i += nThreads )
+    {
+        for ( k = i; k < nChunks && k < i + nThreads; k++ )
+        {
+            pTasks[k].vOut = pTasks[k - i].vOut;
+            Util_PoolAssign( pPool, k - i, Io_WriteVerilogGatesChunk, (void *)(pTasks + k) );
+        }
+        Util_PoolWaitAll( pPool );
+        for ( k = i; k < nChunks && k < i + nThreads; k++ )
+            fwrite( Vec_StrArray(pTasks[k].vOut), 1, Vec_StrSize(pTasks[k].vOut), pFile );
+    }
+    Util_PoolStop( pPool );
+    for ( i = 0; i < nThreads; i++ )
+        Vec_StrFree( pTasks[i].vOut );
+    ABC_FREE( pTasks );
+    Vec_IntFree( vOffsets );
+    Vec_StrFree( vNames );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Counts the number of wires.]
@@ -69,6 +69,11 @@ extern ABC_DLL void   Abc_Stop();
 extern ABC_DLL Abc_Frame_t * Abc_FrameGetGlobalFrame();
 extern ABC_DLL int   Cmd_CommandExecute( Abc_Frame_t * pAbc, const char * pCommandLine );
 
+// procedures to start and stop sessions, which use the libraries of the base frame
+// (the scripts of different sessions can be started in different threads; they are serialized)
+extern ABC_DLL Abc_Frame_t * Abc_FrameStartSession( Abc_Frame_t * pBase );
+extern ABC_DLL void   Abc_FrameStopSession( Abc_Frame_t * pAbc );
+
 // procedures to input/output 'mini AIG'
 extern ABC_DLL void   Abc_NtkInputMiniAig( Abc_Frame_t * pAbc, void * pMiniAig );
 extern ABC_DLL void * Abc_NtkOutputMiniAig( Abc_Frame_t * pAbc );
@@ -92,6 +92,12 @@ extern ABC_DLL void            Abc_FrameDeleteAllNetworks( Abc_Frame_t * p );
 extern ABC_DLL void            Abc_FrameSetGlobalFrame( Abc_Frame_t * p );
 extern ABC_DLL Abc_Frame_t *   Abc_FrameGetGlobalFrame();
 extern ABC_DLL Abc_Frame_t *   Abc_FrameReadGlobalFrame();
+extern ABC_DLL Abc_Frame_t *   Abc_FrameSetSession( Abc_Frame_t * p );
+extern ABC_DLL Abc_Frame_t *   Abc_FrameStartSession( Abc_Frame_t * pBase );
+extern ABC_DLL void            Abc_FrameStopSession( Abc_Frame_t * p );
+extern ABC_DLL void            Abc_FrameLockSessions();
+extern ABC_DLL void            Abc_FrameUnlockSessions();
+extern ABC_DLL int             Abc_FrameIsLibShared( void * pLib );
 
 extern ABC_DLL Vec_Ptr_t *     Abc_FrameReadStore();                  
 extern ABC_DLL int             Abc_FrameReadStoreSize();              
@@ -100,6 +106,7 @@ extern ABC_DLL void *          Abc_FrameReadLibBox();
 extern ABC_DLL void *          Abc_FrameReadLibGen();                    
 extern ABC_DLL void *          Abc_FrameReadLibGen2();                    
 extern ABC_DLL void *          Abc_FrameReadLibSuper();                  
+extern ABC_DLL void *          Abc_FrameReadMapArch();                   
 extern ABC_DLL void *          Abc_FrameReadLibScl();                  
 extern ABC_DLL void *          Abc_FrameReadManDd();                     
 extern ABC_DLL void *          Abc_FrameReadManDec();                    
@@ -138,6 +145,7 @@ extern ABC_DLL void            Abc_FrameSetLibBox( void * pLib );
 extern ABC_DLL void            Abc_FrameSetLibGen( void * pLib );        
 extern ABC_DLL void            Abc_FrameSetLibGen2( void * pLib );        
 extern ABC_DLL void            Abc_FrameSetLibSuper( void * pLib );      
+extern ABC_DLL void            Abc_FrameSetMapArch( void * pArch );      
 extern ABC_DLL void            Abc_FrameSetLibVer( void * pLib );      
 extern ABC_DLL void            Abc_FrameSetFlag( char * pFlag, char * pValue );
 extern ABC_DLL void            Abc_FrameSetCex( Abc_Cex_t * pCex );
@@ -20,14 +20,24 @@
 
 #include "base/abc/abc.h"
 #include "mainInt.h"
+#include "base/cmd/cmdInt.h"
 #include "bool/dec/dec.h"
 #include "map/if/if.h"
+#include "map/mio/mio.h"
 #include "aig/miniaig/ndr.h"
 
 #ifdef ABC_USE_CUDD
 #include "bdd/extrab/extraBdd.h"
 #endif
 
+#ifdef ABC_USE_PTHREADS
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -37,6 +47,30 @@ ABC_NAMESPACE_IMPL_START
 
 static Abc_Frame_t * s_GlobalFrame = NULL;
 
+// the session frame used by the current thread (NULL means the global frame)
+#ifdef ABC_USE_PTHREADS
+#ifdef _MSC_VER
+static __declspec(thread) Abc_Frame_t * s_SessionFrame = NULL;
+#else
+static __thread Abc_Frame_t * s_SessionFrame = NULL;
+#endif
+#else
+static Abc_Frame_t * s_SessionFrame = NULL;
+#endif
+
+// the lock serializing the scripts of all frames and the depth, to which
+// the current thread has taken it (the depth is local to each thread)
+#ifdef ABC_USE_PTHREADS
+static pthread_mutex_t s_SessionMutex = PTHREAD_MUTEX_INITIALIZER;
+#ifdef _MSC_VER
+static __declspec(thread) int s_nSessionLocks = 0;
+#else
+static __thread int s_nSessionLocks = 0;
+#endif
+#endif
+
+static inline Abc_Frame_t * Abc_FrameCur() { return s_SessionFrame ? s_SessionFrame : s_GlobalFrame; }
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -52,77 +86,79 @@ static Abc_Frame_t * s_GlobalFrame = NULL;
   SeeAlso     []
 
 ***********************************************************************/
-Vec_Ptr_t * Abc_FrameReadStore()                             { return s_GlobalFrame->vStore;       } 
-int         Abc_FrameReadStoreSize()                         { return Vec_PtrSize(s_GlobalFrame->vStore); }
-void *      Abc_FrameReadLibLut()                            { return s_GlobalFrame->pLibLut;      } 
-void *      Abc_FrameReadLibBox()                            { return s_GlobalFrame->pLibBox;      } 
-void *      Abc_FrameReadLibGen()                            { return s_GlobalFrame->pLibGen;      } 
-void *      Abc_FrameReadLibGen2()                           { return s_GlobalFrame->pLibGen2;     } 
-void *      Abc_FrameReadLibSuper()                          { return s_GlobalFrame->pLibSuper;    } 
-void *      Abc_FrameReadLibScl()                            { return s_GlobalFrame->pLibScl;      } 
+Vec_Ptr_t * Abc_FrameReadStore()                             { return Abc_FrameCur()->vStore;       } 
+int         Abc_FrameReadStoreSize()                         { return Vec_PtrSize(Abc_FrameCur()->vStore); }
+void *      Abc_FrameReadLibLut()                            { return Abc_FrameCur()->pLibLut;      } 
+void *      Abc_FrameReadLibBox()                            { return Abc_FrameCur()->pLibBox;      } 
+void *      Abc_FrameReadLibGen()                            { return Abc_FrameCur()->pLibGen;      } 
+void *      Abc_FrameReadLibGen2()                           { return Abc_FrameCur()->pLibGen2;     } 
+void *      Abc_FrameReadLibSuper()                          { return Abc_FrameCur()->pLibSuper;    } 
+void *      Abc_FrameReadMapArch()                           { return Abc_FrameCur()->pMapArch;     } 
+void *      Abc_FrameReadLibScl()                            { return Abc_FrameCur()->pLibScl;      } 
 #ifdef ABC_USE_CUDD
-void *      Abc_FrameReadManDd()                             { if ( s_GlobalFrame->dd == NULL )      s_GlobalFrame->dd = Cudd_Init( 0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0 );  return s_GlobalFrame->dd;      } 
+void *      Abc_FrameReadManDd()                             { if ( Abc_FrameCur()->dd == NULL )      Abc_FrameCur()->dd = Cudd_Init( 0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0 );  return Abc_FrameCur()->dd;      } 
 #endif
-void *      Abc_FrameReadManDec()                            { if ( s_GlobalFrame->pManDec == NULL ) s_GlobalFrame->pManDec = Dec_ManStart();                                        return s_GlobalFrame->pManDec; } 
-void *      Abc_FrameReadManDsd()                            { return s_GlobalFrame->pManDsd;      } 
-void *      Abc_FrameReadManDsd2()                           { return s_GlobalFrame->pManDsd2;     }
-char *      Abc_FrameReadFlag( char * pFlag )                { return Cmd_FlagReadByName( s_GlobalFrame, pFlag );   }
-Vec_Ptr_t * Abc_FrameReadSignalNames()                       { return s_GlobalFrame->vSignalNames; }
-char *      Abc_FrameReadSpecName()                          { return s_GlobalFrame->pSpecName;    }
-
-int         Abc_FrameReadBmcFrames( Abc_Frame_t * p )        { return s_GlobalFrame->nFrames;      }               
-int         Abc_FrameReadProbStatus( Abc_Frame_t * p )       { return s_GlobalFrame->Status;       }               
-void *      Abc_FrameReadCex( Abc_Frame_t * p )              { return s_GlobalFrame->pCex;         }        
-Vec_Ptr_t * Abc_FrameReadCexVec( Abc_Frame_t * p )           { return s_GlobalFrame->vCexVec;      }        
-Vec_Int_t * Abc_FrameReadStatusVec( Abc_Frame_t * p )        { return s_GlobalFrame->vStatuses;    }        
-Vec_Ptr_t * Abc_FrameReadPoEquivs( Abc_Frame_t * p )         { return s_GlobalFrame->vPoEquivs;    }        
-Vec_Int_t * Abc_FrameReadPoStatuses( Abc_Frame_t * p )       { return s_GlobalFrame->vStatuses;    }        
-Vec_Int_t * Abc_FrameReadObjIds( Abc_Frame_t * p )           { return s_GlobalFrame->vAbcObjIds;   }        
-Abc_Nam_t * Abc_FrameReadJsonStrs( Abc_Frame_t * p )         { return s_GlobalFrame->pJsonStrs;    }     
-Vec_Wec_t * Abc_FrameReadJsonObjs( Abc_Frame_t * p )         { return s_GlobalFrame->vJsonObjs;    }   
+void *      Abc_FrameReadManDec()                            { if ( Abc_FrameCur()->pManDec == NULL ) Abc_FrameCur()->pManDec = Dec_ManStart();                                        return Abc_FrameCur()->pManDec; } 
+void *      Abc_FrameReadManDsd()                            { return Abc_FrameCur()->pManDsd;      } 
+void *      Abc_FrameReadManDsd2()                           { return Abc_FrameCur()->pManDsd2;     }
+char *      Abc_FrameReadFlag( char * pFlag )                { return Cmd_FlagReadByName( Abc_FrameCur(), pFlag );   }
+Vec_Ptr_t * Abc_FrameReadSignalNames()                       { return Abc_FrameCur()->vSignalNames; }
+char *      Abc_FrameReadSpecName()                          { return Abc_FrameCur()->pSpecName;    }
+
+int         Abc_FrameReadBmcFrames( Abc_Frame_t * p )        { return Abc_FrameCur()->nFrames;      }               
+int         Abc_FrameReadProbStatus( Abc_Frame_t * p )       { return Abc_FrameCur()->Status;       }               
+void *      Abc_FrameReadCex( Abc_Frame_t * p )              { return Abc_FrameCur()->pCex;         }        
+Vec_Ptr_t * Abc_FrameReadCexVec( Abc_Frame_t * p )           { return Abc_FrameCur()->vCexVec;      }        
+Vec_Int_t * Abc_FrameReadStatusVec( Abc_Frame_t * p )        { return Abc_FrameCur()->vStatuses;    }        
+Vec_Ptr_t * Abc_FrameReadPoEquivs( Abc_Frame_t * p )         { return Abc_FrameCur()->vPoEquivs;    }        
+Vec_Int_t * Abc_FrameReadPoStatuses( Abc_Frame_t * p )       { return Abc_FrameCur()->vStatuses;    }        
+Vec_Int_t * Abc_FrameReadObjIds( Abc_Frame_t * p )           { return Abc_FrameCur()->vAbcObjIds;   }        
+Abc_Nam_t * Abc_FrameReadJsonStrs( Abc_Frame_t * p )         { return Abc_FrameCur()->pJsonStrs;    }     
+Vec_Wec_t * Abc_FrameReadJsonObjs( Abc_Frame_t * p )         { return Abc_FrameCur()->vJsonObjs;    }   
        
-int         Abc_FrameReadCexPiNum( Abc_Frame_t * p )         { return s_GlobalFrame->pCex->nPis;   }               
-int         Abc_FrameReadCexRegNum( Abc_Frame_t * p )        { return s_GlobalFrame->pCex->nRegs;  }               
-int         Abc_FrameReadCexPo( Abc_Frame_t * p )            { return s_GlobalFrame->pCex->iPo;    }               
-int         Abc_FrameReadCexFrame( Abc_Frame_t * p )         { return s_GlobalFrame->pCex->iFrame; }               
-
-void        Abc_FrameInputNdr( Abc_Frame_t * pAbc, void * pData ) { Ndr_Delete(s_GlobalFrame->pNdr); s_GlobalFrame->pNdr = pData;                        }
-void *      Abc_FrameOutputNdr( Abc_Frame_t * pAbc )         { void * pData = s_GlobalFrame->pNdr; s_GlobalFrame->pNdr = NULL; return pData;             }  
-int *       Abc_FrameOutputNdrArray( Abc_Frame_t * pAbc )    { int * pArray = s_GlobalFrame->pNdrArray; s_GlobalFrame->pNdrArray = NULL; return pArray;  }
-
-void        Abc_FrameSetLibLut( void * pLib )                { s_GlobalFrame->pLibLut   = pLib;    } 
-void        Abc_FrameSetLibBox( void * pLib )                { s_GlobalFrame->pLibBox   = pLib;    } 
-void        Abc_FrameSetLibGen( void * pLib )                { s_GlobalFrame->pLibGen   = pLib;    } 
-void        Abc_FrameSetLibGen2( void * pLib )               { s_GlobalFrame->pLibGen2  = pLib;    } 
-void        Abc_FrameSetLibSuper( void * pLib )              { s_GlobalFrame->pLibSuper = pLib;    } 
-void        Abc_FrameSetFlag( char * pFlag, char * pValue )  { Cmd_FlagUpdateValue( s_GlobalFrame, pFlag, pValue );               } 
-void        Abc_FrameSetCex( Abc_Cex_t * pCex )              { ABC_FREE( s_GlobalFrame->pCex ); s_GlobalFrame->pCex = pCex;       }
-void        Abc_FrameSetNFrames( int nFrames )               { ABC_FREE( s_GlobalFrame->pCex ); s_GlobalFrame->nFrames = nFrames; }
-void        Abc_FrameSetStatus( int Status )                 { ABC_FREE( s_GlobalFrame->pCex ); s_GlobalFrame->Status = Status;   }
-void        Abc_FrameSetManDsd( void * pMan )                { if (s_GlobalFrame->pManDsd  && s_GlobalFrame->pManDsd  != pMan) If_DsdManFree((If_DsdMan_t *)s_GlobalFrame->pManDsd,  0); s_GlobalFrame->pManDsd = pMan;  }
-void        Abc_FrameSetManDsd2( void * pMan )               { if (s_GlobalFrame->pManDsd2 && s_GlobalFrame->pManDsd2 != pMan) If_DsdManFree((If_DsdMan_t *)s_GlobalFrame->pManDsd2, 0); s_GlobalFrame->pManDsd2 = pMan; }
-void        Abc_FrameSetInv( Vec_Int_t * vInv )              { Vec_IntFreeP(&s_GlobalFrame->pAbcWlcInv); s_GlobalFrame->pAbcWlcInv = vInv; }
-void        Abc_FrameSetJsonStrs( Abc_Nam_t * pStrs )        { Abc_NamDeref( s_GlobalFrame->pJsonStrs ); s_GlobalFrame->pJsonStrs = pStrs; }
-void        Abc_FrameSetJsonObjs( Vec_Wec_t * vObjs )        { Vec_WecFreeP(&s_GlobalFrame->vJsonObjs ); s_GlobalFrame->vJsonObjs = vObjs; }
-void        Abc_FrameSetSignalNames( Vec_Ptr_t * vNames )    { if ( s_GlobalFrame->vSignalNames ) Vec_PtrFreeFree( s_GlobalFrame->vSignalNames ); s_GlobalFrame->vSignalNames = vNames; }
-void        Abc_FrameSetSpecName( char * pFileName )         { ABC_FREE( s_GlobalFrame->pSpecName ); s_GlobalFrame->pSpecName = pFileName; }
-
-int         Abc_FrameIsBatchMode()                           { return s_GlobalFrame ? s_GlobalFrame->fBatchMode : 0;              } 
-void        Abc_FrameSetBatchMode( int Mode )                { if ( s_GlobalFrame ) s_GlobalFrame->fBatchMode = Mode;             } 
-
-int         Abc_FrameIsBridgeMode()                          { return s_GlobalFrame ? s_GlobalFrame->fBridgeMode : 0;             } 
-void        Abc_FrameSetBridgeMode()                         { if ( s_GlobalFrame ) s_GlobalFrame->fBridgeMode = 1;               } 
-
-char *      Abc_FrameReadDrivingCell()                       { return s_GlobalFrame->pDrivingCell;    }              
-float       Abc_FrameReadMaxLoad()                           { return s_GlobalFrame->MaxLoad;         }      
-void        Abc_FrameSetDrivingCell( char * pName )          { ABC_FREE(s_GlobalFrame->pDrivingCell); s_GlobalFrame->pDrivingCell   = pName; }      
-void        Abc_FrameSetMaxLoad( float Load )                { s_GlobalFrame->MaxLoad = Load;         }      
+int         Abc_FrameReadCexPiNum( Abc_Frame_t * p )         { return Abc_FrameCur()->pCex->nPis;   }               
+int         Abc_FrameReadCexRegNum( Abc_Frame_t * p )        { return Abc_FrameCur()->pCex->nRegs;  }               
+int         Abc_FrameReadCexPo( Abc_Frame_t * p )            { return Abc_FrameCur()->pCex->iPo;    }               
+int         Abc_FrameReadCexFrame( Abc_Frame_t * p )         { return Abc_FrameCur()->pCex->iFrame; }               
+
+void        Abc_FrameInputNdr( Abc_Frame_t * pAbc, void * pData ) { Ndr_Delete(Abc_FrameCur()->pNdr); Abc_FrameCur()->pNdr = pData;                        }
+void *      Abc_FrameOutputNdr( Abc_Frame_t * pAbc )         { void * pData = Abc_FrameCur()->pNdr; Abc_FrameCur()->pNdr = NULL; return pData;             }  
+int *       Abc_FrameOutputNdrArray( Abc_Frame_t * pAbc )    { int * pArray = Abc_FrameCur()->pNdrArray; Abc_FrameCur()->pNdrArray = NULL; return pArray;  }
+
+void        Abc_FrameSetLibLut( void * pLib )                { Abc_FrameCur()->pLibLut   = pLib;    } 
+void        Abc_FrameSetLibBox( void * pLib )                { Abc_FrameCur()->pLibBox   = pLib;    } 
+void        Abc_FrameSetLibGen( void * pLib )                { Abc_FrameCur()->pLibGen   = pLib;    } 
+void        Abc_FrameSetLibGen2( void * pLib )               { Abc_FrameCur()->pLibGen2  = pLib;    } 
+void        Abc_FrameSetLibSuper( void * pLib )              { Abc_FrameCur()->pLibSuper = pLib;    } 
+void        Abc_FrameSetMapArch( void * pArch )              { Abc_FrameCur()->pMapArch = pArch;    } 
+void        Abc_FrameSetFlag( char * pFlag, char * pValue )  { Cmd_FlagUpdateValue( Abc_FrameCur(), pFlag, pValue );               } 
+void        Abc_FrameSetCex( Abc_Cex_t * pCex )              { ABC_FREE( Abc_FrameCur()->pCex ); Abc_FrameCur()->pCex = pCex;       }
+void        Abc_FrameSetNFrames( int nFrames )               { ABC_FREE( Abc_FrameCur()->pCex ); Abc_FrameCur()->nFrames = nFrames; }
+void        Abc_FrameSetStatus( int Status )                 { ABC_FREE( Abc_FrameCur()->pCex ); Abc_FrameCur()->Status = Status;   }
+void        Abc_FrameSetManDsd( void * pMan )                { if (Abc_FrameCur()->pManDsd  && Abc_FrameCur()->pManDsd  != pMan) If_DsdManFree((If_DsdMan_t *)Abc_FrameCur()->pManDsd,  0); Abc_FrameCur()->pManDsd = pMan;  }
+void        Abc_FrameSetManDsd2( void * pMan )               { if (Abc_FrameCur()->pManDsd2 && Abc_FrameCur()->pManDsd2 != pMan) If_DsdManFree((If_DsdMan_t *)Abc_FrameCur()->pManDsd2, 0); Abc_FrameCur()->pManDsd2 = pMan; }
+void        Abc_FrameSetInv( Vec_Int_t * vInv )              { Vec_IntFreeP(&Abc_FrameCur()->pAbcWlcInv); Abc_FrameCur()->pAbcWlcInv = vInv; }
+void        Abc_FrameSetJsonStrs( Abc_Nam_t * pStrs )        { Abc_NamDeref( Abc_FrameCur()->pJsonStrs ); Abc_FrameCur()->pJsonStrs = pStrs; }
+void        Abc_FrameSetJsonObjs( Vec_Wec_t * vObjs )        { Vec_WecFreeP(&Abc_FrameCur()->vJsonObjs ); Abc_FrameCur()->vJsonObjs = vObjs; }
+void        Abc_FrameSetSignalNames( Vec_Ptr_t * vNames )    { if ( Abc_FrameCur()->vSignalNames ) Vec_PtrFreeFree( Abc_FrameCur()->vSignalNames ); Abc_FrameCur()->vSignalNames = vNames; }
+void        Abc_FrameSetSpecName( char * pFileName )         { ABC_FREE( Abc_FrameCur()->pSpecName ); Abc_FrameCur()->pSpecName = pFileName; }
+
+int         Abc_FrameIsBatchMode()                           { return Abc_FrameCur() ? Abc_FrameCur()->fBatchMode : 0;              } 
+void        Abc_FrameSetBatchMode( int Mode )                { if ( Abc_FrameCur() ) Abc_FrameCur()->fBatchMode = Mode;             } 
+
+int         Abc_FrameIsBridgeMode()                          { return Abc_FrameCur() ? Abc_FrameCur()->fBridgeMode : 0;             } 
+void        Abc_FrameSetBridgeMode()                         { if ( Abc_FrameCur() ) Abc_FrameCur()->fBridgeMode = 1;               } 
+
+char *      Abc_FrameReadDrivingCell()                       { return Abc_FrameCur()->pDrivingCell;    }              
+float       Abc_FrameReadMaxLoad()                           { return Abc_FrameCur()->MaxLoad;         }      
+void        Abc_FrameSetDrivingCell( char * pName )          { ABC_FREE(Abc_FrameCur()->pDrivingCell); Abc_FrameCur()->pDrivingCell   = pName; }      
+void        Abc_FrameSetMaxLoad( float Load )                { Abc_FrameCur()->MaxLoad = Load;         }      
 
 int *       Abc_FrameReadArrayMapping( Abc_Frame_t * pAbc )  { return pAbc->pArray;                                            }
-void        Abc_FrameSetArrayMapping( int * p )              { ABC_FREE( s_GlobalFrame->pArray ); s_GlobalFrame->pArray = p;   }      
+void        Abc_FrameSetArrayMapping( int * p )              { ABC_FREE( Abc_FrameCur()->pArray ); Abc_FrameCur()->pArray = p;   }      
 
 int *       Abc_FrameReadBoxes( Abc_Frame_t * pAbc )         { return pAbc->pBoxes;                                            }
-void        Abc_FrameSetBoxes( int * p )                     { ABC_FREE( s_GlobalFrame->pBoxes ); s_GlobalFrame->pBoxes = p;   }      
+void        Abc_FrameSetBoxes( int * p )                     { ABC_FREE( Abc_FrameCur()->pBoxes ); Abc_FrameCur()->pBoxes = p;   }      
 
 /**Function*************************************************************
 
@@ -208,7 +244,8 @@ void Abc_FrameDeallocate( Abc_Frame_t * p )
 //    extern void Ivy_TruthManStop();
 //    Abc_HManStop();
 //    undefine_cube_size();
-    Rwt_ManGlobalStop();
+    if ( p->pBase == NULL )
+        Rwt_ManGlobalStop();
 //    Ivy_TruthManStop();
     if ( p->vAbcObjIds)  Vec_IntFree( p->vAbcObjIds );
     if ( p->vCexVec   )  Vec_PtrFreeFree( p->vCexVec );
@@ -241,13 +278,14 @@ void Abc_FrameDeallocate( Abc_Frame_t * p )
     ABC_FREE( p->pSpecName );
     Abc_FrameDeleteAllNetworks( p );
     ABC_FREE( p->pDrivingCell );
+    ABC_FREE( p->pMapItStats );
     ABC_FREE( p->pCex2 );
     ABC_FREE( p->pCex );
     Vec_IntFreeP( &p->pAbcWlcInv );
-    Abc_NamDeref( s_GlobalFrame->pJsonStrs );
-    Vec_WecFreeP( &s_GlobalFrame->vJsonObjs );  
-    Ndr_Delete( s_GlobalFrame->pNdr );
-    ABC_FREE( s_GlobalFrame->pNdrArray );
+    Abc_NamDeref( p->pJsonStrs );
+    Vec_WecFreeP( &p->vJsonObjs );  
+    Ndr_Delete( p->pNdr );
+    ABC_FREE( p->pNdrArray );
 
     Gia_ManStopP( &p->pGiaMiniAig );
     Gia_ManStopP( &p->pGiaMiniLut );
@@ -257,8 +295,9 @@ void Abc_FrameDeallocate( Abc_Frame_t * p )
     ABC_FREE( p->pBoxes );
     
 
+    if ( s_GlobalFrame == p )
+        s_GlobalFrame = NULL;
     ABC_FREE( p );
-    s_GlobalFrame = NULL;
 }
 
 
@@ -641,6 +680,8 @@ void Abc_FrameSetGlobalFrame( Abc_Frame_t * p )
 ***********************************************************************/
 Abc_Frame_t * Abc_FrameGetGlobalFrame()
 {
+    if ( s_SessionFrame )
+        return s_SessionFrame;
     if ( s_GlobalFrame == 0 )
     {
         // start the framework
@@ -664,7 +705,185 @@ Abc_Frame_t * Abc_FrameGetGlobalFrame()
 ***********************************************************************/
 Abc_Frame_t * Abc_FrameReadGlobalFrame()
 {
-    return s_GlobalFrame;
+    return s_SessionFrame ? s_SessionFrame : s_GlobalFrame;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Makes the frame current in the calling thread.]
+
+  Description [After this call, the accessors without the frame argument
+  (such as Abc_FrameReadLibGen() or Abc_FrameGetGlobalFrame()) called in
+  this thread refer to the given frame. Passing NULL or the global frame
+  restores the global frame. Returns the frame that was current before.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Frame_t * Abc_FrameSetSession( Abc_Frame_t * p )
+{
+    Abc_Frame_t * pOld = Abc_FrameCur();
+    s_SessionFrame = (p == s_GlobalFrame) ? NULL : p;
+    return pOld;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Serializes the scripts of the frames.]
+
+  Description [Many packages keep their state in global variables, which
+  are not protected, so the commands of different frames should not run
+  at the same time. The lock is taken for every script, and when a session
+  is started or stopped, so the base frame and its sessions take turns in
+  executing the scripts. The lock is re-entrant within a thread: the depth
+  is kept in a thread-local counter, so the thread holding the lock can
+  take it again (for example, when a command executes another script or
+  when the forked child of the server runs a job), while other threads
+  wait on the mutex.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_FrameLockSessions()
+{
+#ifdef ABC_USE_PTHREADS
+    if ( s_nSessionLocks++ == 0 )
+        pthread_mutex_lock( &s_SessionMutex );
+#endif
+}
+void Abc_FrameUnlockSessions()
+{
+#ifdef ABC_USE_PTHREADS
+    assert( s_nSessionLocks > 0 );
+    if ( --s_nSessionLocks == 0 )
+        pthread_mutex_unlock( &s_SessionMutex );
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the library is shared with the base frame.]
+
+  Description [Returns 1 if the current frame is a session and the given
+  library belongs to its base frame. Such library should not be freed or
+  changed by the session.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_FrameIsLibShared( void * pLib )
+{
+    Abc_Frame_t * pBase = Abc_FrameCur() ? Abc_FrameCur()->pBase : NULL;
+    if ( pBase == NULL || pLib == NULL )
+        return 0;
+    return pLib == pBase->pLibBox || pLib == pBase->pLibScl;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts a session using the libraries of the base frame.]
+
+  Description [The session is a separate frame with its own command
+  tables, current network and saved networks; it starts with the flags
+  and the aliases of the base frame. The session gets its own copies of
+  the LUT and genlib libraries, which can be changed or replaced by the
+  commands of the session; the supergate library and the library used by
+  'amap' are derived from the genlib copy when needed. The box and Liberty
+  libraries of the base frame are shared with the session and are
+  read-only: the commands changing them (registered with CMD_CHANGES_LIB)
+  are rejected in the session, and the libraries are not freed when the
+  session stops. If pBase is NULL, the global frame is used. The sessions
+  are isolated, but not concurrent: their scripts can be executed by
+  Cmd_CommandExecute() in different threads, but only one script runs at
+  a time (see Abc_FrameLockSessions()), and the scripts of different
+  sessions may interleave only between the calls to Cmd_CommandExecute().]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Frame_t * Abc_FrameStartSession( Abc_Frame_t * pBase )
+{
+    Abc_Frame_t * p, * pOld;
+    st__generator * gen;
+    char * pKey, * pValue;
+    if ( pBase == NULL )
+        pBase = Abc_FrameGetGlobalFrame();
+    assert( pBase->pBase == NULL );
+    Abc_FrameLockSessions();
+    p = Abc_FrameAllocate();
+    p->pBase = pBase;
+    p->Out   = pBase->Out;
+    p->Err   = pBase->Err;
+    p->fBatchMode = pBase->fBatchMode;
+    // register the commands in the new frame
+    pOld = Abc_FrameSetSession( p );
+    Abc_FrameInit( p );
+    Abc_FrameSetSession( pOld );
+    // copy the libraries, which can be changed by the commands
+    If_LibLutFree( (If_LibLut_t *)p->pLibLut );
+    p->pLibLut   = pBase->pLibLut ? If_LibLutDup( (If_LibLut_t *)pBase->pLibLut ) : NULL;
+    p->pLibGen   = pBase->pLibGen ? Mio_LibraryDup( (Mio_Library_t *)pBase->pLibGen ) : NULL;
+    p->pLibGen2  = NULL;
+    p->pLibSuper = NULL;
+    // share the read-only libraries
+    p->pLibBox   = pBase->pLibBox;
+    p->pLibScl   = pBase->pLibScl;
+    // inherit the flags and the aliases
+    st__foreach_item( pBase->tFlags, gen, (const char **)&pKey, (char **)&pValue )
+        if ( !st__is_member( p->tFlags, pKey ) )
+            st__insert( p->tFlags, Extra_UtilStrsav(pKey), Extra_UtilStrsav(pValue) );
+    st__foreach_item( pBase->tAliases, gen, (const char **)&pKey, (char **)&pValue )
+        if ( !st__is_member( p->tAliases, pKey ) )
+            CmdCommandAliasAdd( p, pKey, ((Abc_Alias *)pValue)->argc, ((Abc_Alias *)pValue)->argv );
+    pBase->nSessions++;
+    Abc_FrameUnlockSessions();
+    return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Stops the session.]
+
+  Description [Frees the networks and the libraries of the session, while
+  the libraries shared with the base frame are kept.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_FrameStopSession( Abc_Frame_t * p )
+{
+    extern void If_End( Abc_Frame_t * pAbc );
+    extern void Map_End( Abc_Frame_t * pAbc );
+    extern void Mio_End( Abc_Frame_t * pAbc );
+    extern void Scl_End( Abc_Frame_t * pAbc );
+    Abc_Frame_t * pBase = p->pBase, * pOld;
+    assert( pBase != NULL );
+    Abc_FrameLockSessions();
+    // detach the shared libraries
+    if ( p->pLibBox   == pBase->pLibBox   )  p->pLibBox   = NULL;
+    if ( p->pLibScl   == pBase->pLibScl   )  p->pLibScl   = NULL;
+    // free the libraries of the session (the packages read the current frame)
+    pOld = Abc_FrameSetSession( p );
+    Map_End( p );
+    Mio_End( p );
+    If_End( p );
+    Scl_End( p );
+    Cmd_End( p );
+    Abc_FrameDeleteAllNetworks( p );
+    Abc_FrameSetSession( pOld == p ? NULL : pOld );
+    Abc_FrameDeallocate( p );
+    pBase->nSessions--;
+    Abc_FrameUnlockSessions();
 }
 
 /**Function*************************************************************
@@ -59,6 +59,8 @@ typedef void (*Abc_Frame_Callback_BmcFrameDone_Func)(int frame, int po, int stat
 struct Abc_Frame_t_
 {
     // general info
+    Abc_Frame_t *   pBase;         // the frame sharing its libraries with this session (NULL for the global frame)
+    int             nSessions;     // the number of sessions using the libraries of this frame
     char *          sVersion;      // the name of the current version
     char *          sBinary;       // the name of the binary running
     // commands, aliases, etc
@@ -102,6 +104,8 @@ struct Abc_Frame_t_
     void *          pLibGen;       // the current genlib
     void *          pLibGen2;      // the current genlib
     void *          pLibSuper;     // the current supergate library
+    void *          pMapArch;      // the archive of mapped networks found by ITMap
+    void *          pMapItStats;   // the runtime profile of the last call to 'map'
     void *          pLibScl;       // the current Liberty library
     void *          pAbcCon;       // constraint manager
     // timing constraints
@@ -115,9 +115,12 @@ int Abc_RealMain( int argc, char * argv[] )
     pAbc = Abc_FrameGetGlobalFrame();
     pAbc->sBinary = argv[0];
 
-    // init python env
+    // init python env (the mapper takes the interpreter lock when it uses Python)
     if (!Py_IsInitialized()) 
+    {
         Py_Initialize();
+        PyEval_SaveThread();
+    }
 
     // default options
     fBatch      = INTERACTIVE;
@@ -381,7 +384,10 @@ int Abc_RealMain( int argc, char * argv[] )
 
     // close python env
     if (Py_IsInitialized()) 
+    {
+        PyGILState_Ensure();
         Py_Finalize();
+    }
 
     // if the memory should be freed, quit packages
 //    if ( fStatus < 0 ) 
@@ -2493,10 +2493,11 @@ Gia_Man_t * Wlc_NtkBitBlast( Wlc_Ntk_t * p, Wlc_BstPar_t * pParIn )
     }
     assert( Vec_PtrSize(pNew->vNamesOut) == Gia_ManCoNum(pNew) );
 
-    // replace the current library
+    // replace the current library (a session does not free the library of its base frame)
     if ( pBoxLib )
     {
-        If_LibBoxFree( (If_LibBox_t *)Abc_FrameReadLibBox() );
+        if ( !Abc_FrameIsLibShared( Abc_FrameReadLibBox() ) )
+            If_LibBoxFree( (If_LibBox_t *)Abc_FrameReadLibBox() );
         Abc_FrameSetLibBox( pBoxLib );
     }
 
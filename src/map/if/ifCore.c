@@ -51,6 +51,7 @@ void If_ManSetDefaultPars( If_Par_t * pPars )
     pPars->nCutsMax    =  8;
     pPars->nFlowIters  =  1;
     pPars->nAreaIters  =  2;
+    pPars->nProcs      =  1;
     pPars->DelayTarget = -1;
     pPars->Epsilon     =  (float)0.005;
     pPars->fPreprocess =  1;
@@ -25,22 +25,12 @@
 #include "sat/bsat/satSolver.h"
 #include "aig/gia/gia.h"
 #include "bool/kit/kit.h"
+#include "misc/util/utilPool.h"
 
 #ifdef ABC_USE_CUDD
 #include "bdd/extrab/extraBdd.h"
 #endif
 
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#include <unistd.h>
-#endif
-
-#endif
-
 ABC_NAMESPACE_IMPL_START
 
 
@@ -2572,33 +2562,17 @@ typedef struct Ifn_ThData_t_
     int         Id;      // object
     int         nConfls; // conflicts
     int         Result;  // result
-    int         Status;  // state
     abctime     clkUsed; // total runtime
 } Ifn_ThData_t;
-void * Ifn_WorkerThread( void * pArg )
+void Ifn_WorkerTask( void * pArg, int iThread, void * pScratch )
 {
     Ifn_ThData_t * pThData = (Ifn_ThData_t *)pArg;
-    volatile int * pPlace = &pThData->Status;
-    abctime clk;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->Status == 1 );
-        if ( pThData->Id == -1 )
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        clk = Abc_Clock();
-        memset( pThData->pConfig, 0, sizeof(word) * pThData->nConfigWords );
-        pThData->Result = Ifn_NtkMatch( pThData->pNtk, pThData->pTruth, pThData->nVars, pThData->nConfls, 0, 0, pThData->pConfig );
-        pThData->clkUsed += Abc_Clock() - clk;
-        pThData->Status = 0;
-//        printf( "Finished object %d\n", pThData->Id );
-    }
-    assert( 0 );
-    return NULL;
+    abctime clk = Abc_Clock();
+    assert( pThData->Id >= 0 );
+    memset( pThData->pConfig, 0, sizeof(word) * pThData->nConfigWords );
+    pThData->Result = Ifn_NtkMatch( pThData->pNtk, pThData->pTruth, pThData->nVars, pThData->nConfls, 0, 0, pThData->pConfig );
+    pThData->clkUsed += Abc_Clock() - clk;
+//    printf( "Finished object %d\n", pThData->Id );
 }
 void Id_DsdManTuneStr( If_DsdMan_t * p, char * pStruct, int nConfls, int nProcs, int nInputs, int fVerbose )
 {
@@ -2658,10 +2632,10 @@ void Id_DsdManTuneStr( If_DsdMan_t * p, char * pStruct, int nConfls, int nProcs,
 
     // perform concurrent solving
     {
-        pthread_t WorkerThread[PAR_THR_MAX];
         Ifn_ThData_t ThData[PAR_THR_MAX];
+        Util_Pool_t * pPool;
         abctime clk, clkUsed = 0;
-        int status, fRunning = 1, iCurrentObj = p->nObjsPrev;
+        int iCurrentObj = p->nObjsPrev;
         // start the threads
         for ( i = 0; i < nProcs; i++ )
         {
@@ -2670,33 +2644,16 @@ void Id_DsdManTuneStr( If_DsdMan_t * p, char * pStruct, int nConfls, int nProcs,
             ThData[i].Id       = -1;      // object
             ThData[i].nConfls  = nConfls; // conflicts
             ThData[i].Result   = -1;      // result
-            ThData[i].Status   =  0;      // state
             ThData[i].clkUsed  =  0;      // total runtime
             ThData[i].nConfigWords = p->nConfigWords;
-            status = pthread_create( WorkerThread + i, NULL, Ifn_WorkerThread, (void *)(ThData + i) );  assert( status == 0 );
         }
+        pPool = Util_PoolStart( nProcs, 0 );
         // run the threads
-        while ( fRunning || iCurrentObj < Vec_PtrSize(&p->vObjs) )
+        while ( 1 )
         {
-            for ( i = 0; i < nProcs; i++ )
+            // schedule the next objects on the idle threads
+            while ( iCurrentObj < Vec_PtrSize(&p->vObjs) && (i = Util_PoolFindIdle(pPool)) >= 0 )
             {
-                if ( ThData[i].Status )
-                    continue;
-                assert( ThData[i].Status == 0 );
-                if ( ThData[i].Id >= 0 )
-                {
-                    //printf( "Closing obj %d with Thread %d:\n", ThData[i].Id, i );
-                    assert( ThData[i].Result == 0 || ThData[i].Result == 1 );
-                    if ( ThData[i].Result == 0 )
-                        If_DsdVecObjSetMark( &p->vObjs, ThData[i].Id );
-                    else
-                    {
-                        word * pTtWords = Vec_WrdEntryP( p->vConfigs, p->nConfigWords * ThData[i].Id );
-                        memcpy( pTtWords, ThData[i].pConfig, sizeof(word) * p->nConfigWords );
-                    }
-                    ThData[i].Id     = -1;
-                    ThData[i].Result = -1;
-                }
                 for ( k = iCurrentObj; k < Vec_PtrSize(&p->vObjs); k++ )
                 {
                     if ( (k & 0xFF) == 0 )
@@ -2711,26 +2668,33 @@ void Id_DsdManTuneStr( If_DsdMan_t * p, char * pStruct, int nConfls, int nProcs,
                     ThData[i].nVars  = nVars;
                     ThData[i].Id     =  k;
                     ThData[i].Result = -1;
-                    ThData[i].Status =  1;
+                    Util_PoolAssign( pPool, i, Ifn_WorkerTask, (void *)(ThData + i) );
                     //printf( "Scheduling %d for Thread %d\n", ThData[i].Id, i );
-                    iCurrentObj = k+1;
                     break;
                 }
+                iCurrentObj = k < Vec_PtrSize(&p->vObjs) ? k+1 : k;
             }
-            fRunning = 0;
-            for ( i = 0; i < nProcs; i++ )
-                if ( ThData[i].Status == 1 || (ThData[i].Status == 0 && ThData[i].Id >= 0) )
-                    fRunning = 1;
-            //printf( "fRunning %d\n", fRunning );
+            // wait till one of the objects is matched
+            i = Util_PoolWaitAny( pPool, NULL );
+            if ( i == -1 )
+                break;
+            //printf( "Closing obj %d with Thread %d:\n", ThData[i].Id, i );
+            assert( ThData[i].Id >= 0 );
+            assert( ThData[i].Result == 0 || ThData[i].Result == 1 );
+            if ( ThData[i].Result == 0 )
+                If_DsdVecObjSetMark( &p->vObjs, ThData[i].Id );
+            else
+            {
+                word * pTtWords = Vec_WrdEntryP( p->vConfigs, p->nConfigWords * ThData[i].Id );
+                memcpy( pTtWords, ThData[i].pConfig, sizeof(word) * p->nConfigWords );
+            }
+            ThData[i].Id     = -1;
+            ThData[i].Result = -1;
         }
         // stop the threads
+        Util_PoolStop( pPool );
         for ( i = 0; i < nProcs; i++ )
-        {
-            assert( ThData[i].Status == 0 );
-            ThData[i].Id = -1;
-            ThData[i].Status = 1;
             ABC_FREE( ThData[i].pNtk );
-        }
         if ( fVerbose )
         {
             printf( "Main     : " );
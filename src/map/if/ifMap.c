@@ -20,6 +20,7 @@
 
 #include "if.h"
 #include "misc/extra/extra.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -31,6 +32,22 @@ extern char * Dau_DsdMerge( char * pDsd0i, int * pPerm0, char * pDsd1i, int * pP
 extern int    If_CutDelayRecCost3( If_Man_t* p, If_Cut_t* pCut, If_Obj_t * pObj );
 extern int    Abc_ExactDelayCost( word * pTruth, int nVars, int * pArrTimeProfile, char * pPerm, int * Cost, int AigLevel );
 
+// the smallest number of nodes per thread worth mapping in parallel
+#define IF_PAR_NODES_MIN  64
+
+// the nodes of one level mapped by one thread
+typedef struct If_ParTask_t_ If_ParTask_t;
+struct If_ParTask_t_
+{
+    If_Man_t *      pMan;         // the private copy of the manager
+    Vec_Int_t *     vLevel;       // the nodes of the level
+    int             iStart;       // the first node of the chunk
+    int             iStop;        // the node following the last one
+    int             Mode;         // the mapping mode
+    int             fPreprocess;  // the preprocessing round
+    int             fFirst;       // the first round
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -150,16 +167,19 @@ int * If_CutArrTimeProfile( If_Man_t * p, If_Cut_t * pCut )
 
 /**Function*************************************************************
 
-  Synopsis    [Finds the best cut for the given node.]
+  Synopsis    [Computes the cuts of the node and selects the best one.]
 
-  Description [Mapping modes: delay (0), area flow (1), area (2).]
+  Description [Mapping modes: delay (0), area flow (1), area (2). Expects 
+  that the cutset of the node is prepared and that, in the area recovery 
+  modes, the best cut of the node is dereferenced. Besides the node, only 
+  the cut counters and the merging scratch of the manager are modified.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
+static void If_ObjPerformMappingAndInt( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
 {
     If_Set_t * pCutSet;
     If_Cut_t * pCut0, * pCut1, * pCut;
@@ -201,12 +221,8 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
     }
    
 
-    // deref the selected cut
-    if ( Mode && pObj->nRefs > 0 )
-        If_CutAreaDeref( p, If_ObjCutBest(pObj) );
-
-    // prepare the cutset
-    pCutSet = If_ManSetupNodeCutSet( p, pObj );
+    // get the cutset prepared by the caller
+    pCutSet = pObj->pCutSet;
 
     // get the current assigned best cut
     pCut = If_ObjCutBest(pObj);
@@ -501,7 +517,30 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
 //        p->nBestCutSmall[0]++;
 //    else if ( If_ObjCutBest(pObj)->nLeaves == 1 )
 //        p->nBestCutSmall[1]++;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Finds the best cut for the given node.]
+
+  Description [Mapping modes: delay (0), area flow (1), area (2).]
+               
+  SideEffects []
 
+  SeeAlso     []
+
+***********************************************************************/
+void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
+{
+    If_Cut_t * pCut;
+    int i;
+    // deref the selected cut
+    if ( Mode && pObj->nRefs > 0 )
+        If_CutAreaDeref( p, If_ObjCutBest(pObj) );
+    // prepare the cutset
+    If_ManSetupNodeCutSet( p, pObj );
+    // compute the cuts and select the best one
+    If_ObjPerformMappingAndInt( p, pObj, Mode, fPreprocess, fFirst );
     // ref the selected cut
     if ( Mode && pObj->nRefs > 0 )
         If_CutAreaRef( p, If_ObjCutBest(pObj) );
@@ -600,6 +639,203 @@ void If_ObjPerformMappingChoice( If_Man_t * p, If_Obj_t * pObj, int Mode, int fP
     If_ManDerefChoiceCutSet( p, pObj );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the round can map the nodes of a level in parallel.]
+
+  Description [The nodes of one level do not depend on each other, as long 
+  as the cut computation reads only the fanin cutsets and the best cuts of 
+  the transitive fanin. This is not the case for exact area, for the boxes, 
+  for the choices, and for the features that compute or cache the cut 
+  functions in the manager.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int If_ManPerformMappingParCheck( If_Man_t * p, int Mode )
+{
+    If_Par_t * pPars = p->pPars;
+    if ( pPars->nProcs < 2 || Mode == 2 || p->pManTim != NULL || p->nChoices > 0 )
+        return 0;
+    if ( pPars->fTruth || pPars->fUseTtPerm || pPars->fUseDsd || pPars->fPower || pPars->fLiftLeaves || pPars->nGateSize > 0 )
+        return 0;
+    if ( pPars->fDelayOpt || pPars->fDelayOptLut || pPars->fDsdBalance || pPars->fUserRecLib || pPars->fUserSesLib )
+        return 0;
+    if ( pPars->pFuncCost || pPars->pFuncUser || pPars->pFuncCell || pPars->pFuncCell2 )
+        return 0;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Maps a chunk of the nodes of one level.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void If_ManPerformMappingParTask( void * pArg, int iThread, void * pScratch )
+{
+    If_ParTask_t * pTask = (If_ParTask_t *)pArg;
+    int i;
+    for ( i = pTask->iStart; i < pTask->iStop; i++ )
+        If_ObjPerformMappingAndInt( pTask->pMan, If_ManObj(pTask->pMan, Vec_IntEntry(pTask->vLevel, i)), pTask->Mode, pTask->fPreprocess, pTask->fFirst );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Adds cutsets to the free list.]
+
+  Description [Returns the memory block to be freed after the round.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static char * If_ManPerformMappingParGrow( If_Man_t * p, int nCutSets )
+{
+    extern void If_ManSetupSet( If_Man_t * p, If_Set_t * pSet );
+    char * pMemory = ABC_ALLOC( char, nCutSets * p->nSetBytes );
+    If_Set_t * pCutSet;
+    int i;
+    for ( i = 0; i < nCutSets; i++ )
+    {
+        pCutSet = (If_Set_t *)(pMemory + i * p->nSetBytes);
+        If_ManSetupSet( p, pCutSet );
+        pCutSet->pNext = p->pFreeList;
+        p->pFreeList = pCutSet;
+    }
+    return pMemory;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs one mapping pass over the levels of the nodes.]
+
+  Description [The cutsets are fetched, the best cuts are dereferenced, 
+  referenced again and the cutsets are recycled by the calling thread in 
+  the order of node IDs. Only the cut computation and the selection of the 
+  best cut are divided among the threads. In the delay mode, the result 
+  is the same as that of the sequential round. In the area flow mode, the 
+  best cuts of all the nodes of a level are dereferenced before the level 
+  is mapped, so the result does not depend on the number of threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void If_ManPerformMappingRoundPar( If_Man_t * p, int Mode, int fPreprocess, int fFirst )
+{
+    int nThreads = p->pPars->nProcs;
+    Util_Pool_t * pPool = Util_PoolStart( nThreads, 0 );
+    If_ParTask_t * pTasks = ABC_CALLOC( If_ParTask_t, nThreads );
+    If_Man_t * pCopies = ABC_ALLOC( If_Man_t, nThreads );
+    Vec_Wec_t * vLevels = Vec_WecAlloc( 100 );
+    Vec_Ptr_t * vBlocks = Vec_PtrAlloc( 10 );
+    Vec_Int_t * vSizes = Vec_IntAlloc( 10 );
+    Vec_Int_t * vLevel;
+    If_Obj_t * pObj;
+    If_Set_t * pCutSet, * pFree = NULL;
+    char * pBlock;
+    int i, k, iObj, nNodes, nFree, nChunks, nChunkSize, nMerged = 0, nTotal = 0;
+    // collect the nodes by level in the order of their IDs
+    If_ManForEachNode( p, pObj, i )
+        Vec_WecPush( vLevels, If_ObjLevel(pObj), pObj->Id );
+    Vec_WecForEachLevel( vLevels, vLevel, i )
+    {
+        nNodes = Vec_IntSize(vLevel);
+        if ( nNodes == 0 )
+            continue;
+        // the level may need more cutsets than were allocated for the node order
+        for ( pCutSet = p->pFreeList, nFree = 0; pCutSet && nFree < nNodes; pCutSet = pCutSet->pNext )
+            nFree++;
+        if ( nFree < nNodes )
+        {
+            Vec_PtrPush( vBlocks, If_ManPerformMappingParGrow(p, nNodes - nFree + 128) );
+            Vec_IntPush( vSizes, nNodes - nFree + 128 );
+        }
+        // prepare the nodes
+        Vec_IntForEachEntry( vLevel, iObj, k )
+        {
+            pObj = If_ManObj( p, iObj );
+            if ( Mode && pObj->nRefs > 0 )
+                If_CutAreaDeref( p, If_ObjCutBest(pObj) );
+            If_ManSetupNodeCutSet( p, pObj );
+        }
+        // map the nodes
+        nChunks = Abc_MinInt( nThreads, nNodes / IF_PAR_NODES_MIN );
+        if ( nChunks < 2 )
+        {
+            Vec_IntForEachEntry( vLevel, iObj, k )
+                If_ObjPerformMappingAndInt( p, If_ManObj(p, iObj), Mode, fPreprocess, fFirst );
+        }
+        else
+        {
+            nChunkSize = (nNodes + nChunks - 1) / nChunks;
+            for ( k = 0; k < nChunks; k++ )
+            {
+                memcpy( pCopies + k, p, sizeof(If_Man_t) );
+                pTasks[k].pMan        = pCopies + k;
+                pTasks[k].vLevel      = vLevel;
+                pTasks[k].iStart      = k * nChunkSize;
+                pTasks[k].iStop       = Abc_MinInt( (k + 1) * nChunkSize, nNodes );
+                pTasks[k].Mode        = Mode;
+                pTasks[k].fPreprocess = fPreprocess;
+                pTasks[k].fFirst      = fFirst;
+                Util_PoolAssign( pPool, k, If_ManPerformMappingParTask, (void *)(pTasks + k) );
+            }
+            Util_PoolWaitAll( pPool );
+            for ( k = 0; k < nChunks; k++ )
+            {
+                nMerged += pCopies[k].nCutsMerged - p->nCutsMerged;
+                nTotal  += pCopies[k].nCutsTotal  - p->nCutsTotal;
+            }
+        }
+        // finalize the nodes
+        Vec_IntForEachEntry( vLevel, iObj, k )
+        {
+            pObj = If_ManObj( p, iObj );
+            if ( Mode && pObj->nRefs > 0 )
+                If_CutAreaRef( p, If_ObjCutBest(pObj) );
+            if ( If_ObjCutBest(pObj)->fUseless )
+                Abc_Print( 1, "The best cut is useless.\n" );
+            If_ManDerefNodeCutSet( p, pObj );
+        }
+    }
+    p->nCutsMerged += nMerged;
+    p->nCutsTotal  += nTotal;
+    // remove the added cutsets from the free list
+    if ( Vec_PtrSize(vBlocks) > 0 )
+    {
+        while ( p->pFreeList )
+        {
+            pCutSet = p->pFreeList;
+            p->pFreeList = pCutSet->pNext;
+            Vec_PtrForEachEntry( char *, vBlocks, pBlock, k )
+                if ( (char *)pCutSet >= pBlock && (char *)pCutSet < pBlock + Vec_IntEntry(vSizes, k) * p->nSetBytes )
+                    break;
+            if ( k < Vec_PtrSize(vBlocks) )
+                continue;
+            pCutSet->pNext = pFree;
+            pFree = pCutSet;
+        }
+        p->pFreeList = pFree;
+    }
+    Vec_PtrFreeFree( vBlocks );
+    Vec_IntFree( vSizes );
+    Vec_WecFree( vLevels );
+    ABC_FREE( pCopies );
+    ABC_FREE( pTasks );
+    Util_PoolStop( pPool );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Performs one mapping pass over all nodes.]
@@ -666,6 +902,8 @@ int If_ManPerformMappingRound( If_Man_t * p, int nCutsUsed, int Mode, int fPrepr
         }
 //        Tim_ManPrint( p->pManTim );
     }
+    else if ( If_ManPerformMappingParCheck( p, Mode ) )
+        If_ManPerformMappingRoundPar( p, Mode, fPreprocess, fFirst );
     else
     {
         pProgress = Extra_ProgressBarStart( stdout, If_ManObjNum(p) );
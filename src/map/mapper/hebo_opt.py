@@ -8,7 +8,10 @@ import torch
 def obj(params : pd.DataFrame) -> np.ndarray:
     return ((params.values - 0.50)**2).sum(axis = 1).reshape(-1, 1)
 
-def init_opt():
+# the evaluation tiers used by ITMap: 0 = mapper estimate, 1 = STA, 2 = sizing + STA
+FIDELITY_FULL = 2
+
+def init_opt(multi_fidelity = False):
     np.random.seed(42)
     torch.manual_seed(42)
     params = [
@@ -23,6 +26,9 @@ def init_opt():
         {'name' : 'delay_para8', 'type' : 'num', 'lb' : 0.5, 'ub' : 2.0},
         {'name' : 'delay_para9', 'type' : 'num', 'lb' : 0.0, 'ub' : 1.0}    
     ]
+    # the fidelity is an extra input of the surrogate model
+    if multi_fidelity:
+        params.append({'name' : 'fidelity', 'type' : 'int', 'lb' : 0, 'ub' : FIDELITY_FULL})
     space = DesignSpace().parse(params)
     #space.sample(5)
     # cfg = {
@@ -42,25 +48,31 @@ def init_opt():
 
  
 
-def iterate_opt(opt, i_iter,  given_rec_x : List[float], given_rec_y : List[float]):
+def observe_opt(opt, given_rec_x : List[float], given_rec_y : List[float], fidelity : int):
+    column_names = [f'delay_para{i}' for i in range(len(given_rec_x))]
+    points = pd.DataFrame([given_rec_x], columns=column_names)
+    if 'fidelity' in opt.space.para_names:
+        points['fidelity'] = fidelity
+    opt.observe(points, np.array(given_rec_y))
+
+def suggest_opt(opt):
+    # always ask for the parameters at the highest fidelity
+    if 'fidelity' in opt.space.para_names:
+        rec_x = opt.suggest(n_suggestions = 1, fix_input = {'fidelity' : FIDELITY_FULL})
+        rec_x = rec_x.drop(columns = ['fidelity'])
+    else:
+        rec_x = opt.suggest(n_suggestions = 1)
+    return rec_x.values.tolist()[0]
+
+def iterate_opt(opt, i_iter,  given_rec_x : List[float], given_rec_y : List[float], fidelity : int = FIDELITY_FULL):
     if (i_iter == -1): 
-        column_names = [f'delay_para{i}' for i in range(len(given_rec_x))]
-        initial_points = pd.DataFrame([given_rec_x], columns=column_names)
-        initial_evaluations = np.array(given_rec_y) 
-        opt.observe(initial_points, initial_evaluations)
+        observe_opt(opt, given_rec_x, given_rec_y, fidelity)
         return opt, given_rec_x 
     elif (i_iter ==0):
-        rec_x = opt.suggest(n_suggestions = 1)
-        rec_x_list = rec_x.values.tolist()[0] 
-        return opt, rec_x_list
+        return opt, suggest_opt(opt)
     else:
-        column_names = [f'delay_para{i}' for i in range(len(given_rec_x))]
-        given_rec_x = pd.DataFrame([given_rec_x], columns=column_names)
-        given_rec_y = np.array(given_rec_y) 
-        opt.observe(given_rec_x, given_rec_y)
-        rec_x = opt.suggest(n_suggestions = 1)
-        rec_x_list = rec_x.values.tolist()[0] 
-        return opt, rec_x_list 
+        observe_opt(opt, given_rec_x, given_rec_y, fidelity)
+        return opt, suggest_opt(opt)
     
 
 def best_x(opt):
@@ -47,9 +47,27 @@ typedef struct Map_SuperLibStruct_t_    Map_SuperLib_t;
 typedef struct Map_HashTableStruct_t_   Map_HashTable_t;
 typedef struct Map_HashEntryStruct_t_   Map_HashEntry_t;
 typedef struct Map_TimeStruct_t_        Map_Time_t; 
+typedef struct Map_ArchStruct_t_        Map_Arch_t;
+typedef struct Map_ItStatsStruct_t_     Map_ItStats_t;
  
 
 
+// the runtime profile of one ITMap run
+struct Map_ItStatsStruct_t_
+{
+    abctime            clkmapTT;         // cuts and truth tables
+    abctime            clkInitPy;        // starting the optimizer
+    abctime            clkIterExp;       // evaluating the expert parameters
+    abctime            clkDeterPara;     // suggesting parameters
+    abctime            clkIterBayes;     // the Bayesian iterations
+    abctime            clkGradient;      // the local gradient
+    abctime            clkDelayMap;      // delay-oriented mapping
+    abctime            clkAreaRecovery;  // the final mapping with area recovery
+    abctime            clkSTA;           // deriving and timing the candidates
+    abctime            clkTotal;         // the total runtime of the mapper
+    int                nEvals[3];        // evaluations per fidelity tier
+};
+
 // the pair of rise/fall time parameters
 struct Map_TimeStruct_t_
 {
@@ -81,6 +99,7 @@ extern Map_Node_t *    Map_NodeCreate( Map_Man_t * p, Map_Node_t * p1, Map_Node_
 extern void            Map_ManCreateNodeDelays( Map_Man_t * p, int LogFan );
 extern void            Map_ManFree( Map_Man_t * pMan );
 extern void            Map_ManPrintTimeStats( Map_Man_t * p );
+extern void            Map_ManProfPrint( Map_Man_t * p );
 extern void            Map_ManPrintStatsToFile( char * pName, float Area, float Delay, abctime Time );
 extern int             Map_ManReadInputNum( Map_Man_t * p );
 extern int             Map_ManReadOutputNum( Map_Man_t * p );
@@ -112,6 +131,9 @@ extern void            Map_ManSetVerbose( Map_Man_t * p, int fVerbose );
 extern void            Map_ManSetSwitching( Map_Man_t * p, int fSwitching );
 extern void            Map_ManSetSkipFanout( Map_Man_t * p, int fSkipFanout );
 extern void            Map_ManSetUseProfile( Map_Man_t * p );
+extern void            Map_ManSetArchive( Map_Man_t * p, Map_Arch_t * pArch );
+extern void            Map_ManSetItStats( Map_Man_t * p, Map_ItStats_t * pItStats );
+extern void            Map_ManSetPrintProf( Map_Man_t * p, int fPrintProf );
 
 extern Map_Man_t *     Map_NodeReadMan( Map_Node_t * p );
 extern char *          Map_NodeReadData( Map_Node_t * p, int fPhase );
@@ -156,6 +178,8 @@ extern Mio_Library_t * Map_SuperLibReadGenLib( Map_SuperLib_t * p );
 extern float           Map_SuperLibReadAreaInv( Map_SuperLib_t * p );
 extern Map_Time_t      Map_SuperLibReadDelayInv( Map_SuperLib_t * p );
 extern int             Map_SuperLibReadVarsMax( Map_SuperLib_t * p );
+extern void            Map_SuperLibSetScl( Map_SuperLib_t * p, void * pLibScl, float Slew, float Gain, int nGatesMin );
+extern int             Map_SuperLibCheckScl( Map_SuperLib_t * p, void * pLibScl, float Slew, float Gain, int nGatesMin );
 
 extern Map_Node_t *    Map_NodeAnd( Map_Man_t * p, Map_Node_t * p1, Map_Node_t * p2 );
 extern Map_Node_t *    Map_NodeBuf( Map_Man_t * p, Map_Node_t * p1 );
@@ -169,12 +193,21 @@ extern Map_Cut_t *     Map_CutAlloc( Map_Man_t * p );
 /*=== mapperCutUtils.c =============================================================*/
 extern void            Map_CutCreateFromNode( Map_Man_t * p, Map_Super_t * pSuper, int iRoot, unsigned uPhaseRoot, 
                            int * pLeaves, int nLeaves, unsigned uPhaseLeaves );
+/*=== mapperArch.c =============================================================*/
+extern Map_Arch_t *    Map_ArchStart( Abc_Ntk_t * pNtk, Mio_Library_t * pLib );
+extern void            Map_ArchStop( Map_Arch_t * p );
+extern int             Map_ArchSize( Map_Arch_t * p );
+extern Mio_Library_t * Map_ArchReadLib( Map_Arch_t * p );
+extern int             Map_ArchAdd( Map_Arch_t * p, Abc_Ntk_t * pNtk, double * pParams, int nParams );
+extern void            Map_ArchPrint( Map_Arch_t * p, int fVerbose );
+extern Abc_Ntk_t *     Map_ArchDerive( Map_Arch_t * p, int iEntry );
 /*=== mapperCore.c =============================================================*/
 extern int             Map_Mapping( Map_Man_t * p );
 // extern int          Map_MappingSTA( Map_Man_t * p, int fStime);
 extern int             Map_MappingSTA( Map_Man_t * p, Abc_Ntk_t *pNtk, Mio_Library_t *pLib, int fStime,  double DelayTarget, int fUseBuffs);
 extern int             Map_MappingIteratable( Map_Man_t * p, Abc_Ntk_t *pNtk, Mio_Library_t *pLib, int fStime,  double DelayTarget, int fUseBuffs);
-extern int             Map_MappingHeboIt( Map_Man_t * p, Abc_Ntk_t *pNtk, Mio_Library_t *pLib, int fStime,  double DelayTarget, int fUseBuffs, int fGradient);
+extern int             Map_MappingPyPreload();
+extern int             Map_MappingHeboIt( Map_Man_t * p, Abc_Ntk_t *pNtk, Mio_Library_t *pLib, int fStime,  double DelayTarget, int fUseBuffs, int fGradient, float FidRatio );
 extern void            Map_MappingGradient(Map_Man_t * p,  Map_Cut_t *pCut, Map_Super_t *pSuper, int  fPhase,  double * grad, double *gatePara);
 extern int             Map_MappingUpdateTauRef(Map_Man_t * p, Map_Node_t *pNode, Map_Cut_t *pCut, Map_Super_t *pSuper, int fPhase, double gateDelay, double * grad, double *gatePara);
 extern double          Map_MappingEstCutDelay (Map_Man_t *p, Map_Cut_t *pCut, Map_Node_t *pNode, int fPhase, int pi,  double *gatePara);
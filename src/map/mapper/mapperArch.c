@@ -0,0 +1,375 @@
+/**CFile****************************************************************
+
+  FileName    [mapperArch.c]
+
+  PackageName [MVSIS 1.3: Multi-valued logic synthesis system.]
+
+  Synopsis    [Generic technology mapping engine.]
+
+  Author      []
+
+  Affiliation []
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: mapperArch.c,v 1.00 2026/10/18 00:00:00 Exp $]
+
+***********************************************************************/
+
+#include "mapperInt.h"
+#include "map/mio/mio.h"
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+// the archive of non-dominated mapped networks collected by ITMap
+struct Map_ArchStruct_t_
+{
+    Abc_Ntk_t *        pShell;        // the network with CIs/COs (no nodes)
+    Mio_Library_t *    pLib;          // the library used to map the networks
+    Vec_Ptr_t *        vGates;        // the gates of the library by index
+    Vec_Ptr_t *        vEntries;      // the non-dominated entries
+    int                nCands;        // the number of candidates offered
+};
+
+// one mapped network of the archive
+typedef struct Map_ArchEntry_t_ Map_ArchEntry_t;
+struct Map_ArchEntry_t_
+{
+    double             Delay;         // the delay after STA
+    double             Area;          // the area after STA
+    int                nGates;        // the number of gates
+    int                iCand;         // the candidate number in the optimization
+    int                nParams;       // the number of delay parameters
+    double *           pParams;       // the delay parameters of the candidate
+    Vec_Int_t *        vNtk;          // the compact netlist
+};
+
+// the compact netlist is stored as follows:
+// [nCis, nCos, nNodes] followed by [Gate, nFanins, Fanin0, Fanin1, ...] for each node
+// and the driver of each CO; CIs are numbered 0..nCis-1 and nodes follow in topological order
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Starts the archive for the given network.]
+
+  Description [The network provides CIs/COs and their names, which are
+  shared by all mapped networks added to the archive. The library is the
+  current genlib library, whose gates are used by the derived networks.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Map_Arch_t * Map_ArchStart( Abc_Ntk_t * pNtk, Mio_Library_t * pLib )
+{
+    Map_Arch_t * p;
+    Mio_Gate_t * pGate;
+    p = ABC_CALLOC( Map_Arch_t, 1 );
+    p->pShell   = Abc_NtkStartFrom( pNtk, ABC_NTK_LOGIC, ABC_FUNC_MAP );
+    p->pLib     = pLib;
+    p->vGates   = Vec_PtrAlloc( Mio_LibraryReadGateNum(pLib) );
+    p->vEntries = Vec_PtrAlloc( 16 );
+    Mio_LibraryForEachGate( pLib, pGate )
+        Vec_PtrPush( p->vGates, pGate );
+    return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Stops the archive.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Map_ArchEntryFree( Map_ArchEntry_t * pEntry )
+{
+    Vec_IntFree( pEntry->vNtk );
+    ABC_FREE( pEntry->pParams );
+    ABC_FREE( pEntry );
+}
+void Map_ArchStop( Map_Arch_t * p )
+{
+    Map_ArchEntry_t * pEntry;
+    int i;
+    if ( p == NULL )
+        return;
+    Vec_PtrForEachEntry( Map_ArchEntry_t *, p->vEntries, pEntry, i )
+        Map_ArchEntryFree( pEntry );
+    Vec_PtrFree( p->vEntries );
+    Vec_PtrFree( p->vGates );
+    Abc_NtkDelete( p->pShell );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the number of entries in the archive.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Map_ArchSize( Map_Arch_t * p )
+{
+    return p ? Vec_PtrSize(p->vEntries) : 0;
+}
+Mio_Library_t * Map_ArchReadLib( Map_Arch_t * p )
+{
+    return p->pLib;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the first entry dominates the second one.]
+
+  Description [Equal entries are considered dominated.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Map_ArchDominates( Map_ArchEntry_t * p1, Map_ArchEntry_t * p2 )
+{
+    return p1->Delay <= p2->Delay && p1->Area <= p2->Area && p1->nGates <= p2->nGates;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the compact netlist of the mapped network.]
+
+  Description [Returns NULL if some gates are not in the library.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Vec_Int_t * Map_ArchDeriveNetlist( Map_Arch_t * p, Abc_Ntk_t * pNtk )
+{
+    Vec_Int_t * vNtk;
+    Vec_Ptr_t * vNodes;
+    Mio_Gate_t * pGate;
+    Abc_Obj_t * pObj, * pFanin;
+    int i, k;
+    assert( Abc_NtkHasMapping(pNtk) );
+    assert( Abc_NtkCiNum(pNtk) == Abc_NtkCiNum(p->pShell) );
+    assert( Abc_NtkCoNum(pNtk) == Abc_NtkCoNum(p->pShell) );
+    // number the gates of the library
+    Vec_PtrForEachEntry( Mio_Gate_t *, p->vGates, pGate, i )
+        Mio_GateSetValue( pGate, i );
+    // number the objects
+    vNodes = Abc_NtkDfs( pNtk, 0 );
+    Abc_NtkForEachCi( pNtk, pObj, i )
+        pObj->iTemp = i;
+    Vec_PtrForEachEntry( Abc_Obj_t *, vNodes, pObj, i )
+        pObj->iTemp = Abc_NtkCiNum(pNtk) + i;
+    // write the netlist
+    vNtk = Vec_IntAlloc( 3 + 4 * Vec_PtrSize(vNodes) + Abc_NtkCoNum(pNtk) );
+    Vec_IntPush( vNtk, Abc_NtkCiNum(pNtk) );
+    Vec_IntPush( vNtk, Abc_NtkCoNum(pNtk) );
+    Vec_IntPush( vNtk, Vec_PtrSize(vNodes) );
+    Vec_PtrForEachEntry( Abc_Obj_t *, vNodes, pObj, i )
+    {
+        // gates of a derived library are matched by name
+        pGate = (Mio_Gate_t *)pObj->pData;
+        if ( Mio_GateReadLib(pGate) != p->pLib )
+            pGate = Mio_LibraryReadGateByName( p->pLib, Mio_GateReadName(pGate), NULL );
+        if ( pGate == NULL )
+        {
+            Vec_PtrFree( vNodes );
+            Vec_IntFree( vNtk );
+            return NULL;
+        }
+        Vec_IntPush( vNtk, Mio_GateReadValue(pGate) );
+        Vec_IntPush( vNtk, Abc_ObjFaninNum(pObj) );
+        Abc_ObjForEachFanin( pObj, pFanin, k )
+            Vec_IntPush( vNtk, pFanin->iTemp );
+    }
+    Abc_NtkForEachCo( pNtk, pObj, i )
+        Vec_IntPush( vNtk, Abc_ObjFanin0(pObj)->iTemp );
+    Vec_PtrFree( vNodes );
+    return vNtk;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Offers the mapped network to the archive.]
+
+  Description [The network is expected to be timed by STA (MaxDelay and
+  SumArea are set). Returns 1 if the network is not dominated by any of
+  the entries; in this case the entries dominated by it are removed.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Map_ArchAdd( Map_Arch_t * p, Abc_Ntk_t * pNtk, double * pParams, int nParams )
+{
+    Map_ArchEntry_t * pEntry, * pTemp;
+    int i, k;
+    p->nCands++;
+    if ( Abc_FrameReadLibGen() != p->pLib )
+        return 0;
+    pEntry = ABC_CALLOC( Map_ArchEntry_t, 1 );
+    pEntry->Delay  = pNtk->MaxDelay;
+    pEntry->Area   = pNtk->SumArea;
+    pEntry->nGates = Abc_NtkNodeNum(pNtk);
+    pEntry->iCand  = p->nCands - 1;
+    // check if the entry is dominated
+    Vec_PtrForEachEntry( Map_ArchEntry_t *, p->vEntries, pTemp, i )
+        if ( Map_ArchDominates(pTemp, pEntry) )
+        {
+            ABC_FREE( pEntry );
+            return 0;
+        }
+    // save the netlist
+    pEntry->vNtk = Map_ArchDeriveNetlist( p, pNtk );
+    if ( pEntry->vNtk == NULL )
+    {
+        ABC_FREE( pEntry );
+        return 0;
+    }
+    pEntry->nParams = nParams;
+    pEntry->pParams = ABC_ALLOC( double, nParams );
+    memcpy( pEntry->pParams, pParams, sizeof(double) * nParams );
+    // remove the entries dominated by the new one
+    k = 0;
+    Vec_PtrForEachEntry( Map_ArchEntry_t *, p->vEntries, pTemp, i )
+        if ( Map_ArchDominates(pEntry, pTemp) )
+            Map_ArchEntryFree( pTemp );
+        else
+            Vec_PtrWriteEntry( p->vEntries, k++, pTemp );
+    Vec_PtrShrink( p->vEntries, k );
+    // keep the entries sorted by delay
+    Vec_PtrPush( p->vEntries, pEntry );
+    for ( i = Vec_PtrSize(p->vEntries) - 1; i > 0; i-- )
+    {
+        pTemp = (Map_ArchEntry_t *)Vec_PtrEntry( p->vEntries, i-1 );
+        if ( pTemp->Delay <= pEntry->Delay )
+            break;
+        Vec_PtrWriteEntry( p->vEntries, i, pTemp );
+        Vec_PtrWriteEntry( p->vEntries, i-1, pEntry );
+    }
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Prints the archive.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Map_ArchPrint( Map_Arch_t * p, int fVerbose )
+{
+    Map_ArchEntry_t * pEntry;
+    int i, k, nInts = 0;
+    if ( p == NULL || Vec_PtrSize(p->vEntries) == 0 )
+    {
+        printf( "The Pareto archive of mapped networks is empty.\n" );
+        return;
+    }
+    printf( "Pareto archive of \"%s\": %d non-dominated networks out of %d candidates.\n",
+        p->pShell->pName, Vec_PtrSize(p->vEntries), p->nCands );
+    Vec_PtrForEachEntry( Map_ArchEntry_t *, p->vEntries, pEntry, i )
+    {
+        printf( "%3d : Cand = %3d  Delay = %10.2f ps  Area = %12.2f  Gates = %7d",
+            i, pEntry->iCand, pEntry->Delay, pEntry->Area, pEntry->nGates );
+        if ( fVerbose )
+        {
+            printf( "  Params =" );
+            for ( k = 0; k < pEntry->nParams; k++ )
+                printf( " %.3f", pEntry->pParams[k] );
+        }
+        printf( "\n" );
+        nInts += Vec_IntSize(pEntry->vNtk);
+    }
+    if ( fVerbose )
+        printf( "Memory used by the netlists = %.2f MB.\n", 4.0 * nInts / (1<<20) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the mapped network of the given entry.]
+
+  Description [Returns NULL if the library has changed since the
+  archive was created.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Ntk_t * Map_ArchDerive( Map_Arch_t * p, int iEntry )
+{
+    Map_ArchEntry_t * pEntry;
+    Abc_Ntk_t * pNtkNew;
+    Abc_Obj_t * pObj, * pNode;
+    Vec_Ptr_t * vObjs;
+    int * pNtk, nCis, nCos, nNodes, i, k, nFanins;
+    if ( p == NULL || iEntry < 0 || iEntry >= Vec_PtrSize(p->vEntries) )
+        return NULL;
+    if ( Abc_FrameReadLibGen() != p->pLib )
+        return NULL;
+    pEntry = (Map_ArchEntry_t *)Vec_PtrEntry( p->vEntries, iEntry );
+    pNtk   = Vec_IntArray( pEntry->vNtk );
+    nCis   = *pNtk++;
+    nCos   = *pNtk++;
+    nNodes = *pNtk++;
+    pNtkNew = Abc_NtkStartFrom( p->pShell, ABC_NTK_LOGIC, ABC_FUNC_MAP );
+    assert( nCis == Abc_NtkCiNum(pNtkNew) && nCos == Abc_NtkCoNum(pNtkNew) );
+    vObjs = Vec_PtrAlloc( nCis + nNodes );
+    Abc_NtkForEachCi( pNtkNew, pObj, i )
+        Vec_PtrPush( vObjs, pObj );
+    for ( i = 0; i < nNodes; i++ )
+    {
+        pNode = Abc_NtkCreateNode( pNtkNew );
+        pNode->pData = Vec_PtrEntry( p->vGates, *pNtk++ );
+        nFanins = *pNtk++;
+        for ( k = 0; k < nFanins; k++ )
+            Abc_ObjAddFanin( pNode, (Abc_Obj_t *)Vec_PtrEntry(vObjs, *pNtk++) );
+        Vec_PtrPush( vObjs, pNode );
+    }
+    Abc_NtkForEachCo( pNtkNew, pObj, i )
+        Abc_ObjAddFanin( pObj, (Abc_Obj_t *)Vec_PtrEntry(vObjs, *pNtk++) );
+    assert( pNtk == Vec_IntLimit(pEntry->vNtk) );
+    Vec_PtrFree( vObjs );
+    if ( !Abc_NtkCheck( pNtkNew ) )
+    {
+        printf( "Map_ArchDerive: The network check has failed.\n" );
+        Abc_NtkDelete( pNtkNew );
+        return NULL;
+    }
+    return pNtkNew;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
+
@@ -32,8 +32,25 @@ ABC_NAMESPACE_IMPL_START
 typedef struct {
     double* rec_x;          // parameters 
     double rec_y;           // the mapping result wrt the parameters
+    int fidelity;           // the evaluation tier that produced rec_y
 }  ItResults;
 
+// the evaluation tiers (fidelities) of ITMap candidates
+#define MAP_FID_EST     0   // delay and area estimated by the mapper
+#define MAP_FID_STA     1   // NLDM STA of the mapped network
+#define MAP_FID_FULL    2   // buffering, sizing and NLDM STA
+#define MAP_FID_NUM     3
+
+// the multi-fidelity evaluator
+typedef struct {
+    float        FidRatio;               // the fraction of candidates promoted to the next tier
+    int          nEvals[MAP_FID_NUM];    // the number of candidates evaluated at each tier
+    double       Delay0[MAP_FID_NUM];    // the reference delay of each tier
+    double       Area0[MAP_FID_NUM];     // the reference area of each tier
+    Vec_Flt_t *  vScores[MAP_FID_NUM];   // the scores of the candidates seen at each tier
+    abctime      clkTiers[MAP_FID_NUM];  // the runtime spent at each tier
+} Map_ItEval_t;
+
 
 
 ////////////////////////////////////////////////////////////////////////
@@ -786,6 +803,9 @@ int Map_MappingSTA( Map_Man_t * p, Abc_Ntk_t *pNtk, Mio_Library_t *pLib, int fSt
     
 
 
+    if ( p->pItStats )
+        p->pItStats->clkmapTT = p->timeCuts + p->timeTruth;
+
     // print the arrival times of the latest outputs
     if ( p->fVerbose )
         Map_MappingPrintOutputArrivals( p );
@@ -1092,954 +1112,810 @@ int Map_MappingIteratable(Map_Man_t * p, Abc_Ntk_t *pNtk, Mio_Library_t *pLib, i
 */
 
 
-int Map_MappingHeboIt(Map_Man_t * p, Abc_Ntk_t *pNtk, Mio_Library_t *pLib, int fStime,  double DelayTarget, int fUseBuffs, int fGradient)
-{   
-    // the parameters for default `map` operator 
-    int fShowSwitching         = 0;
-    int fUseAreaFlow           = 1;
-    int fUseExactArea          = !p->fSwitching;
-    int fUseExactAreaWithPhase = !p->fSwitching;
-    abctime clk, clk2;
-    abctime clkInitPy = 0, clkIterExp = 0, clkIterBayes = 0, clkDeterPara = 0, clkGradient = 0, clkAreaRecovery = 0, clkDelayMap = 0, clkmapTT = 0, clkSTA = 0 ;
+/**Function*************************************************************
 
-    clk = Abc_Clock();
-    //////////////////////////////////////////////////////////////////////
-    // perform pre-mapping computations
-    if ( p->fVerbose )
-        Map_MappingReportChoices( p );
-    Map_MappingSetChoiceLevels( p ); // should always be called before mapping!
-    //    return 1;
+  Synopsis    [Performs delay-oriented mapping followed by area recovery.]
 
-    // compute the cuts of nodes in the DFS order
-    clk = Abc_Clock();
-    Map_MappingCuts( p );
-    p->timeCuts = Abc_Clock() - clk;
-    // derive the truth tables
-    clk = Abc_Clock();
-    Map_MappingTruths( p );
-    p->timeTruth = Abc_Clock() - clk;
-    //////////////////////////////////////////////////////////////////////
-    clkmapTT = Abc_Clock() - clk;
-      
-    // parameters for iteration 
-    int itera_num = 10;
-    int para_size = 10; 
-    int rec_y_size = 1;
-    p->delayParams = malloc(sizeof(double) * para_size);
-    // some good delay parameters for both delay- and area- oriented mapping  
-    // double goodPara[3][10] = {
-    //     {0.736, 0.144, 0.349, 0.458, 1.025, 0.407, 0.020, 0.889, 1.288, 0.252},
-    //     {0.5, 0.3, 0.1, 0.5, 1.0, 0.3, 0.1, 0.25, 1.0, 0.5},  // Expert Design
-    //     {0.348, 0.061, 0.017, 0.146, 1.832, 0.411, 0.260, 0.050, 1.954, 0.782} // best result for bar
-    // };
-   
-    // double goodPara[4][10] = {
-    //     {0.042, 0.041, 0.261, 0.755, 0.589, 0.189, 0.035, 0.026, 1.836, 0.731},
-    //     {0.139, 0.022, 0.040, 0.174, 1.424, 0.324, 0.298, 0.138, 1.989, 0.631},  // Expert Design
-    //     {0.348, 0.061, 0.017, 0.146, 1.832, 0.411, 0.260, 0.050, 1.954, 0.782},  // best result for bar
-    //     {0.905, 0.243, 0.114, 0.205, 1.363, 0.120, 0.384, 0.780, 1.407, 0.044}
-    //     };
-
-    // cluster center for best parameters  
-    //  {0.53, 0.09, 0.2, 0.53, 1.83, 0.29, 0.28, 0.25, 1.82, 0.63},
-    //  {0.91, 0.15, 0.26, 0.26, 1.46, 0.24, 0.23, 0.33, 0.89, 0.57},
-    //  {0.18, 0.18, 0.28, 0.46, 0.76, 0.24, 0.23, 0.05, 1.69, 0.57},
-    //  {0.77, 0.05, 0.36, 0.08, 1.98, 0.42, 0.03, 0.23, 1.05, 0.99}
-    // cluster center for best parameters 2
-    // {0.23, 0.22, 0.26, 0.45, 0.85, 0.26, 0.28, 0.26, 1.55, 0.33}, 
-    // {0.83, 0.23, 0.26, 0.5 , 1.52, 0.26, 0.25, 0.67, 0.69, 0.67}, 
-    // {0.52, 0.34, 0.26, 0.46, 1.73, 0.25, 0.34, 0.52, 1.63, 0.52}
-    
-    // [0]=0.211, [1]=0.404, [2]=0.448, [3]=0.042, [4]=0.518, [5]=0.488, [6]=0.020, [7]=0.088, [8]=1.929, [9]=0.030, better for bar circuit
-    double goodPara[4][10] = { 
-     {0.23, 0.22, 0.26, 0.45, 0.85, 0.26, 0.28, 0.26, 1.55, 0.33}, 
-     {0.83, 0.23, 0.26, 0.5 , 1.52, 0.26, 0.25, 0.67, 0.69, 0.67}, 
-     {0.52, 0.34, 0.26, 0.46, 1.73, 0.25, 0.34, 0.52, 1.63, 0.52}, 
-     {0.21, 0.40, 0.45, 0.04, 0.52, 0.49, 0.02, 0.08, 1.93, 0.03} 
-     }; 
-    int good_itera_num = 4; 
-    
-    // // worse parameters
-    // double goodPara[3][10] = { 
-    //      {0.736, 0.144, 0.349, 0.458, 1.025, 0.407, 0.020, 0.889, 1.288, 0.252},
-    //      {0.5, 0.3, 0.1, 0.5, 1.0, 0.3, 0.1, 0.25, 1.0, 0.5},
-    //      {0.348, 0.061, 0.017, 0.146, 1.832, 0.411, 0.260, 0.050, 1.954, 0.782} 
-    //     }; 
-    // int good_itera_num = 3; 
-    
+  Description [Uses the delay parameters currently stored in p->delayParams.
+  Returns the depth estimated by the mapper in pEstDepth. The runtime of
+  the delay-oriented pass is accumulated in pTimeDelay.]
 
-    // for recording the delay parameters and the corresponding delay
-    double * rec_x = (double *)malloc(para_size * sizeof(double));
-    double * rec_y = (double *)malloc(rec_y_size * sizeof(double));
-    memset(rec_x, 0, para_size * sizeof(double));
-    memset(rec_y, 0, rec_y_size * sizeof(double));
+  SideEffects []
 
-    clk = Abc_Clock();
-    // parameters for recording the best results
-    ItResults* itRes = (ItResults*)malloc((itera_num+ good_itera_num) * sizeof(ItResults));
-    double min_Y = MAP_FLOAT_LARGE;
-    double *min_rec_x = NULL; 
-     
-    // parameters for iteration parameters
-    double firstDelay = 0.0, firstArea = 0.0, firstLevel = 0.0, firstGate = 0.0, firstEdge = 0.0; 
-    double curDelay = 0.0, curArea = 0.0, curLevel = 0.0, curGate = 0.0, curEdge = 0.0;
-  
-    // PyRun_SimpleString("import sys; import os; sys.path.append(os.getcwd());");
-    PyRun_SimpleString("import sys;");
-    PyRun_SimpleString("sys.path.append('/home/liujunfeng/ABC/abc_itmap/abc-itmap/src/map/mapper/')");
-    
+  SeeAlso     []
 
-    PyObject* pModule = NULL;
-    PyObject* pFuncInit = NULL, *pFuncIterate = NULL;
-      
-    pModule = PyImport_ImportModule("hebo_opt");
-    if (!pModule) {
-        printf("can't find hebo_opt.py\n");
-        Py_Finalize();
-        return 1;
-    } 
-    pFuncInit = PyObject_GetAttrString(pModule, "init_opt");
-    if (!pFuncInit) {
-        printf("can't find function init_opt\n");
-        Py_DECREF(pModule);
-        Py_Finalize();
-        return 1;
-    }
-    pFuncIterate = PyObject_GetAttrString(pModule, "iterate_opt");
-    if (!pFuncIterate) {
-        printf("can't find function iterate_opt\n");
-        Py_DECREF(pFuncInit);
-        Py_DECREF(pModule);
-        Py_Finalize();
-        return 1;
-    }
+***********************************************************************/
+static int Map_MappingPerformIt( Map_Man_t * p, double * pEstDepth, abctime * pTimeDelay )
+{
+    abctime clk = Abc_Clock();
+    // compute the delay-oriented mapping
+    p->fMappingMode = 0;
+    if ( !Map_MappingMatches2( p, pEstDepth ) )
+        return 0;
+    p->timeMatch = Abc_Clock() - clk;
+    // compute the references and collect the nodes used in the mapping
+    Map_MappingSetRefs( p );
+    if ( pTimeDelay )
+        *pTimeDelay += Abc_Clock() - clk;
 
-    PyObject* pOpt = PyObject_CallObject(pFuncInit, NULL);
-    if (!pOpt) {
-        printf("init_opt failed to initialize\n");
-        Py_DECREF(pFuncIterate);
-        Py_DECREF(pFuncInit);
-        Py_DECREF(pModule);
-        Py_Finalize();
-        return 1;
-    }
-    clkInitPy = Abc_Clock() - clk;
-    
-    clk = Abc_Clock();
-    /////////////////////////////////////////////////////////////////////////////////////////////////////// 
-    // init samples using some ``good delay parameters''
-    for (int i = 0; i < good_itera_num; i++ ) {
-        // update the parameters for p->delayParas
-        for (int j = 0; j < para_size; j++)  p->delayParams[j] = goodPara[i][j];
+    // perform area recovery using area flow
+    Map_TimeComputeRequiredGlobal( p );
+    p->fMappingMode = 1;
+    Map_MappingMatches( p );
+    Map_MappingSetRefs( p );
+    p->AreaFinal = Map_MappingGetArea( p );
 
-        double estDepth = 0.0; 
+    // perform area recovery using exact area
+    Map_TimeComputeRequiredGlobal( p );
+    p->fMappingMode = 2;
+    Map_MappingMatches( p );
+    Map_MappingSetRefs( p );
+    p->AreaFinal = Map_MappingGetArea( p );
 
-        ////////////////////////////////////////////////////////////////////// 
-        clk = Abc_Clock();
-        p->fMappingMode = 0;
-        if ( !Map_MappingMatches2( p, &estDepth) )
-            return 0;
-        p->timeMatch = Abc_Clock() - clk;
-        // compute the references and collect the nodes used in the mapping
-        Map_MappingSetRefs( p ); 
-        //////////////////////////////////////////////////////////////////////
-   
-        /* area oriented mapping.  */
-        //////////////////////////////////////////////////////////////////////
-        // perform area recovery using area flow 
-        // compute the required times
-        Map_TimeComputeRequiredGlobal( p );
-        // recover area flow
-        p->fMappingMode = 1;
-        Map_MappingMatches( p );
-        // compute the references and collect the nodes used in the mapping
-        Map_MappingSetRefs( p );
-        p->AreaFinal = Map_MappingGetArea( p );
- 
+    // perform area recovery using exact area with phase
+    Map_TimeComputeRequiredGlobal( p );
+    p->fMappingMode = 3;
+    Map_MappingMatches( p );
+    Map_MappingSetRefs( p );
+    p->AreaFinal = Map_MappingGetArea( p );
+    return 1;
+}
 
-        //////////////////////////////////////////////////////////////////////
-        // perform area recovery using exact area 
-        // compute the required times
-        Map_TimeComputeRequiredGlobal( p );
-        // recover area
-        p->fMappingMode = 2;
-        Map_MappingMatches( p );
-        // compute the references and collect the nodes used in the mapping
-        Map_MappingSetRefs( p );
-        p->AreaFinal = Map_MappingGetArea( p );
+/**Function*************************************************************
 
-        //////////////////////////////////////////////////////////////////////
+  Synopsis    [Cleans the best matches before mapping with new parameters.]
 
-        //////////////////////////////////////////////////////////////////////
-        // perform area recovery using exact area
-        // compute the required times
-        Map_TimeComputeRequiredGlobal( p );
-        // recover area
-        p->fMappingMode = 3;
-        Map_MappingMatches( p );
-        // compute the references and collect the nodes used in the mapping
-        Map_MappingSetRefs( p );
-        p->AreaFinal = Map_MappingGetArea( p );
-        //////////////////////////////////////////////////////////////////////
-       
-        clk = Abc_Clock();
-        // 1. construct the mapped network, and store the mapped ID in Abc_obj_t
-        extern Abc_Ntk_t *  Abc_NtkFromMap( Map_Man_t * pMan, Abc_Ntk_t * pNtk, int fUseBuffs );
-        Abc_Ntk_t* pNtkMapped = Abc_NtkFromMap(p, pNtk, fUseBuffs || (DelayTarget == (double)ABC_INFINITY) );
-        if ( Mio_LibraryHasProfile(pLib) )
-                Mio_LibraryTransferProfile2( (Mio_Library_t *)Abc_FrameReadLibGen(), pLib );
-        // Map_ManFree( p );
-        if ( pNtkMapped == NULL )
-            return 1;
+  Description [Returns 0 if a node without non-trivial cuts is found.]
 
-        if ( pNtk->pExdc )
-            pNtkMapped->pExdc = Abc_NtkDup( pNtk->pExdc );
-        // make sure that everything is okay
-        if ( !Abc_NtkCheck( pNtkMapped ) )
-        {
-            printf( "Abc_NtkMap: The network check has failed.\n" );
-            Abc_NtkDelete( pNtkMapped );
-            return 1;
-        }
-         
-        // 2. execute topo command
-        if ( pNtkMapped == NULL )
-        {
-            Abc_Print( -1, "Empty network.\n" );
-            return 1;
-        }
-        if ( !Abc_NtkIsLogic(pNtkMapped) )
-        {
-            Abc_Print( -1, "This command can only be applied to a logic network.\n" );
-            return 1;
-        }
-        // modify the current network
-        Abc_Ntk_t* pNtkTopoed  = Abc_NtkDupDfs( pNtkMapped );
-        if ( pNtkTopoed == NULL )
-        {
-            Abc_Print( -1, "The command has failed.\n" );
-            return 1;
-        }
-        
-        /*// 3. perform Buffer   */
-        SC_BusPars Pars, * pPars = &Pars;
-        Abc_Ntk_t * pNtkResBuf; 
-        memset( pPars, 0, sizeof(SC_BusPars) );
-        pPars->GainRatio     =  300;
-        pPars->Slew          =  Abc_SclComputeAverageSlew(Abc_FrameReadLibScl());
-        pPars->nDegree       =   10;
-        pPars->fSizeOnly     =    0;
-        pPars->fAddBufs      =    1;
-        pPars->fBufPis       =    0;
-        pPars->fUseWireLoads =    0;
-        pPars->fVerbose      =    0;
-        pPars->fVeryVerbose  =    0;
-        pNtkResBuf = Abc_SclBufferingPerform( pNtkTopoed, Abc_FrameReadLibScl(), pPars );
+  SideEffects []
 
-        {
-        // upsize;
-        SC_SizePars Pars, * pPars = &Pars; 
-        memset( pPars, 0, sizeof(SC_SizePars) );
-        pPars->nIters        = 1000;
-        pPars->nIterNoChange =   50;
-        pPars->Window        =    1;
-        pPars->Ratio         =   10;
-        pPars->Notches       = 1000;
-        pPars->DelayUser     =    0;
-        pPars->DelayGap      =    0;
-        pPars->TimeOut       =    0;
-        pPars->BuffTreeEst   =    0;
-        pPars->BypassFreq    =    0;
-        pPars->fUseDept      =    1;
-        pPars->fUseWireLoads =    0;
-        pPars->fDumpStats    =    0;
-        pPars->fVerbose      =    0;
-        pPars->fVeryVerbose  =    0;
-        Abc_SclUpsizePerform(Abc_FrameReadLibScl(), pNtkResBuf, pPars);
-
-        // dnsize; 
-        pPars->nIters        =    5;
-        pPars->nIterNoChange =   50;
-        pPars->Notches       = 1000;
-        pPars->DelayUser     =    0;
-        pPars->DelayGap      = 1000;
-        pPars->TimeOut       =    0;
-        pPars->BuffTreeEst   =    0;
-        pPars->fUseDept      =    1;
-        pPars->fUseWireLoads =    0;
-        pPars->fDumpStats    =    0;
-        pPars->fVerbose      =    0;
-        pPars->fVeryVerbose  =    0;
-        Abc_SclDnsizePerform(Abc_FrameReadLibScl(), pNtkResBuf, pPars);
-        }
-       
+  SeeAlso     []
 
-        // 4. perform STA   pNtkTopoed   pNtkResBuf
-        int fShowAll      = 0;
-        int fUseWireLoads = 0;
-        int fPrintPath    = 0;
-        int fDumpStats    = 0;
-        int nTreeCRatio   = 0;
-        if ( !Abc_NtkHasMapping(pNtkResBuf) )
-        {
-            Abc_Print(-1, "The current network is not mapped.\n" );
-            return 1;
-        }
-        if ( !Abc_SclCheckNtk(pNtkResBuf, 0) )
+***********************************************************************/
+static int Map_MappingResetMatches( Map_Man_t * p )
+{
+    Map_Node_t * pNode;
+    Map_Cut_t * pCut;
+    Map_Match_t * pMatch;
+    int i, fPhase;
+    p->nMatches = 0;
+    p->nPhases = 0;
+    for ( i = 0; i < p->vMapObjs->nSize; i++ )
+    {
+        pNode = p->vMapObjs->pArray[i];
+        // clear the references
+        pNode->nRefAct[0] = pNode->nRefAct[1] = pNode->nRefAct[2] = 0;
+        pNode->nRefEst[0] = pNode->nRefEst[1] = pNode->nRefEst[2] = 0;
+        // clear the arrival and required times
+        for ( fPhase = 0; fPhase < 2; fPhase++ )
         {
-            Abc_Print(-1, "The current network is not in a topo order (run \"topo\").\n" );
-            return 1;
+            pNode->tArrival[fPhase].Rise   = 0.0;
+            pNode->tArrival[fPhase].Fall   = 0.0;
+            pNode->tArrival[fPhase].Worst  = 0.0;
+            pNode->tRequired[fPhase].Rise  = MAP_FLOAT_LARGE;
+            pNode->tRequired[fPhase].Fall  = MAP_FLOAT_LARGE;
+            pNode->tRequired[fPhase].Worst = MAP_FLOAT_LARGE;
         }
-        if ( Abc_FrameReadLibScl() == NULL )
+        if ( Map_NodeIsBuf(pNode) )
         {
-            Abc_Print(-1, "There is no Liberty library available.\n" );
-            return 1;
-        }
-        printf("####    NLDM (%d)", i);
-        extern void Abc_SclTimePerform( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats );
-        Abc_SclTimePerform( Abc_FrameReadLibScl(), pNtkResBuf, nTreeCRatio, fUseWireLoads, fShowAll, fPrintPath, fDumpStats );
-        
-        
-        
-        curDelay = pNtkResBuf ->MaxDelay;
-        curArea = pNtkResBuf ->SumArea; 
-        // curArea = Abc_SclGetTotalArea(pNtkResBuf);      //  // curArea = Map_MappingGetArea( p );
-        curLevel = Abc_NtkLevel(pNtkResBuf);
-        curGate = Abc_NtkGetLargeNodeNum(pNtkResBuf);
-        curEdge = Abc_NtkGetTotalFanins(pNtkResBuf);
-
-        if ( i == 0) {
-            firstDelay = curDelay; 
-            firstArea = curArea;
-            firstLevel = curLevel;
-            firstGate = curGate;
-            firstEdge  = curEdge;
+            assert( pNode->p2 == NULL );
+            pNode->tArrival[0] = Map_Regular(pNode->p1)->tArrival[ Map_IsComplement(pNode->p1)];
+            pNode->tArrival[1] = Map_Regular(pNode->p1)->tArrival[!Map_IsComplement(pNode->p1)];
+            continue;
         }
-        float gapDepth = 0.0;  
-        if (curDelay > estDepth)
-            gapDepth = estDepth/ curDelay;
-        else 
-            gapDepth = curDelay/estDepth; 
-
-        // rec_y[0] = curLevel/firstLevel;
-        rec_y[0] = curDelay/firstDelay + curArea/firstArea; 
-        // rec_y[0] = curDelay/firstDelay + curArea/firstArea + curLevel/firstLevel + curGate/firstGate + curEdge/firstEdge;
-        printf("#### Heuristic (%d) Delay = %.3f, Depth = %.3f, Level = %.1f, Edge = %.1f, Area = %.3f, Gate = %.1f, Objective = %.3f \n", i, curDelay, estDepth, curLevel, curEdge, curArea, curGate,  rec_y[0]);
-  
-        double* tmpParas = (double*)malloc(para_size * sizeof(double)); 
-        memcpy(tmpParas, p->delayParams, para_size * sizeof(double));
-        itRes[i].rec_x = tmpParas;
-        itRes[i].rec_y = rec_y[0];
+        // skip primary inputs and secondary nodes if mapping with choices
+        if ( !Map_NodeIsAnd( pNode ) || pNode->pRepr )
+            continue;
+        // make sure that at least one non-trival cut is present
+        if ( pNode->pCuts->pNext == NULL )
+            return 0;
+        pNode->pCutBest[0] = NULL;
+        pNode->pCutBest[1] = NULL;
+        // clean the node matches
+        for ( pCut = pNode->pCuts->pNext; pCut; pCut = pCut->pNext )
+            for ( fPhase = 0; fPhase < 2; fPhase++ )
+            {
+                pMatch = pCut->M + fPhase;
+                pMatch->pSuperBest    = NULL;
+                pMatch->tArrive.Rise  = MAP_FLOAT_LARGE;
+                pMatch->tArrive.Fall  = MAP_FLOAT_LARGE;
+                pMatch->tArrive.Worst = MAP_FLOAT_LARGE;
+                pMatch->AreaFlow      = MAP_FLOAT_LARGE;
+            }
+    }
+    return 1;
+}
 
-        if (itRes[i].rec_y < min_Y) {
-            // record better delay parameters and its results
-            min_Y = itRes[i].rec_y;
-            min_rec_x = itRes[i].rec_x; 
-        }
+/**Function*************************************************************
 
-        // 4. clean best matches of the mapped network
-        if (i  <= good_itera_num - 1) {
-            Map_Node_t * pNode;
-            Map_Cut_t * pCut;
-            p->nMatches = 0; 
-            p->nPhases = 0;
+  Synopsis    [Derives the mapped network and performs NLDM STA on it.]
 
-            // recovery matching state. 
-            for (int j = 0; j < p->vMapObjs->nSize; j++ ) { 
-                pNode = p->vMapObjs->pArray[j];
-                // clear the references
-                pNode->nRefAct[0] = pNode->nRefAct[1] = pNode->nRefAct[2] = 0;
-                pNode->nRefEst[0] = pNode->nRefEst[1] = pNode->nRefEst[2] = 0;
-                // clear the arrival times
-                pNode->tArrival[0].Rise = 0.0;
-                pNode->tArrival[0].Fall = 0.0;
-                pNode->tArrival[0].Worst = 0.0; 
-                pNode->tArrival[1].Rise = 0.0;
-                pNode->tArrival[1].Fall = 0.0;
-                pNode->tArrival[1].Worst = 0.0; 
+  Description [If fSizing is set, buffering, upsizing and downsizing are
+  performed before STA. Returns the timed network, which should be deleted
+  by the caller, or NULL if the network cannot be derived.]
 
-                // clear the required times
-                pNode->tRequired[0].Rise =  MAP_FLOAT_LARGE;
-                pNode->tRequired[0].Fall = MAP_FLOAT_LARGE;
-                pNode->tRequired[0].Worst =  MAP_FLOAT_LARGE; 
-                pNode->tRequired[1].Rise =  MAP_FLOAT_LARGE;
-                pNode->tRequired[1].Fall =  MAP_FLOAT_LARGE;
-                pNode->tRequired[1].Worst =  MAP_FLOAT_LARGE;
-                 
-                if ( Map_NodeIsBuf(pNode) )
-                {
-                    assert( pNode->p2 == NULL );
-                    pNode->tArrival[0] = Map_Regular(pNode->p1)->tArrival[ Map_IsComplement(pNode->p1)];
-                    pNode->tArrival[1] = Map_Regular(pNode->p1)->tArrival[!Map_IsComplement(pNode->p1)];
-                    continue;
-                }
+  SideEffects []
 
-                // // skip primary inputs and secondary nodes if mapping with choices
-                if ( !Map_NodeIsAnd( pNode ) || pNode->pRepr ){
-                    continue;
-                }
-                     
-                // make sure that at least one non-trival cut is present
-                if ( pNode->pCuts->pNext == NULL )
-                {
-                    // Extra_ProgressBarStop( pProgress );
-                    return 0;
-                }
+  SeeAlso     []
 
-                pNode->pCutBest[0] = NULL;
-                pNode->pCutBest[1] = NULL; 
+***********************************************************************/
+static Abc_Ntk_t * Map_MappingDeriveTimed( Map_Man_t * p, Abc_Ntk_t * pNtk, Mio_Library_t * pLib, double DelayTarget, int fUseBuffs, int fSizing, int iIter )
+{
+    extern Abc_Ntk_t * Abc_NtkFromMap( Map_Man_t * pMan, Abc_Ntk_t * pNtk, int fUseBuffs );
+    extern void Abc_SclTimePerform( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats );
+    SC_Lib * pLibScl = (SC_Lib *)Abc_FrameReadLibScl();
+    Abc_Ntk_t * pNtkMapped, * pNtkTopoed, * pNtkRes;
+
+    // construct the mapped network, and store the mapped ID in Abc_Obj_t
+    pNtkMapped = Abc_NtkFromMap( p, pNtk, fUseBuffs || (DelayTarget == (double)ABC_INFINITY) );
+    if ( Mio_LibraryHasProfile(pLib) )
+        Mio_LibraryTransferProfile2( (Mio_Library_t *)Abc_FrameReadLibGen(), pLib );
+    if ( pNtkMapped == NULL )
+        return NULL;
+    if ( !Abc_NtkCheck( pNtkMapped ) )
+    {
+        printf( "Abc_NtkMap: The network check has failed.\n" );
+        Abc_NtkDelete( pNtkMapped );
+        return NULL;
+    }
+    // put the network in a topological order
+    pNtkTopoed = Abc_NtkDupDfs( pNtkMapped );
+    Abc_NtkDelete( pNtkMapped );
+    if ( pNtkTopoed == NULL )
+    {
+        Abc_Print( -1, "The command has failed.\n" );
+        return NULL;
+    }
 
-                // clean the node matches   
-                for ( pCut = pNode->pCuts->pNext; pCut; pCut = pCut->pNext ) { 
-                    Map_Match_t * pMatch =  pCut->M + 0;
-                    if (pMatch->pSuperBest) {
-                        pMatch->pSuperBest = NULL; 
-                    }
-                    pMatch->tArrive.Rise = MAP_FLOAT_LARGE;
-                    pMatch->tArrive.Fall = MAP_FLOAT_LARGE;
-                    pMatch->tArrive.Worst = MAP_FLOAT_LARGE;
-                    pMatch->AreaFlow = MAP_FLOAT_LARGE;
-                    // pMatch->uPhaseBest = 286331153; 
-                      
-                    pMatch =  pCut->M + 1;
-                    if (pMatch->pSuperBest) {
-                        pMatch->pSuperBest = NULL;
-                    }
-                    pMatch->tArrive.Rise = MAP_FLOAT_LARGE;
-                    pMatch->tArrive.Fall = MAP_FLOAT_LARGE;
-                    pMatch->tArrive.Worst = MAP_FLOAT_LARGE;
-                    pMatch->AreaFlow = MAP_FLOAT_LARGE; 
-                    // pMatch->uPhaseBest = 286331153; 
-                } 
-            }
-        } 
- 
-        clkSTA += Abc_Clock() - clk;
-        // create args for iterate_opt: 
-        // def iterate_opt(opt, i_iter,  given_rec_x : List[float], given_rec_y : List[float]):
-
-        // 1. the first one: opt
-        PyObject* pArgs = PyTuple_New(4);
-        PyTuple_SetItem(pArgs, 0, pOpt);  
-        Py_INCREF(pOpt); // Increase ref count because PyTuple_SetItem steals a reference
-        
-        // 2. the second one: iteration number -1 stands for only calling opt.oberserve
-        PyTuple_SetItem(pArgs, 1, Py_BuildValue("i", -1)); 
-        
-        // 3. the third one: rec_x
-        PyObject* pListX = PyList_New(para_size); 
-        for (int j = 0; j < para_size; j++) 
-            PyList_SetItem(pListX, j, PyFloat_FromDouble(p->delayParams[j]));
-        PyTuple_SetItem(pArgs, 2, pListX);
-
-        // 4. the fourth one: rec_y
-        PyObject* pListY = PyList_New(rec_y_size);
-        PyList_SetItem(pListY, 0, PyFloat_FromDouble(rec_y[0]));
-        PyTuple_SetItem(pArgs, 3, pListY);
-
-        PyObject* pReturn = PyObject_CallObject(pFuncIterate, pArgs);
-        Py_DECREF(pArgs); // Decrease ref count after calling the function
-        Py_DECREF(pListX);
-        Py_DECREF(pListY);
-
-        // parse the return values 
-        if (pReturn != NULL && PyTuple_Check(pReturn)) {
-            PyObject* pNewOpt;
-            PyObject* pNewListX;
-            if (PyArg_ParseTuple(pReturn, "OO", &pNewOpt, &pNewListX)) {
-                Py_INCREF(pNewOpt); // ParseTuple does not increase ref count
-                Py_DECREF(pOpt); // Replace the old opt object
-                pOpt = pNewOpt; 
-            } else {
-                printf("Failed to parse return value\n");
-            }
+    if ( fSizing )
+    {
+        SC_BusPars BusPars, * pBusPars = &BusPars;
+        SC_SizePars SizePars, * pSizePars = &SizePars;
+        // perform buffering
+        memset( pBusPars, 0, sizeof(SC_BusPars) );
+        pBusPars->GainRatio     =  300;
+        pBusPars->Slew          =  Abc_SclComputeAverageSlew( pLibScl );
+        pBusPars->nDegree       =   10;
+        pBusPars->fSizeOnly     =    0;
+        pBusPars->fAddBufs      =    1;
+        pBusPars->fBufPis       =    0;
+        pBusPars->fUseWireLoads =    0;
+        pBusPars->fVerbose      =    0;
+        pBusPars->fVeryVerbose  =    0;
+        pNtkRes = Abc_SclBufferingPerform( pNtkTopoed, pLibScl, pBusPars );
+        Abc_NtkDelete( pNtkTopoed );
+        if ( pNtkRes == NULL )
+        {
+            Abc_Print( -1, "The current network is not in a topo order (run \"topo\").\n" );
+            return NULL;
+        }
+        // perform upsizing
+        memset( pSizePars, 0, sizeof(SC_SizePars) );
+        pSizePars->nIters        = 1000;
+        pSizePars->nIterNoChange =   50;
+        pSizePars->Window        =    1;
+        pSizePars->Ratio         =   10;
+        pSizePars->Notches       = 1000;
+        pSizePars->DelayUser     =    0;
+        pSizePars->DelayGap      =    0;
+        pSizePars->TimeOut       =    0;
+        pSizePars->BuffTreeEst   =    0;
+        pSizePars->BypassFreq    =    0;
+        pSizePars->fUseDept      =    1;
+        pSizePars->fUseWireLoads =    0;
+        pSizePars->fDumpStats    =    0;
+        pSizePars->fVerbose      =    0;
+        pSizePars->fVeryVerbose  =    0;
+        Abc_SclUpsizePerform( pLibScl, pNtkRes, pSizePars );
+        // perform downsizing
+        pSizePars->nIters        =    5;
+        pSizePars->nIterNoChange =   50;
+        pSizePars->Notches       = 1000;
+        pSizePars->DelayUser     =    0;
+        pSizePars->DelayGap      = 1000;
+        Abc_SclDnsizePerform( pLibScl, pNtkRes, pSizePars );
+    }
+    else
+        pNtkRes = pNtkTopoed;
 
-            Py_DECREF(pReturn);
+    // perform STA
+    if ( !Abc_NtkHasMapping(pNtkRes) )
+    {
+        Abc_Print( -1, "The current network is not mapped.\n" );
+        Abc_NtkDelete( pNtkRes );
+        return NULL;
+    }
+    if ( !Abc_SclCheckNtk(pNtkRes, 0) )
+    {
+        Abc_Print( -1, "The current network is not in a topo order (run \"topo\").\n" );
+        Abc_NtkDelete( pNtkRes );
+        return NULL;
+    }
+    printf( "####    NLDM (%d)", iIter );
+    Abc_SclTimePerform( pLibScl, pNtkRes, 0, 0, 0, 0, 0 );
+    return pNtkRes;
+}
 
-        } else {
-            printf("Function call failed or returned NULL\n");
-        }
+/**Function*************************************************************
+
+  Synopsis    [Computes the normalized objective of one evaluation tier.]
+
+  Description [The first candidate evaluated at a tier becomes the
+  reference point for the delay and area of this tier.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static double Map_ItEvalScore( Map_ItEval_t * p, int Tier, double Delay, double Area )
+{
+    if ( p->nEvals[Tier]++ == 0 )
+    {
+        p->Delay0[Tier] = Delay;
+        p->Area0[Tier]  = Area;
     }
-    ///////////////////////////////////////////////////////////////////////////////////////////////////////
+    return Delay / p->Delay0[Tier] + Area / p->Area0[Tier];
+}
 
-    clkIterExp = Abc_Clock() - clk;
+/**Function*************************************************************
 
-    clk = Abc_Clock();
-    ///////////////////////////////////////////////////////////////////////////////////////////////////////
-    memset(rec_x, 0, para_size * sizeof(double));
-    memset(rec_y, 0, rec_y_size * sizeof(double));
-    // fit models using GP Kernel 
-    for (int i = 0; i <  itera_num; i ++ ) {
-        // create args for iterate_opt: 
-        // def iterate_opt(opt, i_iter,  given_rec_x : List[float], given_rec_y : List[float]):
-        clk2 = Abc_Clock();
-        // 1. the first one: opt
-        PyObject* pArgs = PyTuple_New(4);
-        PyTuple_SetItem(pArgs, 0, pOpt);  
-        Py_INCREF(pOpt); // Increase ref count because PyTuple_SetItem steals a reference
-        
-        // 2. the second one: iteration number
-        PyTuple_SetItem(pArgs, 1, Py_BuildValue("i", i)); 
-        
-        // 3. the third one: rec_x
-        PyObject* pListX = PyList_New(para_size); 
-        for (int j = 0; j < para_size; j++) 
-            PyList_SetItem(pListX, j, PyFloat_FromDouble(rec_x[j]));
-        PyTuple_SetItem(pArgs, 2, pListX);
-
-        // 4. the fourth one: rec_y
-        PyObject* pListY = PyList_New(rec_y_size);
-        PyList_SetItem(pListY, 0, PyFloat_FromDouble(rec_y[0]));
-        PyTuple_SetItem(pArgs, 3, pListY);
-
-        PyObject* pReturn = PyObject_CallObject(pFuncIterate, pArgs);
-        Py_DECREF(pArgs); // Decrease ref count after calling the function
-        Py_DECREF(pListX);
-        Py_DECREF(pListY);
-
-        // parse the return values 
-        printf("#### Parameters(%d) ", i);
-        if (pReturn != NULL && PyTuple_Check(pReturn)) {
-            PyObject* pNewOpt;
-            PyObject* pNewListX;
-            if (PyArg_ParseTuple(pReturn, "OO", &pNewOpt, &pNewListX)) {
-                Py_INCREF(pNewOpt); // ParseTuple does not increase ref count
-                Py_DECREF(pOpt); // Replace the old opt object
-                pOpt = pNewOpt;
-                
-                int x_size = PyList_Size(pNewListX);
-                if (x_size == para_size) {
-                    for (int k = 0; k < x_size; k++) {
-                        PyObject* pItem = PyList_GetItem(pNewListX, k); // Borrowed reference, no need to DECREF
-                        if (PyFloat_Check(pItem)) {
-                            rec_x[k] = PyFloat_AsDouble(pItem);
-                            printf("[%d]=%.3f, ", k, rec_x[k]);
-                        } else {
-                            printf("List item is not a float!\n");
-                        }
-                    }
-                } else {
-                    printf("Returned list size does not match expected size\n");
-                }
-                printf("\n");
-            } else {
-                printf("Failed to parse return value\n");
-            }
+  Synopsis    [Returns 1 if the candidate should be promoted to the next tier.]
 
-            Py_DECREF(pReturn);
+  Description [The candidate is promoted if its score is in the top
+  fraction (p->FidRatio) of the scores seen at this tier so far.]
 
-        } else {
-            printf("Function call failed or returned NULL\n");
-        }
-        // update the parameters for p->delayParas
-        for (int j = 0; j < para_size; j++) p->delayParams[j] = rec_x[j];
-        
-        clkDeterPara += Abc_Clock() - clk2;
+  SideEffects []
 
-        double estDepth = 0.0; 
+  SeeAlso     []
 
-        ////////////////////////////////////////////////////////////////////// 
-        clk = Abc_Clock();
-        p->fMappingMode = 0;
-        if ( !Map_MappingMatches2( p, &estDepth) )
-            return 0;
-        p->timeMatch = Abc_Clock() - clk;
-        // compute the references and collect the nodes used in the mapping
-        Map_MappingSetRefs( p );
-        clkDelayMap += Abc_Clock() - clk;
-        //////////////////////////////////////////////////////////////////////
+***********************************************************************/
+static int Map_ItEvalPromote( Map_ItEval_t * p, int Tier, double Score )
+{
+    float Entry;
+    int i, nBetter = 0;
+    Vec_FltForEachEntry( p->vScores[Tier], Entry, i )
+        nBetter += (Entry < Score);
+    Vec_FltPush( p->vScores[Tier], (float)Score );
+    return nBetter < (int)ceil( p->FidRatio * Vec_FltSize(p->vScores[Tier]) );
+}
 
-        /* area oriented mapping. */
-        //////////////////////////////////////////////////////////////////////
-        // perform area recovery using area flow 
-        // compute the required times
-        Map_TimeComputeRequiredGlobal( p );
-        // recover area flow
-        p->fMappingMode = 1;
-        Map_MappingMatches( p );
-        // compute the references and collect the nodes used in the mapping
-        Map_MappingSetRefs( p );
-        p->AreaFinal = Map_MappingGetArea( p );
- 
+/**Function*************************************************************
 
-        //////////////////////////////////////////////////////////////////////
-        // perform area recovery using exact area 
-        // compute the required times
-        Map_TimeComputeRequiredGlobal( p );
-        // recover area
-        p->fMappingMode = 2;
-        Map_MappingMatches( p );
-        // compute the references and collect the nodes used in the mapping
-        Map_MappingSetRefs( p );
-        p->AreaFinal = Map_MappingGetArea( p );
+  Synopsis    [Evaluates the current mapping using the tiered oracles.]
 
-        //////////////////////////////////////////////////////////////////////
+  Description [Without multi-fidelity evaluation, only the full flow
+  (buffering, sizing, STA) is used. Otherwise, the candidate is first
+  scored by the mapper's own estimates, then by STA without sizing, and
+  only the candidates in the top fraction of each tier are promoted.
+  Returns the fully evaluated network if the top tier was reached (to be
+  deleted by the caller), or NULL otherwise. The score and the tier that
+  produced it are returned in pScore and pFidelity. The fidelity is -1
+  if the evaluation has failed.]
 
-        //////////////////////////////////////////////////////////////////////
-        // perform area recovery using exact area
-        // compute the required times
-        Map_TimeComputeRequiredGlobal( p );
-        // recover area
-        p->fMappingMode = 3;
-        Map_MappingMatches( p );
-        // compute the references and collect the nodes used in the mapping
-        Map_MappingSetRefs( p );
-        p->AreaFinal = Map_MappingGetArea( p );
-        //////////////////////////////////////////////////////////////////////
-        
-        abctime clk_t2 = Abc_Clock();
-        // 1. construct the mapped network, and store the mapped ID in Abc_obj_t
-        extern Abc_Ntk_t *  Abc_NtkFromMap( Map_Man_t * pMan, Abc_Ntk_t * pNtk, int fUseBuffs );
-        Abc_Ntk_t* pNtkMapped = Abc_NtkFromMap(p, pNtk, fUseBuffs || (DelayTarget == (double)ABC_INFINITY) );
-        if ( Mio_LibraryHasProfile(pLib) )
-                Mio_LibraryTransferProfile2( (Mio_Library_t *)Abc_FrameReadLibGen(), pLib );
-        // Map_ManFree( p );
-        if ( pNtkMapped == NULL )
-            return 1;
+  SideEffects []
 
-        if ( pNtk->pExdc )
-            pNtkMapped->pExdc = Abc_NtkDup( pNtk->pExdc );
-        // make sure that everything is okay
-        if ( !Abc_NtkCheck( pNtkMapped ) )
-        {
-            printf( "Abc_NtkMap: The network check has failed.\n" );
-            Abc_NtkDelete( pNtkMapped );
-            return 1;
-        }
-         
-        // 2. execute topo command
-        if ( pNtkMapped == NULL )
-        {
-            Abc_Print( -1, "Empty network.\n" );
-            return 1;
-        }
-        if ( !Abc_NtkIsLogic(pNtkMapped) )
-        {
-            Abc_Print( -1, "This command can only be applied to a logic network.\n" );
-            return 1;
-        }
-        // modify the current network
-        Abc_Ntk_t* pNtkTopoed  = Abc_NtkDupDfs( pNtkMapped );
-        if ( pNtkTopoed == NULL )
+  SeeAlso     []
+
+***********************************************************************/
+static Abc_Ntk_t * Map_MappingItEvaluate( Map_Man_t * p, Map_ItEval_t * pEval, Abc_Ntk_t * pNtk, Mio_Library_t * pLib, double DelayTarget, int fUseBuffs, int iIter, double EstDepth, double * pScore, int * pFidelity )
+{
+    Abc_Ntk_t * pNtkRes;
+    abctime clk;
+    *pFidelity = -1;
+    if ( pEval->FidRatio > 0.0 && pEval->FidRatio < 1.0 )
+    {
+        // tier 0: the delay and area estimated by the mapper
+        *pScore = Map_ItEvalScore( pEval, MAP_FID_EST, EstDepth, p->AreaFinal );
+        *pFidelity = MAP_FID_EST;
+        if ( !Map_ItEvalPromote( pEval, MAP_FID_EST, *pScore ) )
+            return NULL;
+        // tier 1: STA of the mapped network without sizing
+        clk = Abc_Clock();
+        pNtkRes = Map_MappingDeriveTimed( p, pNtk, pLib, DelayTarget, fUseBuffs, 0, iIter );
+        if ( pNtkRes == NULL )
         {
-            Abc_Print( -1, "The command has failed.\n" );
-            return 1;
+            *pFidelity = -1;
+            return NULL;
         }
-        
-        /*
-        // 3. perform Buffer*/
-        SC_BusPars Pars, * pPars = &Pars;
-        Abc_Ntk_t * pNtkResBuf; 
-        memset( pPars, 0, sizeof(SC_BusPars) );
-        pPars->GainRatio     =  300;
-        pPars->Slew          =  Abc_SclComputeAverageSlew(Abc_FrameReadLibScl());
-        pPars->nDegree       =   10;
-        pPars->fSizeOnly     =    0;
-        pPars->fAddBufs      =    1;
-        pPars->fBufPis       =    0;
-        pPars->fUseWireLoads =    0;
-        pPars->fVerbose      =    0;
-        pPars->fVeryVerbose  =    0;
-        pNtkResBuf = Abc_SclBufferingPerform( pNtkTopoed, Abc_FrameReadLibScl(), pPars );
+        *pScore = Map_ItEvalScore( pEval, MAP_FID_STA, pNtkRes->MaxDelay, pNtkRes->SumArea );
+        *pFidelity = MAP_FID_STA;
+        Abc_NtkDelete( pNtkRes );
+        pEval->clkTiers[MAP_FID_STA] += Abc_Clock() - clk;
+        if ( !Map_ItEvalPromote( pEval, MAP_FID_STA, *pScore ) )
+            return NULL;
+    }
+    // tier 2: the full flow
+    clk = Abc_Clock();
+    pNtkRes = Map_MappingDeriveTimed( p, pNtk, pLib, DelayTarget, fUseBuffs, 1, iIter );
+    if ( pNtkRes == NULL )
+    {
+        *pFidelity = -1;
+        return NULL;
+    }
+    *pScore = Map_ItEvalScore( pEval, MAP_FID_FULL, pNtkRes->MaxDelay, pNtkRes->SumArea );
+    *pFidelity = MAP_FID_FULL;
+    pEval->clkTiers[MAP_FID_FULL] += Abc_Clock() - clk;
+    return pNtkRes;
+}
 
-        {
-        // upsize;
-        SC_SizePars Pars, * pPars = &Pars; 
-        memset( pPars, 0, sizeof(SC_SizePars) );
-        pPars->nIters        = 1000;
-        pPars->nIterNoChange =   50;
-        pPars->Window        =    1;
-        pPars->Ratio         =   10;
-        pPars->Notches       = 1000;
-        pPars->DelayUser     =    0;
-        pPars->DelayGap      =    0;
-        pPars->TimeOut       =    0;
-        pPars->BuffTreeEst   =    0;
-        pPars->BypassFreq    =    0;
-        pPars->fUseDept      =    1;
-        pPars->fUseWireLoads =    0;
-        pPars->fDumpStats    =    0;
-        pPars->fVerbose      =    0;
-        pPars->fVeryVerbose  =    0;
-        Abc_SclUpsizePerform(Abc_FrameReadLibScl(), pNtkResBuf, pPars);
-
-        // dnsize; 
-        pPars->nIters        =    5;
-        pPars->nIterNoChange =   50;
-        pPars->Notches       = 1000;
-        pPars->DelayUser     =    0;
-        pPars->DelayGap      = 1000;
-        pPars->TimeOut       =    0;
-        pPars->BuffTreeEst   =    0;
-        pPars->fUseDept      =    1;
-        pPars->fUseWireLoads =    0;
-        pPars->fDumpStats    =    0;
-        pPars->fVerbose      =    0;
-        pPars->fVeryVerbose  =    0;
-        Abc_SclDnsizePerform(Abc_FrameReadLibScl(), pNtkResBuf, pPars);
-        } 
+/**Function*************************************************************
 
-        // 4. perform STA  pNtkTopoed  pNtkResBuf
-        int fShowAll      = 0;
-        int fUseWireLoads = 0;
-        int fPrintPath    = 0;
-        int fDumpStats    = 0;
-        int nTreeCRatio   = 0;
-        if ( !Abc_NtkHasMapping(pNtkResBuf) )
-        {
-            Abc_Print(-1, "The current network is not mapped.\n" );
-            return 1;
-        }
-        if ( !Abc_SclCheckNtk(pNtkResBuf, 0) )
+  Synopsis    [Prints the result of evaluating one candidate.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Map_MappingItPrint( Abc_Ntk_t * pNtkRes, int iIter, double EstDepth, double Score, int Fidelity )
+{
+    if ( pNtkRes == NULL )
+    {
+        printf( "#### Heuristic (%d) Tier = %d, Depth = %.3f, Objective = %.3f (not promoted)\n", iIter, Fidelity, EstDepth, Score );
+        return;
+    }
+    printf( "#### Heuristic (%d) Delay = %.3f, Depth = %.3f, Level = %.1f, Edge = %.1f, Area = %.3f, Gate = %.1f, Objective = %.3f \n",
+        iIter, pNtkRes->MaxDelay, EstDepth, (double)Abc_NtkLevel(pNtkRes), (double)Abc_NtkGetTotalFanins(pNtkRes),
+        pNtkRes->SumArea, (double)Abc_NtkGetLargeNodeNum(pNtkRes), Score );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Passes one observation to the optimizer and gets the next point.]
+
+  Description [Calls iterate_opt(opt, i_iter, rec_x, rec_y, fidelity) in
+  hebo_opt.py. Iteration -1 only records the observation. If pXNext is
+  not NULL, the suggested parameters are written into it.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Map_MappingPyIterate( PyObject * pFuncIterate, PyObject ** ppOpt, int iIter, double * pX, int nX, double Y, int Fidelity, double * pXNext )
+{
+    PyObject * pArgs, * pListX, * pReturn, * pNewOpt, * pNewListX, * pItem;
+    int k, RetValue = 1;
+    pArgs = PyTuple_New( 5 );
+    Py_INCREF( *ppOpt ); // PyTuple_SetItem steals a reference
+    PyTuple_SetItem( pArgs, 0, *ppOpt );
+    PyTuple_SetItem( pArgs, 1, Py_BuildValue("i", iIter) );
+    pListX = PyList_New( nX );
+    for ( k = 0; k < nX; k++ )
+        PyList_SetItem( pListX, k, PyFloat_FromDouble(pX[k]) );
+    PyTuple_SetItem( pArgs, 2, pListX );
+    PyTuple_SetItem( pArgs, 3, Py_BuildValue("[d]", Y) );
+    PyTuple_SetItem( pArgs, 4, Py_BuildValue("i", Fidelity) );
+    pReturn = PyObject_CallObject( pFuncIterate, pArgs );
+    Py_DECREF( pArgs );
+    if ( pReturn == NULL || !PyTuple_Check(pReturn) )
+    {
+        printf( "Function call failed or returned NULL\n" );
+        Py_XDECREF( pReturn );
+        return 0;
+    }
+    if ( !PyArg_ParseTuple( pReturn, "OO", &pNewOpt, &pNewListX ) )
+    {
+        printf( "Failed to parse return value\n" );
+        Py_DECREF( pReturn );
+        return 0;
+    }
+    Py_INCREF( pNewOpt ); // ParseTuple does not increase ref count
+    Py_DECREF( *ppOpt );  // replace the old opt object
+    *ppOpt = pNewOpt;
+    if ( pXNext && PyList_Size(pNewListX) != nX )
+    {
+        printf( "Returned list size does not match expected size\n" );
+        RetValue = 0;
+    }
+    else if ( pXNext )
+    {
+        for ( k = 0; k < nX; k++ )
         {
-            Abc_Print(-1, "The current network is not in a topo order (run \"topo\").\n" );
-            return 1;
+            pItem = PyList_GetItem( pNewListX, k ); // borrowed reference
+            if ( PyFloat_Check(pItem) )
+                pXNext[k] = PyFloat_AsDouble( pItem );
+            else
+                printf( "List item is not a float!\n" ), RetValue = 0;
         }
-        if ( Abc_FrameReadLibScl() == NULL )
+    }
+    Py_DECREF( pReturn );
+    return RetValue;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Takes the lock of the Python interpreter.]
+
+  Description [Starts the interpreter if needed. The interpreter lock is 
+  released after starting, so that the mapper can be called from any 
+  thread (for example, by the sessions of libabc); each caller takes the 
+  lock for the time it uses Python and releases it by PyGILState_Release().]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static PyGILState_STATE Map_MappingPyEnter()
+{
+    if ( !Py_IsInitialized() )
+    {
+        Py_Initialize();
+        PyEval_SaveThread();
+    }
+    return PyGILState_Ensure();
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Imports the Python module of the Bayesian optimizer.]
+
+  Description [The module path is added to sys.path once. After the first 
+  import, the module is served from sys.modules, so a process that has 
+  preloaded it (for example, the ABC server) does not pay the import again.
+  The caller should hold the interpreter lock.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static PyObject * Map_MappingPyImport()
+{
+    static int fPathAdded = 0;
+    if ( !fPathAdded )
+    {
+        PyRun_SimpleString("import sys;");
+        PyRun_SimpleString("sys.path.append('/home/liujunfeng/ABC/abc_itmap/abc-itmap/src/map/mapper/')");
+        fPathAdded = 1;
+    }
+    return PyImport_ImportModule("hebo_opt");
+}
+int Map_MappingPyPreload()
+{
+    PyGILState_STATE State = Map_MappingPyEnter();
+    PyObject * pModule = Map_MappingPyImport();
+    if ( pModule == NULL )
+    {
+        if ( PyErr_Occurred() )
+            PyErr_Print();
+        PyGILState_Release( State );
+        return 0;
+    }
+    Py_DECREF( pModule );
+    PyGILState_Release( State );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs iterative technology mapping (ITMap).]
+
+  Description [The delay parameters of the mapper are tuned by Bayesian
+  optimization (HEBO). The optimizer is first seeded with several expert
+  parameter settings. Each candidate is scored by the delay and area after
+  buffering, sizing and STA, normalized by the first candidate. If FidRatio
+  is in (0,1), a multi-fidelity evaluation is used: cheaper tiers filter
+  the candidates and each tier's score is fed to the optimizer as a
+  separate fidelity. The best fully evaluated parameters are used for
+  the final mapping.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Map_MappingHeboIt( Map_Man_t * p, Abc_Ntk_t * pNtk, Mio_Library_t * pLib, int fStime, double DelayTarget, int fUseBuffs, int fGradient, float FidRatio )
+{
+    abctime clk, clk2;
+    abctime clkInitPy = 0, clkIterExp = 0, clkIterBayes = 0, clkDeterPara = 0, clkGradient = 0, clkAreaRecovery = 0, clkDelayMap = 0, clkmapTT = 0, clkSTA = 0;
+    // cluster centers of the best delay parameters (the last one is better for bar)
+    double goodPara[4][10] = {
+     {0.23, 0.22, 0.26, 0.45, 0.85, 0.26, 0.28, 0.26, 1.55, 0.33},
+     {0.83, 0.23, 0.26, 0.5 , 1.52, 0.26, 0.25, 0.67, 0.69, 0.67},
+     {0.52, 0.34, 0.26, 0.46, 1.73, 0.25, 0.34, 0.52, 1.63, 0.52},
+     {0.21, 0.40, 0.45, 0.04, 0.52, 0.49, 0.02, 0.08, 1.93, 0.03}
+     };
+    int good_itera_num = 4;
+    int itera_num = 10;
+    int para_size = 10;
+    int fMultiFid = (FidRatio > 0.0 && FidRatio < 1.0);
+    Map_ItEval_t Eval, * pEval = &Eval;
+    ItResults * itRes;
+    PyObject * pModule, * pFuncInit, * pFuncIterate, * pOpt;
+    PyGILState_STATE PyState;
+    Abc_Ntk_t * pNtkRes;
+    double * rec_x, rec_y = 0.0, min_Y = MAP_FLOAT_LARGE, * min_rec_x = NULL, estDepth;
+    int i, j, Fidelity = MAP_FID_FULL, RetValue = 0;
+
+    //////////////////////////////////////////////////////////////////////
+    // perform pre-mapping computations
+    if ( p->fVerbose )
+        Map_MappingReportChoices( p );
+    Map_MappingSetChoiceLevels( p ); // should always be called before mapping!
+
+    // compute the cuts of nodes in the DFS order
+    clk = Abc_Clock();
+    Map_MappingCuts( p );
+    p->timeCuts = Abc_Clock() - clk;
+    // derive the truth tables
+    clk2 = Abc_Clock();
+    Map_MappingTruths( p );
+    p->timeTruth = Abc_Clock() - clk2;
+    clkmapTT = Abc_Clock() - clk;
+    //////////////////////////////////////////////////////////////////////
+
+    p->delayParams = (double *)malloc( sizeof(double) * para_size );
+    for ( j = 0; j < para_size; j++ )
+        p->delayParams[j] = goodPara[0][j];
+
+    // the candidates are scored by STA, which needs the Liberty library
+    if ( Abc_FrameReadLibScl() == NULL )
+    {
+        Abc_Print( -1, "There is no Liberty library available.\n" );
+        return Map_MappingPerformIt( p, &estDepth, NULL );
+    }
+
+    // initialize the optimizer
+    clk = Abc_Clock();
+    PyState = Map_MappingPyEnter();
+    pModule = Map_MappingPyImport();
+    pFuncInit = pModule ? PyObject_GetAttrString( pModule, "init_opt" ) : NULL;
+    pFuncIterate = pFuncInit ? PyObject_GetAttrString( pModule, "iterate_opt" ) : NULL;
+    pOpt = pFuncIterate ? PyObject_CallFunction( pFuncInit, "i", fMultiFid ) : NULL;
+    if ( !pOpt )
+    {
+        // the interpreter stays alive for the next calls; map with the expert parameters
+        if ( PyErr_Occurred() )
+            PyErr_Print();
+        printf( "%s; mapping with the expert parameters.\n", !pModule ? "can't find hebo_opt.py" : !pFuncInit ? "can't find function init_opt" :
+            !pFuncIterate ? "can't find function iterate_opt" : "init_opt failed to initialize" );
+        Py_XDECREF( pFuncIterate );
+        Py_XDECREF( pFuncInit );
+        Py_XDECREF( pModule );
+        PyGILState_Release( PyState );
+        return Map_MappingPerformIt( p, &estDepth, NULL );
+    }
+    clkInitPy = Abc_Clock() - clk;
+
+    // start the evaluator and the records
+    memset( pEval, 0, sizeof(Map_ItEval_t) );
+    pEval->FidRatio = FidRatio;
+    for ( j = 0; j < MAP_FID_NUM; j++ )
+        pEval->vScores[j] = Vec_FltAlloc( good_itera_num + itera_num );
+    itRes = ABC_CALLOC( ItResults, good_itera_num + itera_num );
+    rec_x = ABC_CALLOC( double, para_size );
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////
+    // init samples using some ``good delay parameters''
+    clk = Abc_Clock();
+    MAP_PROF_PHASE( p, MAP_PROF_EXP );
+    for ( i = 0; i < good_itera_num; i++ )
+    {
+        for ( j = 0; j < para_size; j++ )
+            p->delayParams[j] = goodPara[i][j];
+        estDepth = 0.0;
+        if ( !Map_MappingPerformIt( p, &estDepth, NULL ) )
+            goto finish;
+
+        clk2 = Abc_Clock();
+        pNtkRes = Map_MappingItEvaluate( p, pEval, pNtk, pLib, DelayTarget, fUseBuffs, i, estDepth, &rec_y, &Fidelity );
+        if ( Fidelity == -1 )
+            goto finish;
+        Map_MappingItPrint( pNtkRes, i, estDepth, rec_y, Fidelity );
+        if ( pNtkRes && p->pArch )
+            Map_ArchAdd( p->pArch, pNtkRes, p->delayParams, para_size );
+        if ( pNtkRes )
+            Abc_NtkDelete( pNtkRes );
+
+        itRes[i].rec_x = ABC_ALLOC( double, para_size );
+        memcpy( itRes[i].rec_x, p->delayParams, para_size * sizeof(double) );
+        itRes[i].rec_y = rec_y;
+        itRes[i].fidelity = Fidelity;
+        // record better delay parameters and its results
+        if ( Fidelity == MAP_FID_FULL && itRes[i].rec_y < min_Y )
         {
-            Abc_Print(-1, "There is no Liberty library available.\n" );
-            return 1;
+            min_Y = itRes[i].rec_y;
+            min_rec_x = itRes[i].rec_x;
         }
-        printf("####    NLDM (%d)", i);
-        extern void Abc_SclTimePerform( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats );
-        Abc_SclTimePerform( Abc_FrameReadLibScl(), pNtkResBuf, nTreeCRatio, fUseWireLoads, fShowAll, fPrintPath, fDumpStats );
-         
-        curDelay = pNtkResBuf ->MaxDelay;
-        curArea = pNtkResBuf ->SumArea;
-        // curArea = Abc_SclGetTotalArea(pNtkResBuf);
-        curLevel = Abc_NtkLevel(pNtkResBuf);
-        curGate = Abc_NtkGetLargeNodeNum(pNtkResBuf);
-        curEdge = Abc_NtkGetTotalFanins(pNtkResBuf);
-
-         float gapDepth = 0.0;  
-        if (curDelay > estDepth)
-            gapDepth = estDepth/ curDelay;
-        else 
-            gapDepth = curDelay/estDepth; 
-            
-        // rec_y[0] = curLevel/firstLevel;
-        rec_y[0] = curDelay/firstDelay + curArea/firstArea; 
-        // rec_y[0] = curDelay/firstDelay + curArea/firstArea + curLevel/firstLevel + curGate/firstGate + curEdge/firstEdge;
-        printf("#### Heuristic (%d) Delay = %.3f, Depth = %.3f, Level = %.1f, Edge = %.1f, Area = %.3f, Gate = %.1f, Objective = %.3f \n", i, curDelay, estDepth, curLevel, curEdge, curArea, curGate,  rec_y[0]);
-          
-       
-        double* tmpParas = (double*)malloc(para_size * sizeof(double)); 
-        memcpy(tmpParas, p->delayParams, para_size * sizeof(double));
-        itRes[i+good_itera_num].rec_x = tmpParas;
-        itRes[i+good_itera_num].rec_y = rec_y[0];
+        // clean best matches of the mapped network
+        if ( !Map_MappingResetMatches( p ) )
+            goto finish;
+        clkSTA += Abc_Clock() - clk2;
+
+        // only call opt.observe for the expert parameters
+        Map_MappingPyIterate( pFuncIterate, &pOpt, -1, p->delayParams, para_size, rec_y, Fidelity, NULL );
+    }
+    clkIterExp = Abc_Clock() - clk;
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////
+    // fit models using GP Kernel
+    clk = Abc_Clock();
+    MAP_PROF_PHASE( p, MAP_PROF_BAYES );
+    rec_y = 0.0;
+    for ( i = 0; i < itera_num; i++ )
+    {
+        // observe the previous candidate and suggest the next one
+        clk2 = Abc_Clock();
+        printf( "#### Parameters(%d) ", i );
+        if ( Map_MappingPyIterate( pFuncIterate, &pOpt, i, rec_x, para_size, rec_y, Fidelity, rec_x ) )
+            for ( j = 0; j < para_size; j++ )
+                printf( "[%d]=%.3f, ", j, rec_x[j] );
+        printf( "\n" );
+        for ( j = 0; j < para_size; j++ )
+            p->delayParams[j] = rec_x[j];
+        clkDeterPara += Abc_Clock() - clk2;
+
+        estDepth = 0.0;
+        if ( !Map_MappingPerformIt( p, &estDepth, &clkDelayMap ) )
+            goto finish;
+
+        clk2 = Abc_Clock();
+        pNtkRes = Map_MappingItEvaluate( p, pEval, pNtk, pLib, DelayTarget, fUseBuffs, i, estDepth, &rec_y, &Fidelity );
+        if ( Fidelity == -1 )
+            goto finish;
+        Map_MappingItPrint( pNtkRes, i, estDepth, rec_y, Fidelity );
+        if ( pNtkRes && p->pArch )
+            Map_ArchAdd( p->pArch, pNtkRes, p->delayParams, para_size );
+        clkSTA += Abc_Clock() - clk2;
+
+        itRes[i+good_itera_num].rec_x = ABC_ALLOC( double, para_size );
+        memcpy( itRes[i+good_itera_num].rec_x, p->delayParams, para_size * sizeof(double) );
+        itRes[i+good_itera_num].rec_y = rec_y;
+        itRes[i+good_itera_num].fidelity = Fidelity;
 
         clk2 = Abc_Clock();
-        if (itRes[i+good_itera_num].rec_y < min_Y) {
+        if ( Fidelity == MAP_FID_FULL && itRes[i+good_itera_num].rec_y < min_Y )
+        {
             min_Y = itRes[i+good_itera_num].rec_y;
             min_rec_x = itRes[i+good_itera_num].rec_x;
 
-            // update local References. 
-            if ( i < (int)itera_num * 0.5 && fGradient){ 
+            // update local references using the gate delays of the sized network
+            if ( i < (int)itera_num * 0.5 && fGradient )
+            {
                 Abc_Obj_t * pObj;
                 Map_Node_t * pNodeMap;
                 Map_Cut_t * pCutBest;
-                Map_Super_t *  pSuperBest; 
-                int ni,  mappingID, fPhase;
+                Map_Super_t * pSuperBest;
+                int ni, mappingID, fPhase, updatedNode = 0;
                 float gateDelay;
-                
-                double *grad = malloc(sizeof(double) * (MAP_TAO*2));
-                memset(grad, 0, sizeof(double) * (MAP_TAO*2));
-                int gate_params_size = 6;
-                double *gateParams = malloc(sizeof(double) * gate_params_size);
-                memset(gateParams, 0, sizeof(double) * gate_params_size);
-                
-                int updatedNode = 0; 
-                    
-                Abc_NtkForEachNode1( pNtkResBuf, pObj, ni ){  
+                double grad[MAP_TAO*2] = {0};
+                double gateParams[6] = {0};
+                Abc_NtkForEachNode1( pNtkRes, pObj, ni )
+                {
                     mappingID = Abc_ObjMapNtkId(pObj);
-                    fPhase =  Abc_ObjMapNtkPhase(pObj);
+                    fPhase    = Abc_ObjMapNtkPhase(pObj);
                     gateDelay = Abc_ObjMapNtkTime(pObj);
-                    pNodeMap = p->vMapObjs->pArray[mappingID];
-                    // update the tauRef using gradient descent
+                    pNodeMap  = p->vMapObjs->pArray[mappingID];
                     // skip the node that has no cut
-                    if ( Map_NodeReadCutBest(pNodeMap, fPhase) == NULL || gateDelay == MAP_FLOAT_LARGE ) 
-                        continue; 
-                    pCutBest = Map_NodeReadCutBest(pNodeMap, fPhase);    
+                    if ( Map_NodeReadCutBest(pNodeMap, fPhase) == NULL || gateDelay == MAP_FLOAT_LARGE )
+                        continue;
+                    pCutBest   = Map_NodeReadCutBest(pNodeMap, fPhase);
                     pSuperBest = pCutBest->M[fPhase].pSuperBest;
-
-                    Map_MappingGradient(p, pCutBest,  pSuperBest, fPhase, grad, gateParams);
-                    if (Map_MappingUpdateTauRef(p, pNodeMap, pCutBest, pSuperBest, fPhase, gateDelay, grad, gateParams)) {
-                        updatedNode += 1; 
-                    }
-                    // clear the arrival times 
-                    Abc_ObjSetMapNtkTime(pObj, MAP_FLOAT_LARGE);
+                    // update the tauRef using gradient descent
+                    Map_MappingGradient( p, pCutBest, pSuperBest, fPhase, grad, gateParams );
+                    if ( Map_MappingUpdateTauRef( p, pNodeMap, pCutBest, pSuperBest, fPhase, gateDelay, grad, gateParams ) )
+                        updatedNode += 1;
+                    // clear the arrival times
+                    Abc_ObjSetMapNtkTime( pObj, MAP_FLOAT_LARGE );
                 }
-                printf("#### Updated node proportion(%.3f) \n", (updatedNode*1.0)/ni);
-                free(grad);
-                free(gateParams); 
+                if ( p->fVerbose )
+                    printf( "#### Updated node proportion(%.3f) \n", (updatedNode*1.0)/ni );
+#ifdef MAP_PROFILE
+                if ( p->Prof.vUpdateRatios == NULL )
+                    p->Prof.vUpdateRatios = Vec_FltAlloc( itera_num );
+                Vec_FltPush( p->Prof.vUpdateRatios, (float)((updatedNode*1.0)/ni) );
+#endif
             }
-
         }
         clkGradient += Abc_Clock() - clk2;
+        if ( pNtkRes )
+            Abc_NtkDelete( pNtkRes );
 
-        // 4. clean best matches of the mapped network
-        if (i  <= itera_num - 1) {
-            Map_Node_t * pNode;
-            Map_Cut_t * pCut;
-            p->nMatches = 0; 
-            p->nPhases = 0; 
-            
-             // recovery matching state. 
-            for (int j = 0; j < p->vMapObjs->nSize; j++ ) { 
-                pNode = p->vMapObjs->pArray[j];
-                // clear the references
-                pNode->nRefAct[0] = pNode->nRefAct[1] = pNode->nRefAct[2] = 0;
-                pNode->nRefEst[0] = pNode->nRefEst[1] = pNode->nRefEst[2] = 0;
-                // clear the arrival times
-                pNode->tArrival[0].Rise = 0.0;
-                pNode->tArrival[0].Fall = 0.0;
-                pNode->tArrival[0].Worst = 0.0; 
-                pNode->tArrival[1].Rise = 0.0;
-                pNode->tArrival[1].Fall = 0.0;
-                pNode->tArrival[1].Worst = 0.0; 
-
-                // clear the required times
-                pNode->tRequired[0].Rise =  MAP_FLOAT_LARGE;
-                pNode->tRequired[0].Fall = MAP_FLOAT_LARGE;
-                pNode->tRequired[0].Worst =  MAP_FLOAT_LARGE; 
-                pNode->tRequired[1].Rise =  MAP_FLOAT_LARGE;
-                pNode->tRequired[1].Fall =  MAP_FLOAT_LARGE;
-                pNode->tRequired[1].Worst =  MAP_FLOAT_LARGE;
-                 
-                
-                if ( Map_NodeIsBuf(pNode) )
-                {
-                    assert( pNode->p2 == NULL );
-                    pNode->tArrival[0] = Map_Regular(pNode->p1)->tArrival[ Map_IsComplement(pNode->p1)];
-                    pNode->tArrival[1] = Map_Regular(pNode->p1)->tArrival[!Map_IsComplement(pNode->p1)];
-                    continue;
-                }
-
-                // // skip primary inputs and secondary nodes if mapping with choices
-                if ( !Map_NodeIsAnd( pNode ) || pNode->pRepr ){
-                    continue;
-                }
-                     
-                // make sure that at least one non-trival cut is present
-                if ( pNode->pCuts->pNext == NULL )
-                {
-                    // Extra_ProgressBarStop( pProgress );
-                    return 0;
-                }
-                
-                pNode->pCutBest[0] = NULL;
-                pNode->pCutBest[1] = NULL; 
-
-                // clean the node matches   
-                for ( pCut = pNode->pCuts->pNext; pCut; pCut = pCut->pNext ) { 
-                    Map_Match_t * pMatch =  pCut->M + 0;
-                    if (pMatch->pSuperBest) {
-                        pMatch->pSuperBest = NULL; 
-                    }
-                    pMatch->tArrive.Rise = MAP_FLOAT_LARGE;
-                    pMatch->tArrive.Fall = MAP_FLOAT_LARGE;
-                    pMatch->tArrive.Worst = MAP_FLOAT_LARGE;
-                    pMatch->AreaFlow = MAP_FLOAT_LARGE;
-                    // pMatch->uPhaseBest = 286331153; 
-                      
-                    pMatch =  pCut->M + 1;
-                    if (pMatch->pSuperBest) {
-                        pMatch->pSuperBest = NULL;
-                    }
-                    pMatch->tArrive.Rise = MAP_FLOAT_LARGE;
-                    pMatch->tArrive.Fall = MAP_FLOAT_LARGE;
-                    pMatch->tArrive.Worst = MAP_FLOAT_LARGE;
-                    pMatch->AreaFlow = MAP_FLOAT_LARGE; 
-                    // pMatch->uPhaseBest = 286331153; 
-                } 
-            }
- 
-
-        } 
-        clkSTA += Abc_Clock() - clk_t2;
+        // clean best matches of the mapped network
+        clk2 = Abc_Clock();
+        if ( !Map_MappingResetMatches( p ) )
+            goto finish;
+        clkSTA += Abc_Clock() - clk2;
     }
-    ///////////////////////////////////////////////////////////////////////////////////////////////////////
     clkIterBayes = Abc_Clock() - clk;
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // set parameters for the best iteration
+    if ( p->pArch && p->fVerbose )
+        Map_ArchPrint( p->pArch, 0 );
 
-    printf("#### Best para");
-    for (int j = 0; j < para_size; j++){
+    // set parameters for the best iteration
+    printf( "#### Best para" );
+    for ( j = 0; j < para_size; j++ )
+    {
         p->delayParams[j] = min_rec_x[j];
-        printf("[%d]=%.3f, ", j, min_rec_x[j]);
+        printf( "[%d]=%.3f, ", j, min_rec_x[j] );
     }
-    printf("\n");
+    printf( "\n" );
 
+    // perform the final mapping
     clk = Abc_Clock();
-    ////////////////////////////////////////////////////////////////////// 
-    clk = Abc_Clock();
+    MAP_PROF_PHASE( p, MAP_PROF_FINAL );
     p->fMappingMode = 0;
-    if ( !Map_MappingMatches( p) )
-        return 0;
+    if ( !Map_MappingMatches( p ) )
+        goto finish;
     p->timeMatch = Abc_Clock() - clk;
-    // compute the references and collect the nodes used in the mapping
     Map_MappingSetRefs( p );
-        
-    //////////////////////////////////////////////////////////////////////
-
-    //////////////////////////////////////////////////////////////////////
-    // perform area recovery using area flow 
-    // compute the required times
     Map_TimeComputeRequiredGlobal( p );
-    // recover area flow
     p->fMappingMode = 1;
     Map_MappingMatches( p );
-    // compute the references and collect the nodes used in the mapping
     Map_MappingSetRefs( p );
-    p->AreaFinal = Map_MappingGetArea( p );
-
- 
-    //////////////////////////////////////////////////////////////////////
-    // perform area recovery using exact area 
-    // compute the required times
     Map_TimeComputeRequiredGlobal( p );
-    // recover area
     p->fMappingMode = 2;
     Map_MappingMatches( p );
-    // compute the references and collect the nodes used in the mapping
     Map_MappingSetRefs( p );
-    p->AreaFinal = Map_MappingGetArea( p );
-
-    //////////////////////////////////////////////////////////////////////
-
-    //////////////////////////////////////////////////////////////////////
-    // perform area recovery using exact area
-    // compute the required times
     Map_TimeComputeRequiredGlobal( p );
-    // recover area
     p->fMappingMode = 3;
     Map_MappingMatches( p );
-    // compute the references and collect the nodes used in the mapping
     Map_MappingSetRefs( p );
     p->AreaFinal = Map_MappingGetArea( p );
-    //////////////////////////////////////////////////////////////////////
     clkAreaRecovery = Abc_Clock() - clk;
-    
 
-     
     // print the arrival times of the latest outputs
-    if ( p->fVerbose ){
+    if ( p->fVerbose )
+    {
         Map_MappingPrintOutputArrivals( p );
-        ABC_PRT("Runtime for init Python", clkInitPy);
-        ABC_PRT("Runtime for iter expert parameters", clkIterExp);
-        // ABC_PRT("Runtime for determining parameters", clkDeterPara);
-        Abc_Print( 1, "Runtime for determining parameters = %.1f sec ",   1.0*clkDeterPara/CLOCKS_PER_SEC  );
-        ABC_PRT("Runtime for iter bayesian opt", clkIterBayes); 
-        Abc_Print( 1, "Runtime for local gradient = %.1f sec ",   1.0*clkGradient/CLOCKS_PER_SEC  );
-        ABC_PRT("Runtime for area recovery", clkAreaRecovery);
-        ABC_PRT("Runtime for delay oriented mapping", clkDelayMap);
-        ABC_PRT("Runtime for mapping TT", clkmapTT);
-        Abc_Print( 1, "Update graph and STA= %.1f sec ",   1.0*clkSTA/CLOCKS_PER_SEC  );
+        ABC_PRT( "Runtime for init Python", clkInitPy );
+        ABC_PRT( "Runtime for iter expert parameters", clkIterExp );
+        Abc_Print( 1, "Runtime for determining parameters = %.1f sec ", 1.0*clkDeterPara/CLOCKS_PER_SEC );
+        ABC_PRT( "Runtime for iter bayesian opt", clkIterBayes );
+        Abc_Print( 1, "Runtime for local gradient = %.1f sec ", 1.0*clkGradient/CLOCKS_PER_SEC );
+        ABC_PRT( "Runtime for area recovery", clkAreaRecovery );
+        ABC_PRT( "Runtime for delay oriented mapping", clkDelayMap );
+        ABC_PRT( "Runtime for mapping TT", clkmapTT );
+        Abc_Print( 1, "Update graph and STA= %.1f sec ", 1.0*clkSTA/CLOCKS_PER_SEC );
+        if ( fMultiFid )
+        {
+            printf( "\nMulti-fidelity evaluations (ratio = %.2f): ", FidRatio );
+            printf( "Estimate = %d.  STA = %d (%.1f sec).  Full = %d (%.1f sec).\n",
+                pEval->nEvals[MAP_FID_EST],
+                pEval->nEvals[MAP_FID_STA],  1.0*pEval->clkTiers[MAP_FID_STA]/CLOCKS_PER_SEC,
+                pEval->nEvals[MAP_FID_FULL], 1.0*pEval->clkTiers[MAP_FID_FULL]/CLOCKS_PER_SEC );
+        }
     }
-        
-    return 1;
 
+    // save the runtime profile
+    if ( p->pItStats )
+    {
+        p->pItStats->clkmapTT        = clkmapTT;
+        p->pItStats->clkInitPy       = clkInitPy;
+        p->pItStats->clkIterExp      = clkIterExp;
+        p->pItStats->clkDeterPara    = clkDeterPara;
+        p->pItStats->clkIterBayes    = clkIterBayes;
+        p->pItStats->clkGradient     = clkGradient;
+        p->pItStats->clkDelayMap     = clkDelayMap;
+        p->pItStats->clkAreaRecovery = clkAreaRecovery;
+        p->pItStats->clkSTA          = clkSTA;
+        for ( j = 0; j < MAP_FID_NUM; j++ )
+            p->pItStats->nEvals[j] = pEval->nEvals[j];
+    }
 
+    RetValue = 1;
+
+finish:
+    // clean up
+    for ( j = 0; j < MAP_FID_NUM; j++ )
+        Vec_FltFree( pEval->vScores[j] );
+    for ( i = 0; i < good_itera_num + itera_num; i++ )
+        ABC_FREE( itRes[i].rec_x );
+    ABC_FREE( itRes );
+    ABC_FREE( rec_x );
+    Py_DECREF( pOpt );
+    Py_DECREF( pFuncIterate );
+    Py_DECREF( pFuncInit );
+    Py_DECREF( pModule );
+    PyGILState_Release( PyState );
+    return RetValue;
 }
 
 
@@ -17,6 +17,7 @@
 ***********************************************************************/
 
 #include "mapperInt.h"
+#include "map/scl/sclLib.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -75,6 +76,9 @@ void            Map_ManSetVerbose( Map_Man_t * p, int fVerbose )           { p->
 void            Map_ManSetSwitching( Map_Man_t * p, int fSwitching )       { p->fSwitching = fSwitching; }   
 void            Map_ManSetSkipFanout( Map_Man_t * p, int fSkipFanout )     { p->fSkipFanout = fSkipFanout; }   
 void            Map_ManSetUseProfile( Map_Man_t * p )                      { p->fUseProfile = 1;         }   
+void            Map_ManSetArchive( Map_Man_t * p, Map_Arch_t * pArch )     { p->pArch = pArch;           }   
+void            Map_ManSetItStats( Map_Man_t * p, Map_ItStats_t * pStats ) { p->pItStats = pStats;       }   
+void            Map_ManSetPrintProf( Map_Man_t * p, int fPrintProf )       { p->fPrintProf = fPrintProf; }   
 
 /**Function*************************************************************
 
@@ -164,6 +168,33 @@ float           Map_SuperLibReadAreaInv( Map_SuperLib_t * p )    {  return p->Ar
 Map_Time_t      Map_SuperLibReadDelayInv( Map_SuperLib_t * p )   {  return p->tDelayInv;}
 int             Map_SuperLibReadVarsMax( Map_SuperLib_t * p )    {  return p->nVarsMax; }
 
+/**Function*************************************************************
+
+  Synopsis    [Records the origin of the generic library.]
+
+  Description [Remembers that the generic library of this supergate library
+  was derived from the Liberty library with the given parameters, so that
+  the mapper can reuse both libraries instead of deriving them again.
+  Passing NULL as the Liberty library forgets the origin.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Map_SuperLibSetScl( Map_SuperLib_t * p, void * pLibScl, float Slew, float Gain, int nGatesMin )
+{
+    p->pLibScl   = pLibScl;
+    p->Slew      = Slew;
+    p->Gain      = Gain;
+    p->nGatesMin = nGatesMin;
+}
+int Map_SuperLibCheckScl( Map_SuperLib_t * p, void * pLibScl, float Slew, float Gain, int nGatesMin )
+{
+    return p != NULL && pLibScl != NULL && p->pLibScl == pLibScl && 
+        p->Slew == Slew && p->Gain == Gain && p->nGatesMin == nGatesMin;
+}
+
 
 /**Function*************************************************************
 
@@ -204,6 +235,9 @@ Map_Man_t * Map_ManCreate( int nInputs, int nOutputs, int fVerbose )
     p->fEpsilon  = (float)0.001;
     p->nodeGainArea = 0;
     p->leavesGainArea = 0;
+#ifdef MAP_PROFILE
+    p->Prof.nLookupsStart = Scl_LibLookupCount;
+#endif
     assert( p->nVarsMax > 0 );
 
     if ( p->nVarsMax == 5 )
@@ -216,6 +250,7 @@ Map_Man_t * Map_ManCreate( int nInputs, int nOutputs, int fVerbose )
 //    printf( "Node = %d bytes. Cut = %d bytes. Super = %d bytes.\n", sizeof(Map_Node_t), sizeof(Map_Cut_t), sizeof(Map_Super_t) ); 
     p->mmNodes    = Extra_MmFixedStart( sizeof(Map_Node_t) );
     p->mmCuts     = Extra_MmFixedStart( sizeof(Map_Cut_t) );
+    p->mmMatches  = Extra_MmFixedStart( 2 * sizeof(Map_Match_t) );
 
     // make sure the constant node will get index -1
     p->nNodes = -1;
@@ -263,6 +298,7 @@ void Map_ManFree( Map_Man_t * p )
     if ( p->pCounters ) ABC_FREE( p->pCounters );
     Extra_MmFixedStop( p->mmNodes );
     Extra_MmFixedStop( p->mmCuts );
+    Extra_MmFixedStop( p->mmMatches );
     ABC_FREE( p->pNodeDelays );
     ABC_FREE( p->pInputArrivals );
     ABC_FREE( p->pOutputRequireds );
@@ -270,6 +306,10 @@ void Map_ManFree( Map_Man_t * p )
     ABC_FREE( p->pOutputs );
     ABC_FREE( p->pBins );
     ABC_FREE( p->ppOutputNames );
+    ABC_FREE( p->delayParams );
+#ifdef MAP_PROFILE
+    Vec_FltFreeP( &p->Prof.vUpdateRatios );
+#endif
     ABC_FREE( p );
 }
 
@@ -331,6 +371,70 @@ void Map_ManPrintTimeStats( Map_Man_t * p )
     if ( p->time3 ) { ABC_PRT( "time3", p->time3 ); }
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Switches the phase of the hot-path counters.]
+
+  Description [The lookups into the NLDM tables are counted globally
+  and attributed to the phase that was current when they happened.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Map_ManProfSetPhase( Map_Man_t * p, int iPhase )
+{
+#ifdef MAP_PROFILE
+    assert( iPhase >= 0 && iPhase < MAP_PROF_NUM );
+    p->Prof.nLookups[p->Prof.iPhase] += Scl_LibLookupCount - p->Prof.nLookupsStart;
+    p->Prof.nLookupsStart = Scl_LibLookupCount;
+    p->Prof.iPhase = iPhase;
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Prints the hot-path counters.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Map_ManProfPrint( Map_Man_t * p )
+{
+#ifdef MAP_PROFILE
+    static const char * pNames[MAP_PROF_NUM] = { "Pre/classic", "Expert", "Bayesian", "Final" };
+    Map_Prof_t * pProf = &p->Prof;
+    float Ratio;
+    int i;
+    Map_ManProfSetPhase( p, pProf->iPhase );
+    printf( "Mapper hot-path counters:\n" );
+    printf( "%-12s %12s %12s %8s %12s %12s %12s %6s %12s\n", "Phase", "Cuts", "Supergates", "Per cut", "Phases", "Arrivals", "Early exits", "%", "NLDM lookups" );
+    for ( i = 0; i < MAP_PROF_NUM; i++ )
+    {
+        if ( pProf->nCuts[i] == 0 && pProf->nArrivals[i] == 0 && pProf->nLookups[i] == 0 )
+            continue;
+        printf( "%-12s %12.0f %12.0f %8.2f %12.0f %12.0f %12.0f %6.2f %12.0f\n", pNames[i], 
+            (double)pProf->nCuts[i], (double)pProf->nSupers[i], pProf->nCuts[i] ? 1.0*pProf->nSupers[i]/pProf->nCuts[i] : 0.0,
+            (double)pProf->nPhases[i], (double)pProf->nArrivals[i], (double)pProf->nArrivalExits[i], 
+            pProf->nArrivals[i] ? 100.0*pProf->nArrivalExits[i]/pProf->nArrivals[i] : 0.0, (double)pProf->nLookups[i] );
+    }
+    if ( pProf->vUpdateRatios && Vec_FltSize(pProf->vUpdateRatios) )
+    {
+        printf( "Updated node proportion per gradient iteration:" );
+        Vec_FltForEachEntry( pProf->vUpdateRatios, Ratio, i )
+            printf( " %.3f", Ratio );
+        printf( "\n" );
+    }
+#else
+    printf( "The mapper hot-path counters are not compiled (rebuild with ABC_USE_MAP_PROFILE=1).\n" );
+#endif
+}
+
 /**Function*************************************************************
 
   Synopsis    [Prints the mapping stats.]
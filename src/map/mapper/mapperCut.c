@@ -166,6 +166,7 @@ void Map_MappingCutsInput( Map_Man_t * p, Map_Node_t * pNode )
     pNode->pCutBest[0] = NULL; // negative polarity is not mapped
     pNode->pCutBest[1] = pCut; // positive polarity is a trivial cut
     pCut->uTruth = 0xAAAAAAAA; // the first variable "1010"
+    Map_CutAllocMatches( p, pCut );
     pCut->M[0].AreaFlow = 0.0;
     pCut->M[1].AreaFlow = 0.0;
 }
@@ -1015,7 +1016,7 @@ Map_Cut_t * Map_CutSortCuts( Map_Man_t * pMan, Map_CutTable_t * p, Map_Cut_t * p
     {
         // free the remaining cuts
         for ( i = MAP_CUTS_MAX_USE - 1; i < nCuts; i++ )
-            Extra_MmFixedEntryRecycle( pMan->mmCuts, (char *)p->pCuts1[i] );
+            Map_CutFree( pMan, p->pCuts1[i] );
         // update the number of cuts
         nCuts = MAP_CUTS_MAX_USE - 1;
     }
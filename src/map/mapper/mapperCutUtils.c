@@ -43,9 +43,30 @@ ABC_NAMESPACE_IMPL_START
 Map_Cut_t * Map_CutAlloc( Map_Man_t * p )
 {
     Map_Cut_t * pCut;
-    Map_Match_t * pMatch;
     pCut = (Map_Cut_t *)Extra_MmFixedEntryFetch( p->mmCuts );
     memset( pCut, 0, sizeof(Map_Cut_t) );
+    return pCut;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Allocates the matches of the cut.]
+
+  Description [The cuts are enumerated and filtered without matches. 
+  The pair of matches is only allocated for the cuts that survive 
+  filtering, when their truth tables are derived.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Map_Match_t * Map_CutAllocMatches( Map_Man_t * p, Map_Cut_t * pCut )
+{
+    Map_Match_t * pMatch;
+    assert( pCut->M == NULL );
+    pCut->M = (Map_Match_t *)Extra_MmFixedEntryFetch( p->mmMatches );
+    memset( pCut->M, 0, 2 * sizeof(Map_Match_t) );
 
     pMatch = pCut->M;
     pMatch->AreaFlow       = MAP_FLOAT_LARGE; // unassigned
@@ -58,7 +79,7 @@ Map_Cut_t * Map_CutAlloc( Map_Man_t * p )
     pMatch->tArrive.Rise   = MAP_FLOAT_LARGE; // unassigned
     pMatch->tArrive.Fall   = MAP_FLOAT_LARGE; // unassigned
     pMatch->tArrive.Worst  = MAP_FLOAT_LARGE; // unassigned
-    return pCut;
+    return pCut->M;
 }
 
 /**Function*************************************************************
@@ -74,7 +95,10 @@ Map_Cut_t * Map_CutAlloc( Map_Man_t * p )
 ***********************************************************************/
 void Map_CutFree( Map_Man_t * p, Map_Cut_t * pCut )
 {
-    if ( pCut )
+    if ( pCut == NULL )
+        return;
+    if ( pCut->M )
+        Extra_MmFixedEntryRecycle( p->mmMatches, (char *)pCut->M );
     Extra_MmFixedEntryRecycle( p->mmCuts, (char *)pCut );
 }
 
@@ -197,7 +221,7 @@ void Map_CutListRecycle( Map_Man_t * p, Map_Cut_t * pSetList, Map_Cut_t * pSave
           pTemp; 
           pTemp = pNext, pNext = pNext? pNext->pNext : NULL )
         if ( pTemp != pSave )
-            Extra_MmFixedEntryRecycle( p->mmCuts, (char *)pTemp );
+            Map_CutFree( p, pTemp );
 }
 
 /**Function*************************************************************
@@ -86,10 +86,41 @@ ABC_NAMESPACE_HEADER_START
 // 
 #define MAP_TAO               (3)       
 
+// the hot-path counters (compiled only with -DMAP_PROFILE, see ABC_USE_MAP_PROFILE)
+#define MAP_PROF_PRE          0         // the mapping before ITMap (or the classic mapper)
+#define MAP_PROF_EXP          1         // the expert parameters
+#define MAP_PROF_BAYES        2         // the Bayesian iterations
+#define MAP_PROF_FINAL        3         // the final mapping
+#define MAP_PROF_NUM          4
+
+#ifdef MAP_PROFILE
+#define MAP_PROF_INC( p, Counter )   ((p)->Prof.Counter[(p)->Prof.iPhase]++)
+#define MAP_PROF_PHASE( p, Phase )   Map_ManProfSetPhase( p, Phase )
+#else
+#define MAP_PROF_INC( p, Counter )
+#define MAP_PROF_PHASE( p, Phase )
+#endif
+
 ////////////////////////////////////////////////////////////////////////
 ///                    STRUCTURE DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
 
+typedef struct Map_ProfStruct_t_        Map_Prof_t;
+
+// the hot-path counters of the mapper
+struct Map_ProfStruct_t_
+{
+    int                 iPhase;                         // the current phase
+    ABC_INT64_T         nCuts[MAP_PROF_NUM];            // cuts matched
+    ABC_INT64_T         nSupers[MAP_PROF_NUM];          // supergates evaluated
+    ABC_INT64_T         nPhases[MAP_PROF_NUM];          // supergate phases evaluated
+    ABC_INT64_T         nArrivals[MAP_PROF_NUM];        // calls to Map_TimeCutComputeArrivalIt()
+    ABC_INT64_T         nArrivalExits[MAP_PROF_NUM];    // early exits on tWorstLimit
+    ABC_INT64_T         nLookups[MAP_PROF_NUM];         // calls to Scl_LibLookup() in STA
+    ABC_INT64_T         nLookupsStart;                  // the lookup count when the phase started
+    Vec_Flt_t *         vUpdateRatios;                  // the proportion of nodes updated by the gradient
+};
+
 // the mapping manager
 struct Map_ManStruct_t_
 {
@@ -127,6 +158,10 @@ struct Map_ManStruct_t_
     int                 fSwitching;    // use switching activity
     int                 fSkipFanout;   // skip large gates when mapping high-fanout nodes
     int                 fUseProfile;   // use standard-cell profile
+    int                 fPrintProf;    // print the hot-path counters
+#ifdef MAP_PROFILE
+    Map_Prof_t          Prof;          // the hot-path counters
+#endif
 
     // the supergate library
     Map_SuperLib_t *    pSuperLib;     // the current supergate library
@@ -139,6 +174,7 @@ struct Map_ManStruct_t_
     // the memory managers
     Extra_MmFixed_t *   mmNodes;       // the memory manager for nodes
     Extra_MmFixed_t *   mmCuts;        // the memory manager for cuts
+    Extra_MmFixed_t *   mmMatches;     // the memory manager for the pairs of cut matches
 
     // precomputed N-canonical forms
     unsigned short *    uCanons;       // N-canonical forms
@@ -170,6 +206,8 @@ struct Map_ManStruct_t_
     int                 leavesGainArea;
     // 
     double *            delayParams;   // the  parameters of the delay model.
+    Map_Arch_t *        pArch;         // the archive of non-dominated mapped networks
+    Map_ItStats_t *     pItStats;      // the runtime profile of ITMap
     int                 mode1Num;  // the number of nodes for area recovery in the delay mode 1. 
     int                 mode2Num;  // the number of nodes for area recovery in the delay mode 2. 
     int                 mode3Num;  // the number of nodes for area recovery in the delay mode 3. 
@@ -181,6 +219,10 @@ struct Map_SuperLibStruct_t_
     // general info
     char *              pName;         // the name of the supergate library
     Mio_Library_t *     pGenlib;       // the generic library
+    void *              pLibScl;       // the Liberty library, from which the generic library was derived
+    float               Slew;          // the slew used to derive the generic library
+    float               Gain;          // the gain used to derive the generic library
+    int                 nGatesMin;     // the minimum gate count used to derive the generic library
 
     // other info
     int                 nVarsMax;      // the max number of variables
@@ -282,13 +324,13 @@ struct Map_CutStruct_t_
     Map_Cut_t *         pOne;          // the father of this cut
     Map_Cut_t *         pTwo;          // the mother of this cut
     Map_Node_t *        ppLeaves[6];   // the leaves of this cut
+    Map_Match_t *       M;             // the matches for positive/negative phase (allocated for the surviving cuts)
+    float               delay[2];      // the delay of cut
     unsigned            uTruth;        // truth table for five-input cuts
     char                nLeaves;       // the number of leaves
     char                nVolume;       // the volume of this cut
     char                fMark;         // the mark to denote visited cut
     char                Phase;         // the mark to denote complemented cut
-    Map_Match_t         M[2];          // the matches for positive/negative phase
-    float               delay[2];      // the delay of cut
 };
 
 // the supergate internally represented
@@ -392,11 +434,14 @@ struct Map_HashEntryStruct_t_
 ////////////////////////////////////////////////////////////////////////
 
 /*=== mapperCanon.c =============================================================*/
+/*=== mapperCreate.c ============================================================*/
+extern void              Map_ManProfSetPhase( Map_Man_t * p, int iPhase );
 /*=== mapperCut.c ===============================================================*/
 extern void              Map_MappingCuts( Map_Man_t * p );
 /*=== mapperCutUtils.c ===============================================================*/
 extern Map_Cut_t *       Map_CutAlloc( Map_Man_t * p );
 extern void              Map_CutFree( Map_Man_t * p, Map_Cut_t * pCut );
+extern Map_Match_t *     Map_CutAllocMatches( Map_Man_t * p, Map_Cut_t * pCut );
 extern void              Map_CutPrint( Map_Man_t * p, Map_Node_t * pRoot, Map_Cut_t * pCut, int fPhase );
 extern float             Map_CutGetRootArea( Map_Cut_t * pCut, int fPhase );
 extern int               Map_CutGetLeafPhase( Map_Cut_t * pCut, int fPhase, int iLeaf );
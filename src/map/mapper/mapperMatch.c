@@ -174,6 +174,7 @@ int Map_MatchNodeCut( Map_Man_t * p, Map_Node_t * pNode, Map_Cut_t * pCut, int f
 
     // save the current match of the cut
     MatchBest = *pMatch;
+    MAP_PROF_INC( p, nCuts );
     // go through the supergates
     for ( pSuper = pMatch->pSupers, Counter = 0; pSuper; pSuper = pSuper->pNext, Counter++ )
     {
@@ -187,10 +188,12 @@ int Map_MatchNodeCut( Map_Man_t * p, Map_Node_t * pNode, Map_Cut_t * pCut, int f
         
         
         // go through different phases of the given match and supergate
+        MAP_PROF_INC( p, nSupers );
         pMatch->pSuperBest = pSuper;
         for ( i = 0; i < (int)pSuper->nPhases; i++ )
         {
             p->nPhases++;
+            MAP_PROF_INC( p, nPhases );
             // find the overall phase of this match
             pMatch->uPhaseBest = pMatch->uPhase ^ pSuper->uPhases[i];
             if ( p->fMappingMode == 0 )
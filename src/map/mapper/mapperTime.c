@@ -169,6 +169,7 @@ float Map_TimeCutComputeArrivalIt( Map_Node_t * pNode, Map_Cut_t * pCut, int fPh
     Mio_Gate_t * pInvGate = pLib->pGateInv;  
     Mio_Pin_t * pInvPin =  pInvGate ->pPins;
 
+    MAP_PROF_INC( pNode->p, nArrivals );
     tExtra = pNode->p->pNodeDelays ? pNode->p->pNodeDelays[pNode->Num] : 0;
     ptArrRes->Rise  = ptArrRes->Fall = 0.0;
     ptArrRes->Worst = MAP_FLOAT_LARGE;
@@ -226,7 +227,10 @@ float Map_TimeCutComputeArrivalIt( Map_Node_t * pNode, Map_Cut_t * pCut, int fPh
 
             tDelay = ptArrIn->Rise + estDelay + tExtra;
             if ( tDelay > tWorstLimit )
+            {
+                MAP_PROF_INC( pNode->p, nArrivalExits );
                 return MAP_FLOAT_LARGE;
+            }
             if ( ptArrRes->Rise < tDelay )
                 ptArrRes->Rise = tDelay;
         }
@@ -245,7 +249,10 @@ float Map_TimeCutComputeArrivalIt( Map_Node_t * pNode, Map_Cut_t * pCut, int fPh
             
             tDelay = ptArrIn->Fall + estDelay + tExtra;
             if ( tDelay > tWorstLimit )
+            {
+                MAP_PROF_INC( pNode->p, nArrivalExits );
                 return MAP_FLOAT_LARGE;
+            }
             if ( ptArrRes->Rise < tDelay )
                 ptArrRes->Rise = tDelay;
         }
@@ -265,7 +272,10 @@ float Map_TimeCutComputeArrivalIt( Map_Node_t * pNode, Map_Cut_t * pCut, int fPh
 
             tDelay = ptArrIn->Rise + estDelay + tExtra;
             if ( tDelay > tWorstLimit )
+            {
+                MAP_PROF_INC( pNode->p, nArrivalExits );
                 return MAP_FLOAT_LARGE;
+            }
             if ( ptArrRes->Fall < tDelay )
                 ptArrRes->Fall = tDelay;
         }
@@ -286,7 +296,10 @@ float Map_TimeCutComputeArrivalIt( Map_Node_t * pNode, Map_Cut_t * pCut, int fPh
         
             tDelay = ptArrIn->Fall + estDelay + tExtra;
             if ( tDelay > tWorstLimit )
+            {
+                MAP_PROF_INC( pNode->p, nArrivalExits );
                 return MAP_FLOAT_LARGE;
+            }
             if ( ptArrRes->Fall < tDelay )
                 ptArrRes->Fall = tDelay;
         }
@@ -61,6 +61,11 @@ void Map_MappingTruths( Map_Man_t * pMan )
         assert( pNode->pCuts );
         assert( pNode->pCuts->nLeaves == 1 );
 
+        // the matches are only allocated for the cuts that survived filtering
+        for ( pCut = pNode->pCuts; pCut; pCut = pCut->pNext )
+            if ( pCut->M == NULL )
+                Map_CutAllocMatches( pMan, pCut );
+
         // match the simple cut
         pNode->pCuts->M[0].uPhase     = 0;
         pNode->pCuts->M[0].pSupers    = pMan->pSuperLib->pSuperInv;
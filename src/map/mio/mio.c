@@ -116,6 +116,7 @@ void Mio_Init( Abc_Frame_t * pAbc )
 ***********************************************************************/
 void Mio_End( Abc_Frame_t * pAbc )
 {
+    Map_ArchStop( (Map_Arch_t *)Abc_FrameReadMapArch() );
     Mio_LibraryDelete( (Mio_Library_t *)Abc_FrameReadLibGen() );
     Amap_LibFree( (Amap_Lib_t *)Abc_FrameReadLibGen2() );
 }
@@ -139,6 +140,9 @@ void Mio_UpdateGenlib( Mio_Library_t * pLib )
         Map_SuperLibFree( (Map_SuperLib_t *)Abc_FrameReadLibSuper() );
         Abc_FrameSetLibSuper( NULL );
     }
+    // free the archive of mapped networks because it depends on the old Mio library
+    Map_ArchStop( (Map_Arch_t *)Abc_FrameReadMapArch() );
+    Abc_FrameSetMapArch( NULL );
 
     // replace the current library
     Mio_LibraryDelete( (Mio_Library_t *)Abc_FrameReadLibGen() );
@@ -162,6 +166,9 @@ int Mio_UpdateGenlib2( Vec_Str_t * vStr, Vec_Str_t * vStr2, char * pFileName, in
         Map_SuperLibFree( (Map_SuperLib_t *)Abc_FrameReadLibSuper() );
         Abc_FrameSetLibSuper( NULL );
     }
+    // free the archive of mapped networks because it depends on the old Mio library
+    Map_ArchStop( (Map_Arch_t *)Abc_FrameReadMapArch() );
+    Abc_FrameSetMapArch( NULL );
 
     // replace the current library
     Mio_LibraryDelete( (Mio_Library_t *)Abc_FrameReadLibGen() );
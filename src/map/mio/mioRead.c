@@ -185,6 +185,80 @@ Mio_Library_t * Mio_LibraryReadBuffer( char * pBuffer, int fExtendedFormat, st__
     return pLib;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Duplicates the genlib library.]
+
+  Description [The gates are copied in the original order, so that the
+  cell IDs, the twin gates, and the special gates of the copy are the
+  same as in the original. The derived matching data is not copied;
+  it is recomputed on demand.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Mio_Library_t * Mio_LibraryDup( Mio_Library_t * pLib )
+{
+    Mio_Library_t * pLibNew;
+    Mio_Gate_t * pGate, * pGateNew, * pBase, ** ppGate;
+    Mio_Pin_t * pPin, ** ppPin;
+    int i;
+
+    pLibNew = ABC_CALLOC( Mio_Library_t, 1 );
+    pLibNew->pName = Abc_UtilStrsav( pLib->pName );
+    pLibNew->tName2Gate = st__init_table(strcmp, st__strhash);
+    pLibNew->pMmFlex = Mem_FlexStart();
+    pLibNew->vCube = Vec_StrAlloc( 100 );
+    pLibNew->fPinFilter = pLib->fPinFilter;
+    pLibNew->fPinPerm = pLib->fPinPerm;
+    pLibNew->fPinQuick = pLib->fPinQuick;
+
+    // copy the gates in the order, in which they were read
+    ppGate = &pLibNew->pGates;
+    for ( i = 0; i < pLib->nGates; i++ )
+    {
+        pGate = pLib->ppGates0[i];
+        pGateNew = ABC_CALLOC( Mio_Gate_t, 1 );
+        pGateNew->pName    = Abc_UtilStrsav( pGate->pName );
+        pGateNew->dArea    = pGate->dArea;
+        pGateNew->pForm    = Abc_UtilStrsav( pGate->pForm );
+        pGateNew->pOutName = Abc_UtilStrsav( pGate->pOutName );
+        pGateNew->pLib     = pLibNew;
+        ppPin = &pGateNew->pPins;
+        Mio_GateForEachPin( pGate, pPin )
+        {
+            *ppPin = Mio_PinDup( pPin );
+            ppPin  = &(*ppPin)->pNext;
+        }
+        *ppGate = pGateNew;
+        ppGate  = &pGateNew->pNext;
+        // pair up the twin gates as the reader does
+        if ( ! st__is_member( pLibNew->tName2Gate, pGateNew->pName ) )
+            st__insert( pLibNew->tName2Gate, pGateNew->pName, (char *)pGateNew );
+        else
+        {
+            pBase = Mio_LibraryReadGateByName( pLibNew, pGateNew->pName, NULL );
+            if ( pBase->pTwin == NULL )
+            {
+                pBase->pTwin = pGateNew;
+                pGateNew->pTwin = pBase;
+            }
+        }
+    }
+
+    // derive the functionality of gates
+    if ( Mio_LibraryParseFormulas( pLibNew ) )
+    {
+        printf( "Mio_LibraryDup: Had problems parsing formulas.\n" );
+        Mio_LibraryDelete( pLibNew );
+        return NULL;
+    }
+    Mio_LibraryDetectSpecialGates( pLibNew );
+    return pLibNew;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Read the genlib type of library.]
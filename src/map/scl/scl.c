@@ -25,6 +25,7 @@
 #include "sclCon.h"
 
 #include "map/mio/mio.h"
+#include "map/mapper/mapper.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -101,11 +102,11 @@ void Abc_SclLoad( SC_Lib * pLib, SC_Lib ** ppScl )
 ***********************************************************************/
 void Scl_Init( Abc_Frame_t * pAbc )
 {
-    Cmd_CommandAdd( pAbc, "SCL mapping",  "read_lib",      Scl_CommandReadLib,     0 ); 
+    Cmd_CommandAdd( pAbc, "SCL mapping",  "read_lib",      Scl_CommandReadLib,     CMD_CHANGES_LIB ); 
     Cmd_CommandAdd( pAbc, "SCL mapping",  "write_lib",     Scl_CommandWriteLib,    0 ); 
     Cmd_CommandAdd( pAbc, "SCL mapping",  "print_lib",     Scl_CommandPrintLib,    0 ); 
-    Cmd_CommandAdd( pAbc, "SCL mapping",  "leak2area",     Scl_CommandLeak2Area,   0 ); 
-    Cmd_CommandAdd( pAbc, "SCL mapping",  "read_scl",      Scl_CommandReadScl,     0 ); 
+    Cmd_CommandAdd( pAbc, "SCL mapping",  "leak2area",     Scl_CommandLeak2Area,   CMD_CHANGES_LIB ); 
+    Cmd_CommandAdd( pAbc, "SCL mapping",  "read_scl",      Scl_CommandReadScl,     CMD_CHANGES_LIB ); 
     Cmd_CommandAdd( pAbc, "SCL mapping",  "write_scl",     Scl_CommandWriteScl,    0 ); 
     Cmd_CommandAdd( pAbc, "SCL mapping",  "dump_genlib",   Scl_CommandDumpGen,     0 ); 
     Cmd_CommandAdd( pAbc, "SCL mapping",  "print_gs",      Scl_CommandPrintGS,     0 ); 
@@ -468,6 +469,9 @@ int Scl_CommandLeak2Area( Abc_Frame_t * pAbc, int argc, char **argv )
     }
     // update the current library
     Abc_SclConvertLeakageIntoArea( (SC_Lib *)pAbc->pLibScl, A, B );
+    // the libraries derived for mapping from the old areas cannot be reused
+    if ( pAbc->pLibSuper )
+        Map_SuperLibSetScl( (Map_SuperLib_t *)pAbc->pLibSuper, NULL, 0, 0, 0 );
     return 0;
 
 usage:
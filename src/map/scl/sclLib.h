@@ -42,6 +42,11 @@ ABC_NAMESPACE_HEADER_START
 
 #define ABC_SCL_CUR_VERSION 8
 
+#ifdef MAP_PROFILE
+// the number of lookups into the NLDM tables (see the mapper hot-path counters)
+extern ABC_INT64_T Scl_LibLookupCount;
+#endif
+
 typedef enum  
 {
     sc_dir_NULL,
@@ -491,6 +496,9 @@ static inline float Scl_LibLookup( SC_Surface * p, float slew, float load )
     float * pIndex0, * pIndex1, * pDataS, * pDataS1;
     float sfrac, lfrac, p0, p1;
     int s, l;
+#ifdef MAP_PROFILE
+    Scl_LibLookupCount++;
+#endif
 
     // handle constant table
     if ( Vec_FltSize(&p->vIndex0) == 1 && Vec_FltSize(&p->vIndex1) == 1 )
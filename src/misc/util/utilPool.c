@@ -0,0 +1,388 @@
+/**CFile****************************************************************
+
+  FileName    [utilPool.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Thread pool utilities.]
+
+  Synopsis    [Pool of blocking worker threads.]
+
+  Author      []
+
+  Affiliation []
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: utilPool.c,v 1.00 2026/10/18 00:00:00 Exp $]
+
+***********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "abc_global.h"
+#include "utilPool.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+/*
+    The pool keeps a fixed set of workers, each of them owning a scratch
+    memory block. The manager thread gives a task to an idle worker
+    (Util_PoolAssign) and then blocks until one of the tasks is finished
+    (Util_PoolWaitAny). Because the task is given to a particular worker,
+    the manager can keep per-worker data (for example, a SAT solver or a
+    cut set) and read the results of the finished task before the worker
+    gets the next one. Idle workers and the waiting manager sleep on
+    condition variables instead of spinning on a flag.
+*/
+
+// the states of a worker
+#define UTIL_POOL_IDLE  0    // waiting for a task
+#define UTIL_POOL_BUSY  1    // running a task
+#define UTIL_POOL_DONE  2    // finished a task, which was not collected yet
+
+typedef struct Util_PoolWorker_t_ Util_PoolWorker_t;
+struct Util_PoolWorker_t_
+{
+    Util_Pool_t *      pPool;       // the parent pool
+    Util_PoolFunc_t    pFunc;       // the current task
+    void *             pArg;        // the argument of the current task
+    void *             pScratch;    // the scratch memory of this worker
+    int                iThread;     // the index of this worker
+    int                State;       // the state of this worker
+#ifdef ABC_USE_PTHREADS
+    pthread_t          Thread;      // the thread
+    pthread_cond_t     CondStart;   // signals that a task is assigned
+#endif
+};
+
+struct Util_Pool_t_
+{
+    int                nThreads;    // the number of workers
+    int                iNext;       // the worker to check first when collecting
+    int                fStop;       // the pool is being stopped
+    Util_PoolWorker_t * pWorkers;   // the workers
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_t    Mutex;       // protects the states of the workers
+    pthread_cond_t     CondDone;    // signals that a task is finished
+#endif
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+#ifdef ABC_USE_PTHREADS
+
+/**Function*************************************************************
+
+  Synopsis    [The worker thread.]
+
+  Description [Sleeps until a task is assigned, runs it, marks it as
+  finished and wakes up the manager.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void * Util_PoolWorkerThread( void * pArgument )
+{
+    Util_PoolWorker_t * pWorker = (Util_PoolWorker_t *)pArgument;
+    Util_Pool_t * p = pWorker->pPool;
+    pthread_mutex_lock( &p->Mutex );
+    while ( 1 )
+    {
+        while ( pWorker->State != UTIL_POOL_BUSY && !p->fStop )
+            pthread_cond_wait( &pWorker->CondStart, &p->Mutex );
+        if ( pWorker->State != UTIL_POOL_BUSY )
+            break;
+        pthread_mutex_unlock( &p->Mutex );
+        pWorker->pFunc( pWorker->pArg, pWorker->iThread, pWorker->pScratch );
+        pthread_mutex_lock( &p->Mutex );
+        pWorker->State = UTIL_POOL_DONE;
+        pthread_cond_signal( &p->CondDone );
+    }
+    pthread_mutex_unlock( &p->Mutex );
+    return NULL;
+}
+
+#endif
+
+/**Function*************************************************************
+
+  Synopsis    [Starts the pool.]
+
+  Description [Creates nThreads workers, which sleep until they are given
+  a task. Each worker gets nScratch bytes of zeroed scratch memory, which
+  is passed to all tasks run by this worker.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Util_Pool_t * Util_PoolStart( int nThreads, int nScratch )
+{
+    Util_Pool_t * p;
+    int i;
+    assert( nThreads > 0 );
+    p = ABC_CALLOC( Util_Pool_t, 1 );
+    p->nThreads = nThreads;
+    p->pWorkers = ABC_CALLOC( Util_PoolWorker_t, nThreads );
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_init( &p->Mutex, NULL );
+    pthread_cond_init( &p->CondDone, NULL );
+#endif
+    for ( i = 0; i < nThreads; i++ )
+    {
+        Util_PoolWorker_t * pWorker = p->pWorkers + i;
+        pWorker->pPool    = p;
+        pWorker->iThread  = i;
+        pWorker->State    = UTIL_POOL_IDLE;
+        pWorker->pScratch = nScratch > 0 ? ABC_CALLOC( char, nScratch ) : NULL;
+#ifdef ABC_USE_PTHREADS
+        {
+            int status;
+            pthread_cond_init( &pWorker->CondStart, NULL );
+            status = pthread_create( &pWorker->Thread, NULL, Util_PoolWorkerThread, (void *)pWorker );  assert( status == 0 );
+        }
+#endif
+    }
+    return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Stops the pool.]
+
+  Description [Waits for the running tasks to finish and joins the threads.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_PoolStop( Util_Pool_t * p )
+{
+    int i;
+    Util_PoolWaitAll( p );
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_lock( &p->Mutex );
+    p->fStop = 1;
+    for ( i = 0; i < p->nThreads; i++ )
+        pthread_cond_signal( &p->pWorkers[i].CondStart );
+    pthread_mutex_unlock( &p->Mutex );
+    for ( i = 0; i < p->nThreads; i++ )
+    {
+        pthread_join( p->pWorkers[i].Thread, NULL );
+        pthread_cond_destroy( &p->pWorkers[i].CondStart );
+    }
+    pthread_cond_destroy( &p->CondDone );
+    pthread_mutex_destroy( &p->Mutex );
+#endif
+    for ( i = 0; i < p->nThreads; i++ )
+        ABC_FREE( p->pWorkers[i].pScratch );
+    ABC_FREE( p->pWorkers );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Simple access procedures.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Util_PoolThreadNum( Util_Pool_t * p )
+{
+    return p->nThreads;
+}
+void * Util_PoolScratch( Util_Pool_t * p, int iThread )
+{
+    assert( iThread >= 0 && iThread < p->nThreads );
+    return p->pWorkers[iThread].pScratch;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the worker has a task that was not collected.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Util_PoolIsBusy( Util_Pool_t * p, int iThread )
+{
+    int State;
+    assert( iThread >= 0 && iThread < p->nThreads );
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_lock( &p->Mutex );
+#endif
+    State = p->pWorkers[iThread].State;
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_unlock( &p->Mutex );
+#endif
+    return State != UTIL_POOL_IDLE;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns an idle worker or -1 if there is none.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Util_PoolFindIdle( Util_Pool_t * p )
+{
+    int i, iThread = -1;
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_lock( &p->Mutex );
+#endif
+    for ( i = 0; i < p->nThreads; i++ )
+        if ( p->pWorkers[i].State == UTIL_POOL_IDLE )
+        {
+            iThread = i;
+            break;
+        }
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_unlock( &p->Mutex );
+#endif
+    return iThread;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Gives the task to the idle worker.]
+
+  Description [Without pthreads, the task is run immediately.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_PoolAssign( Util_Pool_t * p, int iThread, Util_PoolFunc_t pFunc, void * pArg )
+{
+    Util_PoolWorker_t * pWorker = p->pWorkers + iThread;
+    assert( iThread >= 0 && iThread < p->nThreads );
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_lock( &p->Mutex );
+    assert( pWorker->State == UTIL_POOL_IDLE );
+    pWorker->pFunc = pFunc;
+    pWorker->pArg  = pArg;
+    pWorker->State = UTIL_POOL_BUSY;
+    pthread_cond_signal( &pWorker->CondStart );
+    pthread_mutex_unlock( &p->Mutex );
+#else
+    assert( pWorker->State == UTIL_POOL_IDLE );
+    pWorker->pFunc = pFunc;
+    pWorker->pArg  = pArg;
+    pFunc( pArg, iThread, pWorker->pScratch );
+    pWorker->State = UTIL_POOL_DONE;
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Waits till one of the tasks is finished.]
+
+  Description [Returns the worker that finished the task and makes it
+  idle. The argument of the finished task is returned in ppArg (if it is
+  not NULL). Returns -1 if no task is running or waiting to be collected.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Util_PoolWaitAny( Util_Pool_t * p, void ** ppArg )
+{
+    int i, k, fBusy, iThread = -1;
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_lock( &p->Mutex );
+#endif
+    while ( 1 )
+    {
+        fBusy = 0;
+        for ( k = 0; k < p->nThreads; k++ )
+        {
+            i = (p->iNext + k) % p->nThreads;
+            if ( p->pWorkers[i].State == UTIL_POOL_DONE )
+            {
+                iThread = i;
+                break;
+            }
+            if ( p->pWorkers[i].State == UTIL_POOL_BUSY )
+                fBusy = 1;
+        }
+        if ( iThread >= 0 || !fBusy )
+            break;
+#ifdef ABC_USE_PTHREADS
+        pthread_cond_wait( &p->CondDone, &p->Mutex );
+#endif
+    }
+    if ( iThread >= 0 )
+    {
+        p->pWorkers[iThread].State = UTIL_POOL_IDLE;
+        p->iNext = (iThread + 1) % p->nThreads;
+        if ( ppArg )
+            *ppArg = p->pWorkers[iThread].pArg;
+    }
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_unlock( &p->Mutex );
+#endif
+    return iThread;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Waits till all tasks are finished.]
+
+  Description [The finished tasks are not collected; all workers become idle.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_PoolWaitAll( Util_Pool_t * p )
+{
+    while ( Util_PoolWaitAny( p, NULL ) >= 0 );
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
@@ -0,0 +1,72 @@
+/**CFile****************************************************************
+
+  FileName    [utilPool.h]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Thread pool utilities.]
+
+  Synopsis    [Pool of blocking worker threads.]
+
+  Author      []
+
+  Affiliation []
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: utilPool.h,v 1.00 2026/10/18 00:00:00 Exp $]
+
+***********************************************************************/
+
+#ifndef ABC__misc__util__utilPool_h
+#define ABC__misc__util__utilPool_h
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include "misc/util/abc_global.h"
+
+////////////////////////////////////////////////////////////////////////
+///                         PARAMETERS                               ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_HEADER_START
+
+////////////////////////////////////////////////////////////////////////
+///                         BASIC TYPES                              ///
+////////////////////////////////////////////////////////////////////////
+
+// the pool of worker threads
+typedef struct Util_Pool_t_ Util_Pool_t;
+
+// the task executed by a worker (the task, the worker's index, the worker's scratch memory)
+typedef void (*Util_PoolFunc_t)( void * pArg, int iThread, void * pScratch );
+
+////////////////////////////////////////////////////////////////////////
+///                      MACRO DEFINITIONS                           ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                    FUNCTION DECLARATIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/*=== utilPool.c ==========================================================*/
+
+extern Util_Pool_t * Util_PoolStart( int nThreads, int nScratch );
+extern void          Util_PoolStop( Util_Pool_t * p );
+extern int           Util_PoolThreadNum( Util_Pool_t * p );
+extern void *        Util_PoolScratch( Util_Pool_t * p, int iThread );
+extern int           Util_PoolIsBusy( Util_Pool_t * p, int iThread );
+extern int           Util_PoolFindIdle( Util_Pool_t * p );
+extern void          Util_PoolAssign( Util_Pool_t * p, int iThread, Util_PoolFunc_t pFunc, void * pArg );
+extern int           Util_PoolWaitAny( Util_Pool_t * p, void ** ppArg );
+extern void          Util_PoolWaitAll( Util_Pool_t * p );
+
+ABC_NAMESPACE_HEADER_END
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
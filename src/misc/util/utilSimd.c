@@ -0,0 +1,474 @@
+/**CFile****************************************************************
+
+  FileName    [utilSimd.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [SIMD utilities.]
+
+  Synopsis    [Runtime-dispatched kernels for bit-parallel simulation.]
+
+  Author      []
+
+  Affiliation []
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: utilSimd.c,v 1.00 2026/10/18 00:00:00 Exp $]
+
+***********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "abc_global.h"
+#include "utilSimd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(ABC_NO_SIMD)
+#define UTIL_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+/*
+    The simulators compute AND and XOR of two fanin arrays, each of which
+    may be complemented. Each complement case has its own kernel, so that
+    the inner loop has no per-word complement handling. The kernels exist
+    in three versions (scalar, AVX2 and AVX-512), which are compiled with
+    the function-level target attribute, so the rest of the code does not
+    need any special compiler flags. The version is chosen once, at the
+    first call, depending on what the CPU supports; with pthreads, the
+    detection runs under pthread_once(), so the threads calling the
+    kernels for the first time do not race on the level. The arrays are accessed
+    with unaligned loads and stores, and the words that do not fill a whole
+    register are processed by the scalar loop. The AND kernels also exist
+    for arrays of 32-bit words, which are used by the older simulators,
+    so that these arrays are never accessed through a 64-bit pointer.
+*/
+
+typedef void (*Util_SimdFunc_t)( word * pOut, word * p0, word * p1, int nWords );
+typedef void (*Util_SimdFuncUns_t)( unsigned * pOut, unsigned * p0, unsigned * p1, int nWords );
+
+static int s_SimdLevel    = -1;   // the current level
+static int s_SimdLevelMax = -1;   // the best level supported by the CPU
+#ifdef ABC_USE_PTHREADS
+static pthread_once_t s_SimdLevelOnce = PTHREAD_ONCE_INIT;
+#endif
+
+// the scalar kernels
+#define UTIL_SIMD_SCALAR_KERNEL( Name, Type, Expr )                            \
+static void Name( Type * pOut, Type * p0, Type * p1, int nWords )             \
+{                                                                             \
+    int w;                                                                    \
+    for ( w = 0; w < nWords; w++ )                                            \
+        pOut[w] = Expr;                                                       \
+}
+
+UTIL_SIMD_SCALAR_KERNEL( Util_SimdAnd00Scalar, word,  p0[w] &  p1[w] )
+UTIL_SIMD_SCALAR_KERNEL( Util_SimdAnd01Scalar, word,  p0[w] & ~p1[w] )
+UTIL_SIMD_SCALAR_KERNEL( Util_SimdAnd10Scalar, word, ~p0[w] &  p1[w] )
+UTIL_SIMD_SCALAR_KERNEL( Util_SimdAnd11Scalar, word, ~(p0[w] | p1[w]) )
+UTIL_SIMD_SCALAR_KERNEL( Util_SimdXor0Scalar,  word,  p0[w] ^  p1[w] )
+UTIL_SIMD_SCALAR_KERNEL( Util_SimdXor1Scalar,  word, ~(p0[w] ^ p1[w]) )
+
+UTIL_SIMD_SCALAR_KERNEL( Util_SimdAnd00UnsScalar, unsigned,  p0[w] &  p1[w] )
+UTIL_SIMD_SCALAR_KERNEL( Util_SimdAnd01UnsScalar, unsigned,  p0[w] & ~p1[w] )
+UTIL_SIMD_SCALAR_KERNEL( Util_SimdAnd10UnsScalar, unsigned, ~p0[w] &  p1[w] )
+UTIL_SIMD_SCALAR_KERNEL( Util_SimdAnd11UnsScalar, unsigned, ~(p0[w] | p1[w]) )
+
+#ifdef UTIL_SIMD_X86
+
+// the AVX2 kernels (four 64-bit words per instruction)
+#define UTIL_SIMD_AVX2_KERNEL( Name, Type, VecExpr, Expr )                     \
+__attribute__((target("avx2")))                                               \
+static void Name( Type * pOut, Type * p0, Type * p1, int nWords )             \
+{                                                                             \
+    __m256i a, b, Ones = _mm256_set1_epi64x( -1 );                            \
+    int w, nStep = (int)(sizeof(__m256i) / sizeof(Type));                     \
+    (void)Ones;                                                               \
+    for ( w = 0; w + nStep <= nWords; w += nStep )                            \
+    {                                                                         \
+        a = _mm256_loadu_si256( (__m256i const *)(p0 + w) );                  \
+        b = _mm256_loadu_si256( (__m256i const *)(p1 + w) );                  \
+        _mm256_storeu_si256( (__m256i *)(pOut + w), VecExpr );                \
+    }                                                                         \
+    for ( ; w < nWords; w++ )                                                 \
+        pOut[w] = Expr;                                                       \
+}
+
+UTIL_SIMD_AVX2_KERNEL( Util_SimdAnd00Avx2, word, _mm256_and_si256(a, b),                    p0[w] &  p1[w] )
+UTIL_SIMD_AVX2_KERNEL( Util_SimdAnd01Avx2, word, _mm256_andnot_si256(b, a),                 p0[w] & ~p1[w] )
+UTIL_SIMD_AVX2_KERNEL( Util_SimdAnd10Avx2, word, _mm256_andnot_si256(a, b),                ~p0[w] &  p1[w] )
+UTIL_SIMD_AVX2_KERNEL( Util_SimdAnd11Avx2, word, _mm256_xor_si256(_mm256_or_si256(a, b), Ones), ~(p0[w] | p1[w]) )
+UTIL_SIMD_AVX2_KERNEL( Util_SimdXor0Avx2,  word, _mm256_xor_si256(a, b),                    p0[w] ^  p1[w] )
+UTIL_SIMD_AVX2_KERNEL( Util_SimdXor1Avx2,  word, _mm256_xor_si256(_mm256_xor_si256(a, b), Ones), ~(p0[w] ^ p1[w]) )
+
+UTIL_SIMD_AVX2_KERNEL( Util_SimdAnd00UnsAvx2, unsigned, _mm256_and_si256(a, b),                    p0[w] &  p1[w] )
+UTIL_SIMD_AVX2_KERNEL( Util_SimdAnd01UnsAvx2, unsigned, _mm256_andnot_si256(b, a),                 p0[w] & ~p1[w] )
+UTIL_SIMD_AVX2_KERNEL( Util_SimdAnd10UnsAvx2, unsigned, _mm256_andnot_si256(a, b),                ~p0[w] &  p1[w] )
+UTIL_SIMD_AVX2_KERNEL( Util_SimdAnd11UnsAvx2, unsigned, _mm256_xor_si256(_mm256_or_si256(a, b), Ones), ~(p0[w] | p1[w]) )
+
+// the AVX-512 kernels (eight 64-bit words per instruction; the complemented
+// cases use the ternary logic instruction with the truth table of the
+// function of A = 0xF0 and B = 0xCC)
+#define UTIL_SIMD_AVX512_KERNEL( Name, Type, VecExpr, Expr )                   \
+__attribute__((target("avx512f")))                                            \
+static void Name( Type * pOut, Type * p0, Type * p1, int nWords )             \
+{                                                                             \
+    __m512i a, b;                                                             \
+    int w, nStep = (int)(sizeof(__m512i) / sizeof(Type));                     \
+    for ( w = 0; w + nStep <= nWords; w += nStep )                            \
+    {                                                                         \
+        a = _mm512_loadu_si512( (void const *)(p0 + w) );                     \
+        b = _mm512_loadu_si512( (void const *)(p1 + w) );                     \
+        _mm512_storeu_si512( (void *)(pOut + w), VecExpr );                   \
+    }                                                                         \
+    for ( ; w < nWords; w++ )                                                 \
+        pOut[w] = Expr;                                                       \
+}
+
+UTIL_SIMD_AVX512_KERNEL( Util_SimdAnd00Avx512, word, _mm512_and_si512(a, b),                  p0[w] &  p1[w] )
+UTIL_SIMD_AVX512_KERNEL( Util_SimdAnd01Avx512, word, _mm512_andnot_si512(b, a),               p0[w] & ~p1[w] )
+UTIL_SIMD_AVX512_KERNEL( Util_SimdAnd10Avx512, word, _mm512_andnot_si512(a, b),              ~p0[w] &  p1[w] )
+UTIL_SIMD_AVX512_KERNEL( Util_SimdAnd11Avx512, word, _mm512_ternarylogic_epi64(a, b, b, 0x03), ~(p0[w] | p1[w]) )
+UTIL_SIMD_AVX512_KERNEL( Util_SimdXor0Avx512,  word, _mm512_xor_si512(a, b),                  p0[w] ^  p1[w] )
+UTIL_SIMD_AVX512_KERNEL( Util_SimdXor1Avx512,  word, _mm512_ternarylogic_epi64(a, b, b, 0xC3), ~(p0[w] ^ p1[w]) )
+
+UTIL_SIMD_AVX512_KERNEL( Util_SimdAnd00UnsAvx512, unsigned, _mm512_and_si512(a, b),                  p0[w] &  p1[w] )
+UTIL_SIMD_AVX512_KERNEL( Util_SimdAnd01UnsAvx512, unsigned, _mm512_andnot_si512(b, a),               p0[w] & ~p1[w] )
+UTIL_SIMD_AVX512_KERNEL( Util_SimdAnd10UnsAvx512, unsigned, _mm512_andnot_si512(a, b),              ~p0[w] &  p1[w] )
+UTIL_SIMD_AVX512_KERNEL( Util_SimdAnd11UnsAvx512, unsigned, _mm512_ternarylogic_epi64(a, b, b, 0x03), ~(p0[w] | p1[w]) )
+
+#else
+
+#define Util_SimdAnd00Avx2    Util_SimdAnd00Scalar
+#define Util_SimdAnd01Avx2    Util_SimdAnd01Scalar
+#define Util_SimdAnd10Avx2    Util_SimdAnd10Scalar
+#define Util_SimdAnd11Avx2    Util_SimdAnd11Scalar
+#define Util_SimdXor0Avx2     Util_SimdXor0Scalar
+#define Util_SimdXor1Avx2     Util_SimdXor1Scalar
+#define Util_SimdAnd00Avx512  Util_SimdAnd00Scalar
+#define Util_SimdAnd01Avx512  Util_SimdAnd01Scalar
+#define Util_SimdAnd10Avx512  Util_SimdAnd10Scalar
+#define Util_SimdAnd11Avx512  Util_SimdAnd11Scalar
+#define Util_SimdXor0Avx512   Util_SimdXor0Scalar
+#define Util_SimdXor1Avx512   Util_SimdXor1Scalar
+#define Util_SimdAnd00UnsAvx2    Util_SimdAnd00UnsScalar
+#define Util_SimdAnd01UnsAvx2    Util_SimdAnd01UnsScalar
+#define Util_SimdAnd10UnsAvx2    Util_SimdAnd10UnsScalar
+#define Util_SimdAnd11UnsAvx2    Util_SimdAnd11UnsScalar
+#define Util_SimdAnd00UnsAvx512  Util_SimdAnd00UnsScalar
+#define Util_SimdAnd01UnsAvx512  Util_SimdAnd01UnsScalar
+#define Util_SimdAnd10UnsAvx512  Util_SimdAnd10UnsScalar
+#define Util_SimdAnd11UnsAvx512  Util_SimdAnd11UnsScalar
+
+#endif
+
+// the kernels indexed by the level and the complement attributes (2*fCompl0 + fCompl1)
+static Util_SimdFunc_t s_SimdAndFuncs[3][4] = {
+    { Util_SimdAnd00Scalar, Util_SimdAnd01Scalar, Util_SimdAnd10Scalar, Util_SimdAnd11Scalar },
+    { Util_SimdAnd00Avx2,   Util_SimdAnd01Avx2,   Util_SimdAnd10Avx2,   Util_SimdAnd11Avx2   },
+    { Util_SimdAnd00Avx512, Util_SimdAnd01Avx512, Util_SimdAnd10Avx512, Util_SimdAnd11Avx512 }
+};
+static Util_SimdFunc_t s_SimdXorFuncs[3][2] = {
+    { Util_SimdXor0Scalar,  Util_SimdXor1Scalar  },
+    { Util_SimdXor0Avx2,    Util_SimdXor1Avx2    },
+    { Util_SimdXor0Avx512,  Util_SimdXor1Avx512  }
+};
+static Util_SimdFuncUns_t s_SimdAndUnsFuncs[3][4] = {
+    { Util_SimdAnd00UnsScalar, Util_SimdAnd01UnsScalar, Util_SimdAnd10UnsScalar, Util_SimdAnd11UnsScalar },
+    { Util_SimdAnd00UnsAvx2,   Util_SimdAnd01UnsAvx2,   Util_SimdAnd10UnsAvx2,   Util_SimdAnd11UnsAvx2   },
+    { Util_SimdAnd00UnsAvx512, Util_SimdAnd01UnsAvx512, Util_SimdAnd10UnsAvx512, Util_SimdAnd11UnsAvx512 }
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the best level supported by the CPU.]
+
+  Description [The check also verifies that the OS saves the wide registers.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Util_SimdLevelDetect()
+{
+#ifdef UTIL_SIMD_X86
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports("avx512f") )
+        return UTIL_SIMD_AVX512;
+    if ( __builtin_cpu_supports("avx2") )
+        return UTIL_SIMD_AVX2;
+#endif
+    return UTIL_SIMD_SCALAR;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Detects the level and makes it the current one.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Util_SimdLevelInit()
+{
+    s_SimdLevelMax = Util_SimdLevelDetect();
+    s_SimdLevel = s_SimdLevelMax;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the level of the kernels used.]
+
+  Description [The level is detected at the first call. With pthreads,
+  the detection is done exactly once, and the threads that call this
+  function concurrently wait till it is finished.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Util_SimdLevel()
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_once( &s_SimdLevelOnce, Util_SimdLevelInit );
+#else
+    if ( s_SimdLevel < 0 )
+        Util_SimdLevelInit();
+#endif
+    return s_SimdLevel;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the best level supported by the CPU.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Util_SimdLevelMax()
+{
+    Util_SimdLevel();
+    return s_SimdLevelMax;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Sets the level of the kernels used.]
+
+  Description [The level is limited by what the CPU supports. Returns the
+  previous level.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Util_SimdSetLevel( int Level )
+{
+    int LevelOld = Util_SimdLevel();
+    s_SimdLevel = Abc_MaxInt( UTIL_SIMD_SCALAR, Abc_MinInt(Level, s_SimdLevelMax) );
+    return LevelOld;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the name of the level.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+char * Util_SimdLevelName( int Level )
+{
+    if ( Level == UTIL_SIMD_AVX512 )
+        return "AVX-512";
+    if ( Level == UTIL_SIMD_AVX2 )
+        return "AVX2";
+    return "scalar";
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Calls the AND kernel.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_SimdAndInt( word * pOut, word * p0, word * p1, int fCompl0, int fCompl1, int nWords )
+{
+    s_SimdAndFuncs[Util_SimdLevel()][2*(fCompl0 != 0) + (fCompl1 != 0)]( pOut, p0, p1, nWords );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Calls the AND kernel for 32-bit words.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_SimdAndUnsInt( unsigned * pOut, unsigned * p0, unsigned * p1, int fCompl0, int fCompl1, int nWords )
+{
+    s_SimdAndUnsFuncs[Util_SimdLevel()][2*(fCompl0 != 0) + (fCompl1 != 0)]( pOut, p0, p1, nWords );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Calls the XOR kernel.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_SimdXorInt( word * pOut, word * p0, word * p1, int fCompl, int nWords )
+{
+    s_SimdXorFuncs[Util_SimdLevel()][fCompl != 0]( pOut, p0, p1, nWords );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Compares the kernels of all supported levels.]
+
+  Description [Runs each of the six kernels nIters times on random arrays
+  of nWords words, checks that the results of each level (including the
+  AND kernels for 32-bit words) are equal to those of the scalar loop and
+  prints the runtime and the speedup.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_SimdBench( int nWords, int nIters, int fVerbose )
+{
+    word * p0   = ABC_ALLOC( word, nWords + 1 );
+    word * p1   = ABC_ALLOC( word, nWords + 1 );
+    word * pOut = ABC_ALLOC( word, nWords + 1 );
+    word * pRes = ABC_ALLOC( word, 6 * nWords );
+    unsigned * pUns0   = ABC_ALLOC( unsigned, 2 * nWords );
+    unsigned * pUns1   = ABC_ALLOC( unsigned, 2 * nWords );
+    unsigned * pUnsOut = ABC_ALLOC( unsigned, 2 * nWords );
+    unsigned * pUnsRes = ABC_ALLOC( unsigned, 2 * nWords );
+    abctime clk, clkScalar = 0;
+    int LevelMax = Util_SimdLevelMax();
+    int Level, k, i, w, nErrors;
+    Abc_RandomW( 1 );
+    for ( w = 0; w <= nWords; w++ )
+    {
+        p0[w] = Abc_RandomW( 0 );
+        p1[w] = Abc_RandomW( 0 );
+    }
+    for ( w = 0; w < 2 * nWords; w++ )
+    {
+        pUns0[w] = Abc_Random( 0 );
+        pUns1[w] = Abc_Random( 0 );
+    }
+    printf( "Comparing simulation kernels on %d words (%d iterations). The CPU supports %s.\n",
+        nWords, nIters, Util_SimdLevelName(LevelMax) );
+    for ( Level = UTIL_SIMD_SCALAR; Level <= LevelMax; Level++ )
+    {
+        nErrors = 0;
+        clk = Abc_Clock();
+        for ( k = 0; k < 6; k++ )
+        {
+            Util_SimdFunc_t pFunc = k < 4 ? s_SimdAndFuncs[Level][k] : s_SimdXorFuncs[Level][k-4];
+            for ( i = 0; i < nIters; i++ )
+                pFunc( pOut, p0, p1, nWords );
+            if ( Level == UTIL_SIMD_SCALAR )
+                memcpy( pRes + k * nWords, pOut, sizeof(word) * nWords );
+            else if ( memcmp( pRes + k * nWords, pOut, sizeof(word) * nWords ) )
+                nErrors++;
+        }
+        clk = Abc_Clock() - clk;
+        if ( Level == UTIL_SIMD_SCALAR )
+            clkScalar = clk;
+        // check the unaligned arrays with a tail
+        for ( k = 0; Level > UTIL_SIMD_SCALAR && k < 6 && nWords > 1; k++ )
+        {
+            Util_SimdFunc_t pFunc = k < 4 ? s_SimdAndFuncs[Level][k] : s_SimdXorFuncs[Level][k-4];
+            Util_SimdFunc_t pGold = k < 4 ? s_SimdAndFuncs[0][k]     : s_SimdXorFuncs[0][k-4];
+            pFunc( pOut, p0 + 1, p1, nWords - 1 );
+            pGold( pRes, p0 + 1, p1, nWords - 1 );
+            if ( memcmp( pRes, pOut, sizeof(word) * (nWords - 1) ) )
+                nErrors++;
+        }
+        // check the kernels for 32-bit words (the arrays are unaligned and have a tail)
+        for ( k = 0; Level > UTIL_SIMD_SCALAR && k < 4; k++ )
+        {
+            s_SimdAndUnsFuncs[Level][k]( pUnsOut, pUns0 + 1, pUns1, 2 * nWords - 1 );
+            s_SimdAndUnsFuncs[0][k]( pUnsRes, pUns0 + 1, pUns1, 2 * nWords - 1 );
+            if ( memcmp( pUnsRes, pUnsOut, sizeof(unsigned) * (2 * nWords - 1) ) )
+                nErrors++;
+        }
+        // restore the scalar result of the first kernel
+        if ( Level > UTIL_SIMD_SCALAR )
+            s_SimdAndFuncs[0][0]( pRes, p0, p1, nWords );
+        printf( "%-8s : ", Util_SimdLevelName(Level) );
+        printf( "%8.2f Gwords/sec  ", clk ? 1.0 * 6 * nWords * nIters * CLOCKS_PER_SEC / clk / 1000000000 : 0.0 );
+        printf( "Speedup = %5.2f  ", clk ? 1.0 * clkScalar / clk : 0.0 );
+        printf( "%s  ", nErrors ? "MISMATCH" : "Verified" );
+        Abc_PrintTime( 1, "Time", clk );
+    }
+    if ( fVerbose )
+        printf( "The simulators use the %s kernels for arrays of %d words or more.\n", Util_SimdLevelName(Util_SimdLevel()), UTIL_SIMD_MIN_WORDS );
+    ABC_FREE( p0 );
+    ABC_FREE( p1 );
+    ABC_FREE( pOut );
+    ABC_FREE( pRes );
+    ABC_FREE( pUns0 );
+    ABC_FREE( pUns1 );
+    ABC_FREE( pUnsOut );
+    ABC_FREE( pUnsRes );
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
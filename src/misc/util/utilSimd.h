@@ -0,0 +1,158 @@
+/**CFile****************************************************************
+
+  FileName    [utilSimd.h]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [SIMD utilities.]
+
+  Synopsis    [Runtime-dispatched kernels for bit-parallel simulation.]
+
+  Author      []
+
+  Affiliation []
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: utilSimd.h,v 1.00 2026/10/18 00:00:00 Exp $]
+
+***********************************************************************/
+
+#ifndef ABC__misc__util__utilSimd_h
+#define ABC__misc__util__utilSimd_h
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include "misc/util/abc_global.h"
+
+////////////////////////////////////////////////////////////////////////
+///                         PARAMETERS                               ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_HEADER_START
+
+// the instruction sets used by the kernels
+#define UTIL_SIMD_SCALAR    0
+#define UTIL_SIMD_AVX2      1
+#define UTIL_SIMD_AVX512    2
+
+// below this number of words, the inlined scalar loop is faster than the call
+#define UTIL_SIMD_MIN_WORDS 8
+
+////////////////////////////////////////////////////////////////////////
+///                         BASIC TYPES                              ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                      MACRO DEFINITIONS                           ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                    FUNCTION DECLARATIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/*=== utilSimd.c ==========================================================*/
+
+extern int           Util_SimdLevel();
+extern int           Util_SimdLevelMax();
+extern int           Util_SimdSetLevel( int Level );
+extern char *        Util_SimdLevelName( int Level );
+extern void          Util_SimdAndInt( word * pOut, word * p0, word * p1, int fCompl0, int fCompl1, int nWords );
+extern void          Util_SimdAndUnsInt( unsigned * pOut, unsigned * p0, unsigned * p1, int fCompl0, int fCompl1, int nWords );
+extern void          Util_SimdXorInt( word * pOut, word * p0, word * p1, int fCompl, int nWords );
+extern void          Util_SimdBench( int nWords, int nIters, int fVerbose );
+
+/**Function*************************************************************
+
+  Synopsis    [Computes pOut = (p0 ^ fCompl0) & (p1 ^ fCompl1).]
+
+  Description [Short arrays are processed inline; longer ones are given
+  to the kernel selected for this CPU.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Util_SimdAnd( word * pOut, word * p0, word * p1, int fCompl0, int fCompl1, int nWords )
+{
+    int w;
+    if ( nWords >= UTIL_SIMD_MIN_WORDS )
+        Util_SimdAndInt( pOut, p0, p1, fCompl0, fCompl1, nWords );
+    else if ( fCompl0 && fCompl1 )
+        for ( w = 0; w < nWords; w++ )
+            pOut[w] = ~(p0[w] | p1[w]);
+    else if ( fCompl0 )
+        for ( w = 0; w < nWords; w++ )
+            pOut[w] = ~p0[w] & p1[w];
+    else if ( fCompl1 )
+        for ( w = 0; w < nWords; w++ )
+            pOut[w] = p0[w] & ~p1[w];
+    else
+        for ( w = 0; w < nWords; w++ )
+            pOut[w] = p0[w] & p1[w];
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes pOut = (p0 ^ fCompl0) & (p1 ^ fCompl1) for 32-bit words.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Util_SimdAndUns( unsigned * pOut, unsigned * p0, unsigned * p1, int fCompl0, int fCompl1, int nWords )
+{
+    int w;
+    if ( nWords >= 2 * UTIL_SIMD_MIN_WORDS )
+        Util_SimdAndUnsInt( pOut, p0, p1, fCompl0, fCompl1, nWords );
+    else if ( fCompl0 && fCompl1 )
+        for ( w = 0; w < nWords; w++ )
+            pOut[w] = ~(p0[w] | p1[w]);
+    else if ( fCompl0 )
+        for ( w = 0; w < nWords; w++ )
+            pOut[w] = ~p0[w] & p1[w];
+    else if ( fCompl1 )
+        for ( w = 0; w < nWords; w++ )
+            pOut[w] = p0[w] & ~p1[w];
+    else
+        for ( w = 0; w < nWords; w++ )
+            pOut[w] = p0[w] & p1[w];
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes pOut = p0 ^ p1 ^ fCompl.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Util_SimdXor( word * pOut, word * p0, word * p1, int fCompl, int nWords )
+{
+    int w;
+    if ( nWords >= UTIL_SIMD_MIN_WORDS )
+        Util_SimdXorInt( pOut, p0, p1, fCompl, nWords );
+    else if ( fCompl )
+        for ( w = 0; w < nWords; w++ )
+            pOut[w] = ~(p0[w] ^ p1[w]);
+    else
+        for ( w = 0; w < nWords; w++ )
+            pOut[w] = p0[w] ^ p1[w];
+}
+
+ABC_NAMESPACE_HEADER_END
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
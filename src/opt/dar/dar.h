@@ -52,6 +52,9 @@ struct Dar_RwrPar_t_
     int              fUseZeros;      // performs zero-cost replacement
     int              fPower;         // enables power-aware rewriting
     int              fRecycle;       // enables cut recycling
+    int              nProcs;         // the number of threads rewriting the windows
+    int              nWinMax;        // the maximum number of nodes in a window
+    int              fVerify;        // verifies the result of partitioned rewriting
     int              fVerbose;       // enables verbose output
     int              fVeryVerbose;   // enables very verbose output
 };
@@ -92,6 +95,7 @@ extern void            Dar_BalancePrintStats( Aig_Man_t * p );
 /*=== darCore.c ========================================================*/
 extern void            Dar_ManDefaultRwrParams( Dar_RwrPar_t * pPars );
 extern int             Dar_ManRewrite( Aig_Man_t * pAig, Dar_RwrPar_t * pPars );
+extern Aig_Man_t *     Dar_ManRewritePar( Aig_Man_t * pAig, Dar_RwrPar_t * pPars );
 extern Aig_MmFixed_t * Dar_ManComputeCuts( Aig_Man_t * pAig, int nCutsMax, int fSkipTtMin, int fVerbose );
 /*=== darRefact.c ========================================================*/
 extern void            Dar_ManDefaultRefParams( Dar_RefPar_t * pPars );
@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "darInt.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -33,6 +34,20 @@ ABC_NAMESPACE_IMPL_START
           p->iNext && (((pObj) = Aig_ManObj(p, p->iNext)), 1);                  \
           p->iNext = p->pOrderData[2*p->iPrev+1] )
 
+// window of the AIG rewritten by one thread
+typedef struct Dar_ParWin_t_ Dar_ParWin_t;
+struct Dar_ParWin_t_
+{
+    Vec_Ptr_t *      vNodes;         // the nodes of the window in a topological order
+    Vec_Ptr_t *      vIns;           // the inputs of the window
+    Vec_Ptr_t *      vOuts;          // the outputs of the window
+    Aig_Man_t *      pWin;           // the AIG of the window
+    Dar_RwrPar_t *   pPars;          // the rewriting parameters of the threads
+    int              nNodesBeg;      // the number of nodes before rewriting
+    int              nNodesEnd;      // the number of nodes after rewriting
+    abctime          clkRwr;         // the runtime of rewriting
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -59,6 +74,9 @@ void Dar_ManDefaultRwrParams( Dar_RwrPar_t * pPars )
     pPars->fUseZeros    =  0;
     pPars->fPower       =  0;
     pPars->fRecycle     =  1;
+    pPars->nProcs       =  1;
+    pPars->nWinMax      =  5000;
+    pPars->fVerify      =  0;
     pPars->fVerbose     =  0;
     pPars->fVeryVerbose =  0;
 }
@@ -247,6 +265,265 @@ p->timeOther = p->timeTotal - p->timeCuts - p->timeEval;
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Divides the AIG into windows rewritten independently.]
+
+  Description [The nodes are taken in the DFS order and cut into windows 
+  of at most nWinMax nodes, so that the fanins of a window belong to the 
+  window itself or to the previous windows. The windows do not overlap.
+  The inputs of a window are its fanins outside of it. The outputs are 
+  its nodes used by the nodes of other windows or by the COs.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Vec_Ptr_t * Dar_ManParWindows( Aig_Man_t * pAig, int nWinMax )
+{
+    Vec_Ptr_t * vWins = Vec_PtrAlloc( 100 );
+    Vec_Ptr_t * vDfs = Aig_ManDfs( pAig, 1 );
+    Vec_Str_t * vIsOut = Vec_StrStart( Aig_ManObjNumMax(pAig) );
+    Dar_ParWin_t * pWin = NULL;
+    Aig_Obj_t * pObj, * pFanin;
+    int i, k, f;
+    // assign the nodes to the windows
+    Vec_PtrForEachEntry( Aig_Obj_t *, vDfs, pObj, i )
+    {
+        if ( pWin == NULL || Vec_PtrSize(pWin->vNodes) == nWinMax )
+        {
+            pWin = ABC_CALLOC( Dar_ParWin_t, 1 );
+            pWin->vNodes = Vec_PtrAlloc( nWinMax );
+            pWin->vIns   = Vec_PtrAlloc( 100 );
+            pWin->vOuts  = Vec_PtrAlloc( 100 );
+            Vec_PtrPush( vWins, pWin );
+        }
+        Vec_PtrPush( pWin->vNodes, pObj );
+    }
+    // mark the nodes used outside of their windows
+    Aig_ManForEachCo( pAig, pObj, i )
+        if ( Aig_ObjIsNode(Aig_ObjFanin0(pObj)) )
+            Vec_StrWriteEntry( vIsOut, Aig_ObjFaninId0(pObj), 1 );
+    Vec_PtrForEachEntry( Dar_ParWin_t *, vWins, pWin, i )
+    {
+        Aig_ManIncrementTravId( pAig );
+        Vec_PtrForEachEntry( Aig_Obj_t *, pWin->vNodes, pObj, k )
+            Aig_ObjSetTravIdCurrent( pAig, pObj );
+        Vec_PtrForEachEntry( Aig_Obj_t *, pWin->vNodes, pObj, k )
+            for ( f = 0; f < 2; f++ )
+            {
+                pFanin = f ? Aig_ObjFanin1(pObj) : Aig_ObjFanin0(pObj);
+                if ( Aig_ObjIsConst1(pFanin) || Aig_ObjIsTravIdCurrent(pAig, pFanin) )
+                    continue;
+                Aig_ObjSetTravIdCurrent( pAig, pFanin );
+                Vec_PtrPush( pWin->vIns, pFanin );
+                if ( Aig_ObjIsNode(pFanin) )
+                    Vec_StrWriteEntry( vIsOut, pFanin->Id, 1 );
+            }
+    }
+    // collect the outputs in the order of the nodes
+    Vec_PtrForEachEntry( Dar_ParWin_t *, vWins, pWin, i )
+        Vec_PtrForEachEntry( Aig_Obj_t *, pWin->vNodes, pObj, k )
+            if ( Vec_StrEntry(vIsOut, pObj->Id) )
+                Vec_PtrPush( pWin->vOuts, pObj );
+    Vec_StrFree( vIsOut );
+    Vec_PtrFree( vDfs );
+    return vWins;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the AIG of the window.]
+
+  Description []
+               
+  SideEffects [Uses the pData fields of the window objects.]
+
+  SeeAlso     []
+
+***********************************************************************/
+static Aig_Man_t * Dar_ManParWindowAig( Aig_Man_t * pAig, Dar_ParWin_t * pWin )
+{
+    Aig_Man_t * pNew;
+    Aig_Obj_t * pObj;
+    int i;
+    pNew = Aig_ManStart( Vec_PtrSize(pWin->vNodes) );
+    Aig_ManConst1(pAig)->pData = Aig_ManConst1(pNew);
+    Vec_PtrForEachEntry( Aig_Obj_t *, pWin->vIns, pObj, i )
+        pObj->pData = Aig_ObjCreateCi( pNew );
+    Vec_PtrForEachEntry( Aig_Obj_t *, pWin->vNodes, pObj, i )
+        pObj->pData = Aig_And( pNew, Aig_ObjChild0Copy(pObj), Aig_ObjChild1Copy(pObj) );
+    Vec_PtrForEachEntry( Aig_Obj_t *, pWin->vOuts, pObj, i )
+        Aig_ObjCreateCo( pNew, (Aig_Obj_t *)pObj->pData );
+    return pNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Rewrites one window.]
+
+  Description [Runs in a worker thread. The window AIG is owned by the 
+  thread, while the library is only read.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Dar_ManParTask( void * pArg, int iThread, void * pScratch )
+{
+    Dar_ParWin_t * pWin = (Dar_ParWin_t *)pArg;
+    Aig_Man_t * pTemp;
+    abctime clk = Abc_Clock();
+    pWin->nNodesBeg = Aig_ManNodeNum( pWin->pWin );
+    Dar_ManRewrite( pWin->pWin, pWin->pPars );
+    pWin->pWin = Aig_ManDupDfs( pTemp = pWin->pWin );
+    Aig_ManStop( pTemp );
+    pWin->nNodesEnd = Aig_ManNodeNum( pWin->pWin );
+    pWin->clkRwr = Abc_Clock() - clk;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Stitches the rewritten windows into the new AIG.]
+
+  Description [The windows are added in their order, so that the inputs 
+  of each window are already available. The nodes are structurally hashed, 
+  which merges the logic duplicated across the windows.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Aig_Man_t * Dar_ManParStitch( Aig_Man_t * pAig, Vec_Ptr_t * vWins )
+{
+    Dar_ParWin_t * pWin;
+    Aig_Man_t * pNew;
+    Aig_Obj_t * pObj;
+    int i, k;
+    pNew = Aig_ManStart( Aig_ManObjNumMax(pAig) );
+    pNew->pName = Abc_UtilStrsav( pAig->pName );
+    pNew->pSpec = Abc_UtilStrsav( pAig->pSpec );
+    Aig_ManConst1(pAig)->pData = Aig_ManConst1(pNew);
+    Aig_ManForEachCi( pAig, pObj, i )
+        pObj->pData = Aig_ObjCreateCi( pNew );
+    Vec_PtrForEachEntry( Dar_ParWin_t *, vWins, pWin, i )
+    {
+        Aig_ManConst1(pWin->pWin)->pData = Aig_ManConst1(pNew);
+        Aig_ManForEachCi( pWin->pWin, pObj, k )
+            pObj->pData = ((Aig_Obj_t *)Vec_PtrEntry(pWin->vIns, k))->pData;
+        Aig_ManForEachNode( pWin->pWin, pObj, k )
+            pObj->pData = Aig_And( pNew, Aig_ObjChild0Copy(pObj), Aig_ObjChild1Copy(pObj) );
+        Aig_ManForEachCo( pWin->pWin, pObj, k )
+            ((Aig_Obj_t *)Vec_PtrEntry(pWin->vOuts, k))->pData = Aig_ObjChild0Copy(pObj);
+    }
+    Aig_ManForEachCo( pAig, pObj, i )
+        Aig_ObjCreateCo( pNew, Aig_ObjChild0Copy(pObj) );
+    Aig_ManSetRegNum( pNew, Aig_ManRegNum(pAig) );
+    Aig_ManCleanup( pNew );
+    return pNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs rewriting of the windows using several threads.]
+
+  Description [Divides the AIG into the windows of at most pPars->nWinMax 
+  nodes, rewrites each window by a separate thread and stitches the results 
+  back. The windows are assigned to the threads as soon as they are idle, 
+  while the result does not depend on the timing of the threads. Level-
+  preserving and power-aware rewriting need the information about the 
+  whole AIG, so they are performed by Dar_ManRewrite(). Returns the new AIG.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Aig_Man_t * Dar_ManRewritePar( Aig_Man_t * pAig, Dar_RwrPar_t * pPars )
+{
+    extern int Cec_ManVerifyTwoAigs( Aig_Man_t * pAig0, Aig_Man_t * pAig1, int fVerbose );
+    Dar_RwrPar_t ParsWin, * pParsWin = &ParsWin;
+    Vec_Ptr_t * vWins;
+    Dar_ParWin_t * pWin;
+    Util_Pool_t * pPool;
+    Aig_Man_t * pNew;
+    abctime clk = Abc_Clock(), clkRwr = 0, clkTotal;
+    int i, k, RetValue;
+    if ( pPars->nProcs < 2 || pPars->fUpdateLevel || pPars->fPower )
+    {
+        Dar_ManRewrite( pAig, pPars );
+        return Aig_ManDupDfs( pAig );
+    }
+    // the library is prepared before the threads start reading it
+    Dar_LibPrepare( pPars->nSubgMax );
+    *pParsWin = *pPars;
+    pParsWin->fVerbose = pParsWin->fVeryVerbose = 0;
+    // divide the AIG into the windows
+    Aig_ManCleanup( pAig );
+    vWins = Dar_ManParWindows( pAig, Abc_MaxInt(pPars->nWinMax, 1) );
+    Vec_PtrForEachEntry( Dar_ParWin_t *, vWins, pWin, i )
+    {
+        pWin->pWin  = Dar_ManParWindowAig( pAig, pWin );
+        pWin->pPars = pParsWin;
+    }
+    // rewrite the windows
+    pPool = Util_PoolStart( Abc_MinInt(pPars->nProcs, Vec_PtrSize(vWins)), 0 );
+    Vec_PtrForEachEntry( Dar_ParWin_t *, vWins, pWin, i )
+    {
+        k = Util_PoolFindIdle( pPool );
+        if ( k == -1 )
+            k = Util_PoolWaitAny( pPool, NULL );
+        Util_PoolAssign( pPool, k, Dar_ManParTask, (void *)pWin );
+    }
+    Util_PoolWaitAll( pPool );
+    Util_PoolStop( pPool );
+    // stitch the windows
+    pNew = Dar_ManParStitch( pAig, vWins );
+    clkTotal = Abc_Clock() - clk;
+    if ( pPars->fVerbose )
+    {
+        Vec_PtrForEachEntry( Dar_ParWin_t *, vWins, pWin, i )
+        {
+            clkRwr += pWin->clkRwr;
+            if ( !pPars->fVeryVerbose )
+                continue;
+            printf( "Window %4d : Ins = %6d. Outs = %6d. Beg = %7d. End = %7d. Gain = %6.2f %%  ", 
+                i, Vec_PtrSize(pWin->vIns), Vec_PtrSize(pWin->vOuts), pWin->nNodesBeg, pWin->nNodesEnd, 
+                100.0 * (pWin->nNodesBeg - pWin->nNodesEnd) / Abc_MaxInt(pWin->nNodesBeg, 1) );
+            ABC_PRT( "Time", pWin->clkRwr );
+        }
+        printf( "Windows = %d. Threads = %d. Beg = %d. End = %d. Gain = %6.2f %%.  Rewriting time / total time = %.2f.\n", 
+            Vec_PtrSize(vWins), pPars->nProcs, Aig_ManNodeNum(pAig), Aig_ManNodeNum(pNew), 
+            100.0 * (Aig_ManNodeNum(pAig) - Aig_ManNodeNum(pNew)) / Abc_MaxInt(Aig_ManNodeNum(pAig), 1), 
+            1.0 * clkRwr / Abc_MaxInt((int)clkTotal, 1) );
+        ABC_PRT( "Total time", clkTotal );
+    }
+    // verify the result
+    if ( pPars->fVerify )
+    {
+        RetValue = Cec_ManVerifyTwoAigs( pAig, pNew, 0 );
+        if ( RetValue == 1 )
+            printf( "Verification of partitioned rewriting succeeded.\n" );
+        else if ( RetValue == 0 )
+            printf( "Verification of partitioned rewriting FAILED.\n" );
+        else
+            printf( "Verification of partitioned rewriting is undecided.\n" );
+    }
+    Vec_PtrForEachEntry( Dar_ParWin_t *, vWins, pWin, i )
+    {
+        Aig_ManStop( pWin->pWin );
+        Vec_PtrFree( pWin->vNodes );
+        Vec_PtrFree( pWin->vIns );
+        Vec_PtrFree( pWin->vOuts );
+        ABC_FREE( pWin );
+    }
+    Vec_PtrFree( vWins );
+    return pNew;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Computes the total number of cuts.]
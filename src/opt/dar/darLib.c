@@ -31,7 +31,6 @@ ABC_NAMESPACE_IMPL_START
 
 typedef struct Dar_Lib_t_            Dar_Lib_t;
 typedef struct Dar_LibObj_t_         Dar_LibObj_t;
-typedef struct Dar_LibDat_t_         Dar_LibDat_t;
 
 struct Dar_LibObj_t_ // library object (2 words)
 {
@@ -110,6 +109,10 @@ static Dar_Lib_t * s_DarLib = NULL;
 static inline Dar_LibObj_t * Dar_LibObj( Dar_Lib_t * p, int Id )    { return p->pObjs + Id; }
 static inline int            Dar_LibObjTruth( Dar_LibObj_t * pObj ) { return pObj->Num < (0xFFFF & ~pObj->Num) ? pObj->Num : (0xFFFF & ~pObj->Num); }
 
+// the numbers of library objects used by one rewriting manager
+static inline int            Dar_LibObjNum( Dar_Man_t * p, Dar_LibObj_t * pObj )              { return p->pNums[pObj - s_DarLib->pObjs];        }
+static inline void           Dar_LibObjSetNum( Dar_Man_t * p, Dar_LibObj_t * pObj, int Num )  { p->pNums[pObj - s_DarLib->pObjs] = Num;         }
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -619,6 +622,47 @@ void Dar_LibStop()
     s_DarLib = NULL;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Allocates the library data of the rewriting manager.]
+
+  Description [Each manager keeps its own numbering of the library objects
+  and its own object data, so that several managers can evaluate cuts
+  at the same time. The library should be prepared before this call.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Dar_LibDataStart( Dar_Man_t * p )
+{
+    int i;
+    if ( s_DarLib == NULL )
+        return;
+    p->pDatas = ABC_CALLOC( Dar_LibDat_t, Abc_MaxInt(s_DarLib->nDatas, 1) );
+    p->pNums  = ABC_CALLOC( int, s_DarLib->iObj );
+    for ( i = 0; i < 4; i++ )
+        p->pNums[i] = i;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Frees the library data of the rewriting manager.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Dar_LibDataStop( Dar_Man_t * p )
+{
+    ABC_FREE( p->pDatas );
+    ABC_FREE( p->pNums );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Updates the score of the class and adjusts the priority of this class.]
@@ -723,13 +767,13 @@ int Dar_LibCutMatch( Dar_Man_t * p, Dar_Cut_t * pCut )
             return 0;
         }
         pFanin = Aig_NotCond(pFanin, ((uPhase >> i) & 1) );
-        s_DarLib->pDatas[i].pFunc = pFanin;
-        s_DarLib->pDatas[i].Level = Aig_Regular(pFanin)->Level;
+        p->pDatas[i].pFunc = pFanin;
+        p->pDatas[i].Level = Aig_Regular(pFanin)->Level;
         // copy the propability of node being one
         if ( p->pPars->fPower )
         {
             float Prob = Abc_Int2Float( Vec_IntEntry( p->pAig->vProbs, Aig_ObjId(Aig_Regular(pFanin)) ) );
-            s_DarLib->pDatas[i].dProb = Aig_IsComplement(pFanin)? 1.0-Prob : Prob;
+            p->pDatas[i].dProb = Aig_IsComplement(pFanin)? 1.0-Prob : Prob;
         }
     }
     p->nCutsGood++;
@@ -749,17 +793,17 @@ int Dar_LibCutMatch( Dar_Man_t * p, Dar_Cut_t * pCut )
   SeeAlso     []
 
 ***********************************************************************/
-int Dar_LibCutMarkMffc( Aig_Man_t * p, Aig_Obj_t * pRoot, int nLeaves, float * pPower )
+int Dar_LibCutMarkMffc( Dar_Man_t * p, Aig_Obj_t * pRoot, int nLeaves, float * pPower )
 {
     int i, nNodes;
     // mark the cut leaves
     for ( i = 0; i < nLeaves; i++ )
-        Aig_Regular(s_DarLib->pDatas[i].pFunc)->nRefs++;
+        Aig_Regular(p->pDatas[i].pFunc)->nRefs++;
     // label MFFC with current ID
-    nNodes = Aig_NodeMffcLabel( p, pRoot, pPower );
+    nNodes = Aig_NodeMffcLabel( p->pAig, pRoot, pPower );
     // unmark the cut leaves
     for ( i = 0; i < nLeaves; i++ )
-        Aig_Regular(s_DarLib->pDatas[i].pFunc)->nRefs--;
+        Aig_Regular(p->pDatas[i].pFunc)->nRefs--;
     return nNodes;
 }
 
@@ -813,18 +857,18 @@ void Dar_LibEvalAssignNums( Dar_Man_t * p, int Class, Aig_Obj_t * pRoot )
     {
         // get one class node, assign its temporary number and set its data
         pObj = Dar_LibObj(s_DarLib, s_DarLib->pNodes0[Class][i]);
-        pObj->Num = 4 + i;
-        assert( (int)pObj->Num < s_DarLib->nNodes0Max + 4 );
-        pData = s_DarLib->pDatas + pObj->Num;
+        Dar_LibObjSetNum( p, pObj, 4 + i );
+        assert( (int)Dar_LibObjNum(p, pObj) < s_DarLib->nNodes0Max + 4 );
+        pData = p->pDatas + Dar_LibObjNum(p, pObj);
         pData->fMffc = 0;
         pData->pFunc = NULL;
         pData->TravId = 0xFFFF;
 
         // explore the fanins
-        assert( (int)Dar_LibObj(s_DarLib, pObj->Fan0)->Num < s_DarLib->nNodes0Max + 4 );
-        assert( (int)Dar_LibObj(s_DarLib, pObj->Fan1)->Num < s_DarLib->nNodes0Max + 4 );
-        pData0 = s_DarLib->pDatas + Dar_LibObj(s_DarLib, pObj->Fan0)->Num;
-        pData1 = s_DarLib->pDatas + Dar_LibObj(s_DarLib, pObj->Fan1)->Num;
+        assert( (int)Dar_LibObjNum(p, Dar_LibObj(s_DarLib, pObj->Fan0)) < s_DarLib->nNodes0Max + 4 );
+        assert( (int)Dar_LibObjNum(p, Dar_LibObj(s_DarLib, pObj->Fan1)) < s_DarLib->nNodes0Max + 4 );
+        pData0 = p->pDatas + Dar_LibObjNum(p, Dar_LibObj(s_DarLib, pObj->Fan0));
+        pData1 = p->pDatas + Dar_LibObjNum(p, Dar_LibObj(s_DarLib, pObj->Fan1));
         pData->Level = 1 + Abc_MaxInt(pData0->Level, pData1->Level);
         if ( pData0->pFunc == NULL || pData1->pFunc == NULL )
             continue;
@@ -860,14 +904,14 @@ void Dar_LibEvalAssignNums( Dar_Man_t * p, int Class, Aig_Obj_t * pRoot )
   SeeAlso     []
 
 ***********************************************************************/
-int Dar_LibEval_rec( Dar_LibObj_t * pObj, int Out, int nNodesSaved, int Required, float * pPower )
+int Dar_LibEval_rec( Dar_Man_t * p, Dar_LibObj_t * pObj, int Out, int nNodesSaved, int Required, float * pPower )
 {
     Dar_LibDat_t * pData;
     float Power0, Power1;
     int Area;
     if ( pPower )
         *pPower = (float)0.0;
-    pData = s_DarLib->pDatas + pObj->Num;
+    pData = p->pDatas + Dar_LibObjNum(p, pObj);
     if ( pData->TravId == Out )
         return 0;
     pData->TravId = Out;
@@ -877,7 +921,7 @@ int Dar_LibEval_rec( Dar_LibObj_t * pObj, int Out, int nNodesSaved, int Required
             *pPower = pData->dProb;
         return 0;
     }
-    assert( pObj->Num > 3 );
+    assert( Dar_LibObjNum(p, pObj) > 3 );
     if ( pData->Level > Required )
         return 0xff;
     if ( pData->pFunc && !pData->fMffc )
@@ -888,16 +932,16 @@ int Dar_LibEval_rec( Dar_LibObj_t * pObj, int Out, int nNodesSaved, int Required
     }
     // this is a new node - get a bound on the area of its branches
     nNodesSaved--;
-    Area = Dar_LibEval_rec( Dar_LibObj(s_DarLib, pObj->Fan0), Out, nNodesSaved, Required+1, pPower? &Power0 : NULL );
+    Area = Dar_LibEval_rec( p, Dar_LibObj(s_DarLib, pObj->Fan0), Out, nNodesSaved, Required+1, pPower? &Power0 : NULL );
     if ( Area > nNodesSaved )
         return 0xff;
-    Area += Dar_LibEval_rec( Dar_LibObj(s_DarLib, pObj->Fan1), Out, nNodesSaved, Required+1, pPower? &Power1 : NULL );
+    Area += Dar_LibEval_rec( p, Dar_LibObj(s_DarLib, pObj->Fan1), Out, nNodesSaved, Required+1, pPower? &Power1 : NULL );
     if ( Area > nNodesSaved )
         return 0xff;
     if ( pPower )
     {
-        Dar_LibDat_t * pData0 = s_DarLib->pDatas + Dar_LibObj(s_DarLib, pObj->Fan0)->Num;
-        Dar_LibDat_t * pData1 = s_DarLib->pDatas + Dar_LibObj(s_DarLib, pObj->Fan1)->Num;
+        Dar_LibDat_t * pData0 = p->pDatas + Dar_LibObjNum(p, Dar_LibObj(s_DarLib, pObj->Fan0));
+        Dar_LibDat_t * pData1 = p->pDatas + Dar_LibObjNum(p, Dar_LibObj(s_DarLib, pObj->Fan1));
         pData->dProb = (pObj->fCompl0? 1.0 - pData0->dProb : pData0->dProb)*
                        (pObj->fCompl1? 1.0 - pData1->dProb : pData1->dProb);
         *pPower = Power0 + 2.0 * pData0->dProb * (1.0 - pData0->dProb) +
@@ -930,7 +974,7 @@ void Dar_LibEval( Dar_Man_t * p, Aig_Obj_t * pRoot, Dar_Cut_t * pCut, int Requir
     if ( !Dar_LibCutMatch(p, pCut) )
         return;
     // mark MFFC of the node
-    nNodesSaved = Dar_LibCutMarkMffc( p->pAig, pRoot, pCut->nLeaves, p->pPars->fPower? &PowerSaved : NULL );
+    nNodesSaved = Dar_LibCutMarkMffc( p, pRoot, pCut->nLeaves, p->pPars->fPower? &PowerSaved : NULL );
     // evaluate the cut
     Class = s_DarLib->pMap[pCut->uTruth];
     Dar_LibEvalAssignNums( p, Class, pRoot );
@@ -940,9 +984,9 @@ void Dar_LibEval( Dar_Man_t * p, Aig_Obj_t * pRoot, Dar_Cut_t * pCut, int Requir
     for ( Out = 0; Out < s_DarLib->nSubgr0[Class]; Out++ )
     {
         pObj = Dar_LibObj(s_DarLib, s_DarLib->pSubgr0[Class][Out]);
-        if ( Aig_Regular(s_DarLib->pDatas[pObj->Num].pFunc) == pRoot )
+        if ( Aig_Regular(p->pDatas[Dar_LibObjNum(p, pObj)].pFunc) == pRoot )
             continue;
-        nNodesAdded = Dar_LibEval_rec( pObj, Out, nNodesSaved - !p->pPars->fUseZeros, Required, p->pPars->fPower? &PowerAdded : NULL );
+        nNodesAdded = Dar_LibEval_rec( p, pObj, Out, nNodesSaved - !p->pPars->fUseZeros, Required, p->pPars->fPower? &PowerAdded : NULL );
         nNodesGained = nNodesSaved - nNodesAdded;
         if ( p->pPars->fPower && PowerSaved < PowerAdded )
             continue;
@@ -951,15 +995,15 @@ void Dar_LibEval( Dar_Man_t * p, Aig_Obj_t * pRoot, Dar_Cut_t * pCut, int Requir
         if ( nNodesGained < 0 || (nNodesGained == 0 && !p->pPars->fUseZeros) )
             continue;
         if ( nNodesGained <  p->GainBest || 
-            (nNodesGained == p->GainBest && s_DarLib->pDatas[pObj->Num].Level >= p->LevelBest) )
+            (nNodesGained == p->GainBest && p->pDatas[Dar_LibObjNum(p, pObj)].Level >= p->LevelBest) )
             continue;
         // remember this possibility
         Vec_PtrClear( p->vLeavesBest );
         for ( k = 0; k < (int)pCut->nLeaves; k++ )
-            Vec_PtrPush( p->vLeavesBest, s_DarLib->pDatas[k].pFunc );
+            Vec_PtrPush( p->vLeavesBest, p->pDatas[k].pFunc );
         p->OutBest    = s_DarLib->pSubgr0[Class][Out];
         p->OutNumBest = Out;
-        p->LevelBest  = s_DarLib->pDatas[pObj->Num].Level;
+        p->LevelBest  = p->pDatas[Dar_LibObjNum(p, pObj)].Level;
         p->GainBest   = nNodesGained;
         p->ClassBest  = Class;
         assert( p->LevelBest <= Required );
@@ -981,14 +1025,14 @@ p->timeEval += clk;
   SeeAlso     []
 
 ***********************************************************************/
-void Dar_LibBuildClear_rec( Dar_LibObj_t * pObj, int * pCounter )
+void Dar_LibBuildClear_rec( Dar_Man_t * p, Dar_LibObj_t * pObj, int * pCounter )
 {
     if ( pObj->fTerm )
         return;
-    pObj->Num = (*pCounter)++;
-    s_DarLib->pDatas[ pObj->Num ].pFunc = NULL;
-    Dar_LibBuildClear_rec( Dar_LibObj(s_DarLib, pObj->Fan0), pCounter );
-    Dar_LibBuildClear_rec( Dar_LibObj(s_DarLib, pObj->Fan1), pCounter );
+    Dar_LibObjSetNum( p, pObj, (*pCounter)++ );
+    p->pDatas[ Dar_LibObjNum(p, pObj) ].pFunc = NULL;
+    Dar_LibBuildClear_rec( p, Dar_LibObj(s_DarLib, pObj->Fan0), pCounter );
+    Dar_LibBuildClear_rec( p, Dar_LibObj(s_DarLib, pObj->Fan1), pCounter );
 }
 
 /**Function*************************************************************
@@ -1005,7 +1049,7 @@ void Dar_LibBuildClear_rec( Dar_LibObj_t * pObj, int * pCounter )
 Aig_Obj_t * Dar_LibBuildBest_rec( Dar_Man_t * p, Dar_LibObj_t * pObj )
 {
     Aig_Obj_t * pFanin0, * pFanin1;
-    Dar_LibDat_t * pData = s_DarLib->pDatas + pObj->Num;
+    Dar_LibDat_t * pData = p->pDatas + Dar_LibObjNum(p, pObj);
     if ( pData->pFunc )
         return pData->pFunc;
     pFanin0 = Dar_LibBuildBest_rec( p, Dar_LibObj(s_DarLib, pObj->Fan0) );
@@ -1032,8 +1076,8 @@ Aig_Obj_t * Dar_LibBuildBest( Dar_Man_t * p )
 {
     int i, Counter = 4;
     for ( i = 0; i < Vec_PtrSize(p->vLeavesBest); i++ )
-        s_DarLib->pDatas[i].pFunc = (Aig_Obj_t *)Vec_PtrEntry( p->vLeavesBest, i );
-    Dar_LibBuildClear_rec( Dar_LibObj(s_DarLib, p->OutBest), &Counter );
+        p->pDatas[i].pFunc = (Aig_Obj_t *)Vec_PtrEntry( p->vLeavesBest, i );
+    Dar_LibBuildClear_rec( p, Dar_LibObj(s_DarLib, p->OutBest), &Counter );
     return Dar_LibBuildBest_rec( p, Dar_LibObj(s_DarLib, p->OutBest) );
 }
 
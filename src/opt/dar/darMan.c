@@ -52,6 +52,7 @@ Dar_Man_t * Dar_ManStart( Aig_Man_t * pAig, Dar_RwrPar_t * pPars )
     p->vCutNodes = Vec_PtrAlloc( 1000 );
     p->pMemCuts = Aig_MmFixedStart( p->pPars->nCutsMax * sizeof(Dar_Cut_t), 1024 );
     p->vLeavesBest = Vec_PtrAlloc( 4 );
+    Dar_LibDataStart( p );
     return p;
 }
 
@@ -76,6 +77,7 @@ void Dar_ManStop( Dar_Man_t * p )
         Aig_MmFixedStop( p->pMemCuts, 0 );
     if ( p->vLeavesBest ) 
         Vec_PtrFree( p->vLeavesBest );
+    Dar_LibDataStop( p );
     ABC_FREE( p );
 }
 
@@ -20,6 +20,7 @@
 
 #include "sfmInt.h"
 #include "bool/kit/kit.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -28,6 +29,32 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define SFM_PAR_NODES 8  // the number of nodes per thread in one round
+
+// the node tried by a thread
+typedef struct Sfm_ParNode_t_ Sfm_ParNode_t;
+struct Sfm_ParNode_t_
+{
+    int               iNode;       // the node
+    int               fFound;      // the change is found
+    int               iFanin;      // the fanin to replace (-1 if the function is improved)
+    int               iDiv;        // the new fanin (-1 if the fanin is removed)
+    word              uTruth;      // the new function
+    word              pTruth[SFM_WORDS_MAX];
+    Vec_Int_t *       vWin;        // the objects of the window
+};
+
+// the task of one thread
+typedef struct Sfm_ParTask_t_ Sfm_ParTask_t;
+struct Sfm_ParTask_t_
+{
+    Sfm_Ntk_t *       pMan;        // the copy of the manager
+    Sfm_ParNode_t *   pNodes;      // the nodes of the round
+    int               nNodes;      // the number of nodes
+    int               iThread;     // the thread
+    int               nThreads;    // the number of threads
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -56,6 +83,7 @@ void Sfm_ParSetDefault( Sfm_Par_t * pPars )
     pPars->fArea        =    0;  // performs optimization for area
     pPars->fMoreEffort  =    0;  // performs high-affort minimization
     pPars->fAllBoxes    =    0;  // enable preserving all boxes
+    pPars->nProcs       =    1;  // the number of threads
     pPars->fVerbose     =    0;  // enable basic stats
     pPars->fVeryVerbose =    0;  // enable detailed stats
 }
@@ -208,12 +236,20 @@ finish:
             iNode, f, Sfm_ObjFanin(p, iNode, f), iVar, Vec_IntEntry(p->vDivs, iVar) );
         Kit_DsdPrintFromTruth( (unsigned *)&uTruth, Vec_IntSize(p->vDivIds) ); printf( "\n" );
     }
+    if ( fSkipUpdate )
+        return 0;
+    if ( p->fSpecul )
+    {
+        p->iSpecFanin = f;
+        p->iSpecDiv   = (iVar == -1 ? iVar : Vec_IntEntry(p->vDivs, iVar));
+        p->uSpecTruth = uTruth;
+        Abc_TtCopy( p->pSpecTruth, p->pTruth, SFM_WORDS_MAX, 0 );
+        return 1;
+    }
     if ( iVar == -1 )
         p->nRemoves++;
     else
         p->nResubs++;
-    if ( fSkipUpdate )
-        return 0;
     // update the network
     Sfm_NtkUpdate( p, iNode, f, (iVar == -1 ? iVar : Vec_IntEntry(p->vDivs, iVar)), uTruth, p->pTruth );
     // the number of fanins cannot increase
@@ -277,10 +313,18 @@ p->timeSat += Abc_Clock() - clk;
         if ( New > Old )
             return 0;
     }
-    p->nImproves++;
     if ( fSkipUpdate )
         return 0;
+    if ( p->fSpecul )
+    {
+        p->iSpecFanin = -1;
+        p->iSpecDiv   = -1;
+        p->uSpecTruth = uTruth;
+        return 1;
+    }
+    p->nImproves++;
     // update truth table
+    Sfm_NtkMarkChanged( p, iNode );
     Vec_WrdWriteEntry( p->vTruths, iNode, uTruth );
     Sfm_TruthToCnf( uTruth, NULL, Sfm_ObjFaninNum(p, iNode), p->vCover, (Vec_Str_t *)Vec_WecEntry(p->vCnfs, iNode) );
     return 1;
@@ -353,6 +397,286 @@ void Sfm_NtkPrint( Sfm_Ntk_t * p )
     }
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Starts the copy of the manager used by one thread.]
+
+  Description [The copy shares the network with the manager, while the 
+  window, the SAT solver and the traversal data are its own.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Sfm_NtkParCopyStart( Sfm_Ntk_t * p, Sfm_Ntk_t * pCopy, Sfm_Par_t * pPars )
+{
+    int i;
+    memcpy( pCopy, p, sizeof(Sfm_Ntk_t) );
+    memcpy( pPars, p->pPars, sizeof(Sfm_Par_t) );
+    pPars->fVerbose = pPars->fVeryVerbose = 0;
+    pCopy->pPars    = pPars;
+    pCopy->fSpecul  = 1;
+    pCopy->vChanged = NULL;
+    memset( &pCopy->vCounts,   0, sizeof(Vec_Int_t) );
+    memset( &pCopy->vTravIds,  0, sizeof(Vec_Int_t) );
+    memset( &pCopy->vTravIds2, 0, sizeof(Vec_Int_t) );
+    memset( &pCopy->vId2Var,   0, sizeof(Vec_Int_t) );
+    memset( &pCopy->vVar2Id,   0, sizeof(Vec_Int_t) );
+    Vec_IntFill( &pCopy->vCounts,   p->nObjs,  0 );
+    Vec_IntFill( &pCopy->vTravIds,  p->nObjs,  0 );
+    Vec_IntFill( &pCopy->vTravIds2, p->nObjs,  0 );
+    Vec_IntFill( &pCopy->vId2Var,   2*p->nObjs, -1 );
+    Vec_IntFill( &pCopy->vVar2Id,   2*p->nObjs, -1 );
+    pCopy->nTravIds  = pCopy->nTravIds2 = 0;
+    pCopy->vCover    = Vec_IntAlloc( 1 << 16 );
+    for ( i = 0; i < SFM_FANIN_MAX; i++ )
+        pCopy->pTtElems[i] = pCopy->TtElems[i];
+    Sfm_NtkPrepare( pCopy );
+    pCopy->nTryRemoves = pCopy->nTryImproves = pCopy->nTryResubs = 0;
+    pCopy->nNodesTried = pCopy->nTotalDivs = pCopy->nSatCalls = pCopy->nTimeOuts = pCopy->nMaxDivs = 0;
+    pCopy->timeWin = pCopy->timeDiv = pCopy->timeCnf = pCopy->timeSat = 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Stops the copy of the manager and collects its statistics.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Sfm_NtkParCopyStop( Sfm_Ntk_t * p, Sfm_Ntk_t * pCopy )
+{
+    p->nTryRemoves  += pCopy->nTryRemoves;
+    p->nTryImproves += pCopy->nTryImproves;
+    p->nTryResubs   += pCopy->nTryResubs;
+    p->nNodesTried  += pCopy->nNodesTried;
+    p->nTotalDivs   += pCopy->nTotalDivs;
+    p->nSatCalls    += pCopy->nSatCalls;
+    p->nTimeOuts    += pCopy->nTimeOuts;
+    p->nMaxDivs     += pCopy->nMaxDivs;
+    p->timeWin      += pCopy->timeWin;
+    p->timeDiv      += pCopy->timeDiv;
+    p->timeCnf      += pCopy->timeCnf;
+    p->timeSat      += pCopy->timeSat;
+    ABC_FREE( pCopy->vCounts.pArray );
+    ABC_FREE( pCopy->vTravIds.pArray );
+    ABC_FREE( pCopy->vTravIds2.pArray );
+    ABC_FREE( pCopy->vId2Var.pArray );
+    ABC_FREE( pCopy->vVar2Id.pArray );
+    Vec_IntFree( pCopy->vCover );
+    Vec_IntFreeP( &pCopy->vNodes );
+    Vec_IntFreeP( &pCopy->vDivs  );
+    Vec_IntFreeP( &pCopy->vRoots );
+    Vec_IntFreeP( &pCopy->vTfo   );
+    Vec_WrdFreeP( &pCopy->vDivCexes );
+    Vec_IntFreeP( &pCopy->vOrder );
+    Vec_IntFreeP( &pCopy->vDivVars );
+    Vec_IntFreeP( &pCopy->vDivIds );
+    Vec_IntFreeP( &pCopy->vLits  );
+    Vec_IntFreeP( &pCopy->vValues );
+    Vec_WecFreeP( &pCopy->vClauses );
+    Vec_IntFreeP( &pCopy->vFaninMap );
+    sat_solver_delete( pCopy->pSat );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Looks for the changes of the nodes assigned to one thread.]
+
+  Description [Runs in a worker thread. The network is only read. For 
+  each node, the first change found is recorded together with the objects 
+  of the window used to prove it.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Sfm_NtkPerformParTask( void * pArg, int iThread, void * pScratch )
+{
+    Sfm_ParTask_t * pTask = (Sfm_ParTask_t *)pArg;
+    Sfm_Ntk_t * p = pTask->pMan;
+    Sfm_ParNode_t * pNode;
+    int k;
+    for ( k = pTask->iThread; k < pTask->nNodes; k += pTask->nThreads )
+    {
+        pNode = pTask->pNodes + k;
+        Vec_IntClear( p->vNodes );
+        Vec_IntClear( p->vOrder );
+        pNode->fFound = Sfm_NodeResub( p, pNode->iNode );
+        if ( pNode->fFound )
+        {
+            pNode->iFanin = p->iSpecFanin;
+            pNode->iDiv   = p->iSpecDiv;
+            pNode->uTruth = p->uSpecTruth;
+            Abc_TtCopy( pNode->pTruth, p->pSpecTruth, SFM_WORDS_MAX, 0 );
+        }
+        Vec_IntClear( pNode->vWin );
+        Vec_IntAppend( pNode->vWin, p->vNodes );
+        Vec_IntAppend( pNode->vWin, p->vOrder );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Checks that the window of the node was not changed in this round.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Sfm_NtkParIsValid( Sfm_ParNode_t * pNode, Vec_Int_t * vDirty, int Round )
+{
+    int i, iObj;
+    if ( Vec_IntEntry(vDirty, pNode->iNode) == Round )
+        return 0;
+    Vec_IntForEachEntry( pNode->vWin, iObj, i )
+        if ( Vec_IntEntry(vDirty, iObj) == Round )
+            return 0;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Applies the change found by a thread.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Sfm_NtkParApply( Sfm_Ntk_t * p, Sfm_ParNode_t * pNode )
+{
+    if ( pNode->iFanin == -1 )
+    {
+        p->nImproves++;
+        Sfm_NtkMarkChanged( p, pNode->iNode );
+        Vec_WrdWriteEntry( p->vTruths, pNode->iNode, pNode->uTruth );
+        Sfm_TruthToCnf( pNode->uTruth, NULL, Sfm_ObjFaninNum(p, pNode->iNode), p->vCover, (Vec_Str_t *)Vec_WecEntry(p->vCnfs, pNode->iNode) );
+        return;
+    }
+    if ( pNode->iDiv == -1 )
+        p->nRemoves++;
+    else
+        p->nResubs++;
+    Sfm_NtkUpdate( p, pNode->iNode, pNode->iFanin, pNode->iDiv, pNode->uTruth, pNode->pTruth );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs resubstitution using several threads.]
+
+  Description [The nodes are processed in rounds. In each round, the next 
+  nodes are divided among the threads, which look for the changes without 
+  updating the network. The calling thread applies the changes in the order 
+  of the nodes. A change is applied only if none of the objects of its 
+  window was changed earlier in the round. Otherwise, the node is tried 
+  again by the calling thread. After the change is applied, the node is 
+  tried again for more changes, as in the serial flow. The result does 
+  not depend on the timing of the threads. Returns the number of the 
+  nodes that were changed.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Sfm_NtkPerformPar( Sfm_Ntk_t * p, int * pCounterLarge )
+{
+    int nThreads = p->pPars->nProcs;
+    int nNodesMax = nThreads * SFM_PAR_NODES;
+    Util_Pool_t * pPool = Util_PoolStart( nThreads, 0 );
+    Sfm_Ntk_t * pCopies = ABC_ALLOC( Sfm_Ntk_t, nThreads );
+    Sfm_Par_t * pParsCopies = ABC_ALLOC( Sfm_Par_t, nThreads );
+    Sfm_ParTask_t * pTasks = ABC_CALLOC( Sfm_ParTask_t, nThreads );
+    Sfm_ParNode_t * pNodes = ABC_CALLOC( Sfm_ParNode_t, nNodesMax );
+    Vec_Int_t * vDirty = Vec_IntStart( p->nObjs );
+    Sfm_ParNode_t * pNode;
+    int i, k, n, iObj, nNodes, Round = 0, Counter = 0, fStop = 0;
+    for ( k = 0; k < nThreads; k++ )
+    {
+        Sfm_NtkParCopyStart( p, pCopies + k, pParsCopies + k );
+        pTasks[k].pMan     = pCopies + k;
+        pTasks[k].pNodes   = pNodes;
+        pTasks[k].iThread  = k;
+        pTasks[k].nThreads = nThreads;
+    }
+    for ( k = 0; k < nNodesMax; k++ )
+        pNodes[k].vWin = Vec_IntAlloc( 100 );
+    p->vChanged = Vec_IntAlloc( 100 );
+    i = p->nPis;
+    while ( !fStop && i + p->nPos < p->nObjs )
+    {
+        // collect the nodes of this round
+        for ( nNodes = 0; nNodes < nNodesMax && i + p->nPos < p->nObjs; i++ )
+        {
+            if ( Sfm_ObjIsFixed( p, i ) )
+                continue;
+            if ( p->pPars->nDepthMax && Sfm_ObjLevel(p, i) > p->pPars->nDepthMax )
+                continue;
+            if ( Sfm_ObjFaninNum(p, i) > SFM_SUPP_MAX )
+            {
+                (*pCounterLarge)++;
+                continue;
+            }
+            pNodes[nNodes++].iNode = i;
+        }
+        // look for the changes
+        for ( k = 0; k < nThreads; k++ )
+        {
+            pTasks[k].nNodes = nNodes;
+            if ( k < nNodes )
+                Util_PoolAssign( pPool, k, Sfm_NtkPerformParTask, (void *)(pTasks + k) );
+        }
+        Util_PoolWaitAll( pPool );
+        // apply the changes in the order of the nodes
+        Round++;
+        for ( k = 0; k < nNodes && !fStop; k++ )
+        {
+            pNode = pNodes + k;
+            if ( !Sfm_NtkParIsValid( pNode, vDirty, Round ) )
+                n = 0;
+            else if ( pNode->fFound )
+            {
+                Sfm_NtkParApply( p, pNode );
+                n = 1;
+            }
+            else
+                continue;
+            for ( ; Sfm_NodeResub(p, pNode->iNode); n++ )
+                ;
+            Counter += (n > 0);
+            Vec_IntForEachEntry( p->vChanged, iObj, n )
+                Vec_IntWriteEntry( vDirty, iObj, Round );
+            Vec_IntClear( p->vChanged );
+            if ( p->pPars->nNodesMax && Counter >= p->pPars->nNodesMax )
+                fStop = 1;
+        }
+    }
+    Vec_IntFreeP( &p->vChanged );
+    for ( k = 0; k < nThreads; k++ )
+        Sfm_NtkParCopyStop( p, pCopies + k );
+    for ( k = 0; k < nNodesMax; k++ )
+        Vec_IntFree( pNodes[k].vWin );
+    Vec_IntFree( vDirty );
+    ABC_FREE( pNodes );
+    ABC_FREE( pTasks );
+    ABC_FREE( pParsCopies );
+    ABC_FREE( pCopies );
+    Util_PoolStop( pPool );
+    return Counter;
+}
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -382,27 +706,32 @@ int Sfm_NtkPerform( Sfm_Ntk_t * p, Sfm_Par_t * pPars )
 //    return 0;
     p->nTotalNodesBeg = Vec_WecSizeUsedLimits( &p->vFanins, Sfm_NtkPiNum(p), Vec_WecSize(&p->vFanins) - Sfm_NtkPoNum(p) );
     p->nTotalEdgesBeg = Vec_WecSizeSize(&p->vFanins) - Sfm_NtkPoNum(p);
-    Sfm_NtkForEachNode( p, i )
+    if ( pPars->nProcs > 1 )
+        Counter = Sfm_NtkPerformPar( p, &CounterLarge );
+    else
     {
-        if ( Sfm_ObjIsFixed( p, i ) )
-            continue;
-        if ( p->pPars->nDepthMax && Sfm_ObjLevel(p, i) > p->pPars->nDepthMax )
-            continue;
-        //if ( Sfm_ObjFaninNum(p, i) < 2 )
-        //    continue;
-        if ( Sfm_ObjFaninNum(p, i) > SFM_SUPP_MAX )
+        Sfm_NtkForEachNode( p, i )
         {
-            CounterLarge++;
-            continue;
-        }
-        for ( k = 0; Sfm_NodeResub(p, i); k++ )
-        {
-//            Counter++;
-//            break;
+            if ( Sfm_ObjIsFixed( p, i ) )
+                continue;
+            if ( p->pPars->nDepthMax && Sfm_ObjLevel(p, i) > p->pPars->nDepthMax )
+                continue;
+            //if ( Sfm_ObjFaninNum(p, i) < 2 )
+            //    continue;
+            if ( Sfm_ObjFaninNum(p, i) > SFM_SUPP_MAX )
+            {
+                CounterLarge++;
+                continue;
+            }
+            for ( k = 0; Sfm_NodeResub(p, i); k++ )
+            {
+    //            Counter++;
+    //            break;
+            }
+            Counter += (k > 0);
+            if ( pPars->nNodesMax && Counter >= pPars->nNodesMax )
+                break;
         }
-        Counter += (k > 0);
-        if ( pPars->nNodesMax && Counter >= pPars->nNodesMax )
-            break;
     }
     p->nTotalNodesEnd = Vec_WecSizeUsedLimits( &p->vFanins, Sfm_NtkPiNum(p), Vec_WecSize(&p->vFanins) - Sfm_NtkPoNum(p) );
     p->nTotalEdgesEnd = Vec_WecSizeSize(&p->vFanins) - Sfm_NtkPoNum(p);
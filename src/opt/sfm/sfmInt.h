@@ -129,6 +129,13 @@ struct Sfm_Ntk_t_
     word *            pTtElems[SFM_FANIN_MAX];
     word              pTruth[SFM_WORDS_MAX];
     word              pCube[SFM_WORDS_MAX];
+    // speculative resubstitution
+    int               fSpecul;     // records the change instead of applying it
+    int               iSpecFanin;  // the fanin to replace (-1 if the function is improved)
+    int               iSpecDiv;    // the new fanin (-1 if the fanin is removed)
+    word              uSpecTruth;  // the new function
+    word              pSpecTruth[SFM_WORDS_MAX];
+    Vec_Int_t *       vChanged;    // the objects changed by the updates
     // nodes
     int               nTotalNodesBeg;
     int               nTotalEdgesBeg;
@@ -186,6 +193,8 @@ static inline void Sfm_ObjSetLevelR( Sfm_Ntk_t * p, int iObj, int Lev ) { Vec_In
 static inline int  Sfm_ObjUpdateFaninCount( Sfm_Ntk_t * p, int iObj )   { return Vec_IntAddToEntry(&p->vCounts, iObj, -1);                  }
 static inline void Sfm_ObjResetFaninCount( Sfm_Ntk_t * p, int iObj )    { Vec_IntWriteEntry(&p->vCounts, iObj, Sfm_ObjFaninNum(p, iObj)-1); }
 
+static inline void Sfm_NtkMarkChanged( Sfm_Ntk_t * p, int iObj )       { if ( p->vChanged ) Vec_IntPush( p->vChanged, iObj );              }
+
 extern void        Kit_DsdPrintFromTruth( unsigned * pTruth, int nVars );
 
 ////////////////////////////////////////////////////////////////////////
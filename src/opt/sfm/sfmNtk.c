@@ -273,6 +273,8 @@ void Sfm_NtkRemoveFanin( Sfm_Ntk_t * p, int iNode, int iFanin )
     assert( RetValue );
     RetValue = Vec_IntRemove( Sfm_ObjFoArray(p, iFanin), iNode );
     assert( RetValue );
+    Sfm_NtkMarkChanged( p, iNode );
+    Sfm_NtkMarkChanged( p, iFanin );
 }
 void Sfm_NtkAddFanin( Sfm_Ntk_t * p, int iNode, int iFanin )
 {
@@ -284,6 +286,8 @@ void Sfm_NtkAddFanin( Sfm_Ntk_t * p, int iNode, int iFanin )
     assert( Vec_IntFind( Sfm_ObjFoArray(p, iFanin), iNode ) == -1 );
     Vec_IntPush( Sfm_ObjFiArray(p, iNode), iFanin );
     Vec_IntPush( Sfm_ObjFoArray(p, iFanin), iNode );
+    Sfm_NtkMarkChanged( p, iNode );
+    Sfm_NtkMarkChanged( p, iFanin );
 }
 void Sfm_NtkDeleteObj_rec( Sfm_Ntk_t * p, int iNode )
 {
@@ -291,9 +295,11 @@ void Sfm_NtkDeleteObj_rec( Sfm_Ntk_t * p, int iNode )
     if ( Sfm_ObjFanoutNum(p, iNode) > 0 || Sfm_ObjIsPi(p, iNode) || Sfm_ObjIsFixed(p, iNode) )
         return;
     assert( Sfm_ObjIsNode(p, iNode) );
+    Sfm_NtkMarkChanged( p, iNode );
     Sfm_ObjForEachFanin( p, iNode, iFanin, i )
     {
         int RetValue = Vec_IntRemove( Sfm_ObjFoArray(p, iFanin), iNode );  assert( RetValue );
+        Sfm_NtkMarkChanged( p, iFanin );
         Sfm_NtkDeleteObj_rec( p, iFanin );
     }
     Vec_IntClear( Sfm_ObjFiArray(p, iNode) );
@@ -331,6 +337,7 @@ void Sfm_NtkUpdate( Sfm_Ntk_t * p, int iNode, int f, int iFaninNew, word uTruth,
         Sfm_ObjForEachFanin( p, iNode, iFanin, f )
         {
             int RetValue = Vec_IntRemove( Sfm_ObjFoArray(p, iFanin), iNode );  assert( RetValue );
+            Sfm_NtkMarkChanged( p, iFanin );
             Sfm_NtkDeleteObj_rec( p, iFanin );
         }
         Vec_IntClear( Sfm_ObjFiArray(p, iNode) );
@@ -350,6 +357,7 @@ void Sfm_NtkUpdate( Sfm_Ntk_t * p, int iNode, int f, int iFaninNew, word uTruth,
     if ( Sfm_ObjFanoutNum(p, iFanin) > 0 )
         Sfm_NtkUpdateLevelR_rec( p, iFanin );
     // update truth table
+    Sfm_NtkMarkChanged( p, iNode );
     Vec_WrdWriteEntry( p->vTruths, iNode, uTruth );
     if ( p->vTruths2 && Vec_WrdSize(p->vTruths2) )
         Abc_TtCopy( Vec_WrdEntryP(p->vTruths2, Vec_IntEntry(p->vStarts, iNode)), pTruth, nWords, 0 );
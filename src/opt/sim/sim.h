@@ -198,6 +198,9 @@ extern int             Sim_SymmsGetPatternUsingSat( Sym_Man_t * p, unsigned * pP
 extern void            Sim_SymmsStructCompute( Abc_Ntk_t * pNtk, Vec_Ptr_t * vMatrs, Vec_Ptr_t * vSuppFun );
 /*=== simSymSim.c ==========================================================*/
 extern void            Sim_SymmsSimulate( Sym_Man_t * p, unsigned * pPatRand, Vec_Ptr_t * vMatrsNonSym );
+/*=== simSwitch.c ==========================================================*/
+extern Vec_Int_t *     Sim_NtkComputeSwitching( Abc_Ntk_t * pNtk, int nPatterns );
+extern Vec_Int_t *     Sim_NtkComputeSwitchingExt( Abc_Ntk_t * pNtk, int nPatterns, char * pActFile, int nThreads, int fVerbose );
 /*=== simUtil.c ==========================================================*/
 extern Vec_Ptr_t *     Sim_UtilInfoAlloc( int nSize, int nWords, int  fClean );
 extern void            Sim_UtilInfoFree( Vec_Ptr_t * p );
@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "base/abc/abc.h"
+#include "aig/gia/gia.h"
 #include "sim.h"
 
 ABC_NAMESPACE_IMPL_START
@@ -28,8 +29,6 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-static void Sim_NodeSimulate( Abc_Obj_t * pNode, Vec_Ptr_t * vSimInfo, int nSimWords );
-static float Sim_ComputeSwitching( unsigned * pSimInfo, int nSimWords );
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -51,56 +50,71 @@ static float Sim_ComputeSwitching( unsigned * pSimInfo, int nSimWords );
 ***********************************************************************/
 Vec_Int_t * Sim_NtkComputeSwitching( Abc_Ntk_t * pNtk, int nPatterns )
 {
-    Vec_Int_t * vSwitching;
-    float * pSwitching;
-    Vec_Ptr_t * vNodes;
-    Vec_Ptr_t * vSimInfo;
-    Abc_Obj_t * pNode;
-    unsigned * pSimInfo;
-    int nSimWords, i;
-
-    // allocate space for simulation info of all nodes
-    nSimWords = SIM_NUM_WORDS(nPatterns);
-    vSimInfo = Sim_UtilInfoAlloc( Abc_NtkObjNumMax(pNtk), nSimWords, 0 );
-    // assign the random simulation to the CIs
-    vSwitching = Vec_IntStart( Abc_NtkObjNumMax(pNtk) );
-    pSwitching = (float *)vSwitching->pArray;
-    Abc_NtkForEachCi( pNtk, pNode, i )
-    {
-        pSimInfo = (unsigned *)Vec_PtrEntry(vSimInfo, pNode->Id);
-        Sim_UtilSetRandom( pSimInfo, nSimWords );
-        pSwitching[pNode->Id] = Sim_ComputeSwitching( pSimInfo, nSimWords );
-    }
-    // simulate the internal nodes
-    vNodes  = Abc_AigDfs( pNtk, 1, 0 );
-    Vec_PtrForEachEntry( Abc_Obj_t *, vNodes, pNode, i )
-    {
-        pSimInfo = (unsigned *)Vec_PtrEntry(vSimInfo, pNode->Id);
-        Sim_UtilSimulateNodeOne( pNode, vSimInfo, nSimWords, 0 );
-        pSwitching[pNode->Id] = Sim_ComputeSwitching( pSimInfo, nSimWords );
-    }
-    Vec_PtrFree( vNodes );
-    Sim_UtilInfoFree( vSimInfo );
-    return vSwitching;
+    return Sim_NtkComputeSwitchingExt( pNtk, nPatterns, NULL, 1, 0 );
 }
 
 /**Function*************************************************************
 
-  Synopsis    [Computes switching activity of one node.]
+  Synopsis    [Computes switching activity using word-level simulation.]
 
-  Description [Uses the formula: Switching = 2 * nOnes * nZeros / (nTotal ^ 2) ]
+  Description [Converts the AIG into a GIA and simulates it with 64-bit
+  words in parallel blocks of patterns using nThreads threads. If
+  pActFile is given, it is either a VCD file (extension ".vcd") with the
+  stimuli of the CIs or a text file with the probabilities of one of the
+  CIs (see Gia_ManSwiReadProbs()). Returns the switching activity (as
+  float) for each object ID of the network.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-float Sim_ComputeSwitching( unsigned * pSimInfo, int nSimWords )
+Vec_Int_t * Sim_NtkComputeSwitchingExt( Abc_Ntk_t * pNtk, int nPatterns, char * pActFile, int nThreads, int fVerbose )
 {
-    int nOnes, nTotal;
-    nTotal = 32 * nSimWords;
-    nOnes = Sim_UtilCountOnes( pSimInfo, nSimWords );
-    return (float)2.0 * nOnes / nTotal * (nTotal - nOnes) / nTotal;
+    Vec_Int_t * vSwitching;
+    Vec_Flt_t * vSwiGia, * vProbs = NULL;
+    Vec_Wrd_t * vStims = NULL;
+    Vec_Int_t * vStimCis = NULL;
+    Vec_Ptr_t * vNodes;
+    Gia_Man_t * pGia;
+    Abc_Obj_t * pNode;
+    float * pSwitching;
+    int i, nSteps = 0;
+    assert( Abc_NtkIsStrash(pNtk) );
+    // derive the GIA
+    pGia = Gia_ManStart( Abc_NtkObjNumMax(pNtk) );
+    pGia->vNamesIn = Vec_PtrAlloc( Abc_NtkCiNum(pNtk) );
+    Abc_NtkForEachObj( pNtk, pNode, i )
+        pNode->iTemp = -1;
+    Abc_AigConst1(pNtk)->iTemp = 1;
+    Abc_NtkForEachCi( pNtk, pNode, i )
+    {
+        pNode->iTemp = Gia_ManAppendCi( pGia );
+        Vec_PtrPush( pGia->vNamesIn, Abc_UtilStrsav(Abc_ObjName(pNode)) );
+    }
+    vNodes = Abc_AigDfs( pNtk, 1, 0 );
+    Vec_PtrForEachEntry( Abc_Obj_t *, vNodes, pNode, i )
+        pNode->iTemp = Gia_ManAppendAnd( pGia, Abc_LitNotCond(Abc_ObjFanin0(pNode)->iTemp, Abc_ObjFaninC0(pNode)), 
+                                               Abc_LitNotCond(Abc_ObjFanin1(pNode)->iTemp, Abc_ObjFaninC1(pNode)) );
+    Vec_PtrFree( vNodes );
+    // read the input activity
+    if ( pActFile && strstr(pActFile, ".vcd") )
+        vStims = Gia_ManSwiReadVcd( pGia, pActFile, &nSteps, &vStimCis, fVerbose );
+    else if ( pActFile )
+        vProbs = Gia_ManSwiReadProbs( pGia, pActFile );
+    // simulate
+    vSwiGia = Gia_ManSimSwitching( pGia, vProbs, vStims, vStimCis, nSteps, Abc_Bit6WordNum(nPatterns), nThreads, fVerbose );
+    vSwitching = Vec_IntStart( Abc_NtkObjNumMax(pNtk) );
+    pSwitching = (float *)vSwitching->pArray;
+    Abc_NtkForEachObj( pNtk, pNode, i )
+        if ( pNode->iTemp >= 0 )
+            pSwitching[pNode->Id] = Vec_FltEntry( vSwiGia, Abc_Lit2Var(pNode->iTemp) );
+    Vec_FltFree( vSwiGia );
+    Vec_FltFreeP( &vProbs );
+    Vec_WrdFreeP( &vStims );
+    Vec_IntFreeP( &vStimCis );
+    Gia_ManStop( pGia );
+    return vSwitching;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -292,8 +292,12 @@ void solveQuadraticProblem(bool useCOG) {
       g_place_qpProb->cog_num = 0;
 
   g_place_qpProb->loop_num = 0;
+  g_place_qpProb->num_threads = g_place_numThreads;
 
-  qps_solve(g_place_qpProb);
+  if (COMPARE_QP_SOLVERS)
+      qps_bench(g_place_qpProb);
+  else
+      qps_solve(g_place_qpProb);
 
   qps_clean(g_place_qpProb);
 
@@ -26,6 +26,7 @@ ABC_NAMESPACE_IMPL_START
 // --------------------------------------------------------------------
 
 int g_place_numPartitions;
+int g_place_numThreads = 1;
 
 
 // --------------------------------------------------------------------
@@ -33,13 +33,27 @@ ABC_NAMESPACE_HEADER_START
 #define REPARTITION_LEVEL_DEPTH 4
 #define REPARTITION_TARGET_FRACTION 0.15
 #define REPARTITION_FM false
-#define REPARTITION_HMETIS true
+#define REPARTITION_MULTILEVEL true
+#define REPARTITION_HMETIS false
 
 // Parameters for F-M re-partitioning
 #define FM_MAX_BIN 10
 #define FM_MAX_PASSES 10
 
+// Parameters for multilevel re-partitioning
+#define ML_COARSEST_SIZE 100
+#define ML_MAX_LEVELS 32
+#define ML_MIN_REDUCTION 0.90
+#define ML_MATCH_NETSIZE IGNORE_NETSIZE
+#define ML_MAX_NETSIZE 500
+#define ML_SCAN_LIMIT 64
+#define ML_STALL_MOVES 100
+
+// Parameters for the QP solver
+#define COMPARE_QP_SOLVERS false
+
 extern int g_place_numPartitions;
+extern int g_place_numThreads;
 
 extern qps_problem_t *g_place_qpProb;
 
@@ -65,11 +79,13 @@ void incrementalPartition();
 bool refinePartitions();
 void reallocPartitions();
 bool refinePartition(Partition *p);
+void splitPartition(Partition *p);
 void resizePartition(Partition *p);
 void reallocPartition(Partition *p);
 
 void repartitionHMetis(Partition *parent);
 void repartitionFM(Partition *parent);
+void repartitionMultilevel(Partition *parent);
 
 void partitionScanlineMincut(Partition *parent);
 void partitionEqualArea(Partition *parent);
@@ -18,6 +18,7 @@
 
 #include "place_base.h"
 #include "place_gordian.h"
+#include "misc/util/utilPool.h"
 
 #if !defined(NO_HMETIS)
 #include "libhmetis.h"
@@ -55,6 +56,46 @@ void FM_updateGains(ConcreteNet *net, int partition, int inc,
                     FM_cell target [], FM_cell *bin [], 
                     int count_1 [], int count_2 []);
 
+void ML_buildCellNets();
+void ML_numberMembers(Partition *p);
+
+void splitPartitionTask(void *pArg, int iThread, void *pScratch);
+void collectLeaves(Partition *p, Partition *leaves [], int *numLeaves);
+int  partitionSortBySize(const void *a, const void *b);
+bool updateDone(Partition *p);
+
+// --- ML_graph - the hypergraph of one coarsening level
+
+typedef struct ML_graph {
+  int    m_numVerts;
+  int    m_numNets;
+  float *m_area;      // vertex areas
+  int   *m_netStart;  // pins of each net (CSR)
+  int   *m_netPins;
+  int   *m_netFixed;  // terminals outside the partition on each side (2x)
+  int   *m_vertStart; // nets of each vertex (CSR)
+  int   *m_vertNets;
+  float  m_fixedArea[2]; // area of the fixed members on each side
+} ML_graph;
+
+// --- ML_fm - the state of F-M refinement
+
+typedef struct ML_fm {
+  ML_graph *m_graph;
+  int      *m_side;     // side of each vertex
+  int      *m_count;    // pins of each net on each side (2x)
+  int      *m_gain;     // gain of each vertex
+  int      *m_next;     // bucket lists
+  int      *m_prev;
+  bool     *m_locked;
+  int      *m_buckets;  // list heads (2 x (2*m_maxDeg+1))
+  int       m_maxDeg;
+  int       m_maxIdx[2];
+} ML_fm;
+
+// the nets of each cell (CSR over cell IDs)
+static int *ML_cellNetStart = NULL, *ML_cellNets = NULL;
+
 
 // --------------------------------------------------------------------
 // initPartitioning()
@@ -124,8 +165,35 @@ void presortNets() {
 //
 // --------------------------------------------------------------------
 bool refinePartitions() {
+  Partition **leaves;
+  Util_Pool_t *pool;
+  int numLeaves = 0, i, k;
+
+  if (REPARTITION_MULTILEVEL)
+    ML_buildCellNets();
+
+  if (g_place_numThreads <= 1 || !REPARTITION_MULTILEVEL)
+    return refinePartition(g_place_rootPartition);
+
+  // split the leaves in parallel, largest first
+  leaves = (Partition **)malloc(sizeof(Partition*)*g_place_numPartitions);
+  collectLeaves(g_place_rootPartition, leaves, &numLeaves);
+  qsort(leaves, (size_t)numLeaves, sizeof(Partition*), partitionSortBySize);
+  for(i=0; i<numLeaves; i++)
+    ML_numberMembers(leaves[i]);
+  g_place_numPartitions += numLeaves;
+
+  pool = Util_PoolStart(g_place_numThreads, 0);
+  for(i=0; i<numLeaves; i++) {
+    if ((k = Util_PoolFindIdle(pool)) < 0)
+      k = Util_PoolWaitAny(pool, NULL);
+    Util_PoolAssign(pool, k, splitPartitionTask, leaves[i]);
+  }
+  Util_PoolWaitAll(pool);
+  Util_PoolStop(pool);
+  free(leaves);
 
-  return refinePartition(g_place_rootPartition);
+  return updateDone(g_place_rootPartition);
 }
 
 
@@ -137,6 +205,9 @@ bool refinePartitions() {
 // --------------------------------------------------------------------
 void reallocPartitions() {
 
+  if (REPARTITION_MULTILEVEL)
+    ML_buildCellNets();
+
   reallocPartition(g_place_rootPartition);
 }
 
@@ -148,9 +219,6 @@ void reallocPartitions() {
 //
 // --------------------------------------------------------------------
 bool refinePartition(Partition *p) {
-  bool degenerate = false;
-  int nonzeroCount = 0;
-  int i;
 
   assert(p);
 
@@ -165,8 +233,31 @@ bool refinePartition(Partition *p) {
   }
   
   // leaf...
-  // create two new subpartitions
   g_place_numPartitions++;
+  ML_numberMembers(p);
+  splitPartition(p);
+  return p->m_done;
+}
+
+
+// --------------------------------------------------------------------
+// splitPartition()
+//
+/// \brief Splits a leaf partition into two new subpartitions.
+//
+/// Only the partition, its members and its new subpartitions are
+/// modified, so that different leaves can be split concurrently.
+///
+// --------------------------------------------------------------------
+void splitPartition(Partition *p) {
+  bool degenerate = false;
+  int nonzeroCount = 0;
+  int i;
+
+  assert(p);
+  assert(p->m_leaf);
+
+  // create two new subpartitions
   p->m_sub1 = malloc(sizeof(Partition));
   p->m_sub1->m_level = p->m_level+1;
   p->m_sub1->m_leaf = true;
@@ -199,6 +290,8 @@ bool refinePartition(Partition *p) {
   if (p->m_level < REPARTITION_LEVEL_DEPTH) {
     if (REPARTITION_FM)
       repartitionFM(p);
+    else if (REPARTITION_MULTILEVEL)
+      repartitionMultilevel(p);
     else if (REPARTITION_HMETIS)
       repartitionHMetis(p);
   }
@@ -242,7 +335,65 @@ bool refinePartition(Partition *p) {
   
   // is this parent now finished?
   if (p->m_sub1->m_done && p->m_sub2->m_done) p->m_done = true;
-  
+}
+
+
+
+// --------------------------------------------------------------------
+// splitPartitionTask()
+//
+/// \brief Splits one leaf partition in a worker thread.
+//
+// --------------------------------------------------------------------
+void splitPartitionTask(void *pArg, int iThread, void *pScratch) {
+
+  splitPartition((Partition *)pArg);
+}
+
+
+// --------------------------------------------------------------------
+// collectLeaves()
+//
+/// \brief Collects the leaves of a partition that are not yet done.
+//
+// --------------------------------------------------------------------
+void collectLeaves(Partition *p, Partition *leaves [], int *numLeaves) {
+
+  if (p->m_done) return;
+  if (!p->m_leaf) {
+    collectLeaves(p->m_sub1, leaves, numLeaves);
+    collectLeaves(p->m_sub2, leaves, numLeaves);
+    return;
+  }
+  leaves[(*numLeaves)++] = p;
+}
+
+
+// --------------------------------------------------------------------
+// partitionSortBySize()
+//
+/// \brief Orders partitions by decreasing number of members.
+//
+// --------------------------------------------------------------------
+int partitionSortBySize(const void *a, const void *b) {
+  const Partition *pa = *(const Partition **)a;
+  const Partition *pb = *(const Partition **)b;
+
+  return pb->m_numMembers - pa->m_numMembers;
+}
+
+
+// --------------------------------------------------------------------
+// updateDone()
+//
+/// \brief Marks the partitions whose leaves are all done.
+//
+// --------------------------------------------------------------------
+bool updateDone(Partition *p) {
+
+  if (p->m_done || p->m_leaf) return p->m_done;
+  p->m_done = updateDone(p->m_sub1);
+  p->m_done &= updateDone(p->m_sub2);
   return p->m_done;
 }
 
@@ -424,6 +575,652 @@ void repartitionHMetis(Partition *parent) {
 }
 
 
+// --------------------------------------------------------------------
+// ML_intSort()
+//
+// --------------------------------------------------------------------
+int ML_intSort(const void *a, const void *b) {
+  return *(const int *)a - *(const int *)b;
+}
+
+
+// --------------------------------------------------------------------
+// ML_buildCellNets()
+//
+/// \brief Collects the nets of each cell.
+//
+/// Nets with a single terminal or more than ML_MAX_NETSIZE terminals
+/// are skipped.
+///
+// --------------------------------------------------------------------
+void ML_buildCellNets() {
+  int n, t, c, id;
+  ConcreteNet *net;
+
+  ML_cellNetStart = (int *)realloc(ML_cellNetStart, sizeof(int)*(g_place_numCells+1));
+  memset(ML_cellNetStart, 0, sizeof(int)*(g_place_numCells+1));
+  for(n=0; n<g_place_numNets; n++) if ((net = g_place_concreteNets[n]))
+    if (net->m_numTerms > 1 && net->m_numTerms <= ML_MAX_NETSIZE)
+      for(t=0; t<net->m_numTerms; t++)
+        ML_cellNetStart[net->m_terms[t]->m_id+1]++;
+  for(c=0; c<g_place_numCells; c++)
+    ML_cellNetStart[c+1] += ML_cellNetStart[c];
+  ML_cellNets = (int *)realloc(ML_cellNets, sizeof(int)*(ML_cellNetStart[g_place_numCells]+1));
+  for(n=0; n<g_place_numNets; n++) if ((net = g_place_concreteNets[n]))
+    if (net->m_numTerms > 1 && net->m_numTerms <= ML_MAX_NETSIZE)
+      for(t=0; t<net->m_numTerms; t++) {
+        id = net->m_terms[t]->m_id;
+        ML_cellNets[ML_cellNetStart[id]++] = n;
+      }
+  // restore the starting positions
+  for(c=g_place_numCells; c>0; c--)
+    ML_cellNetStart[c] = ML_cellNetStart[c-1];
+  ML_cellNetStart[0] = 0;
+}
+
+
+// --------------------------------------------------------------------
+// ML_numberMembers()
+//
+/// \brief Stores the index of each member of a partition in m_data.
+//
+/// Members are numbered in the order of m_members, skipping empty
+/// entries. This is done before the partitions are split in parallel,
+/// so that the workers only read m_data.
+///
+// --------------------------------------------------------------------
+void ML_numberMembers(Partition *p) {
+  int t, v = 0;
+
+  for(t=0; t<p->m_numMembers; t++) if (p->m_members[t])
+    p->m_members[t]->m_data = v++;
+}
+
+
+// --------------------------------------------------------------------
+// ML_freeGraph()
+//
+// --------------------------------------------------------------------
+void ML_freeGraph(ML_graph *g) {
+  free(g->m_area);
+  free(g->m_netStart);
+  free(g->m_netPins);
+  free(g->m_netFixed);
+  free(g->m_vertStart);
+  free(g->m_vertNets);
+  free(g);
+}
+
+
+// --------------------------------------------------------------------
+// ML_buildVertNets()
+//
+/// \brief Derives the nets of each vertex from the pins of each net.
+//
+// --------------------------------------------------------------------
+void ML_buildVertNets(ML_graph *g) {
+  int e, k, v;
+
+  g->m_vertStart = (int *)calloc(g->m_numVerts+1, sizeof(int));
+  g->m_vertNets = (int *)malloc(sizeof(int)*(g->m_netStart[g->m_numNets]+1));
+  for(k=0; k<g->m_netStart[g->m_numNets]; k++)
+    g->m_vertStart[g->m_netPins[k]+1]++;
+  for(v=0; v<g->m_numVerts; v++)
+    g->m_vertStart[v+1] += g->m_vertStart[v];
+  for(e=0; e<g->m_numNets; e++)
+    for(k=g->m_netStart[e]; k<g->m_netStart[e+1]; k++) {
+      v = g->m_netPins[k];
+      g->m_vertNets[g->m_vertStart[v]++] = e;
+    }
+  for(v=g->m_numVerts; v>0; v--)
+    g->m_vertStart[v] = g->m_vertStart[v-1];
+  g->m_vertStart[0] = 0;
+}
+
+
+// --------------------------------------------------------------------
+// ML_keepNet()
+//
+/// \brief Returns true if a net can change the cut.
+//
+/// A net with one vertex matters only if its outside terminals are
+/// all on one side.
+///
+// --------------------------------------------------------------------
+bool ML_keepNet(int numPins, int fixed0, int fixed1) {
+  if (numPins >= 2) return true;
+  return numPins == 1 && (fixed0 > 0) != (fixed1 > 0);
+}
+
+
+// --------------------------------------------------------------------
+// ML_buildGraph()
+//
+/// \brief Builds the hypergraph of the members of a partition near the cut.
+//
+/// As in repartitionHMetis(), only the members closer to the cut line
+/// than REPARTITION_TARGET_FRACTION of the partition are free. They
+/// become the vertices; vert[] gives the vertex of each member or -1.
+/// The other members stay on their side, and the terminals outside of
+/// the partition are fixed on the side of the cut line where they are
+/// located. The side of each member is taken from the current
+/// subpartitions.
+///
+// --------------------------------------------------------------------
+ML_graph *ML_buildGraph(Partition *parent, ConcreteCell **members, int side [], int vert []) {
+  ML_graph *g = (ML_graph *)calloc(1, sizeof(ML_graph));
+  int *nets = NULL, *mark = NULL, numMembers = 0, numNets = 0, numPins = 0;
+  int m, v, k, t, e, n, fixed[2];
+  float cut_loc = parent->m_vertical ? parent->m_sub2->m_bounds.x : parent->m_sub2->m_bounds.y;
+  float target = parent->m_vertical ? parent->m_bounds.w*REPARTITION_TARGET_FRACTION : 
+                                      parent->m_bounds.h*REPARTITION_TARGET_FRACTION;
+  ConcreteCell *cell;
+  ConcreteNet *net;
+
+  // collect the members (they may have been sorted since they were numbered)
+  for(t=0; t<parent->m_numMembers; t++) if (parent->m_members[t])
+    numMembers++;
+  for(t=0; t<parent->m_numMembers; t++) if (parent->m_members[t]) {
+    cell = parent->m_members[t];
+    assert(cell->m_data >= 0 && cell->m_data < numMembers);
+    members[cell->m_data] = cell;
+  }
+  for(m=0; m<numMembers; m++) side[m] = 1;
+  for(t=0; t<parent->m_sub1->m_numMembers; t++) if (parent->m_sub1->m_members[t])
+    side[parent->m_sub1->m_members[t]->m_data] = 0;
+
+  // pay attention to cells that are close to the cut
+  g->m_area = (float *)malloc(sizeof(float)*(numMembers+1));
+  for(m=0; m<numMembers; m++) {
+    cell = members[m];
+    if (fabs((parent->m_vertical ? cell->m_x : cell->m_y) - cut_loc) < target) {
+      vert[m] = g->m_numVerts;
+      g->m_area[g->m_numVerts++] = getCellArea(cell);
+    } else {
+      vert[m] = -1;
+      g->m_fixedArea[side[m]] += getCellArea(cell);
+    }
+  }
+
+  // collect the nets of the vertices without duplicates
+  for(m=0; m<numMembers; m++) if (vert[m] >= 0)
+    numPins += ML_cellNetStart[members[m]->m_id+1] - ML_cellNetStart[members[m]->m_id];
+  nets = (int *)malloc(sizeof(int)*(numPins+1));
+  for(m=0; m<numMembers; m++) if (vert[m] >= 0)
+    for(k=ML_cellNetStart[members[m]->m_id]; k<ML_cellNetStart[members[m]->m_id+1]; k++)
+      nets[numNets++] = ML_cellNets[k];
+  qsort(nets, (size_t)numNets, sizeof(int), ML_intSort);
+  for(k=n=0; k<numNets; k++)
+    if (n == 0 || nets[n-1] != nets[k])
+      nets[n++] = nets[k];
+  numNets = n;
+
+  // add the pins of each net
+  mark = (int *)malloc(sizeof(int)*(g->m_numVerts+1));
+  for(v=0; v<g->m_numVerts; v++) mark[v] = -1;
+  g->m_netStart = (int *)malloc(sizeof(int)*(numNets+1));
+  g->m_netFixed = (int *)malloc(sizeof(int)*2*(numNets+1));
+  g->m_netPins = (int *)malloc(sizeof(int)*(numPins+1));
+  g->m_netStart[0] = 0;
+  for(k=0; k<numNets; k++) {
+    net = g_place_concreteNets[nets[k]];
+    e = g->m_numNets;
+    fixed[0] = fixed[1] = n = 0;
+    for(t=0; t<net->m_numTerms; t++) {
+      cell = net->m_terms[t];
+      m = cell->m_data;
+      if (m >= 0 && m < numMembers && members[m] == cell) {
+        if ((v = vert[m]) < 0)
+          fixed[side[m]]++;
+        else if (mark[v] != k) {
+          mark[v] = k;
+          g->m_netPins[g->m_netStart[e] + n++] = v;
+        }
+      } else if ((parent->m_vertical ? cell->m_x : cell->m_y) < cut_loc)
+        fixed[0]++;
+      else
+        fixed[1]++;
+    }
+    if (!ML_keepNet(n, fixed[0], fixed[1]))
+      continue;
+    g->m_netFixed[2*e] = fixed[0];
+    g->m_netFixed[2*e+1] = fixed[1];
+    g->m_netStart[++g->m_numNets] = g->m_netStart[e] + n;
+  }
+  free(nets);
+  free(mark);
+
+  ML_buildVertNets(g);
+  return g;
+}
+
+
+// --------------------------------------------------------------------
+// ML_coarsen()
+//
+/// \brief Clusters the vertices of a hypergraph in pairs.
+//
+/// Each unmatched vertex is paired with the unmatched neighbor that
+/// shares the heaviest connection, where a net of k pins contributes
+/// 1/(k-1). Nets with more than ML_MATCH_NETSIZE pins are not
+/// considered, and clusters may not exceed maxArea. The cluster of
+/// each vertex is returned in map[].
+///
+// --------------------------------------------------------------------
+ML_graph *ML_coarsen(ML_graph *g, int map [], float maxArea) {
+  ML_graph *c = (ML_graph *)calloc(1, sizeof(ML_graph));
+  float *score = (float *)calloc(g->m_numVerts+1, sizeof(float));
+  int *touched = (int *)malloc(sizeof(int)*(g->m_numVerts+1));
+  int *mark = NULL;
+  int numTouched, v, u, best, k, j, e, n;
+  float w;
+
+  for(v=0; v<g->m_numVerts; v++) map[v] = -1;
+
+  // match the vertices
+  for(v=0; v<g->m_numVerts; v++) {
+    if (map[v] >= 0) continue;
+    numTouched = 0;
+    for(k=g->m_vertStart[v]; k<g->m_vertStart[v+1]; k++) {
+      e = g->m_vertNets[k];
+      n = g->m_netStart[e+1] - g->m_netStart[e];
+      if (n < 2 || n > ML_MATCH_NETSIZE) continue;
+      w = 1.0 / (n-1);
+      for(j=g->m_netStart[e]; j<g->m_netStart[e+1]; j++) {
+        u = g->m_netPins[j];
+        if (u == v || map[u] >= 0) continue;
+        if (score[u] == 0) touched[numTouched++] = u;
+        score[u] += w;
+      }
+    }
+    best = -1;
+    for(j=0; j<numTouched; j++) {
+      u = touched[j];
+      if (g->m_area[u] + g->m_area[v] <= maxArea && 
+          (best < 0 || score[u] > score[best]))
+        best = u;
+    }
+    for(j=0; j<numTouched; j++) score[touched[j]] = 0;
+    map[v] = c->m_numVerts;
+    if (best >= 0) map[best] = c->m_numVerts;
+    c->m_numVerts++;
+  }
+  free(score);
+  free(touched);
+
+  // cluster areas
+  c->m_fixedArea[0] = g->m_fixedArea[0];
+  c->m_fixedArea[1] = g->m_fixedArea[1];
+  c->m_area = (float *)calloc(c->m_numVerts+1, sizeof(float));
+  for(v=0; v<g->m_numVerts; v++)
+    c->m_area[map[v]] += g->m_area[v];
+
+  // map the nets, dropping the duplicated pins
+  mark = (int *)malloc(sizeof(int)*(c->m_numVerts+1));
+  for(v=0; v<c->m_numVerts; v++) mark[v] = -1;
+  c->m_netStart = (int *)malloc(sizeof(int)*(g->m_numNets+1));
+  c->m_netFixed = (int *)malloc(sizeof(int)*2*(g->m_numNets+1));
+  c->m_netPins = (int *)malloc(sizeof(int)*(g->m_netStart[g->m_numNets]+1));
+  c->m_netStart[0] = 0;
+  for(e=0; e<g->m_numNets; e++) {
+    n = 0;
+    for(j=g->m_netStart[e]; j<g->m_netStart[e+1]; j++) {
+      u = map[g->m_netPins[j]];
+      if (mark[u] == e) continue;
+      mark[u] = e;
+      c->m_netPins[c->m_netStart[c->m_numNets] + n++] = u;
+    }
+    if (!ML_keepNet(n, g->m_netFixed[2*e], g->m_netFixed[2*e+1]))
+      continue;
+    c->m_netFixed[2*c->m_numNets] = g->m_netFixed[2*e];
+    c->m_netFixed[2*c->m_numNets+1] = g->m_netFixed[2*e+1];
+    c->m_netStart[c->m_numNets+1] = c->m_netStart[c->m_numNets] + n;
+    c->m_numNets++;
+  }
+  free(mark);
+
+  ML_buildVertNets(c);
+  return c;
+}
+
+
+// --------------------------------------------------------------------
+// ML_cutSize()
+//
+/// \brief Counts the nets with terminals on both sides.
+//
+// --------------------------------------------------------------------
+int ML_cutSize(ML_graph *g, int side []) {
+  int e, j, count[2], cuts = 0;
+
+  for(e=0; e<g->m_numNets; e++) {
+    count[0] = g->m_netFixed[2*e];
+    count[1] = g->m_netFixed[2*e+1];
+    for(j=g->m_netStart[e]; j<g->m_netStart[e+1]; j++)
+      count[side[g->m_netPins[j]]]++;
+    if (count[0] > 0 && count[1] > 0) cuts++;
+  }
+  return cuts;
+}
+
+
+// --------------------------------------------------------------------
+// ML_bucketAdd() / ML_bucketRemove()
+//
+/// \brief Inserts or removes a vertex in the gain bucket of its side.
+//
+// --------------------------------------------------------------------
+void ML_bucketAdd(ML_fm *fm, int v) {
+  int s = fm->m_side[v], idx = fm->m_gain[v] + fm->m_maxDeg;
+  int *head = fm->m_buckets + s*(2*fm->m_maxDeg+1) + idx;
+
+  fm->m_prev[v] = -1;
+  fm->m_next[v] = *head;
+  if (*head >= 0) fm->m_prev[*head] = v;
+  *head = v;
+  if (idx > fm->m_maxIdx[s]) fm->m_maxIdx[s] = idx;
+}
+
+void ML_bucketRemove(ML_fm *fm, int v) {
+  int s = fm->m_side[v], idx = fm->m_gain[v] + fm->m_maxDeg;
+  int *head = fm->m_buckets + s*(2*fm->m_maxDeg+1) + idx;
+
+  if (fm->m_prev[v] >= 0) fm->m_next[fm->m_prev[v]] = fm->m_next[v];
+  else *head = fm->m_next[v];
+  if (fm->m_next[v] >= 0) fm->m_prev[fm->m_next[v]] = fm->m_prev[v];
+}
+
+
+// --------------------------------------------------------------------
+// ML_updateGain()
+//
+/// \brief Changes the gain of an unlocked vertex and moves it to its new bucket.
+//
+// --------------------------------------------------------------------
+void ML_updateGain(ML_fm *fm, int v, int inc) {
+  if (fm->m_locked[v]) return;
+  ML_bucketRemove(fm, v);
+  fm->m_gain[v] += inc;
+  ML_bucketAdd(fm, v);
+}
+
+
+// --------------------------------------------------------------------
+// ML_updateNetGains()
+//
+/// \brief Updates the gains of the pins of a net whose count on a side becomes critical.
+//
+/// If the net has no pins on side s, all free pins change their gain by
+/// inc. If it has one pin on side s, only that pin is changed (unless it
+/// is an outside terminal).
+///
+// --------------------------------------------------------------------
+void ML_updateNetGains(ML_fm *fm, int e, int s, int inc) {
+  ML_graph *g = fm->m_graph;
+  int j, u;
+
+  if (fm->m_count[2*e+s] == 0) {
+    for(j=g->m_netStart[e]; j<g->m_netStart[e+1]; j++)
+      ML_updateGain(fm, g->m_netPins[j], inc);
+  } else if (fm->m_count[2*e+s] == 1 && g->m_netFixed[2*e+s] == 0) {
+    for(j=g->m_netStart[e]; j<g->m_netStart[e+1]; j++) {
+      u = g->m_netPins[j];
+      if (fm->m_side[u] == s) { 
+        ML_updateGain(fm, u, -inc); 
+        break; 
+      }
+    }
+  }
+}
+
+
+// --------------------------------------------------------------------
+// ML_pickMove()
+//
+/// \brief Returns the free vertex with the highest gain whose move keeps the balance.
+//
+/// At most ML_SCAN_LIMIT vertices are examined on each side. Returns -1
+/// if no vertex can be moved.
+///
+// --------------------------------------------------------------------
+int ML_pickMove(ML_fm *fm, float sideArea [], float maxArea) {
+  int s, idx, v, scanned, best = -1;
+  int *heads;
+
+  for(s=0; s<2; s++) {
+    heads = fm->m_buckets + s*(2*fm->m_maxDeg+1);
+    while(fm->m_maxIdx[s] >= 0 && heads[fm->m_maxIdx[s]] < 0) fm->m_maxIdx[s]--;
+    scanned = 0;
+    for(idx=fm->m_maxIdx[s]; idx>=0 && scanned<ML_SCAN_LIMIT; idx--)
+      for(v=heads[idx]; v>=0 && scanned<ML_SCAN_LIMIT; v=fm->m_next[v], scanned++)
+        if (sideArea[!s] + fm->m_graph->m_area[v] <= maxArea) {
+          if (best < 0 || fm->m_gain[v] > fm->m_gain[best] ||
+              (fm->m_gain[v] == fm->m_gain[best] && sideArea[s] > sideArea[!s]))
+            best = v;
+          scanned = ML_SCAN_LIMIT;
+          break;
+        }
+  }
+  return best;
+}
+
+
+// --------------------------------------------------------------------
+// ML_refine()
+//
+/// \brief Improves a bisection with Fiduccia-Mattheyses passes.
+//
+/// Each pass moves the free vertex with the highest gain, locks it and
+/// updates the gains through the bucket arrays, then rolls back to the
+/// best prefix of moves. A pass stops after ML_STALL_MOVES moves without
+/// improvement. Returns the number of cut nets.
+///
+// --------------------------------------------------------------------
+int ML_refine(ML_graph *g, int side [], float maxArea) {
+  ML_fm fm;
+  int *moves = (int *)malloc(sizeof(int)*(g->m_numVerts+1));
+  int numMoves, bestMoves, pass, v, k, e, from, to, cuts, gain, bestGain;
+  int maxStall = g->m_numVerts/20 > ML_STALL_MOVES ? g->m_numVerts/20 : ML_STALL_MOVES;
+  float sideArea[2], bestImbalance;
+
+  memset(&fm, 0, sizeof(ML_fm));
+  fm.m_graph = g;
+  fm.m_side = side;
+  for(v=0; v<g->m_numVerts; v++)
+    if (g->m_vertStart[v+1] - g->m_vertStart[v] > fm.m_maxDeg)
+      fm.m_maxDeg = g->m_vertStart[v+1] - g->m_vertStart[v];
+  fm.m_count = (int *)malloc(sizeof(int)*2*(g->m_numNets+1));
+  fm.m_gain = (int *)malloc(sizeof(int)*(g->m_numVerts+1));
+  fm.m_next = (int *)malloc(sizeof(int)*(g->m_numVerts+1));
+  fm.m_prev = (int *)malloc(sizeof(int)*(g->m_numVerts+1));
+  fm.m_locked = (bool *)malloc(sizeof(bool)*(g->m_numVerts+1));
+  fm.m_buckets = (int *)malloc(sizeof(int)*2*(2*fm.m_maxDeg+1));
+  cuts = ML_cutSize(g, side);
+
+  for(pass=0; pass<FM_MAX_PASSES; pass++) {
+    // count the pins on each side and the gains
+    sideArea[0] = g->m_fixedArea[0];
+    sideArea[1] = g->m_fixedArea[1];
+    for(v=0; v<g->m_numVerts; v++)
+      sideArea[side[v]] += g->m_area[v];
+    for(e=0; e<g->m_numNets; e++) {
+      fm.m_count[2*e] = g->m_netFixed[2*e];
+      fm.m_count[2*e+1] = g->m_netFixed[2*e+1];
+      for(k=g->m_netStart[e]; k<g->m_netStart[e+1]; k++)
+        fm.m_count[2*e+side[g->m_netPins[k]]]++;
+    }
+    for(k=0; k<2*(2*fm.m_maxDeg+1); k++) fm.m_buckets[k] = -1;
+    fm.m_maxIdx[0] = fm.m_maxIdx[1] = -1;
+    for(v=0; v<g->m_numVerts; v++) {
+      fm.m_gain[v] = 0;
+      for(k=g->m_vertStart[v]; k<g->m_vertStart[v+1]; k++) {
+        e = g->m_vertNets[k];
+        if (fm.m_count[2*e+side[v]] == 1) fm.m_gain[v]++;
+        if (fm.m_count[2*e+!side[v]] == 0) fm.m_gain[v]--;
+      }
+      fm.m_locked[v] = false;
+      ML_bucketAdd(&fm, v);
+    }
+
+    // move the vertices
+    numMoves = bestMoves = 0;
+    gain = bestGain = 0;
+    bestImbalance = fabs(sideArea[0] - sideArea[1]);
+    while(numMoves - bestMoves < maxStall) {
+      if ((v = ML_pickMove(&fm, sideArea, maxArea)) < 0)
+        break;
+      from = side[v];
+      to = !from;
+      ML_bucketRemove(&fm, v);
+      fm.m_locked[v] = true;
+      gain += fm.m_gain[v];
+      for(k=g->m_vertStart[v]; k<g->m_vertStart[v+1]; k++) {
+        e = g->m_vertNets[k];
+        ML_updateNetGains(&fm, e, to, 1);
+        fm.m_count[2*e+from]--;
+        fm.m_count[2*e+to]++;
+        side[v] = to;
+        ML_updateNetGains(&fm, e, from, -1);
+        side[v] = from;
+      }
+      side[v] = to;
+      sideArea[from] -= g->m_area[v];
+      sideArea[to] += g->m_area[v];
+      moves[numMoves++] = v;
+      if (gain > bestGain || 
+          (gain == bestGain && fabs(sideArea[0] - sideArea[1]) < bestImbalance)) {
+        bestGain = gain;
+        bestMoves = numMoves;
+        bestImbalance = fabs(sideArea[0] - sideArea[1]);
+      }
+    }
+
+    // undo the moves after the best prefix
+    while(numMoves > bestMoves) {
+      v = moves[--numMoves];
+      side[v] = !side[v];
+    }
+    cuts -= bestGain;
+    if (bestGain <= 0) break;
+  }
+  assert(cuts == ML_cutSize(g, side));
+
+  free(moves);
+  free(fm.m_count);
+  free(fm.m_gain);
+  free(fm.m_next);
+  free(fm.m_prev);
+  free(fm.m_locked);
+  free(fm.m_buckets);
+  return cuts;
+}
+
+
+// --------------------------------------------------------------------
+// repartitionMultilevel()
+//
+/// \brief Repartitions the two subpartitions with a built-in multilevel min-cut partitioner.
+//
+/// The members are clustered in pairs until ML_COARSEST_SIZE vertices
+/// remain, the initial bisection is projected to the coarsest level,
+/// and the bisection is refined with F-M on the way back to the cells.
+/// The members must be numbered by ML_numberMembers() and the nets of
+/// the cells collected by ML_buildCellNets().
+///
+// --------------------------------------------------------------------
+void repartitionMultilevel(Partition *parent) {
+  ML_graph *graphs[ML_MAX_LEVELS], *g;
+  int *maps[ML_MAX_LEVELS], *sides[ML_MAX_LEVELS];
+  ConcreteCell **members = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*(parent->m_numMembers+1));
+  int *side = (int *)malloc(sizeof(int)*(parent->m_numMembers+1));
+  int *vert = (int *)malloc(sizeof(int)*(parent->m_numMembers+1));
+  int numLevels = 1, numMembers, level, m, v, c, before_cuts, after_cuts = 0;
+  float totalArea, maxArea, *bestArea;
+
+  assert(parent);
+  assert(parent->m_sub1);
+  assert(parent->m_sub2);
+
+  graphs[0] = ML_buildGraph(parent, members, side, vert);
+  numMembers = parent->m_sub1->m_numMembers + parent->m_sub2->m_numMembers;
+  sides[0] = (int *)malloc(sizeof(int)*(graphs[0]->m_numVerts+1));
+  totalArea = graphs[0]->m_fixedArea[0] + graphs[0]->m_fixedArea[1];
+  for(m=0; m<numMembers; m++) if ((v = vert[m]) >= 0) {
+    sides[0][v] = side[m];
+    totalArea += graphs[0]->m_area[v];
+  }
+  maxArea = totalArea*(0.5+MAX_PARTITION_NONSYMMETRY);
+  before_cuts = ML_cutSize(graphs[0], sides[0]);
+
+  // coarsen, projecting the initial sides
+  while(numLevels < ML_MAX_LEVELS && graphs[numLevels-1]->m_numVerts > ML_COARSEST_SIZE) {
+    g = graphs[numLevels-1];
+    maps[numLevels-1] = (int *)malloc(sizeof(int)*(g->m_numVerts+1));
+    graphs[numLevels] = ML_coarsen(g, maps[numLevels-1], totalArea*2.0/ML_COARSEST_SIZE);
+    if (graphs[numLevels]->m_numVerts > g->m_numVerts*ML_MIN_REDUCTION) {
+      ML_freeGraph(graphs[numLevels]);
+      free(maps[numLevels-1]);
+      break;
+    }
+    // each cluster goes to the side of its largest vertex
+    sides[numLevels] = (int *)malloc(sizeof(int)*(graphs[numLevels]->m_numVerts+1));
+    bestArea = (float *)malloc(sizeof(float)*(graphs[numLevels]->m_numVerts+1));
+    for(c=0; c<graphs[numLevels]->m_numVerts; c++) bestArea[c] = -1;
+    for(v=0; v<g->m_numVerts; v++) {
+      c = maps[numLevels-1][v];
+      if (g->m_area[v] > bestArea[c]) {
+        bestArea[c] = g->m_area[v];
+        sides[numLevels][c] = sides[numLevels-1][v];
+      }
+    }
+    free(bestArea);
+    numLevels++;
+  }
+
+  // refine from the coarsest level to the cells
+  for(level=numLevels-1; level>=0; level--) {
+    if (level < numLevels-1) {
+      for(v=0; v<graphs[level]->m_numVerts; v++)
+        sides[level][v] = sides[level+1][maps[level][v]];
+      ML_freeGraph(graphs[level+1]);
+      free(sides[level+1]);
+      free(maps[level]);
+    }
+    after_cuts = ML_refine(graphs[level], sides[level], maxArea);
+  }
+
+  // reassign members to subpartitions
+  parent->m_sub1->m_numMembers = 0;
+  parent->m_sub1->m_area = 0;
+  parent->m_sub2->m_numMembers = 0;
+  parent->m_sub2->m_area = 0;
+  parent->m_sub1->m_members = (ConcreteCell**)realloc(parent->m_sub1->m_members, 
+       sizeof(ConcreteCell*)*parent->m_numMembers); 
+  parent->m_sub2->m_members = (ConcreteCell**)realloc(parent->m_sub2->m_members, 
+       sizeof(ConcreteCell*)*parent->m_numMembers); 
+  for(m=0; m<numMembers; m++) {
+    if (vert[m] >= 0) 
+      side[m] = sides[0][vert[m]];
+    if (side[m] == 0) {
+      parent->m_sub1->m_members[parent->m_sub1->m_numMembers++] = members[m];
+      parent->m_sub1->m_area += getCellArea(members[m]);
+    } else {
+      parent->m_sub2->m_members[parent->m_sub2->m_numMembers++] = members[m];
+      parent->m_sub2->m_area += getCellArea(members[m]);
+    }
+  }
+
+  printf("QPAR-03 : \t\tmultilevel repartitioning: targets= %d levels= %d starting cuts= %d final cuts= %d\n",
+         graphs[0]->m_numVerts, numLevels, before_cuts, after_cuts);
+
+  ML_freeGraph(graphs[0]);
+  free(sides[0]);
+  free(members);
+  free(side);
+  free(vert);
+}
+
+
 // --------------------------------------------------------------------
 // repartitionFM()
 //
@@ -1002,7 +1799,10 @@ void reallocPartition(Partition *p) {
 
   // --- PARTITION IMPROVEMENT
   if (p->m_level < REPARTITION_LEVEL_DEPTH) {
-    if (REPARTITION_HMETIS)
+    if (REPARTITION_MULTILEVEL) {
+      ML_numberMembers(p);
+      repartitionMultilevel(p);
+    } else if (REPARTITION_HMETIS)
       repartitionHMetis(p);
     
     resizePartition(p);
@@ -13,6 +13,7 @@
 #include <stdlib.h>
 
 #include "place_qpsolver.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -36,6 +37,15 @@ ABC_NAMESPACE_IMPL_START
 
 #undef QPS_HOIST
 
+#define QPS_PAR_MIN 4096        /* fewest variables worth the threads */
+
+#define QPS_OP_INIT 0
+#define QPS_OP_EXPAND 1
+#define QPS_OP_SPMV 2
+#define QPS_OP_DOT 3
+#define QPS_OP_UPDATE 4
+#define QPS_OP_DIR 5
+
 #if defined(QPS_DEBUG)
 #define QPS_DEBUG_FILE "/tmp/qps_debug.log"
 #endif
@@ -528,6 +538,7 @@ qps_cgmin(qps_problem_t * p)
 #if (QPS_DEBUG > 0)
   fprintf(p->priv_fp, "### CG ITERS=%d %d %d\n", i, p->cog_num, p->loop_num);
 #endif
+  p->iters += i;
   if (i == 2 * n) {
     fprintf(stderr, "### Too many iterations in qps_cgmin()\n");
 #if defined(QPS_DEBUG)
@@ -538,6 +549,315 @@ qps_cgmin(qps_problem_t * p)
 
 /**********************************************************************/
 
+static void
+qps_spbuild(qps_problem_t * p)
+{
+  /* Assemble the Hessian of the wirelength over all cells (twice the
+     Laplacian of the connectivity) in CSR form.  The diagonal entry is
+     the first entry of each row. */
+
+  int i, j, k;
+  int pr;
+  qps_float_t w;
+
+  int nc = p->num_cells;
+  int *rp;
+
+  rp = p->priv_rp = (int *)malloc((nc + 1) * sizeof(int));
+  assert(rp);
+  for (i = nc + 1; i--;) {
+    rp[i] = 0;
+  }
+  pr = 0;
+  for (j = 0; j < nc; j++) {
+    while ((k = p->priv_cc[pr]) >= 0) {
+      rp[j + 1]++;
+      rp[k + 1]++;
+      pr++;
+    }
+    pr++;
+  }
+  for (j = 0; j < nc; j++) {
+    rp[j + 1] += rp[j] + 1;
+  }
+  p->priv_ci = (int *)malloc(rp[nc] * sizeof(int));
+  assert(p->priv_ci);
+  p->priv_cv = (qps_float_t *) malloc(rp[nc] * sizeof(qps_float_t));
+  assert(p->priv_cv);
+
+  /* diagonal entries first; rp[j] is used as the fill position */
+  for (j = 0; j < nc; j++) {
+    p->priv_ci[rp[j]] = j;
+    p->priv_cv[rp[j]] = 0.0;
+    rp[j]++;
+  }
+  pr = 0;
+  for (j = 0; j < nc; j++) {
+    while ((k = p->priv_cc[pr]) >= 0) {
+      w = 2.0 * p->priv_ct[pr];
+      p->priv_ci[rp[j]] = k;
+      p->priv_cv[rp[j]++] = -w;
+      p->priv_ci[rp[k]] = j;
+      p->priv_cv[rp[k]++] = -w;
+      pr++;
+    }
+    pr++;
+  }
+  /* shift the fill positions back into row starts */
+  for (j = nc; j > 0; j--) {
+    rp[j] = rp[j - 1];
+  }
+  rp[0] = 0;
+  for (j = 0; j < nc; j++) {
+    w = 0.0;
+    for (i = rp[j] + 1; i < rp[j + 1]; i++) {
+      w -= p->priv_cv[i];
+    }
+    p->priv_cv[rp[j]] = w;
+  }
+}
+
+/**********************************************************************/
+
+static void
+qps_sptask(void *arg, int thread, void *scratch)
+{
+  /* Run one step of the sparse solver over the share of the variables
+     (or cells) given to this thread.  The steps are separated by the
+     barrier in qps_sprun(). */
+
+  qps_problem_t *p = (qps_problem_t *) arg;
+  int i, j, k;
+  int pr;
+  int ji, ki;
+  int lo, hi;
+  qps_float_t jx, jy, w;
+  double sum = 0.0;
+
+  int n = p->priv_n;
+  int nc = p->num_cells;
+  qps_float_t *r = p->priv_g;
+  qps_float_t *h = p->priv_h;
+  qps_float_t *ap = p->priv_xi;
+  qps_float_t *tp = p->priv_tp;
+  qps_float_t *tp2 = p->priv_tp2;
+#if defined(QPS_PRECON)
+  qps_float_t *pc = p->priv_pcgt;
+#endif
+
+  if (p->priv_op == QPS_OP_EXPAND || p->priv_op == QPS_OP_SPMV) {
+    lo = (int)((long)nc * thread / p->priv_nt);
+    hi = (int)((long)nc * (thread + 1) / p->priv_nt);
+  }
+  else {
+    /* keep the x and y variables of a cell together */
+    lo = (int)((long)(n / 2) * thread / p->priv_nt) * 2;
+    hi = (int)((long)(n / 2) * (thread + 1) / p->priv_nt) * 2;
+  }
+
+  switch (p->priv_op) {
+  case QPS_OP_INIT:
+    /* r = -grad f, h = M r */
+    for (j = lo; j < hi; j++) {
+      r[j] = -r[j];
+#if defined(QPS_PRECON)
+      h[j] = pc[j] * r[j];
+#else
+      h[j] = r[j];
+#endif
+      sum += (double)r[j] * h[j];
+    }
+    break;
+  case QPS_OP_EXPAND:
+    /* translate h to all cells; fixed cells do not move */
+    for (j = lo; j < hi; j++) {
+      ji = p->priv_ii[j];
+      if (ji >= 0) {
+    tp[j * 2] = h[ji];
+    tp[j * 2 + 1] = h[ji + 1];
+    continue;
+      }
+      tp[j * 2] = 0.0;
+      tp[j * 2 + 1] = 0.0;
+      if (ji < -1) {
+    pr = p->priv_gt[-(ji + 2)];
+    while ((k = p->cog_list[pr]) >= 0) {
+      ki = p->priv_ii[k];
+      if (ki >= 0) {
+        w = p->priv_gw[pr];
+        tp[j * 2] -= h[ki] * w;
+        tp[j * 2 + 1] -= h[ki + 1] * w;
+      }
+      pr++;
+    }
+      }
+    }
+    break;
+  case QPS_OP_SPMV:
+    /* tp2 = H tp for the movable cells, ap = tp2 for the independent */
+    for (j = lo; j < hi; j++) {
+      ji = p->priv_ii[j];
+      if (ji == -1) {
+    continue;
+      }
+      jx = 0.0;
+      jy = 0.0;
+      for (i = p->priv_rp[j]; i < p->priv_rp[j + 1]; i++) {
+    k = p->priv_ci[i];
+    w = p->priv_cv[i];
+    jx += w * tp[k * 2];
+    jy += w * tp[k * 2 + 1];
+      }
+      tp2[j * 2] = jx;
+      tp2[j * 2 + 1] = jy;
+      if (ji >= 0) {
+    ap[ji] = jx;
+    ap[ji + 1] = jy;
+      }
+    }
+    break;
+  case QPS_OP_DOT:
+    for (j = lo; j < hi; j++) {
+      sum += (double)h[j] * ap[j];
+    }
+    break;
+  case QPS_OP_UPDATE:
+    /* u += alpha h, r -= alpha ap */
+    w = p->priv_alpha;
+    for (j = lo; j < hi; j++) {
+      p->priv_cp[j] += w * h[j];
+      r[j] -= w * ap[j];
+#if defined(QPS_PRECON)
+      sum += (double)r[j] * r[j] * pc[j];
+#else
+      sum += (double)r[j] * r[j];
+#endif
+    }
+    break;
+  case QPS_OP_DIR:
+    /* h = M r + beta h */
+    w = p->priv_beta;
+    for (j = lo; j < hi; j++) {
+#if defined(QPS_PRECON)
+      h[j] = pc[j] * r[j] + w * h[j];
+#else
+      h[j] = r[j] + w * h[j];
+#endif
+    }
+    break;
+  default:
+    assert(0);
+  }
+  p->priv_ps[thread] = sum;
+}
+
+/**********************************************************************/
+
+static double
+qps_sprun(qps_problem_t * p, int op)
+{
+  /* Run one step of the sparse solver on all threads and wait for them.
+     Returns the sum of the partial results, added in the order of the
+     threads, so that the result does not depend on the timing. */
+
+  int i;
+  double sum = 0.0;
+
+  p->priv_op = op;
+  if (p->priv_pool == NULL) {
+    qps_sptask(p, 0, NULL);
+    return p->priv_ps[0];
+  }
+  for (i = 0; i < p->priv_nt; i++) {
+    Util_PoolAssign((Util_Pool_t *) p->priv_pool, i, qps_sptask, p);
+  }
+  Util_PoolWaitAll((Util_Pool_t *) p->priv_pool);
+  for (i = 0; i < p->priv_nt; i++) {
+    sum += p->priv_ps[i];
+  }
+  return sum;
+}
+
+/**********************************************************************/
+
+static void
+qps_spmin(qps_problem_t * p)
+{
+  /* Perform linear preconditioned CG on the quadratic system in the
+     independent variables, H_z u = b, where H_z = Z^T H Z.  H is applied
+     in CSR form, and Z (the dependent cells of the COG constraints) is
+     applied on the fly as in qps_linmin().  The linear terms of the max
+     penalties only enter through the initial gradient.  Each iteration
+     takes one product with H, instead of the three passes over the
+     connectivity of qps_cgmin(), and stops under the same criterion. */
+
+  qps_float_t fp, f;
+  double rz, rz2, pap;
+  int i, j, k;
+  int pr;
+  int ki;
+  qps_float_t w;
+
+  int n = p->priv_n;
+  qps_float_t *ap = p->priv_xi;
+  qps_float_t *tp2 = p->priv_tp2;
+
+  qps_settp(p);
+  fp = qps_func(p);
+  qps_dfunc(p, p->priv_g);
+  rz = qps_sprun(p, QPS_OP_INIT);
+
+  for (i = 0; i < 2 * n; i++) {
+    if (rz == 0.0) {
+      break;
+    }
+    /* ap = Z^T H Z h */
+    qps_sprun(p, QPS_OP_EXPAND);
+    qps_sprun(p, QPS_OP_SPMV);
+    for (j = p->num_cells; j--;) {
+      if (p->priv_ii[j] < -1) {
+    pr = p->priv_gt[-(p->priv_ii[j] + 2)];
+    while ((k = p->cog_list[pr]) >= 0) {
+      ki = p->priv_ii[k];
+      if (ki >= 0) {
+        w = p->priv_gw[pr];
+        ap[ki] -= tp2[j * 2] * w;
+        ap[ki + 1] -= tp2[j * 2 + 1] * w;
+      }
+      pr++;
+    }
+      }
+    }
+    pap = qps_sprun(p, QPS_OP_DOT);
+    if (pap <= 0.0) {
+      break;
+    }
+    p->priv_alpha = (qps_float_t)(rz / pap);
+    rz2 = qps_sprun(p, QPS_OP_UPDATE);
+    /* the exact line search decreases f by alpha (r^T M r) / 2 */
+    f = fp - (qps_float_t)(p->priv_alpha * rz / 2.0);
+    if (fabs(f - fp) <= (fabs(f) + fabs(fp) + QPS_EPS) * QPS_TOL / 2.0) {
+      i++;
+      break;
+    }
+    fp = f;
+    p->priv_beta = (qps_float_t)(rz2 / rz);
+    rz = rz2;
+    qps_sprun(p, QPS_OP_DIR);
+  }
+#if (QPS_DEBUG > 0)
+  fprintf(p->priv_fp, "### SPCG ITERS=%d %d %d\n", i, p->cog_num, p->loop_num);
+#endif
+  p->iters += i;
+  if (i == 2 * n) {
+    fprintf(stderr, "### Too many iterations in qps_spmin()\n");
+  }
+  qps_settp(p);
+  p->priv_f = qps_func(p);
+}
+
+/**********************************************************************/
+
 void
 qps_init(qps_problem_t * p)
 {
@@ -736,7 +1056,12 @@ qps_solve_inner(qps_problem_t * p)
   p->priv_cw = p->priv_ct;
 #endif /* QPS_HOIST */
 
-  qps_cgmin(p);
+  if (p->priv_sparse) {
+    qps_spmin(p);
+  }
+  else {
+    qps_cgmin(p);
+  }
 
   if (p->max_enable || p->loop_num) {
     if (p->max_enable == 1 || (p->loop_num && p->loop_k == 0)) {
@@ -977,8 +1302,8 @@ qps_solve_inner(qps_problem_t * p)
 
 /**********************************************************************/
 
-void
-qps_solve(qps_problem_t * p)
+static void
+qps_solve_int(qps_problem_t * p)
 {
   int i, j;
   int pr, pw;
@@ -1215,6 +1540,20 @@ qps_solve(qps_problem_t * p)
 #endif /* QPS_HOIST */
   }
 
+  /* set up the sparse solver */
+  p->iters = 0;
+  p->priv_pool = NULL;
+  p->priv_nt = 1;
+  if (p->priv_sparse) {
+    qps_spbuild(p);
+    if (p->num_threads > 1 && p->priv_n >= QPS_PAR_MIN) {
+      p->priv_nt = p->num_threads;
+      p->priv_pool = Util_PoolStart(p->priv_nt, 0);
+    }
+    p->priv_ps = (double *) malloc(p->priv_nt * sizeof(double));
+    assert(p->priv_ps);
+  }
+
   do {
     qps_solve_inner(p);
   } while (!p->loop_done || !p->max_done);
@@ -1251,6 +1590,77 @@ qps_solve(qps_problem_t * p)
   free(p->priv_pcg);
   free(p->priv_pcgt);
 #endif
+  if (p->priv_sparse) {
+    if (p->priv_pool) {
+      Util_PoolStop((Util_Pool_t *) p->priv_pool);
+    }
+    free(p->priv_rp);
+    free(p->priv_ci);
+    free(p->priv_cv);
+    free(p->priv_ps);
+  }
+}
+
+/**********************************************************************/
+
+void
+qps_solve(qps_problem_t * p)
+{
+  /* The sparse solver handles the quadratic problem with the COG and max
+     constraints; the loop penalties need the nonlinear CG. */
+  p->priv_sparse = (p->loop_num == 0);
+  qps_solve_int(p);
+}
+
+/**********************************************************************/
+
+void
+qps_bench(qps_problem_t * p)
+{
+  /* Solve the problem with the nonlinear CG of qps_cgmin() and then with
+     the sparse solver, starting from the same locations, and print the
+     iterations, the runtime and the wirelength of both.  The solution of
+     the sparse solver is kept. */
+
+  int i;
+  abctime clk;
+  int it0;
+  double f0, t0, t1;
+  qps_float_t *sx;
+
+  if (p->loop_num) {
+    qps_solve(p);
+    return;
+  }
+  sx = (qps_float_t *) malloc(2 * p->num_cells * sizeof(qps_float_t));
+  assert(sx);
+  for (i = p->num_cells; i--;) {
+    sx[i * 2] = p->x[i];
+    sx[i * 2 + 1] = p->y[i];
+  }
+
+  clk = Abc_Clock();
+  p->priv_sparse = 0;
+  qps_solve_int(p);
+  t0 = 1.0 * (Abc_Clock() - clk) / CLOCKS_PER_SEC;
+  it0 = p->iters;
+  f0 = p->f;
+
+  for (i = p->num_cells; i--;) {
+    p->x[i] = sx[i * 2];
+    p->y[i] = sx[i * 2 + 1];
+  }
+  free(sx);
+
+  clk = Abc_Clock();
+  p->priv_sparse = 1;
+  qps_solve_int(p);
+  t1 = 1.0 * (Abc_Clock() - clk) / CLOCKS_PER_SEC;
+
+  printf("QP solver: CG     %6d iters %9.3f sec  wirelength %.6e\n",
+     it0, t0, f0);
+  printf("QP solver: sparse %6d iters %9.3f sec  wirelength %.6e  (%d threads)\n",
+     p->iters, t1, (double)p->f, p->priv_nt);
 }
 
 /**********************************************************************/
@@ -50,6 +50,10 @@ ABC_NAMESPACE_HEADER_START
                    floating. */
     qps_float_t f;        /* return value for sum-of-square
                    wirelengths. */
+    int num_threads;        /* Number of threads used by the sparse
+                   solver; 0 or 1 to use a single thread. */
+    int iters;            /* return value for the number of CG
+                   iterations. */
 
     /* COG stuff */
     int cog_num;        /* Number of COG constraints. */
@@ -119,6 +123,13 @@ ABC_NAMESPACE_HEADER_START
     int priv_pn;
     qps_float_t *priv_mxl, *priv_mxh, *priv_myl, *priv_myh;
     int priv_ik;
+    int priv_sparse;
+    int *priv_rp, *priv_ci;
+    qps_float_t *priv_cv;
+    void *priv_pool;
+    int priv_nt, priv_op;
+    qps_float_t priv_alpha, priv_beta;
+    double *priv_ps;
     FILE *priv_fp;
 
   } qps_problem_t;
@@ -128,8 +139,15 @@ ABC_NAMESPACE_HEADER_START
   extern void qps_init(qps_problem_t *);
 
   /* call qps_solve() to solve the given qp problem */
+  /* without loop constraints, the system is solved with the sparse
+     preconditioned CG solver using num_threads threads */
   extern void qps_solve(qps_problem_t *);
 
+  /* call qps_bench() instead of qps_solve() to solve the problem with
+     both the original CG minimizer and the sparse solver, and print the
+     iterations and the runtime of each; the sparse solution is kept */
+  extern void qps_bench(qps_problem_t *);
+
   /* call qps_clean() when finished with the qps_problem_t */
   /* this discards the private data structures assigned by qps_init() */
   extern void qps_clean(qps_problem_t *);
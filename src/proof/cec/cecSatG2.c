@@ -20,6 +20,8 @@
 
 #include "aig/gia/gia.h"
 #include "misc/util/utilTruth.h"
+#include "misc/util/utilSimd.h"
+#include "misc/util/utilPool.h"
 #include "cec.h"
 
 #define USE_GLUCOSE2
@@ -138,6 +140,26 @@ struct Cec4_Man_t_
     abctime          timeStart;
 };
 
+// the number of candidate pairs per thread in one round of parallel sweeping
+#define CEC4_PAR_TASKS 4
+
+// the candidate pair proved by a worker
+typedef struct Cec4_Task_t_ Cec4_Task_t;
+struct Cec4_Task_t_
+{
+    Cec4_Man_t **    ppWorkers;      // the managers of the workers
+    int              iObj;           // the node (in the user's AIG)
+    int              iRepr;          // its representative (in the user's AIG)
+    int              iObj0;          // the representative (in the internal AIG)
+    int              iObj1;          // the node (in the internal AIG)
+    int              fPhase;         // the phase of the comparison
+    int              nBTLimit;       // the conflict limit
+    int              Status;         // the result
+    int              fEasy;          // solved without conflicts
+    abctime          Time;           // the solving time
+    Vec_Int_t *      vPat;           // the counter-example
+};
+
 static inline int    Cec4_ObjSatId( Gia_Man_t * p, Gia_Obj_t * pObj )             { return Gia_ObjCopy2Array(p, Gia_ObjId(p, pObj));                                                     }
 static inline int    Cec4_ObjSetSatId( Gia_Man_t * p, Gia_Obj_t * pObj, int Num ) { assert(Cec4_ObjSatId(p, pObj) == -1); Gia_ObjSetCopy2Array(p, Gia_ObjId(p, pObj), Num); Vec_IntPush(&p->vSuppVars, Gia_ObjId(p, pObj)); if ( Gia_ObjIsCi(pObj) ) Vec_IntPushTwo(&p->vCopiesTwo, Gia_ObjId(p, pObj), Num); assert(Vec_IntSize(&p->vVarMap) == Num); Vec_IntPush(&p->vVarMap, Gia_ObjId(p, pObj)); return Num;  }
 static inline void   Cec4_ObjCleanSatId( Gia_Man_t * p, Gia_Obj_t * pObj )        { assert(Cec4_ObjSatId(p, pObj) != -1); Gia_ObjSetCopy2Array(p, Gia_ObjId(p, pObj), -1);               }
@@ -218,6 +240,7 @@ void Cec4_ManSetParams( Cec_ParFra_t * pPars )
     pPars->nSatVarMax     =    1000;    // the max number of SAT variables before recycling SAT solver
     pPars->nCallsRecycle  =     500;    // calls to perform before recycling SAT solver
     pPars->nGenIters      =     100;    // pattern generation iterations
+    pPars->nProcs         =       1;    // the number of threads
 }
 
 /**Function*************************************************************
@@ -838,37 +861,19 @@ static inline void Cec4_ObjSimCo( Gia_Man_t * p, int iObj )
 }
 static inline void Cec4_ObjSimAnd( Gia_Man_t * p, int iObj )
 {
-    int w;
     Gia_Obj_t * pObj = Gia_ManObj( p, iObj );
     word * pSim  = Cec4_ObjSim( p, iObj );
     word * pSim0 = Cec4_ObjSim( p, Gia_ObjFaninId0(pObj, iObj) );
     word * pSim1 = Cec4_ObjSim( p, Gia_ObjFaninId1(pObj, iObj) );
-    if ( Gia_ObjFaninC0(pObj) && Gia_ObjFaninC1(pObj) )
-        for ( w = 0; w < p->nSimWords; w++ )
-            pSim[w] = ~pSim0[w] & ~pSim1[w];
-    else if ( Gia_ObjFaninC0(pObj) && !Gia_ObjFaninC1(pObj) )
-        for ( w = 0; w < p->nSimWords; w++ )
-            pSim[w] = ~pSim0[w] & pSim1[w];
-    else if ( !Gia_ObjFaninC0(pObj) && Gia_ObjFaninC1(pObj) )
-        for ( w = 0; w < p->nSimWords; w++ )
-            pSim[w] = pSim0[w] & ~pSim1[w];
-    else
-        for ( w = 0; w < p->nSimWords; w++ )
-            pSim[w] = pSim0[w] & pSim1[w];
+    Util_SimdAnd( pSim, pSim0, pSim1, Gia_ObjFaninC0(pObj), Gia_ObjFaninC1(pObj), p->nSimWords );
 }
 static inline void Cec4_ObjSimXor( Gia_Man_t * p, int iObj )
 {
-    int w;
     Gia_Obj_t * pObj = Gia_ManObj( p, iObj );
     word * pSim  = Cec4_ObjSim( p, iObj );
     word * pSim0 = Cec4_ObjSim( p, Gia_ObjFaninId0(pObj, iObj) );
     word * pSim1 = Cec4_ObjSim( p, Gia_ObjFaninId1(pObj, iObj) );
-    if ( Gia_ObjFaninC0(pObj) ^ Gia_ObjFaninC1(pObj) )
-        for ( w = 0; w < p->nSimWords; w++ )
-            pSim[w] = ~pSim0[w] ^ pSim1[w];
-    else
-        for ( w = 0; w < p->nSimWords; w++ )
-            pSim[w] =  pSim0[w] ^ pSim1[w];
+    Util_SimdXor( pSim, pSim0, pSim1, Gia_ObjFaninC0(pObj) ^ Gia_ObjFaninC1(pObj), p->nSimWords );
 }
 static inline void Cec4_ObjSimCi( Gia_Man_t * p, int iObj )
 {
@@ -1507,10 +1512,17 @@ void Cec4_ManSatSolverRecycle( Cec4_Man_t * p )
     Vec_IntClear( &p->pNew->vCopiesTwo );  // pairs (CiAigId, SatId)
     Vec_IntClear( &p->pNew->vVarMap    );  // mapping of SatId into AigId
 }
-int Cec4_ManSolveTwo( Cec4_Man_t * p, int iObj0, int iObj1, int fPhase, int * pfEasy, int fVerbose, int fEffort )
+int Cec4_ManConfLimit( Cec4_Man_t * p, int iObj0, int iObj1, int fEffort )
+{
+    if ( fEffort )
+        return p->pPars->nBTLimitPo;
+    if ( Vec_BitEntry(p->vFails, iObj0) || Vec_BitEntry(p->vFails, iObj1) )
+        return Abc_MaxInt(1, p->pPars->nBTLimit/10);
+    return p->pPars->nBTLimit;
+}
+int Cec4_ManSolveTwo( Cec4_Man_t * p, int iObj0, int iObj1, int fPhase, int nBTLimit, int * pfEasy, int fVerbose )
 {
     abctime clk;
-    int nBTLimit = fEffort ? p->pPars->nBTLimitPo : (Vec_BitEntry(p->vFails, iObj0) || Vec_BitEntry(p->vFails, iObj1)) ? Abc_MaxInt(1, p->pPars->nBTLimit/10) : p->pPars->nBTLimit;
     int nConfEnd, nConfBeg, status, iVar0, iVar1, Lits[2];
     int UnsatConflicts[3] = {0};
     //printf( "%d ", nBTLimit );
@@ -1605,95 +1617,108 @@ int Cec4_ManSolveTwo( Cec4_Man_t * p, int iObj0, int iObj1, int fPhase, int * pf
     //    printf( "*  " );
     return status;
 }
-int Cec4_ManSweepNode( Cec4_Man_t * p, int iObj, int iRepr )
+void Cec4_ManReadPattern( Cec4_Man_t * p, Vec_Int_t * vPat )
+{
+    int i, IdAig, IdSat;
+    Vec_IntClear( vPat );
+    if ( p->pPars->jType == 0 )
+    {
+        Vec_IntForEachEntryDouble( &p->pNew->vCopiesTwo, IdAig, IdSat, i )
+            Vec_IntPush( vPat, Abc_Var2Lit(IdAig, sat_solver_read_cex_varvalue(p->pSat, IdSat)) );
+    }
+    else
+    {
+        int * pCex = sat_solver_read_cex( p->pSat );
+        int * pMap = Vec_IntArray(&p->pNew->vVarMap);
+        for ( i = 0; i < pCex[0]; )
+            Vec_IntPush( vPat, Abc_Lit2LitV(pMap, Abc_LitNot(pCex[++i])) );
+    }
+}
+void Cec4_ManSavePattern( Cec4_Man_t * p, Vec_Int_t * vPat )
+{
+    int i, iLit;
+    //int iPatsOld = p->pAig->iPatsPi;
+    assert( p->pAig->iPatsPi >= 0 && p->pAig->iPatsPi < 64 * p->pAig->nSimWords - 1 );
+    p->pAig->iPatsPi++;
+    Vec_IntForEachEntry( vPat, iLit, i )
+        Cec4_ObjSimSetInputBit( p->pAig, Abc_Lit2Var(iLit), Abc_LitIsCompl(iLit) );
+    if ( p->pAig->vPats )
+    {
+        Vec_IntPush( p->pAig->vPats, Vec_IntSize(vPat)+2 );
+        Vec_IntAppend( p->pAig->vPats, vPat );
+        Vec_IntPush( p->pAig->vPats, -1 );
+    }
+    //Cec4_ManPackAddPattern( p->pAig, vPat, 0 );
+    //assert( iPatsOld + 1 == p->pAig->iPatsPi );
+    // resimulated once in a while
+    if ( p->pAig->iPatsPi == 64 * p->pAig->nSimWords - 2 )
+    {
+        abctime clk2 = Abc_Clock();
+        Cec4_ManSimulate( p->pAig, p );
+        //printf( "FasterSmall = %d.  FasterBig = %d.\n", p->nFaster[0], p->nFaster[1] );
+        p->nFaster[0] = p->nFaster[1] = 0;
+        //if ( p->nSatSat && p->nSatSat % 100 == 0 )
+            Cec4_ManPrintStats( p->pAig, p->pPars, p, 0 );
+        Vec_IntFill( p->vCexStamps, Gia_ManObjNum(p->pAig), 0 );
+        p->pAig->iPatsPi = 0;
+        Vec_WrdFill( p->pAig->vSimsPi, Vec_WrdSize(p->pAig->vSimsPi), 0 );
+        p->timeResimGlo += Abc_Clock() - clk2;
+    }
+}
+int Cec4_ManSweepNodeUpdate( Cec4_Man_t * p, int iObj, int iRepr, int status, int fEasy, Vec_Int_t * vPat, abctime clk )
 {
-    abctime clk = Abc_Clock();
-    int i, IdAig, IdSat, status, fEasy, RetValue = 1;
     Gia_Obj_t * pObj = Gia_ManObj( p->pAig, iObj );
     Gia_Obj_t * pRepr = Gia_ManObj( p->pAig, iRepr );
-    int fCompl = Abc_LitIsCompl(pObj->Value) ^ Abc_LitIsCompl(pRepr->Value) ^ pObj->fPhase ^ pRepr->fPhase;
-    int fEffort = p->vCoDrivers ? Vec_BitEntry(p->vCoDrivers, iObj) || Vec_BitEntry(p->vCoDrivers, iRepr) : 0;
-    status = Cec4_ManSolveTwo( p, Abc_Lit2Var(pRepr->Value), Abc_Lit2Var(pObj->Value), fCompl, &fEasy, p->pPars->fVerbose, fEffort );
     if ( status == GLUCOSE_SAT )
     {
-        int iLit;
-        //int iPatsOld = p->pAig->iPatsPi;
         //printf( "Disproved: %d == %d.\n", Abc_Lit2Var(pRepr->Value), Abc_Lit2Var(pObj->Value) );
         p->nSatSat++;
         p->nPatterns++;
-        Vec_IntClear( p->vPat );
-        if ( p->pPars->jType == 0 )
-        {
-            Vec_IntForEachEntryDouble( &p->pNew->vCopiesTwo, IdAig, IdSat, i )
-                Vec_IntPush( p->vPat, Abc_Var2Lit(IdAig, sat_solver_read_cex_varvalue(p->pSat, IdSat)) );
-        }
-        else
-        {
-            int * pCex = sat_solver_read_cex( p->pSat );
-            int * pMap = Vec_IntArray(&p->pNew->vVarMap);
-            for ( i = 0; i < pCex[0]; )
-                Vec_IntPush( p->vPat, Abc_Lit2LitV(pMap, Abc_LitNot(pCex[++i])) );
-        }
-        assert( p->pAig->iPatsPi >= 0 && p->pAig->iPatsPi < 64 * p->pAig->nSimWords - 1 );
-        p->pAig->iPatsPi++;
-        Vec_IntForEachEntry( p->vPat, iLit, i )
-            Cec4_ObjSimSetInputBit( p->pAig, Abc_Lit2Var(iLit), Abc_LitIsCompl(iLit) );
-        if ( p->pAig->vPats )
-        {
-            Vec_IntPush( p->pAig->vPats, Vec_IntSize(p->vPat)+2 );
-            Vec_IntAppend( p->pAig->vPats, p->vPat );
-            Vec_IntPush( p->pAig->vPats, -1 );
-        }
-        //Cec4_ManPackAddPattern( p->pAig, p->vPat, 0 );
-        //assert( iPatsOld + 1 == p->pAig->iPatsPi );
         if ( fEasy )
-            p->timeSatSat0 += Abc_Clock() - clk;
+            p->timeSatSat0 += clk;
         else
-            p->timeSatSat += Abc_Clock() - clk;
-        RetValue = 0;
+            p->timeSatSat += clk;
         // this is not needed, but we keep it here anyway, because it takes very little time
         //Cec4_ManVerify( p->pNew, Abc_Lit2Var(pRepr->Value), Abc_Lit2Var(pObj->Value), fCompl, p->pSat );
-        // resimulated once in a while
-        if ( p->pAig->iPatsPi == 64 * p->pAig->nSimWords - 2 )
-        {
-            abctime clk2 = Abc_Clock();
-            Cec4_ManSimulate( p->pAig, p );
-            //printf( "FasterSmall = %d.  FasterBig = %d.\n", p->nFaster[0], p->nFaster[1] );
-            p->nFaster[0] = p->nFaster[1] = 0;
-            //if ( p->nSatSat && p->nSatSat % 100 == 0 )
-                Cec4_ManPrintStats( p->pAig, p->pPars, p, 0 );
-            Vec_IntFill( p->vCexStamps, Gia_ManObjNum(p->pAig), 0 );
-            p->pAig->iPatsPi = 0;
-            Vec_WrdFill( p->pAig->vSimsPi, Vec_WrdSize(p->pAig->vSimsPi), 0 );
-            p->timeResimGlo += Abc_Clock() - clk2;
-        }
+        Cec4_ManSavePattern( p, vPat );
+        return 0;
     }
-    else if ( status == GLUCOSE_UNSAT )
+    if ( status == GLUCOSE_UNSAT )
     {
         //printf( "Proved: %d == %d.\n", Abc_Lit2Var(pRepr->Value), Abc_Lit2Var(pObj->Value) );
         p->nSatUnsat++;
-        pObj->Value = Abc_LitNotCond( pRepr->Value, fCompl );
+        pObj->Value = Abc_LitNotCond( pRepr->Value, pObj->fPhase ^ pRepr->fPhase );
         Gia_ObjSetProved( p->pAig, iObj );
         if ( iRepr == 0 )
             p->iLastConst = iObj;
         if ( fEasy )
-            p->timeSatUnsat0 += Abc_Clock() - clk;
+            p->timeSatUnsat0 += clk;
         else
-            p->timeSatUnsat += Abc_Clock() - clk;
-        RetValue = 1;
-    }
-    else 
-    {
-        p->nSatUndec++;
-        assert( status == GLUCOSE_UNDEC );
-        Gia_ObjSetFailed( p->pAig, iObj );
-        Vec_BitWriteEntry( p->vFails, iObj, 1 );
-        //if ( iRepr )
-        //Vec_BitWriteEntry( p->vFails, iRepr, 1 );
-        p->timeSatUndec += Abc_Clock() - clk;
-        RetValue = 2;
+            p->timeSatUnsat += clk;
+        return 1;
     }
-    return RetValue;
+    p->nSatUndec++;
+    assert( status == GLUCOSE_UNDEC );
+    Gia_ObjSetFailed( p->pAig, iObj );
+    Vec_BitWriteEntry( p->vFails, iObj, 1 );
+    //if ( iRepr )
+    //Vec_BitWriteEntry( p->vFails, iRepr, 1 );
+    p->timeSatUndec += clk;
+    return 2;
+}
+int Cec4_ManSweepNode( Cec4_Man_t * p, int iObj, int iRepr )
+{
+    abctime clk = Abc_Clock();
+    int status, fEasy;
+    Gia_Obj_t * pObj = Gia_ManObj( p->pAig, iObj );
+    Gia_Obj_t * pRepr = Gia_ManObj( p->pAig, iRepr );
+    int fCompl = Abc_LitIsCompl(pObj->Value) ^ Abc_LitIsCompl(pRepr->Value) ^ pObj->fPhase ^ pRepr->fPhase;
+    int fEffort = p->vCoDrivers ? Vec_BitEntry(p->vCoDrivers, iObj) || Vec_BitEntry(p->vCoDrivers, iRepr) : 0;
+    int iObj0 = Abc_Lit2Var(pRepr->Value), iObj1 = Abc_Lit2Var(pObj->Value);
+    status = Cec4_ManSolveTwo( p, iObj0, iObj1, fCompl, Cec4_ManConfLimit(p, iObj0, iObj1, fEffort), &fEasy, p->pPars->fVerbose );
+    if ( status == GLUCOSE_SAT )
+        Cec4_ManReadPattern( p, p->vPat );
+    return Cec4_ManSweepNodeUpdate( p, iObj, iRepr, status, fEasy, p->vPat, Abc_Clock() - clk );
 }
 Gia_Obj_t * Cec4_ManFindRepr( Gia_Man_t * p, Cec4_Man_t * pMan, int iObj )
 {
@@ -1764,14 +1789,304 @@ void Gia_ManRemoveWrongChoices( Gia_Man_t * p )
     }
     //Abc_Print( 1, "Removed %d wrong choices.\n", Counter );
 }
+/**Function*************************************************************
+
+  Synopsis    [Adds the node to the internal AIG.]
+
+  Description [Returns 1 if the node has a candidate representative.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Cec4_ManAddNode( Gia_Man_t * p, Cec4_Man_t * pMan, int i )
+{
+    Gia_Obj_t * pObj = Gia_ManObj( p, i );
+    Gia_Obj_t * pObjNew; 
+    pMan->nAndNodes++;
+    if ( Gia_ObjIsXor(pObj) )
+        pObj->Value = Gia_ManHashXorReal( pMan->pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+    else
+        pObj->Value = Gia_ManHashAnd( pMan->pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+    if ( pMan->pPars->nLevelMax && Gia_ObjLevel(p, pObj) > pMan->pPars->nLevelMax )
+        return 0;
+    pObjNew = Gia_ManObj( pMan->pNew, Abc_Lit2Var(pObj->Value) );
+    if ( Gia_ObjIsAnd(pObjNew) )
+    if ( Vec_BitEntry(pMan->vFails, Gia_ObjFaninId0(pObjNew, Abc_Lit2Var(pObj->Value))) || 
+         Vec_BitEntry(pMan->vFails, Gia_ObjFaninId1(pObjNew, Abc_Lit2Var(pObj->Value))) )
+        Vec_BitWriteEntry( pMan->vFails, Abc_Lit2Var(pObjNew->Value), 1 );
+    //if ( Gia_ObjIsAnd(pObjNew) )
+    //    Gia_ObjSetAndLevel( pMan->pNew, pObjNew );
+    // select representative based on candidate equivalence classes
+    return Gia_ObjReprObj( p, i ) != NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Selects the representative to be compared with the node.]
+
+  Description [Returns NULL if the recent counter-examples have removed
+  the node from its class or if the node is structurally equal to the
+  representative.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Obj_t * Cec4_ManSelectRepr( Gia_Man_t * p, Cec4_Man_t * pMan, int i )
+{
+    Gia_Obj_t * pObj = Gia_ManObj( p, i );
+    Gia_Obj_t * pRepr;
+    if ( Gia_ObjReprObj( p, i ) == NULL )
+        return NULL;
+    // select representative based on recent counter-examples
+    pRepr = Cec4_ManFindRepr( p, pMan, i );
+    if ( pRepr == NULL )
+        return NULL;
+    if ( Abc_Lit2Var(pObj->Value) == Abc_Lit2Var(pRepr->Value) )
+    {
+        assert( (pObj->Value ^ pRepr->Value) == (pObj->fPhase ^ pRepr->fPhase) );
+        Gia_ObjSetProved( p, i );
+        if ( Gia_ObjId(p, pRepr) == 0 )
+            pMan->iLastConst = i;
+        return NULL;
+    }
+    return pRepr;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts the manager of one worker.]
+
+  Description [The worker has its own SAT solver and its own view of the
+  internal AIG. The view shares the objects with the internal AIG of the
+  main manager, while the mapping of its nodes into the SAT variables
+  (vCopies2, vSuppVars, vCopiesTwo, vVarMap) belongs to the worker.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Cec4_Man_t * Cec4_ManWorkerStart( Gia_Man_t * pAig, Cec_ParFra_t * pPars )
+{
+    Cec4_Man_t * p = ABC_CALLOC( Cec4_Man_t, 1 );
+    p->pPars     = pPars;
+    p->pAig      = pAig;
+    p->pSat      = sat_solver_start();  
+    sat_solver_set_jftr( p->pSat, pPars->jType );
+    p->vFrontier = Vec_PtrAlloc( 1000 );
+    p->vFanins   = Vec_PtrAlloc( 100 );
+    p->pNew      = ABC_CALLOC( Gia_Man_t, 1 );
+    Vec_IntFill( &p->pNew->vCopies2, Gia_ManObjNum(pAig), -1 );
+    return p;
+}
+void Cec4_ManWorkerSync( Cec4_Man_t * p, Gia_Man_t * pNew )
+{
+    Vec_Int_t vCopies2   = p->pNew->vCopies2;
+    Vec_Int_t vSuppVars  = p->pNew->vSuppVars;
+    Vec_Int_t vCopiesTwo = p->pNew->vCopiesTwo;
+    Vec_Int_t vVarMap    = p->pNew->vVarMap;
+    memcpy( p->pNew, pNew, sizeof(Gia_Man_t) );
+    p->pNew->vCopies2    = vCopies2;
+    p->pNew->vSuppVars   = vSuppVars;
+    p->pNew->vCopiesTwo  = vCopiesTwo;
+    p->pNew->vVarMap     = vVarMap;
+}
+void Cec4_ManWorkerStop( Cec4_Man_t * p, Cec4_Man_t * pMain )
+{
+    int k;
+    // add the statistics to the main manager
+    for ( k = 0; k < 2; k++ )
+    {
+        pMain->nConflicts[k][0] += p->nConflicts[k][0];
+        pMain->nConflicts[k][1] += p->nConflicts[k][1];
+        pMain->nConflicts[k][2]  = Abc_MaxInt( pMain->nConflicts[k][2], p->nConflicts[k][2] );
+        pMain->nGates[k]        += p->nGates[k];
+    }
+    pMain->nRecycles += p->nRecycles;
+    pMain->timeCnf   += p->timeCnf;
+    sat_solver_stop( p->pSat );
+    Vec_IntErase( &p->pNew->vCopies2 );
+    Vec_IntErase( &p->pNew->vSuppVars );
+    Vec_IntErase( &p->pNew->vCopiesTwo );
+    Vec_IntErase( &p->pNew->vVarMap );
+    ABC_FREE( p->pNew );
+    Vec_PtrFreeP( &p->vFrontier );
+    Vec_PtrFreeP( &p->vFanins );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Proves one candidate pair in a worker thread.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cec4_ManSolveTask( void * pArg, int iThread, void * pScratch )
+{
+    Cec4_Task_t * pTask = (Cec4_Task_t *)pArg;
+    Cec4_Man_t * p = pTask->ppWorkers[iThread];
+    abctime clk = Abc_Clock();
+    pTask->Status = Cec4_ManSolveTwo( p, pTask->iObj0, pTask->iObj1, pTask->fPhase, pTask->nBTLimit, &pTask->fEasy, p->pPars->fVerbose );
+    if ( pTask->Status == GLUCOSE_SAT )
+        Cec4_ManReadPattern( p, pTask->vPat );
+    pTask->Time = Abc_Clock() - clk;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Divides the nodes into waves for parallel sweeping.]
+
+  Description [A node belongs to a later wave than its fanins, and not to
+  an earlier wave than the members of its class with smaller IDs, which
+  may be selected as its representative. When the nodes of a wave are
+  added to the internal AIG, their fanins are already merged and their
+  representatives are already added.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Wec_t * Cec4_ManSweepWaves( Gia_Man_t * p )
+{
+    Vec_Int_t * vWaves = Vec_IntStart( Gia_ManObjNum(p) );
+    Vec_Int_t * vClass = Vec_IntStart( Gia_ManObjNum(p) );
+    Vec_Wec_t * vRes;
+    Gia_Obj_t * pObj;
+    int i, iRepr, Wave, WaveMax = 0;
+    Gia_ManForEachAnd( p, pObj, i )
+    {
+        Wave = 1 + Abc_MaxInt( Vec_IntEntry(vWaves, Gia_ObjFaninId0(pObj, i)), Vec_IntEntry(vWaves, Gia_ObjFaninId1(pObj, i)) );
+        iRepr = Gia_ObjRepr( p, i );
+        if ( iRepr != GIA_VOID )
+        {
+            Wave = Abc_MaxInt( Wave, Abc_MaxInt(Vec_IntEntry(vWaves, iRepr), Vec_IntEntry(vClass, iRepr)) );
+            Vec_IntWriteEntry( vClass, iRepr, Wave );
+        }
+        Vec_IntWriteEntry( vWaves, i, Wave );
+        WaveMax = Abc_MaxInt( WaveMax, Wave );
+    }
+    vRes = Vec_WecStart( WaveMax + 1 );
+    Gia_ManForEachAnd( p, pObj, i )
+        Vec_WecPush( vRes, Vec_IntEntry(vWaves, i), i );
+    Vec_IntFree( vWaves );
+    Vec_IntFree( vClass );
+    return vRes;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs SAT sweeping with several threads.]
+
+  Description [The nodes are added to the internal AIG wave by wave.
+  The candidate pairs of one wave do not depend on each other, so they
+  are given to the workers in rounds of a few pairs per thread; pair t
+  of a round always goes to worker t % nProcs, so each worker solves the
+  same sequence of problems in every run. After each round, the results
+  are applied in the order of the nodes: the proved nodes are merged,
+  and the counter-examples found by all workers are added to the
+  simulation patterns of the main manager, which are used to refine the
+  classes and to select the representatives for the next round. As a
+  result, the outcome does not depend on the timing of the threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cec4_ManSweepPar( Gia_Man_t * p, Cec4_Man_t * pMan )
+{
+    int nProcs = pMan->pPars->nProcs;
+    int nTasksMax = CEC4_PAR_TASKS * nProcs;
+    Cec4_Man_t ** ppWorkers = ABC_CALLOC( Cec4_Man_t *, nProcs );
+    Cec4_Task_t * pTasks = ABC_CALLOC( Cec4_Task_t, nTasksMax );
+    Vec_Int_t * vCands = Vec_IntAlloc( 100 );
+    Vec_Int_t * vWave;
+    Vec_Wec_t * vWaves;
+    Util_Pool_t * pPool;
+    Gia_Obj_t * pObj, * pRepr;
+    int i, k, t, l, iThread, nTasks;
+    // order the nodes by waves
+    vWaves = Cec4_ManSweepWaves( p );
+    // start the workers
+    for ( t = 0; t < nProcs; t++ )
+        ppWorkers[t] = Cec4_ManWorkerStart( p, pMan->pPars );
+    for ( t = 0; t < nTasksMax; t++ )
+    {
+        pTasks[t].ppWorkers = ppWorkers;
+        pTasks[t].vPat = Vec_IntAlloc( 100 );
+    }
+    pPool = Util_PoolStart( nProcs, 0 );
+    Vec_WecForEachLevel( vWaves, vWave, l )
+    {
+        // add the nodes of this wave and collect the candidates
+        Vec_IntClear( vCands );
+        Vec_IntForEachEntry( vWave, i, k )
+            if ( Cec4_ManAddNode( p, pMan, i ) )
+                Vec_IntPush( vCands, i );
+        for ( t = 0; t < nProcs; t++ )
+            Cec4_ManWorkerSync( ppWorkers[t], pMan->pNew );
+        // prove the candidates in rounds
+        for ( k = 0; k < Vec_IntSize(vCands); )
+        {
+            for ( nTasks = 0; k < Vec_IntSize(vCands) && nTasks < nTasksMax; k++ )
+            {
+                Cec4_Task_t * pTask = pTasks + nTasks;
+                int fEffort;
+                i = Vec_IntEntry( vCands, k );
+                pObj = Gia_ManObj( p, i );
+                pRepr = Cec4_ManSelectRepr( p, pMan, i );
+                if ( pRepr == NULL )
+                    continue;
+                fEffort = pMan->vCoDrivers ? Vec_BitEntry(pMan->vCoDrivers, i) || Vec_BitEntry(pMan->vCoDrivers, Gia_ObjId(p, pRepr)) : 0;
+                pTask->iObj     = i;
+                pTask->iRepr    = Gia_ObjId( p, pRepr );
+                pTask->iObj0    = Abc_Lit2Var( pRepr->Value );
+                pTask->iObj1    = Abc_Lit2Var( pObj->Value );
+                pTask->fPhase   = Abc_LitIsCompl(pObj->Value) ^ Abc_LitIsCompl(pRepr->Value) ^ pObj->fPhase ^ pRepr->fPhase;
+                pTask->nBTLimit = Cec4_ManConfLimit( pMan, pTask->iObj0, pTask->iObj1, fEffort );
+                nTasks++;
+            }
+            for ( t = 0; t < nTasks; t++ )
+            {
+                iThread = t % nProcs;
+                while ( Util_PoolIsBusy(pPool, iThread) )
+                    Util_PoolWaitAny( pPool, NULL );
+                Util_PoolAssign( pPool, iThread, Cec4_ManSolveTask, (void *)(pTasks + t) );
+            }
+            Util_PoolWaitAll( pPool );
+            for ( t = 0; t < nTasks; t++ )
+                Cec4_ManSweepNodeUpdate( pMan, pTasks[t].iObj, pTasks[t].iRepr, pTasks[t].Status, pTasks[t].fEasy, pTasks[t].vPat, pTasks[t].Time );
+        }
+    }
+    Util_PoolStop( pPool );
+    for ( t = 0; t < nProcs; t++ )
+        Cec4_ManWorkerStop( ppWorkers[t], pMan );
+    for ( t = 0; t < nTasksMax; t++ )
+        Vec_IntFree( pTasks[t].vPat );
+    ABC_FREE( ppWorkers );
+    ABC_FREE( pTasks );
+    Vec_IntFree( vCands );
+    Vec_WecFree( vWaves );
+}
+
 int Cec4_ManPerformSweeping( Gia_Man_t * p, Cec_ParFra_t * pPars, Gia_Man_t ** ppNew, int fSimOnly )
 {
     Cec4_Man_t * pMan = Cec4_ManCreate( p, pPars ); 
     Gia_Obj_t * pObj, * pRepr; 
     int i, fSimulate = 1;
     if ( pPars->fVerbose )
-        printf( "Solver type = %d. Simulate %d words in %d rounds. SAT with %d confs. Recycle after %d SAT calls.\n", 
-            pPars->jType, pPars->nWords, pPars->nRounds, pPars->nBTLimit, pPars->nCallsRecycle );
+        printf( "Solver type = %d. Simulate %d words in %d rounds. SAT with %d confs. Recycle after %d SAT calls. Threads = %d.\n", 
+            pPars->jType, pPars->nWords, pPars->nRounds, pPars->nBTLimit, pPars->nCallsRecycle, Abc_MaxInt(1, pPars->nProcs) );
 
     // this is currently needed to have a correct mapping
     Gia_ManForEachCi( p, pObj, i )
@@ -1834,43 +2149,18 @@ int Cec4_ManPerformSweeping( Gia_Man_t * p, Cec_ParFra_t * pPars, Gia_Man_t ** p
     Vec_WrdFill( p->vSimsPi, Vec_WrdSize(p->vSimsPi), 0 );
     pMan->nSatSat = 0;
     pMan->pNew = Cec4_ManStartNew( p );
-    Gia_ManForEachAnd( p, pObj, i )
+    if ( pPars->nProcs > 1 )
+        Cec4_ManSweepPar( p, pMan );
+    else
     {
-        Gia_Obj_t * pObjNew; 
-        pMan->nAndNodes++;
-        if ( Gia_ObjIsXor(pObj) )
-            pObj->Value = Gia_ManHashXorReal( pMan->pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
-        else
-            pObj->Value = Gia_ManHashAnd( pMan->pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
-        if ( pPars->nLevelMax && Gia_ObjLevel(p, pObj) > pPars->nLevelMax )
-            continue;
-        pObjNew = Gia_ManObj( pMan->pNew, Abc_Lit2Var(pObj->Value) );
-        if ( Gia_ObjIsAnd(pObjNew) )
-        if ( Vec_BitEntry(pMan->vFails, Gia_ObjFaninId0(pObjNew, Abc_Lit2Var(pObj->Value))) || 
-             Vec_BitEntry(pMan->vFails, Gia_ObjFaninId1(pObjNew, Abc_Lit2Var(pObj->Value))) )
-            Vec_BitWriteEntry( pMan->vFails, Abc_Lit2Var(pObjNew->Value), 1 );
-        //if ( Gia_ObjIsAnd(pObjNew) )
-        //    Gia_ObjSetAndLevel( pMan->pNew, pObjNew );
-        // select representative based on candidate equivalence classes
-        pRepr = Gia_ObjReprObj( p, i );
-        if ( pRepr == NULL )
-            continue;
-        if ( 1 ) // select representative based on recent counter-examples
+        Gia_ManForEachAnd( p, pObj, i )
         {
-            pRepr = Cec4_ManFindRepr( p, pMan, i );
-            if ( pRepr == NULL )
+            if ( !Cec4_ManAddNode( p, pMan, i ) )
                 continue;
+            pRepr = Cec4_ManSelectRepr( p, pMan, i );
+            if ( pRepr != NULL )
+                Cec4_ManSweepNode( pMan, i, Gia_ObjId(p, pRepr) );
         }
-        if ( Abc_Lit2Var(pObj->Value) == Abc_Lit2Var(pRepr->Value) )
-        {
-            assert( (pObj->Value ^ pRepr->Value) == (pObj->fPhase ^ pRepr->fPhase) );
-            Gia_ObjSetProved( p, i );
-            if ( Gia_ObjId(p, pRepr) == 0 )
-                pMan->iLastConst = i;
-            continue;
-        }
-        if ( Cec4_ManSweepNode(pMan, i, Gia_ObjId(p, pRepr)) && Gia_ObjProved(p, i) )
-            pObj->Value = Abc_LitNotCond( pRepr->Value, pObj->fPhase ^ pRepr->fPhase );
     }
     if ( p->iPatsPi > 0 )
     {
@@ -1921,16 +2211,21 @@ void Cec4_ManSimulateTest2( Gia_Man_t * p, int nConfs, int fVerbose )
     if ( fVerbose )
         Abc_PrintTime( 1, "New choice computation time", Abc_Clock() - clk );
 }
-Gia_Man_t * Cec4_ManSimulateTest3( Gia_Man_t * p, int nBTLimit, int fVerbose )
+Gia_Man_t * Cec4_ManSimulateTest3Par( Gia_Man_t * p, int nBTLimit, int nProcs, int fVerbose )
 {
     Gia_Man_t * pNew = NULL;
     Cec_ParFra_t ParsFra, * pPars = &ParsFra;
     Cec4_ManSetParams( pPars );
     pPars->fVerbose = fVerbose;
     pPars->nBTLimit = nBTLimit;
+    pPars->nProcs   = nProcs;
     Cec4_ManPerformSweeping( p, pPars, &pNew, 0 );
     return pNew;
 }
+Gia_Man_t * Cec4_ManSimulateTest3( Gia_Man_t * p, int nBTLimit, int fVerbose )
+{
+    return Cec4_ManSimulateTest3Par( p, nBTLimit, 1, fVerbose );
+}
 Gia_Man_t * Cec4_ManSimulateTest4( Gia_Man_t * p, int nBTLimit, int nBTLimitPo, int fVerbose )
 {
     Gia_Man_t * pNew = NULL;
@@ -24,19 +24,9 @@
 #include "sat/cnf/cnf.h"
 #include "sat/bsat/satSolver.h"
 #include "misc/util/utilTruth.h"
+#include "misc/util/utilPool.h"
 //#include "bdd/cudd/cuddInt.h"
 
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#include <unistd.h>
-#endif
-
-#endif
-
 ABC_NAMESPACE_IMPL_START
 
 
@@ -544,36 +534,21 @@ typedef struct Par_ThData_t_
     Cnf_Dat_t * pCnf;
     int         iThread;
     int         nTimeOut;
-    int         fWorking;
     int         Result;
     int         nVars;
     int         nConfs;
 } Par_ThData_t;
-void * Cec_GiaSplitWorkerThread( void * pArg )
+void Cec_GiaSplitWorkerTask( void * pArg, int iThread, void * pScratch )
 {
     Par_ThData_t * pThData = (Par_ThData_t *)pArg;
-    volatile int * pPlace = &pThData->fWorking;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->fWorking );
-        if ( pThData->p == NULL )
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        pThData->Result = Cnf_GiaSolveOne( pThData->p, pThData->pCnf, pThData->nTimeOut, &pThData->nVars, &pThData->nConfs );
-        pThData->fWorking = 0;
-    }
-    assert( 0 );
-    return NULL;
+    assert( pThData->p != NULL );
+    pThData->Result = Cnf_GiaSolveOne( pThData->p, pThData->pCnf, pThData->nTimeOut, &pThData->nVars, &pThData->nConfs );
 }
 int Cec_GiaSplitTestInt( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, int LookAhead, int fVerbose, int fVeryVerbose, int fSilent )
 {
     abctime clkTotal = Abc_Clock();
     Par_ThData_t ThData[PAR_THR_MAX];
-    pthread_t WorkerThread[PAR_THR_MAX];
+    Util_Pool_t * pPool;
     Vec_Ptr_t * vStack;
     Cnf_Dat_t * pCnf;
     double Progress = 0;
@@ -619,82 +594,73 @@ int Cec_GiaSplitTestInt( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax,
         ThData[i].pCnf     = NULL;
         ThData[i].iThread  = i;
         ThData[i].nTimeOut = nTimeOut;
-        ThData[i].fWorking = 0;
         ThData[i].Result   = -1;
         ThData[i].nVars    = -1;
         ThData[i].nConfs   = -1;
-        status = pthread_create( WorkerThread + i, NULL,Cec_GiaSplitWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
     }
+    pPool = Util_PoolStart( nProcs, 0 );
     // look at the threads
     while ( fWorkToDo )
     {
-        fWorkToDo = (int)(Vec_PtrSize(vStack) > 0);
-        for ( i = 0; i < nProcs; i++ )
+        // give the cofactors to the idle threads
+        while ( Vec_PtrSize(vStack) > 0 && (i = Util_PoolFindIdle(pPool)) >= 0 )
+        {
+            assert( ThData[i].p == NULL );
+            ThData[i].p = (Gia_Man_t*)Vec_PtrPop( vStack );
+            ThData[i].pCnf = Cec_GiaDeriveGiaRemapped( ThData[i].p );
+            Util_PoolAssign( pPool, i, Cec_GiaSplitWorkerTask, (void *)(ThData + i) );
+        }
+        // wait till one of the threads finishes
+        i = Util_PoolWaitAny( pPool, NULL );
+        fWorkToDo = (int)(i >= 0);
+        if ( !fWorkToDo )
+            break;
         {
-            // check if this thread is working
-            if ( ThData[i].fWorking )
+            Gia_Man_t * pLast = ThData[i].p;
+            int Depth = pLast->vCofVars ? Vec_IntSize(pLast->vCofVars) : 0;
+            if ( pLast->vCofVars == NULL )
+                pLast->vCofVars = Vec_IntAlloc( 100 );
+            if ( fVerbose )
+                Cec_GiaSplitPrint( i+1, Depth, ThData[i].nVars, ThData[i].nConfs, ThData[i].Result, Progress, Abc_Clock() - clkTotal );
+            if ( ThData[i].Result == 0 ) // SAT
             {
-                fWorkToDo = 1;
-                continue;
+                p->pCexComb = pLast->pCexComb;  pLast->pCexComb = NULL;
+                RetValue = 0;
+                goto finish;
             }
-            // check if this thread has recently finished
-            if ( ThData[i].p != NULL )
+            if ( ThData[i].Result == -1 ) // UNDEC
             {
-                Gia_Man_t * pLast = ThData[i].p;
-                int Depth = pLast->vCofVars ? Vec_IntSize(pLast->vCofVars) : 0;
-                if ( pLast->vCofVars == NULL )
-                    pLast->vCofVars = Vec_IntAlloc( 100 );
-                if ( fVerbose )
-                    Cec_GiaSplitPrint( i+1, Depth, ThData[i].nVars, ThData[i].nConfs, ThData[i].Result, Progress, Abc_Clock() - clkTotal );
-                if ( ThData[i].Result == 0 ) // SAT
+                // determine cofactoring variable
+                int nFanouts, Cost, iVar = Gia_SplitCofVar( pLast, LookAhead, &nFanouts, &Cost );
+                // cofactor
+                Gia_Man_t * pPart = Gia_ManDupCofactorVar( pLast, iVar, 0 );
+                pPart->vCofVars = Vec_IntAlloc( Vec_IntSize(pLast->vCofVars) + 1 );
+                Vec_IntAppend( pPart->vCofVars, pLast->vCofVars );
+                Vec_IntPush( pPart->vCofVars, Abc_Var2Lit(iVar, 1) );
+                Vec_PtrPush( vStack, pPart );
+                // print results
+                if ( fVeryVerbose )
                 {
-                    p->pCexComb = pLast->pCexComb;  pLast->pCexComb = NULL;
-                    RetValue = 0;
-                    goto finish;
+//                    Cec_GiaSplitPrintRefs( pLast );
+                    printf( "Var = %5d. Fanouts = %5d. Cost = %8d.  AndBefore = %6d.  AndAfter = %6d.\n",
+                        iVar, nFanouts, Cost, Gia_ManAndNum(pLast), Gia_ManAndNum(pPart) );
+//                    Cec_GiaSplitPrintRefs( pPart );
                 }
-                if ( ThData[i].Result == -1 ) // UNDEC
-                {
-                    // determine cofactoring variable
-                    int nFanouts, Cost, iVar = Gia_SplitCofVar( pLast, LookAhead, &nFanouts, &Cost );
-                    // cofactor
-                    Gia_Man_t * pPart = Gia_ManDupCofactorVar( pLast, iVar, 0 );
-                    pPart->vCofVars = Vec_IntAlloc( Vec_IntSize(pLast->vCofVars) + 1 );
-                    Vec_IntAppend( pPart->vCofVars, pLast->vCofVars );
-                    Vec_IntPush( pPart->vCofVars, Abc_Var2Lit(iVar, 1) );
-                    Vec_PtrPush( vStack, pPart );
-                    // print results
-                    if ( fVeryVerbose )
-                    {
-//                        Cec_GiaSplitPrintRefs( pLast );
-                        printf( "Var = %5d. Fanouts = %5d. Cost = %8d.  AndBefore = %6d.  AndAfter = %6d.\n", 
-                            iVar, nFanouts, Cost, Gia_ManAndNum(pLast), Gia_ManAndNum(pPart) );
-//                        Cec_GiaSplitPrintRefs( pPart );
-                    }
-                    // cofactor
-                    pPart = Gia_ManDupCofactorVar( pLast, iVar, 1 );
-                    pPart->vCofVars = Vec_IntAlloc( Vec_IntSize(pLast->vCofVars) + 1 );
-                    Vec_IntAppend( pPart->vCofVars, pLast->vCofVars );
-                    Vec_IntPush( pPart->vCofVars, Abc_Var2Lit(iVar, 1) );
-                    Vec_PtrPush( vStack, pPart );
-                    // keep working
-                    fWorkToDo = 1;
-                    nIter++;
-                }
-                else
-                    Progress += 1.0 / pow((double)2, (double)Depth);
-                Gia_ManStopP( &ThData[i].p );
-                if ( ThData[i].pCnf == NULL )
-                    continue;
-                Cnf_DataFree( ThData[i].pCnf );
-                ThData[i].pCnf = NULL;
+                // cofactor
+                pPart = Gia_ManDupCofactorVar( pLast, iVar, 1 );
+                pPart->vCofVars = Vec_IntAlloc( Vec_IntSize(pLast->vCofVars) + 1 );
+                Vec_IntAppend( pPart->vCofVars, pLast->vCofVars );
+                Vec_IntPush( pPart->vCofVars, Abc_Var2Lit(iVar, 1) );
+                Vec_PtrPush( vStack, pPart );
+                // keep working
+                nIter++;
             }
-            if ( Vec_PtrSize(vStack) == 0 )
-                continue;
-            // start a new thread
-            assert( ThData[i].p == NULL );
-            ThData[i].p = (Gia_Man_t*)Vec_PtrPop( vStack );
-            ThData[i].pCnf = Cec_GiaDeriveGiaRemapped( ThData[i].p );
-            ThData[i].fWorking = 1;
+            else
+                Progress += 1.0 / pow((double)2, (double)Depth);
+            Gia_ManStopP( &ThData[i].p );
+            if ( ThData[i].pCnf )
+                Cnf_DataFree( ThData[i].pCnf );
+            ThData[i].pCnf = NULL;
         }
         if ( nIterMax && nIter >= nIterMax )
             break;
@@ -703,23 +669,18 @@ int Cec_GiaSplitTestInt( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax,
         RetValue = 1;
 finish:
     // wait till threads finish
-    for ( i = 0; i < nProcs; i++ )
-        if ( ThData[i].fWorking )
-            i = -1;
+    Util_PoolWaitAll( pPool );
     // stop threads
     for ( i = 0; i < nProcs; i++ )
     {
-        assert( !ThData[i].fWorking );
         // cleanup
         Gia_ManStopP( &ThData[i].p );
         if ( ThData[i].pCnf == NULL )
             continue;
         Cnf_DataFree( ThData[i].pCnf );
         ThData[i].pCnf = NULL;
-        // stop
-        ThData[i].p = NULL;
-        ThData[i].fWorking = 1;
     }
+    Util_PoolStop( pPool );
     // finish
     Cec_GiaSplitClean( vStack );
     if ( !fSilent )
@@ -69,6 +69,7 @@ struct Dch_Man_t_
     Vec_Ptr_t *      vFanins;        // fanins of the CNF node
     Vec_Ptr_t *      vSimRoots;      // the roots of cand const 1 nodes to simulate
     Vec_Ptr_t *      vSimClasses;    // the roots of cand equiv classes to simulate
+    Vec_Str_t *      vCexValues;     // the CI values of the counter-example found by a thread
     // solver cone size
     int              nConeThis;
     int              nConeMax;
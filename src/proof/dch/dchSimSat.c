@@ -119,6 +119,12 @@ void Dch_ManResimulateSolved_rec( Dch_Man_t * p, Aig_Obj_t * pObj )
         int nVarNum;
         pObjFraig = Dch_ObjFraig( pObj );
         assert( !Aig_IsComplement(pObjFraig) );
+        // the counter-example may come from the solver of another thread
+        if ( p->vCexValues )
+        {
+            pObj->fMarkB = Vec_StrEntry( p->vCexValues, Aig_ObjCioId(pObj) );
+            return;
+        }
         nVarNum = Dch_ObjSatNum( p, pObjFraig );
         // get the value from the SAT solver
         // (account for the fact that some vars may be minimized away)
@@ -20,6 +20,7 @@
 
 #include "dchInt.h"
 #include "misc/bar/bar.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -31,6 +32,32 @@ ABC_NAMESPACE_IMPL_START
 static inline Aig_Obj_t * Dch_ObjChild0Fra( Aig_Obj_t * pObj ) { assert( !Aig_IsComplement(pObj) ); return Aig_ObjFanin0(pObj)? Aig_NotCond(Dch_ObjFraig(Aig_ObjFanin0(pObj)), Aig_ObjFaninC0(pObj)) : NULL;  }
 static inline Aig_Obj_t * Dch_ObjChild1Fra( Aig_Obj_t * pObj ) { assert( !Aig_IsComplement(pObj) ); return Aig_ObjFanin1(pObj)? Aig_NotCond(Dch_ObjFraig(Aig_ObjFanin1(pObj)), Aig_ObjFaninC1(pObj)) : NULL;  }
 
+// the number of candidate pairs given to each thread in one round
+#define DCH_PAR_PAIRS  4
+
+// the candidate pair solved by a thread
+typedef struct Dch_ParPair_t_ Dch_ParPair_t;
+struct Dch_ParPair_t_
+{
+    Aig_Obj_t *      pObj;           // the node
+    Aig_Obj_t *      pRepr;          // its representative
+    Aig_Obj_t *      pOld;           // the fraiged representative
+    Aig_Obj_t *      pNew;           // the fraiged node
+    int              Status;         // the outcome of the SAT call
+    Vec_Int_t *      vCex;           // the CIs equal to 1 in the counter-example
+};
+
+// the work of one thread in one round
+typedef struct Dch_ParTask_t_ Dch_ParTask_t;
+struct Dch_ParTask_t_
+{
+    Dch_Man_t *      pMan;           // the private copy of the manager
+    Dch_ParPair_t *  pPairs;         // the pairs of the round
+    int              nPairs;         // the number of pairs
+    int              iThread;        // the first pair of the thread
+    int              nThreads;       // the step between the pairs
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -92,6 +119,253 @@ void Dch_ManSweepNode( Dch_Man_t * p, Aig_Obj_t * pObj )
     assert( Aig_ObjRepr( p->pAigTotal, pObj ) != pObjRepr );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Proves the candidate pairs given to one thread.]
+
+  Description [The thread uses its own SAT solver over the shared fraiged 
+  AIG, which is not modified while the threads are running. For each 
+  disproved pair, the values of the CIs are saved.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Dch_ManSweepParTask( void * pArg, int iThread, void * pScratch )
+{
+    Dch_ParTask_t * pTask = (Dch_ParTask_t *)pArg;
+    Dch_Man_t * p = pTask->pMan;
+    Dch_ParPair_t * pPair;
+    Aig_Obj_t * pNode;
+    int i, k;
+    for ( i = pTask->iThread; i < pTask->nPairs; i += pTask->nThreads )
+    {
+        pPair = pTask->pPairs + i;
+        pPair->Status = Dch_NodesAreEquiv( p, pPair->pOld, pPair->pNew );
+        Vec_IntClear( pPair->vCex );
+        if ( pPair->Status != 0 )
+            continue;
+        Vec_PtrForEachEntry( Aig_Obj_t *, p->vUsedNodes, pNode, k )
+            if ( Aig_ObjIsCi(pNode) && sat_solver_var_value(p->pSat, Dch_ObjSatNum(p, pNode)) )
+                Vec_IntPush( pPair->vCex, Aig_ObjCioId(pNode) );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Checks whether the node needs a SAT call.]
+
+  Description [Returns 1 if the node and its representative have different 
+  fraiged nodes. Otherwise, records the equivalence if it is structural.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Dch_ManSweepParCheck( Dch_Man_t * p, Aig_Obj_t * pObj )
+{
+    Aig_Obj_t * pObjRepr = Aig_ObjRepr( p->pAigTotal, pObj );
+    if ( pObjRepr == NULL || Dch_ObjFraig(pObj) == NULL || Dch_ObjFraig(pObjRepr) == NULL )
+        return 0;
+    if ( Aig_Regular(Dch_ObjFraig(pObj)) == Aig_Regular(Dch_ObjFraig(pObjRepr)) )
+    {
+        p->pReprsProved[ pObj->Id ] = pObjRepr;
+        return 0;
+    }
+    assert( Aig_Regular(Dch_ObjFraig(pObj)) != Aig_ManConst1(p->pAigFraig) );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Applies the outcome of the SAT call in the calling thread.]
+
+  Description [Returns 0 if the pair became stale because the class of the 
+  node was refined by a previous counter-example of the same round.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Dch_ManSweepParApply( Dch_Man_t * p, Dch_ParPair_t * pPair )
+{
+    Aig_Obj_t * pObj = pPair->pObj, * pObjRepr = pPair->pRepr;
+    int i, iCi;
+    if ( Aig_ObjRepr(p->pAigTotal, pObj) != pObjRepr )
+        return 0;
+    if ( pPair->Status == -1 ) // timed out
+    {
+        Dch_ObjSetFraig( pObj, NULL );
+        return 1;
+    }
+    if ( pPair->Status == 1 )  // proved equivalent
+    {
+        Dch_ObjSetFraig( pObj, Aig_NotCond( Dch_ObjFraig(pObjRepr), pObj->fPhase ^ pObjRepr->fPhase ) );
+        p->pReprsProved[ pObj->Id ] = pObjRepr;
+        return 1;
+    }
+    // disproved the equivalence
+    Vec_StrFill( p->vCexValues, Aig_ManCiNum(p->pAigTotal), 0 );
+    Vec_IntForEachEntry( pPair->vCex, iCi, i )
+        Vec_StrWriteEntry( p->vCexValues, iCi, 1 );
+    if ( p->pPars->fSimulateTfo )
+        Dch_ManResimulateCex( p, pObj, pObjRepr );
+    else
+        Dch_ManResimulateCex2( p, pObj, pObjRepr );
+    assert( Aig_ObjRepr( p->pAigTotal, pObj ) != pObjRepr );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs fraiging for the internal nodes using several threads.]
+
+  Description [The nodes are processed by levels, so that the fraiged nodes 
+  of a level can be created before the candidate pairs of the level are 
+  proved. In each round, the next pairs of the level are divided among the 
+  threads. Each thread has its own SAT solver. The outcomes are applied by 
+  the calling thread in the order of the pairs: the proved nodes are merged 
+  and the counter-examples refine the shared classes. The pairs whose 
+  classes were refined by a previous counter-example of the same round are 
+  checked again in the next round. The result does not depend on the timing 
+  of the threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Dch_ManSweepPar( Dch_Man_t * p )
+{
+    int nThreads = p->pPars->nProcs;
+    int nPairsMax = nThreads * DCH_PAR_PAIRS;
+    Util_Pool_t * pPool = Util_PoolStart( nThreads, 0 );
+    Dch_Man_t * pCopies = ABC_ALLOC( Dch_Man_t, nThreads );
+    Dch_ParTask_t * pTasks = ABC_CALLOC( Dch_ParTask_t, nThreads );
+    Dch_ParPair_t * pPairs = ABC_CALLOC( Dch_ParPair_t, nPairsMax );
+    Vec_Wec_t * vLevels = Vec_WecAlloc( 100 );
+    Vec_Int_t * vRetry = Vec_IntAlloc( 100 );
+    Vec_Int_t * vRetryNext = Vec_IntAlloc( 100 );
+    Vec_Int_t * vLevel;
+    Aig_Obj_t * pObj, * pObjNew;
+    int i, k, iObj, iNext, nPairs;
+    // prepare the copies of the manager with their own solvers
+    for ( k = 0; k < nThreads; k++ )
+    {
+        memcpy( pCopies + k, p, sizeof(Dch_Man_t) );
+        pCopies[k].pSat       = NULL;
+        pCopies[k].nSatVars   = 1;
+        pCopies[k].pSatVars   = ABC_CALLOC( int, Aig_ManObjNumMax(p->pAigTotal) );
+        pCopies[k].vUsedNodes = Vec_PtrAlloc( 1000 );
+        pCopies[k].vFanins    = Vec_PtrAlloc( 100 );
+        pCopies[k].nRecycles  = 0;
+        pCopies[k].nSatCalls  = pCopies[k].nSatProof = pCopies[k].nSatFailsReal = 0;
+        pCopies[k].nSatCallsUnsat = pCopies[k].nSatCallsSat = 0;
+        pCopies[k].timeSat    = pCopies[k].timeSatSat = pCopies[k].timeSatUnsat = pCopies[k].timeSatUndec = 0;
+        pTasks[k].pMan        = pCopies + k;
+        pTasks[k].pPairs      = pPairs;
+        pTasks[k].iThread     = k;
+        pTasks[k].nThreads    = nThreads;
+    }
+    for ( k = 0; k < nPairsMax; k++ )
+        pPairs[k].vCex = Vec_IntAlloc( 100 );
+    p->vCexValues = Vec_StrAlloc( Aig_ManCiNum(p->pAigTotal) );
+    Aig_ManSetCioIds( p->pAigTotal );
+    Aig_ManSetCioIds( p->pAigFraig );
+    // collect the nodes by level in the order of their IDs
+    Aig_ManForEachNode( p->pAigTotal, pObj, i )
+        Vec_WecPush( vLevels, Aig_ObjLevel(pObj), pObj->Id );
+    Vec_WecForEachLevel( vLevels, vLevel, i )
+    {
+        // create the fraiged nodes of the level
+        Vec_IntForEachEntry( vLevel, iObj, k )
+        {
+            pObj = Aig_ManObj( p->pAigTotal, iObj );
+            if ( Dch_ObjFraig(Aig_ObjFanin0(pObj)) == NULL || 
+                 Dch_ObjFraig(Aig_ObjFanin1(pObj)) == NULL )
+                continue;
+            pObjNew = Aig_And( p->pAigFraig, Dch_ObjChild0Fra(pObj), Dch_ObjChild1Fra(pObj) );
+            Dch_ObjSetFraig( pObj, pObjNew );
+        }
+        // prove the candidate pairs of the level
+        Vec_IntClear( vRetry );
+        for ( iNext = 0; iNext < Vec_IntSize(vLevel) || Vec_IntSize(vRetry) > 0; )
+        {
+            // collect the pairs of this round, starting with the stale ones
+            nPairs = 0;
+            Vec_IntClear( vRetryNext );
+            Vec_IntForEachEntry( vRetry, iObj, k )
+            {
+                pObj = Aig_ManObj( p->pAigTotal, iObj );
+                if ( nPairs == nPairsMax )
+                    Vec_IntPush( vRetryNext, iObj );
+                else if ( Dch_ManSweepParCheck( p, pObj ) )
+                    pPairs[nPairs++].pObj = pObj;
+            }
+            for ( ; nPairs < nPairsMax && iNext < Vec_IntSize(vLevel); iNext++ )
+            {
+                pObj = Aig_ManObj( p->pAigTotal, Vec_IntEntry(vLevel, iNext) );
+                if ( Dch_ManSweepParCheck( p, pObj ) )
+                    pPairs[nPairs++].pObj = pObj;
+            }
+            for ( k = 0; k < nPairs; k++ )
+            {
+                pPairs[k].pRepr = Aig_ObjRepr( p->pAigTotal, pPairs[k].pObj );
+                pPairs[k].pOld  = Aig_Regular( Dch_ObjFraig(pPairs[k].pRepr) );
+                pPairs[k].pNew  = Aig_Regular( Dch_ObjFraig(pPairs[k].pObj) );
+            }
+            // solve the pairs
+            for ( k = 0; k < nThreads; k++ )
+            {
+                pTasks[k].nPairs = nPairs;
+                if ( k < nPairs )
+                    Util_PoolAssign( pPool, k, Dch_ManSweepParTask, (void *)(pTasks + k) );
+            }
+            Util_PoolWaitAll( pPool );
+            // apply the outcomes in the order of the pairs
+            for ( k = 0; k < nPairs; k++ )
+                if ( !Dch_ManSweepParApply( p, pPairs + k ) )
+                    Vec_IntPush( vRetryNext, pPairs[k].pObj->Id );
+            ABC_SWAP( Vec_Int_t *, vRetry, vRetryNext );
+        }
+    }
+    Aig_ManCleanCioIds( p->pAigFraig );
+    Aig_ManCleanCioIds( p->pAigTotal );
+    Vec_StrFreeP( &p->vCexValues );
+    // collect the statistics and free the copies
+    for ( k = 0; k < nThreads; k++ )
+    {
+        p->nSatCalls      += pCopies[k].nSatCalls;
+        p->nSatProof      += pCopies[k].nSatProof;
+        p->nSatFailsReal  += pCopies[k].nSatFailsReal;
+        p->nSatCallsUnsat += pCopies[k].nSatCallsUnsat;
+        p->nSatCallsSat   += pCopies[k].nSatCallsSat;
+        p->nRecycles      += pCopies[k].nRecycles;
+        p->nSatVars        = Abc_MaxInt( p->nSatVars, pCopies[k].nSatVars );
+        p->timeSat        += pCopies[k].timeSat;
+        p->timeSatSat     += pCopies[k].timeSatSat;
+        p->timeSatUnsat   += pCopies[k].timeSatUnsat;
+        p->timeSatUndec   += pCopies[k].timeSatUndec;
+        if ( pCopies[k].pSat )
+            sat_solver_delete( pCopies[k].pSat );
+        Vec_PtrFree( pCopies[k].vUsedNodes );
+        Vec_PtrFree( pCopies[k].vFanins );
+        ABC_FREE( pCopies[k].pSatVars );
+    }
+    for ( k = 0; k < nPairsMax; k++ )
+        Vec_IntFree( pPairs[k].vCex );
+    Vec_IntFree( vRetry );
+    Vec_IntFree( vRetryNext );
+    Vec_WecFree( vLevels );
+    ABC_FREE( pPairs );
+    ABC_FREE( pTasks );
+    ABC_FREE( pCopies );
+    Util_PoolStop( pPool );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Performs fraiging for the internal nodes.]
@@ -115,20 +389,25 @@ void Dch_ManSweep( Dch_Man_t * p )
     Aig_ManForEachCi( p->pAigTotal, pObj, i )
         pObj->pData = Aig_ObjCreateCi( p->pAigFraig );
     // sweep internal nodes
-    pProgress = Bar_ProgressStart( stdout, Aig_ManObjNumMax(p->pAigTotal) );
-    Aig_ManForEachNode( p->pAigTotal, pObj, i )
+    if ( p->pPars->nProcs > 1 )
+        Dch_ManSweepPar( p );
+    else
     {
-        Bar_ProgressUpdate( pProgress, i, NULL );
-        if ( Dch_ObjFraig(Aig_ObjFanin0(pObj)) == NULL || 
-             Dch_ObjFraig(Aig_ObjFanin1(pObj)) == NULL )
-            continue;
-        pObjNew = Aig_And( p->pAigFraig, Dch_ObjChild0Fra(pObj), Dch_ObjChild1Fra(pObj) );
-        if ( pObjNew == NULL )
-            continue;
-        Dch_ObjSetFraig( pObj, pObjNew );
-        Dch_ManSweepNode( p, pObj );
+        pProgress = Bar_ProgressStart( stdout, Aig_ManObjNumMax(p->pAigTotal) );
+        Aig_ManForEachNode( p->pAigTotal, pObj, i )
+        {
+            Bar_ProgressUpdate( pProgress, i, NULL );
+            if ( Dch_ObjFraig(Aig_ObjFanin0(pObj)) == NULL || 
+                 Dch_ObjFraig(Aig_ObjFanin1(pObj)) == NULL )
+                continue;
+            pObjNew = Aig_And( p->pAigFraig, Dch_ObjChild0Fra(pObj), Dch_ObjChild1Fra(pObj) );
+            if ( pObjNew == NULL )
+                continue;
+            Dch_ObjSetFraig( pObj, pObjNew );
+            Dch_ManSweepNode( p, pObj );
+        }
+        Bar_ProgressStop( pProgress );
     }
-    Bar_ProgressStop( pProgress );
     // update the representatives of the nodes (makes classes invalid)
     ABC_FREE( p->pAigTotal->pReprs );
     p->pAigTotal->pReprs = p->pReprsProved;
@@ -74,6 +74,8 @@ struct Pdr_Par_t_
     int fStoreCex;        // enable storing counter-examples in MO mode
     int fUseBridge;       // use bridge interface
     int fUsePropOut;      // use property output
+    int nProcs;           // the number of threads
+    int fPortfolio;       // run the threads as a portfolio without sharing clauses
     int nFailOuts;        // the number of failed outputs
     int nDropOuts;        // the number of timed out outputs
     int nProveOuts;       // the number of proved outputs
@@ -21,6 +21,18 @@
 #include "pdrInt.h"
 #include "base/main/main.h"
 #include "misc/hash/hash.h"
+#include "misc/util/utilPool.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
 
 ABC_NAMESPACE_IMPL_START
 
@@ -32,6 +44,22 @@ ABC_NAMESPACE_IMPL_START
 extern int Gia_ManToBridgeResult( FILE * pFile, int Result, Abc_Cex_t * pCex, int iPoProved );
 extern int Gia_ManToBridgeAbort( FILE * pFile, int Size, unsigned char * pBuffer );
 
+// the clauses shared by the threads
+struct Pdr_Shr_t_
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_t Mutex;     // protects the arrays below
+#endif
+    Vec_Ptr_t *     vCubes;    // the blocked cubes
+    Vec_Int_t *     vFrames;   // the frame of each cube
+    Vec_Int_t *     vThreads;  // the thread that derived each cube
+    Pdr_Man_t **    pMans;     // the manager of each thread
+    int *           pStatus;   // the result of each thread
+    int             nThreads;  // the number of threads
+    int             iWinner;   // the first thread that finishes
+    int             fStop;     // set by the first thread that finishes
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -68,6 +96,8 @@ void Pdr_ManSetDefaultParams( Pdr_Par_t * pPars )
     pPars->fUseSupp       =       1;  // using support variables in the invariant
     pPars->fShortest      =       0;  // forces bug traces to be shortest
     pPars->fUsePropOut    =       1;  // use property output
+    pPars->nProcs         =       1;  // the number of threads
+    pPars->fPortfolio     =       0;  // run the threads as a portfolio without sharing clauses
     pPars->fSkipDown      =       1;  // apply down in generalization
     pPars->fCtgs          =       0;  // handle CTGs in down
     pPars->fUseAbs        =       0;  // use abstraction 
@@ -880,6 +910,126 @@ int Pdr_ManGeneralize( Pdr_Man_t * p, int k, Pdr_Set_t * pCube, Pdr_Set_t ** ppP
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if another thread has finished.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Pdr_ManShareStop( Pdr_Man_t * p )
+{
+    return p->pShare && __atomic_load_n( &p->pShare->fStop, __ATOMIC_ACQUIRE );
+}
+static inline void Pdr_ManShareLock( Pdr_Shr_t * pShr )
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_lock( &pShr->Mutex );
+#endif
+}
+static inline void Pdr_ManShareUnlock( Pdr_Shr_t * pShr )
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_unlock( &pShr->Mutex );
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Exports the cube blocked in frames 1..k to other threads.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Pdr_ManShareExport( Pdr_Man_t * p, int k, Pdr_Set_t * pCube )
+{
+    Pdr_Shr_t * pShr = p->pShare;
+    if ( pShr == NULL || p->pPars->fPortfolio )
+        return;
+    Pdr_ManShareLock( pShr );
+    Vec_PtrPush( pShr->vCubes, Pdr_SetDup(pCube) );
+    Vec_IntPush( pShr->vFrames, k );
+    Vec_IntPush( pShr->vThreads, p->iThread );
+    Pdr_ManShareUnlock( pShr );
+    p->nShareOut++;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Imports the cubes blocked by other threads.]
+
+  Description [The shared array is only appended, so the thread copies 
+  the cubes added since its last visit while holding the lock and checks 
+  them without it. A cube blocked by another thread in frame k is added 
+  to frames 1..k of this thread only if it does not contain the initial 
+  state and is blocked by relative induction with frame k-1 of this thread. 
+  This keeps the frames of each thread valid, whatever the other threads 
+  have derived. A cube whose check reaches the conflict limit is dropped. 
+  Returns the number of cubes added, or -1 if the runtime limit is reached.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Pdr_ManShareImport( Pdr_Man_t * p )
+{
+    Pdr_Shr_t * pShr = p->pShare;
+    Vec_Ptr_t * vCubes;
+    Vec_Int_t * vFrames;
+    Pdr_Set_t * pCube;
+    int i, j, k, RetValue = 1, nAdded = 0, kMax = Vec_PtrSize(p->vSolvers)-1;
+    abctime TimeLimit;
+    if ( pShr == NULL || p->pPars->fPortfolio || kMax < 1 )
+        return 0;
+    // copy the new cubes of other threads
+    vCubes  = Vec_PtrAlloc( 100 );
+    vFrames = Vec_IntAlloc( 100 );
+    Pdr_ManShareLock( pShr );
+    for ( i = p->iShared; i < Vec_PtrSize(pShr->vCubes); i++ )
+        if ( Vec_IntEntry(pShr->vThreads, i) != p->iThread )
+        {
+            Vec_PtrPush( vCubes, Pdr_SetDup((Pdr_Set_t *)Vec_PtrEntry(pShr->vCubes, i)) );
+            Vec_IntPush( vFrames, Vec_IntEntry(pShr->vFrames, i) );
+        }
+    p->iShared = Vec_PtrSize(pShr->vCubes);
+    Pdr_ManShareUnlock( pShr );
+    // add the cubes that are blocked in the frames of this thread
+    Vec_PtrForEachEntry( Pdr_Set_t *, vCubes, pCube, i )
+    {
+        k = Abc_MinInt( Vec_IntEntry(vFrames, i), kMax );
+        if ( RetValue != -1 && !Pdr_SetIsInit(pCube, -1) && !Pdr_ManCheckContainment(p, k, pCube) )
+        {
+            RetValue = Pdr_ManCheckCube( p, k-1, pCube, NULL, p->pPars->nConfLimit, 0, 1 );
+            TimeLimit = Pdr_ManTimeLimit( p );
+            if ( RetValue == -1 && !(TimeLimit && Abc_Clock() > TimeLimit) )
+                RetValue = 0; // the conflict limit is reached; drop the cube
+            if ( RetValue == 1 )
+            {
+                Vec_VecPush( p->vClauses, k, pCube ); // consume ref
+                for ( j = 1; j <= k; j++ )
+                    Pdr_ManSolverAddClause( p, j, pCube );
+                p->iUseFrame = Abc_MinInt( p->iUseFrame, k );
+                nAdded++;
+                continue;
+            }
+        }
+        Pdr_SetDeref( pCube );
+    }
+    Vec_PtrFree( vCubes );
+    Vec_IntFree( vFrames );
+    p->nShareIn += nAdded;
+    return RetValue == -1 ? -1 : nAdded;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Returns 1 if the state could be blocked.]
@@ -991,6 +1141,7 @@ int Pdr_ManBlockCube( Pdr_Man_t * p, Pdr_Set_t * pCube )
             // add clause
             for ( i = 1; i <= k; i++ )
                 Pdr_ManSolverAddClause( p, i, pCubeMin );
+            Pdr_ManShareExport( p, k, pCubeMin );
             // schedule proof obligation
             if ( (k < kMax || p->pPars->fReuseProofOblig) && !p->pPars->fShortest )
             {
@@ -1016,6 +1167,8 @@ int Pdr_ManBlockCube( Pdr_Man_t * p, Pdr_Set_t * pCube )
         // check termination
         if ( p->pPars->pFuncStop && p->pPars->pFuncStop(p->pPars->RunId) )
             return -1;
+        if ( Pdr_ManShareStop(p) )
+            return -1;
         if ( p->timeToStop && Abc_Clock() > p->timeToStop )
             return -1;
         if ( p->timeToStopOne && Abc_Clock() > p->timeToStopOne )
@@ -1142,13 +1295,20 @@ int Pdr_ManSolveInt( Pdr_Man_t * p )
                     p->pPars->iFrame = iFrame;
                     return -1;
                 }
-                RetValue = Pdr_ManCheckCube( p, iFrame, NULL, &pCube, p->pPars->nConfLimit, 0, 1 );
+                RetValue = Pdr_ManShareImport( p );
+                if ( RetValue != -1 )
+                    RetValue = Pdr_ManCheckCube( p, iFrame, NULL, &pCube, p->pPars->nConfLimit, 0, 1 );
                 if ( RetValue == 1 )
                     break;
                 if ( RetValue == -1 )
                 {
                     if ( p->pPars->fVerbose )
                         Pdr_ManPrintProgress( p, 1, Abc_Clock() - clkStart );
+                    if ( p->pShare ) // the reason is reported by Pdr_ManSolvePar()
+                    {
+                        p->pPars->iFrame = iFrame;
+                        return -1;
+                    }
                     if ( p->timeToStop && Abc_Clock() > p->timeToStop )
                         Abc_Print( 1, "Reached timeout (%d seconds) in frame %d.\n",  p->pPars->nTimeOut, iFrame );
                     else if ( p->pPars->nTimeOutGap && p->pPars->timeLastSolved && Abc_Clock() > p->pPars->timeLastSolved + p->pPars->nTimeOutGap * CLOCKS_PER_SEC )
@@ -1173,6 +1333,11 @@ int Pdr_ManSolveInt( Pdr_Man_t * p )
                     {
                         if ( p->pPars->fVerbose )
                             Pdr_ManPrintProgress( p, 1, Abc_Clock() - clkStart );
+                        if ( p->pShare ) // the reason is reported by Pdr_ManSolvePar()
+                        {
+                            p->pPars->iFrame = iFrame;
+                            return -1;
+                        }
                         if ( p->timeToStop && Abc_Clock() > p->timeToStop )
                             Abc_Print( 1, "Reached timeout (%d seconds) in frame %d.\n",  p->pPars->nTimeOut, iFrame );
                         else if ( p->pPars->nTimeOutGap && p->pPars->timeLastSolved && Abc_Clock() > p->pPars->timeLastSolved + p->pPars->nTimeOutGap * CLOCKS_PER_SEC )
@@ -1286,8 +1451,10 @@ int Pdr_ManSolveInt( Pdr_Man_t * p )
             Abc_Print( 1, "*** Clauses after frame %d:\n", iFrame );
             Pdr_ManPrintClauses( p, 0 );
         }
-        // push clauses into this timeframe
-        RetValue = Pdr_ManPushClauses( p );
+        // push clauses into this timeframe (including those of other threads)
+        RetValue = Pdr_ManShareImport( p );
+        if ( RetValue != -1 )
+            RetValue = Pdr_ManPushClauses( p );
         if ( RetValue == -1 )
         {
             if ( p->pPars->fVerbose )
@@ -1332,7 +1499,7 @@ int Pdr_ManSolveInt( Pdr_Man_t * p )
             Pdr_ManPrintProgress( p, 0, Abc_Clock() - clkStart );
 
         // check termination
-        if ( p->pPars->pFuncStop && p->pPars->pFuncStop(p->pPars->RunId) )
+        if ( (p->pPars->pFuncStop && p->pPars->pFuncStop(p->pPars->RunId)) || Pdr_ManShareStop(p) )
         {
             p->pPars->iFrame = iFrame;
             return -1;
@@ -1379,6 +1546,189 @@ int Pdr_ManSolveInt( Pdr_Man_t * p )
     return -1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Diversifies the parameters of one thread.]
+
+  Description [Thread 0 uses the parameters of the user. Other threads 
+  break the ties in the flop order differently. In the portfolio mode, 
+  they also use different generalization options.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Pdr_ManDiversify( Pdr_Par_t * pPars, int iThread, int nRegs )
+{
+    Vec_Int_t * vPrio;
+    unsigned Rand = (unsigned)pPars->nRandomSeed + iThread;
+    int i;
+    if ( iThread == 0 )
+        return NULL;
+    if ( pPars->fPortfolio )
+    {
+        if ( iThread & 1 )
+            pPars->fFlopOrder ^= 1;
+        if ( iThread & 2 )
+            pPars->fTwoRounds ^= 1;
+        if ( iThread & 4 )
+            pPars->fSkipDown ^= 1;
+    }
+    if ( pPars->fFlopPrio )
+        return NULL;
+    // the priorities below (1 << nPrioShift) only break the ties
+    vPrio = Vec_IntAlloc( nRegs );
+    for ( i = 0; i < nRegs; i++ )
+    {
+        Rand = 1664525 * Rand + 1013904223;
+        Vec_IntPush( vPrio, (Rand >> 8) % nRegs );
+    }
+    return vPrio;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Solves the problem with several threads.]
+
+  Description [Each thread runs PDR on its own copy of the AIG with its 
+  own solvers and frames. Unless the portfolio mode is selected, the 
+  threads exchange the blocked cubes through the shared array protected 
+  by the lock (see Pdr_ManShareImport). The first thread that proves 
+  or disproves the property stops the others. Returns the manager of 
+  this thread, or the one that has explored the most frames, while 
+  the other managers are freed.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifdef ABC_USE_PTHREADS
+
+void Pdr_ManSolveParTask( void * pArg, int iThread, void * pScratch )
+{
+    Pdr_Shr_t * pShr = (Pdr_Shr_t *)pArg;
+    int Status = Pdr_ManSolveInt( pShr->pMans[iThread] ), iWinner = -1;
+    pShr->pStatus[iThread] = Status;
+    if ( Status == -1 )
+        return;
+    if ( __atomic_compare_exchange_n( &pShr->iWinner, &iWinner, iThread, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ) )
+        __atomic_store_n( &pShr->fStop, 1, __ATOMIC_RELEASE );
+}
+Pdr_Man_t * Pdr_ManSolvePar( Aig_Man_t * pAig, Pdr_Par_t * pPars, int * pRetValue )
+{
+    Pdr_Shr_t Share, * pShr = &Share;
+    Pdr_Par_t * pThrPars = ABC_ALLOC( Pdr_Par_t, pPars->nProcs );
+    Util_Pool_t * pPool;
+    Pdr_Man_t * p;
+    Pdr_Set_t * pCube;
+    Vec_Int_t * vPrio;
+    abctime clk = Abc_Clock();
+    int i, iBest, status;
+    memset( pShr, 0, sizeof(Pdr_Shr_t) );
+    status = pthread_mutex_init( &pShr->Mutex, NULL );  assert( status == 0 );
+    pShr->vCubes   = Vec_PtrAlloc( 1000 );
+    pShr->vFrames  = Vec_IntAlloc( 1000 );
+    pShr->vThreads = Vec_IntAlloc( 1000 );
+    pShr->nThreads = pPars->nProcs;
+    pShr->pMans    = ABC_CALLOC( Pdr_Man_t *, pShr->nThreads );
+    pShr->pStatus  = ABC_FALLOC( int, pShr->nThreads );
+    pShr->iWinner  = -1;
+    for ( i = 0; i < pShr->nThreads; i++ )
+    {
+        pThrPars[i] = *pPars;
+        vPrio = Pdr_ManDiversify( pThrPars + i, i, Aig_ManRegNum(pAig) );
+        pThrPars[i].fVerbose     = 0;
+        pThrPars[i].fVeryVerbose = 0;
+        pThrPars[i].fNotVerbose  = 1;
+        pThrPars[i].fSilent      = 1;
+        p = Pdr_ManStart( Aig_ManDupSimple(pAig), pThrPars + i, vPrio );
+        p->pShare  = pShr;
+        p->iThread = i;
+        pShr->pMans[i] = p;
+    }
+    // manager i is run by thread i
+    pPool = Util_PoolStart( pShr->nThreads, 0 );
+    for ( i = 0; i < pShr->nThreads; i++ )
+        Util_PoolAssign( pPool, i, Pdr_ManSolveParTask, (void *)pShr );
+    Util_PoolWaitAll( pPool );
+    Util_PoolStop( pPool );
+    // select the result
+    iBest = pShr->iWinner;
+    if ( iBest == -1 )
+    {
+        iBest = 0;
+        for ( i = 1; i < pShr->nThreads; i++ )
+            if ( pShr->pMans[iBest]->pPars->iFrame < pShr->pMans[i]->pPars->iFrame )
+                iBest = i;
+    }
+    *pRetValue = pShr->pStatus[iBest];
+    if ( pPars->fVerbose )
+    {
+        Abc_Print( 1, "%d threads %s: ", pShr->nThreads, pPars->fPortfolio ? "in the portfolio" : "sharing clauses" );
+        if ( pShr->iWinner >= 0 )
+            Abc_Print( 1, "thread %d finished first in frame %d.\n", pShr->iWinner, pShr->pMans[pShr->iWinner]->pPars->iFrame );
+        else
+            Abc_Print( 1, "no thread finished.\n" );
+        for ( i = 0; i < pShr->nThreads; i++ )
+        {
+            p = pShr->pMans[i];
+            Abc_Print( 1, "Thread %2d : Frame = %4d.  Clause = %7d.  Call = %8d.  Exported = %7d.  Imported = %7d.\n", 
+                i, p->pPars->iFrame, p->nCubes, p->nCalls, p->nShareOut, p->nShareIn );
+        }
+    }
+    // report the result in terms of the user's parameters
+    p = pShr->pMans[iBest];
+    pPars->iFrame     = p->pPars->iFrame;
+    pPars->nFailOuts  = p->pPars->nFailOuts;
+    pPars->nProveOuts = p->pPars->nProveOuts;
+    p->pPars = pPars;
+    if ( p->pAig->pSeqModel )
+    {
+        pAig->pSeqModel = p->pAig->pSeqModel;
+        p->pAig->pSeqModel = NULL;
+    }
+    if ( *pRetValue == 1 && !pPars->fSilent )
+    {
+        Pdr_ManReportInvariant( p );
+        Pdr_ManVerifyInvariant( p );
+    }
+    else if ( *pRetValue == -1 && !pPars->fSilent )
+    {
+        if ( pPars->nTimeOut && Abc_Clock() - clk >= (abctime)pPars->nTimeOut * CLOCKS_PER_SEC )
+            Abc_Print( 1, "Reached timeout (%d seconds) in frame %d.\n",  pPars->nTimeOut, pPars->iFrame );
+        else if ( pPars->nTimeOutGap )
+            Abc_Print( 1, "Reached gap timeout (%d seconds) in frame %d.\n",  pPars->nTimeOutGap, pPars->iFrame );
+        else if ( pPars->nFrameMax && pPars->iFrame >= pPars->nFrameMax )
+            Abc_Print( 1, "Reached limit on the number of timeframes (%d).\n", pPars->nFrameMax );
+        else if ( pPars->nConfLimit )
+            Abc_Print( 1, "Reached conflict limit (%d) in frame %d.\n",  pPars->nConfLimit, pPars->iFrame );
+    }
+    // free the other threads
+    for ( i = 0; i < pShr->nThreads; i++ )
+    {
+        if ( i == iBest )
+            continue;
+        pAig = pShr->pMans[i]->pAig;
+        Pdr_ManStop( pShr->pMans[i] );
+        Aig_ManStop( pAig );
+    }
+    Vec_PtrForEachEntry( Pdr_Set_t *, pShr->vCubes, pCube, i )
+        Pdr_SetDeref( pCube );
+    Vec_PtrFree( pShr->vCubes );
+    Vec_IntFree( pShr->vFrames );
+    Vec_IntFree( pShr->vThreads );
+    status = pthread_mutex_destroy( &pShr->Mutex );  assert( status == 0 );
+    ABC_FREE( pShr->pMans );
+    ABC_FREE( pShr->pStatus );
+    ABC_FREE( pThrPars );
+    p->pShare = NULL;
+    return p;
+}
+
+#endif // pthreads are used
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -1392,6 +1742,7 @@ int Pdr_ManSolveInt( Pdr_Man_t * p )
 ***********************************************************************/
 int Pdr_ManSolve( Aig_Man_t * pAig, Pdr_Par_t * pPars )
 {
+    Aig_Man_t * pAigUsed;
     Pdr_Man_t * p;
     int k, RetValue;
     abctime clk = Abc_Clock();
@@ -1413,8 +1764,16 @@ int Pdr_ManSolve( Aig_Man_t * pAig, Pdr_Par_t * pPars )
             pPars->fSolveAll ?    "yes" : "no" );
     }
     ABC_FREE( pAig->pSeqModel );
-    p = Pdr_ManStart( pAig, pPars, NULL );
-    RetValue = Pdr_ManSolveInt( p );
+#ifdef ABC_USE_PTHREADS
+    if ( pPars->nProcs > 1 && !pPars->fSolveAll && !pPars->fUseAbs && !pPars->fUseBridge )
+        p = Pdr_ManSolvePar( pAig, pPars, &RetValue );
+    else
+#endif
+    {
+        p = Pdr_ManStart( pAig, pPars, NULL );
+        RetValue = Pdr_ManSolveInt( p );
+    }
+    pAigUsed = p->pAig;
     if ( RetValue == 0 )
         assert( pAig->pSeqModel != NULL || p->vCexes != NULL );
     if ( p->vCexes )
@@ -1434,6 +1793,8 @@ int Pdr_ManSolve( Aig_Man_t * pAig, Pdr_Par_t * pPars )
         Abc_FrameSetInv( Pdr_ManDeriveInfinityClauses( p, RetValue!=1 ) );
     p->tTotal += Abc_Clock() - clk;
     Pdr_ManStop( p );
+    if ( pAigUsed != pAig )
+        Aig_ManStop( pAigUsed );
     pPars->iFrame--;
     // convert all -2 (unknown) entries into -1 (undec)
     if ( pPars->vOutMap )
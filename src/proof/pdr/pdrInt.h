@@ -92,6 +92,8 @@ struct Pdr_Obl_t_
     Pdr_Obl_t * pLink;     // queue link
 };
 
+typedef struct Pdr_Shr_t_ Pdr_Shr_t;
+
 typedef struct Pdr_Man_t_ Pdr_Man_t;
 struct Pdr_Man_t_
 {
@@ -140,6 +142,10 @@ struct Pdr_Man_t_
     Vec_Int_t * vRes;      // final result
     abctime *   pTime4Outs;// timeout per output
     Vec_Ptr_t * vInfCubes; // infinity clauses/cubes
+    // clauses shared with other threads
+    Pdr_Shr_t * pShare;    // the shared clauses (or NULL)
+    int         iThread;   // the thread running this manager
+    int         iShared;   // the number of shared clauses already seen
     // statistics
     int         nBlocks;   // the number of times blockState was called
     int         nObligs;   // the number of proof obligations derived
@@ -158,6 +164,8 @@ struct Pdr_Man_t_
     int         nQueLim;
     int         nXsimRuns;
     int         nXsimLits;
+    int         nShareOut; // the number of clauses exported
+    int         nShareIn;  // the number of clauses imported
     // runtime
     abctime     timeToStop;
     abctime     timeToStopOne;
@@ -22,17 +22,7 @@
 #include "aig/ioa/ioa.h"
 #include "aig/gia/giaAig.h"
 #include "proof/cec/cec.h"
-
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#include <unistd.h>
-#endif
-
-#endif
+#include "misc/util/utilPool.h"
 
 
 ABC_NAMESPACE_IMPL_START
@@ -98,36 +88,21 @@ typedef struct Par_ScorrThData_t_
     int *        pMap;
     int          iThread;
     int          nTimeOut;
-    int          fWorking;
 } Par_ScorrThData_t;
 
-void * Ssw_GiaWorkerThread( void * pArg )
+void Ssw_GiaWorkerTask( void * pArg, int iThread, void * pScratch )
 {
     Par_ScorrThData_t * pThData = (Par_ScorrThData_t *)pArg;
-    volatile int * pPlace = &pThData->fWorking;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->fWorking );
-        if ( pThData->p == NULL )
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        Cec_ManLSCorrespondenceClasses( pThData->p, &pThData->CorPars );
-        pThData->fWorking = 0;
-    }
-    assert( 0 );
-    return NULL;
+    assert( pThData->p != NULL );
+    Cec_ManLSCorrespondenceClasses( pThData->p, &pThData->CorPars );
 }
 
 void Ssw_SignalCorrespondenceArray( Vec_Ptr_t * vGias, Ssw_Pars_t * pPars )
 {
     //abctime clkTotal = Abc_Clock();
     Par_ScorrThData_t ThData[PAR_THR_MAX];
-    pthread_t WorkerThread[PAR_THR_MAX];
-    int i, status, nProcs = pPars->nProcs;
+    Util_Pool_t * pPool;
+    int i, nProcs = pPars->nProcs;
     Vec_Ptr_t * vStack;
     Cec_ParCor_t CorPars, * pCorPars = &CorPars;
     Cec_ManCorSetDefaultParams( pCorPars );
@@ -145,36 +120,21 @@ void Ssw_SignalCorrespondenceArray( Vec_Ptr_t * vGias, Ssw_Pars_t * pPars )
         ThData[i].CorPars  = *pCorPars;
         ThData[i].iThread  = i;
         //ThData[i].nTimeOut = pPars->nTimeOut;
-        ThData[i].fWorking = 0;
-        status = pthread_create( WorkerThread + i, NULL, Ssw_GiaWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
     }
+    pPool = Util_PoolStart( nProcs, 0 );
     // look at the threads
     vStack = Vec_PtrDup( vGias );
     while ( Vec_PtrSize(vStack) > 0 )
     {
-        for ( i = 0; i < nProcs; i++ )
-        {
-            if ( ThData[i].fWorking )
-                continue;
-            ThData[i].p = (Gia_Man_t*)Vec_PtrPop( vStack );
-            ThData[i].fWorking = 1;   
-            break;
-        }
+        i = Util_PoolFindIdle( pPool );
+        if ( i == -1 )
+            i = Util_PoolWaitAny( pPool, NULL );
+        ThData[i].p = (Gia_Man_t*)Vec_PtrPop( vStack );
+        Util_PoolAssign( pPool, i, Ssw_GiaWorkerTask, (void *)(ThData + i) );
     }
     Vec_PtrFree( vStack );    
-    // wait till threads finish
-    for ( i = 0; i < nProcs; i++ )
-        if ( ThData[i].fWorking )
-            i = -1;
-    // stop threads
-    for ( i = 0; i < nProcs; i++ )
-    {
-        assert( !ThData[i].fWorking );
-        // stop
-        ThData[i].p = NULL;
-        ThData[i].fWorking = 1;
-    }
-
+    // wait till threads finish and stop them
+    Util_PoolStop( pPool );
 }
 
 #endif // pthreads are used
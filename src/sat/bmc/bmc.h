@@ -120,6 +120,7 @@ struct Saig_ParBmc_t_
     int         fVerbose;       // verbose 
     int         fNotVerbose;    // skip line-by-line print-out 
     char *      pLogFileName;   // log file name
+    char *      pCacheFileName; // file with the frames proved by earlier runs
     int         fSilent;        // completely silent
     int         iFrame;         // explored up to this frame
     int         nFailOuts;      // the number of failed outputs
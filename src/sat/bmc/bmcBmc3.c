@@ -49,6 +49,7 @@ struct Gia_ManBmc_t_
     Vec_Ptr_t *       vId2Var;     // SAT vars for each object
     Vec_Wec_t *       vVisited;    // visited nodes
     abctime *         pTime4Outs;  // timeout per output
+    Vec_Int_t *       vProved;     // the last frame proved by earlier runs for each output
     // hash table
     Vec_Int_t *       vData;       // storage for cuts
     Hsh_IntMan_t *    vHash;       // hash table
@@ -70,6 +71,12 @@ struct Gia_ManBmc_t_
     char * pSopSizes, ** pSops;    // CNF representation
 };
 
+// the tags of the structural hashes of the unrolled outputs
+#define SAIG_BMC_CACHE_CONST  ABC_CONST(0x6A09E667F3BCC908)
+#define SAIG_BMC_CACHE_PI     ABC_CONST(0xBB67AE8584CAA73B)
+#define SAIG_BMC_CACHE_AND    ABC_CONST(0x3C6EF372FE94F82B)
+#define SAIG_BMC_CACHE_XOR    ABC_CONST(0xA54FF53A5F1D36F1)
+
 extern int Gia_ManToBridgeResult( FILE * pFile, int Result, Abc_Cex_t * pCex, int iPoProved );
 
 void Gia_ManReportProgress( FILE * pFile, int prop_no, int depth )
@@ -831,6 +838,7 @@ void Saig_Bmc3ManStop( Gia_ManBmc_t * p )
     if ( p->pSat2 ) satoko_destroy( p->pSat2 );
     if ( p->pSat3 ) bmcg_sat_solver_stop( p->pSat3 );
     ABC_FREE( p->pTime4Outs );
+    Vec_IntFreeP( &p->vProved );
     Vec_IntFree( p->vData );
     Hsh_IntManStop( p->vHash );
     Vec_IntFree( p->vId2Lit );
@@ -1447,6 +1455,234 @@ int Saig_ManCallSolver( Gia_ManBmc_t * p, int Lit )
         return sat_solver_solve( p->pSat, &Lit, &Lit + 1, (ABC_INT64_T)p->pPars->nConfLimit, (ABC_INT64_T)0, (ABC_INT64_T)0, (ABC_INT64_T)0 );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Adds the unit clause to the solver.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Saig_ManBmcAddUnit( Gia_ManBmc_t * p, int Lit )
+{
+    if ( p->pSat2 )
+        return satoko_add_clause( p->pSat2, &Lit, 1 );
+    if ( p->pSat3 )
+        return bmcg_sat_solver_addclause( p->pSat3, &Lit, 1 );
+    return sat_solver_addclause( p->pSat, &Lit, &Lit + 1 );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Mixes two words into a hash value.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline word Saig_ManBmcCacheMix( word a, word b )
+{
+    word h = (a * ABC_CONST(0x9E3779B97F4A7C15)) ^ (b + ABC_CONST(0x632BE59BD9B4E019) + (a << 6) + (a >> 2));
+    h ^= h >> 33;
+    h *= ABC_CONST(0xFF51AFD7ED558CCD);
+    h ^= h >> 33;
+    return h;
+}
+static inline word Saig_ManBmcCacheKey( word Hash, int iFrame )
+{
+    return Saig_ManBmcCacheMix( Hash, (word)iFrame );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Hashes the outputs of the AIG unrolled for one more frame.]
+
+  Description [The hash of an object in frame f is the hash of its cone in
+  the AIG unrolled for frames 0..f, with the flops starting in zero. It
+  depends only on the structure of the cone, the indexes of its PIs and the
+  frame. pObjs are the hashes of the objects (those of the previous frame
+  on entry). pRegs is a scratch array for the flops. pOuts accumulates the
+  hashes of the outputs over the frames.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Saig_ManBmcCacheFrame( Aig_Man_t * pAig, int iFrame, word * pObjs, word * pRegs, word * pOuts )
+{
+    Aig_Obj_t * pObj, * pObjLi, * pObjLo;
+    word Hash0, Hash1;
+    int i;
+    Saig_ManForEachLiLo( pAig, pObjLi, pObjLo, i )
+        pRegs[i] = iFrame ? pObjs[Aig_ObjId(pObjLi)] : ~(word)SAIG_BMC_CACHE_CONST;
+    pObjs[Aig_ObjId(Aig_ManConst1(pAig))] = SAIG_BMC_CACHE_CONST;
+    Saig_ManForEachPi( pAig, pObj, i )
+        pObjs[Aig_ObjId(pObj)] = Saig_ManBmcCacheMix( Saig_ManBmcCacheMix(SAIG_BMC_CACHE_PI, (word)i), (word)iFrame );
+    Saig_ManForEachLo( pAig, pObj, i )
+        pObjs[Aig_ObjId(pObj)] = pRegs[i];
+    Aig_ManForEachNode( pAig, pObj, i )
+    {
+        // complemented edges invert the hash; the fanins are unordered
+        Hash0 = pObjs[Aig_ObjFaninId0(pObj)] ^ (Aig_ObjFaninC0(pObj) ? ~(word)0 : 0);
+        Hash1 = pObjs[Aig_ObjFaninId1(pObj)] ^ (Aig_ObjFaninC1(pObj) ? ~(word)0 : 0);
+        if ( Hash0 > Hash1 )
+            ABC_SWAP( word, Hash0, Hash1 );
+        pObjs[Aig_ObjId(pObj)] = Saig_ManBmcCacheMix( Saig_ManBmcCacheMix(Aig_ObjIsExor(pObj) ? SAIG_BMC_CACHE_XOR : SAIG_BMC_CACHE_AND, Hash0), Hash1 );
+    }
+    Aig_ManForEachCo( pAig, pObj, i )
+        pObjs[Aig_ObjId(pObj)] = pObjs[Aig_ObjFaninId0(pObj)] ^ (Aig_ObjFaninC0(pObj) ? ~(word)0 : 0);
+    Saig_ManForEachPo( pAig, pObj, i )
+        pOuts[i] = Saig_ManBmcCacheMix( pOuts[i], pObjs[Aig_ObjId(pObj)] );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the frames proved by earlier runs.]
+
+  Description [Each line of the file contains a frame and the hash of an
+  output unrolled for the frames up to it, written by a run that proved 
+  this output in these frames. Returns, for each output of the AIG, the 
+  last frame proved for an output with the same unrolled cone, or -1.
+  Returns NULL if the file cannot be read.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Saig_ManBmcCacheRead( Aig_Man_t * pAig, char * pFileName )
+{
+    Vec_Int_t * vProved;
+    Vec_Wrd_t * vKeys;
+    word * pObjs, * pRegs, * pOuts, Key;
+    unsigned long long Hash;
+    FILE * pFile;
+    int i, f, iFrame, iFrameMax = -1, iBeg, iEnd, iMid;
+    pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+        return NULL;
+    vKeys = Vec_WrdAlloc( 1000 );
+    while ( fscanf( pFile, "%d %llx", &iFrame, &Hash ) == 2 )
+    {
+        Vec_WrdPush( vKeys, Saig_ManBmcCacheKey((word)Hash, iFrame) );
+        iFrameMax = Abc_MaxInt( iFrameMax, iFrame );
+    }
+    fclose( pFile );
+    Vec_WrdSortUnsigned( vKeys );
+    // unroll the hashes and look them up
+    vProved = Vec_IntStartFull( Saig_ManPoNum(pAig) );
+    pObjs = ABC_CALLOC( word, Aig_ManObjNumMax(pAig) );
+    pRegs = ABC_CALLOC( word, Aig_ManRegNum(pAig) );
+    pOuts = ABC_CALLOC( word, Saig_ManPoNum(pAig) );
+    for ( f = 0; f <= iFrameMax; f++ )
+    {
+        Saig_ManBmcCacheFrame( pAig, f, pObjs, pRegs, pOuts );
+        for ( i = 0; i < Saig_ManPoNum(pAig); i++ )
+        {
+            Key = Saig_ManBmcCacheKey( pOuts[i], f );
+            for ( iBeg = 0, iEnd = Vec_WrdSize(vKeys); iBeg < iEnd; )
+            {
+                iMid = (iBeg + iEnd) / 2;
+                if ( Vec_WrdEntry(vKeys, iMid) < Key )
+                    iBeg = iMid + 1;
+                else
+                    iEnd = iMid;
+            }
+            if ( iBeg < Vec_WrdSize(vKeys) && Vec_WrdEntry(vKeys, iBeg) == Key )
+                Vec_IntWriteEntry( vProved, i, f );
+        }
+    }
+    ABC_FREE( pObjs );
+    ABC_FREE( pRegs );
+    ABC_FREE( pOuts );
+    Vec_WrdFree( vKeys );
+    return vProved;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the frames proved for each output.]
+
+  Description [Outputs with the proved frame equal to -1 are skipped.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Saig_ManBmcCacheWrite( Aig_Man_t * pAig, char * pFileName, Vec_Int_t * vProved )
+{
+    word * pObjs, * pRegs, * pOuts;
+    FILE * pFile;
+    int i, f, iFrame, nEntries = 0;
+    pFile = fopen( pFileName, "wb" );
+    if ( pFile == NULL )
+        return -1;
+    pObjs = ABC_CALLOC( word, Aig_ManObjNumMax(pAig) );
+    pRegs = ABC_CALLOC( word, Aig_ManRegNum(pAig) );
+    pOuts = ABC_CALLOC( word, Saig_ManPoNum(pAig) );
+    for ( f = 0; f <= Vec_IntFindMax(vProved); f++ )
+    {
+        Saig_ManBmcCacheFrame( pAig, f, pObjs, pRegs, pOuts );
+        Vec_IntForEachEntry( vProved, iFrame, i )
+        {
+            if ( iFrame != f )
+                continue;
+            fprintf( pFile, "%d %016llx\n", f, (unsigned long long)pOuts[i] );
+            nEntries++;
+        }
+    }
+    ABC_FREE( pObjs );
+    ABC_FREE( pRegs );
+    ABC_FREE( pOuts );
+    fclose( pFile );
+    return nEntries;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Saves the frames proved in this run.]
+
+  Description [An output is proved in the frames explored by the engine,
+  unless it has failed or timed out. The frames proved by earlier runs 
+  are kept if they go further.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Saig_ManBmcCacheUpdate( Gia_ManBmc_t * p )
+{
+    Vec_Int_t * vProved = Vec_IntStartFull( Saig_ManPoNum(p->pAig) );
+    int i, iFrame, nEntries;
+    for ( i = 0; i < Saig_ManPoNum(p->pAig); i++ )
+    {
+        iFrame = p->pPars->nStart ? -1 : p->pPars->iFrame;
+        if ( p->vCexes && Vec_PtrEntry(p->vCexes, i) )
+            iFrame = -1;
+        if ( p->pTime4Outs && p->pTime4Outs[i] == 0 )
+            iFrame = -1;
+        if ( p->vProved )
+            iFrame = Abc_MaxInt( iFrame, Vec_IntEntry(p->vProved, i) );
+        Vec_IntWriteEntry( vProved, i, iFrame );
+    }
+    nEntries = Saig_ManBmcCacheWrite( p->pAig, p->pPars->pCacheFileName, vProved );
+    if ( nEntries == -1 )
+        Abc_Print( 1, "Cannot open file \"%s\" for writing.\n", p->pPars->pCacheFileName );
+    else if ( p->pPars->fVerbose )
+        Abc_Print( 1, "Saved %d outputs proved up to frame %d into file \"%s\".\n", 
+            nEntries, Vec_IntFindMax(vProved), p->pPars->pCacheFileName );
+    Vec_IntFree( vProved );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Bounded model checking engine.]
@@ -1504,6 +1740,8 @@ int Saig_ManBmcScalable( Aig_Man_t * pAig, Saig_ParBmc_t * pPars )
     }
     if ( pPars->fSolveAll && p->vCexes == NULL )
         p->vCexes = Vec_PtrStart( Saig_ManPoNum(pAig) );
+    if ( pPars->pCacheFileName )
+        p->vProved = Saig_ManBmcCacheRead( pAig, pPars->pCacheFileName );
     if ( pPars->fVerbose )
     {
         Abc_Print( 1, "Running \"bmc3\". PI/PO/Reg = %d/%d/%d. And =%7d. Lev =%6d. ObjNums =%6d.\n",// Sect =%3d.\n", 
@@ -1511,6 +1749,9 @@ int Saig_ManBmcScalable( Aig_Man_t * pAig, Saig_ParBmc_t * pPars )
             Aig_ManNodeNum(pAig), Aig_ManLevelNum(pAig), p->nObjNums );//, Vec_VecSize(p->vSects) );
         Abc_Print( 1, "Params: FramesMax = %d. Start = %d. ConfLimit = %d. TimeOut = %d. SolveAll = %d.\n", 
             pPars->nFramesMax, pPars->nStart, pPars->nConfLimit, pPars->nTimeOut, pPars->fSolveAll );
+        if ( p->vProved )
+            Abc_Print( 1, "Earlier runs proved %d outputs up to frame %d (file \"%s\").\n", 
+                Saig_ManPoNum(pAig) - Vec_IntCountEntry(p->vProved, -1), Vec_IntFindMax(p->vProved), pPars->pCacheFileName );
     } 
     pPars->nFramesMax = pPars->nFramesMax ? pPars->nFramesMax : ABC_INFINITY;
     // set runtime limit
@@ -1642,6 +1883,13 @@ clkOther += Abc_Clock() - clk2;
 clk2 = Abc_Clock();
             Lit = Saig_ManBmcCreateCnf( p, pObj, f );
 clkOther += Abc_Clock() - clk2;
+            // reuse the result of an earlier run, which proved this output in this frame
+            if ( p->vProved && f <= Vec_IntEntry(p->vProved, i) && Lit != 1 )
+            {
+                if ( Lit != 0 )
+                    Saig_ManBmcAddUnit( p, lit_neg(Lit) );
+                continue;
+            }
             // solve this output
             fUnfinished = 0;
             if ( p->pSat ) sat_solver_compress( p->pSat );
@@ -1881,6 +2129,8 @@ finish:
         Abc_Print( 1, "UNDEC = %.1f sec (%.1f %%)",   1.0*nTimeUndec/CLOCKS_PER_SEC, 100.0*nTimeUndec/(Abc_Clock() - clkTotal) );
         Abc_Print( 1, "\n" );
     }
+    if ( pPars->pCacheFileName )
+        Saig_ManBmcCacheUpdate( p );
     Saig_Bmc3ManStop( p );
     fflush( stdout );
     if ( pLogFile )
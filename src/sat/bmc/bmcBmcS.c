@@ -21,6 +21,7 @@
 #include "bmc.h"
 #include "sat/cnf/cnf.h"
 #include "sat/satoko/satoko.h"
+#include "misc/util/utilPool.h"
 
 
 //#define ABC_USE_EXT_SOLVERS 1
@@ -46,18 +47,6 @@
 
 
 
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-    #include "../lib/pthread.h"
-#else
-    #include <pthread.h>
-    #include <unistd.h>
-#endif
-
-#endif
-
-
 ABC_NAMESPACE_IMPL_START
 
 ////////////////////////////////////////////////////////////////////////
@@ -735,75 +724,41 @@ typedef struct Par_ThData_t_
     bmc_sat_solver *  pSat;
     int         iLit;
     int         iThread;
-    int         fWorking;
     int         status;
 } Par_ThData_t;
 
-void * Bmcs_ManWorkerThread( void * pArg )
+void Bmcs_ManWorkerTask( void * pArg, int iThread, void * pScratch )
 {
     Par_ThData_t * pThData = (Par_ThData_t *)pArg;
-    volatile int * pPlace = &pThData->fWorking;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->fWorking );
-        if ( pThData->pSat == NULL )
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-
-        pThData->status = bmc_sat_solver_solve( pThData->pSat, &pThData->iLit, 1 );
+    assert( pThData->pSat != NULL );
 
-        //printf( "Thread %d finished with status %d\n", pThData->iThread, pThData->status );
+    pThData->status = bmc_sat_solver_solve( pThData->pSat, &pThData->iLit, 1 );
 
-        pThData->fWorking = 0;
-    }
-    assert( 0 );
-    return NULL;
+    //printf( "Thread %d finished with status %d\n", pThData->iThread, pThData->status );
 }
 
-int Bmcs_ManPerform_Solve( Bmcs_Man_t * p, int iLit, pthread_t * WorkerThread, Par_ThData_t * ThData, int nProcs, int * pSolver )
+int Bmcs_ManPerform_Solve( Bmcs_Man_t * p, int iLit, Util_Pool_t * pPool, Par_ThData_t * ThData, int nProcs, int * pSolver )
 {
     int i, status = -1;
-    // set new problem
-    for ( i = 0; i < nProcs; i++ )
-    {
-        ThData[i].iLit = iLit;
-        assert( ThData[i].fWorking == 0 );
-    }
     // start solvers on a new problem
     for ( i = 0; i < nProcs; i++ )
-        ThData[i].fWorking = 1;
-    // check if any of the solvers finished
-    while ( i == nProcs )
     {
-        for ( i = 0; i < nProcs; i++ )
-        {
-            if ( ThData[i].fWorking )
-                continue;
-            // set stop request
-            p->fStopNow = 1;
-            // remember status
-            status = ThData[i].status;
-            //printf( "Solver %d returned status %d.\n", i, status );
-            *pSolver = i;
-            break;
-        }
+        ThData[i].iLit = iLit;
+        Util_PoolAssign( pPool, i, Bmcs_ManWorkerTask, (void *)(ThData + i) );
     }
+    // wait till any of the solvers finishes
+    i = Util_PoolWaitAny( pPool, NULL );
+    assert( i >= 0 && i < nProcs );
+    // set stop request
+    p->fStopNow = 1;
+    // remember status
+    status = ThData[i].status;
+    //printf( "Solver %d returned status %d.\n", i, status );
+    *pSolver = i;
     // wait till threads finish
-    while ( i < nProcs )
-    {
-        for ( i = 0; i < nProcs; i++ )
-            if ( ThData[i].fWorking )
-                break;
-    }
+    Util_PoolWaitAll( pPool );
     for ( i = 0; i < nProcs; i++ )
-    {
         ThData[i].iLit = -1;
-        assert( ThData[i].fWorking == 0 );
-    }
     // reset stop request
     p->fStopNow = 0;
     return status;
@@ -812,8 +767,8 @@ int Bmcs_ManPerform_Solve( Bmcs_Man_t * p, int iLit, pthread_t * WorkerThread, P
 int Bmcs_ManPerformMulti( Gia_Man_t * pGia, Bmc_AndPar_t * pPars )
 {
     abctime clkStart = Abc_Clock();
-    pthread_t WorkerThread[PAR_THR_MAX];
     Par_ThData_t ThData[PAR_THR_MAX];
+    Util_Pool_t * pPool;
     Bmcs_Man_t * p = Bmcs_ManStart( pGia, pPars );
     int f, k = 0, i = Gia_ManPoNum(pGia), status, RetValue = -1, nClauses = 0, Solver = 0;
     Abc_CexFreeP( &pGia->pCexSeq );
@@ -823,10 +778,9 @@ int Bmcs_ManPerformMulti( Gia_Man_t * pGia, Bmc_AndPar_t * pPars )
         ThData[i].pSat     = p->pSats[i];
         ThData[i].iLit     = -1;
         ThData[i].iThread  =  i;
-        ThData[i].fWorking =  0;
         ThData[i].status   = -1;
-        status = pthread_create( WorkerThread + i, NULL, Bmcs_ManWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
     }
+    pPool = Util_PoolStart( pPars->nProcs, 0 );
     // solve properties in each timeframe
     for ( f = 0; !pPars->nFramesMax || f < pPars->nFramesMax; f += pPars->nFramesAdd )
     {
@@ -857,7 +811,7 @@ int Bmcs_ManPerformMulti( Gia_Man_t * pGia, Bmc_AndPar_t * pPars )
                 int iLit = Abc_Var2Lit( Vec_IntEntry(&p->vFr2Sat, iObj), 0 );
                 if ( pPars->nTimeOut && (Abc_Clock() - clkStart)/CLOCKS_PER_SEC >= pPars->nTimeOut )
                     break;
-                status = Bmcs_ManPerform_Solve( p, iLit, WorkerThread, ThData, pPars->nProcs, &Solver );
+                status = Bmcs_ManPerform_Solve( p, iLit, pPool, ThData, pPars->nProcs, &Solver );
                 p->timeSat += Abc_Clock() - clk;
                 if ( status == l_False ) // unsat
                 {
@@ -893,12 +847,7 @@ int Bmcs_ManPerformMulti( Gia_Man_t * pGia, Bmc_AndPar_t * pPars )
             break;
     }
     // stop threads
-    for ( i = 0; i < pPars->nProcs; i++ )
-    {
-        assert( !ThData[i].fWorking );
-        ThData[i].pSat = NULL;
-        ThData[i].fWorking = 1;
-    }
+    Util_PoolStop( pPool );
     p->timeOth = Abc_Clock() - clkStart - p->timeUnf - p->timeCnf - p->timeSat;
     if ( RetValue == -1 && !pPars->fNotVerbose )
         printf( "No output failed in %d frames.  ", f + (k < pPars->nFramesAdd ? k+1 : 0) );
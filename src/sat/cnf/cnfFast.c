@@ -20,6 +20,7 @@
 
 #include "cnf.h"
 #include "bool/kit/kit.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -27,6 +28,28 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+// the state of one thread deriving the clauses of a range of nodes
+typedef struct Cnf_FastThData_t_ Cnf_FastThData_t;
+struct Cnf_FastThData_t_
+{
+    Aig_Man_t *    p;         // the marked AIG (shared, read-only)
+    Vec_Int_t *    vMap;      // the SAT variables (shared, read-only)
+    Vec_Ptr_t *    vRoots;    // the marked nodes in the order of clauses (shared)
+    int            iBeg;      // the first root of this thread
+    int            iEnd;      // the last root of this thread plus one
+    int *          pStamps;   // the traversal stamps of the objects
+    int            Stamp;     // the current stamp
+    Vec_Ptr_t *    vLeaves;   // the leaves of the cone
+    Vec_Ptr_t *    vNodes;    // the nodes of the cone
+    Vec_Int_t *    vCover;    // the ISOP cover
+    Vec_Int_t *    vTemp;     // the clauses of one node
+    Vec_Int_t *    vLits;     // the literals of the clauses of this thread
+    Vec_Int_t *    vClas;     // the clause beginnings in vLits
+};
+
+// the smallest number of marked nodes processed by a thread
+#define CNF_FAST_PAR_MIN  1000
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -165,6 +188,79 @@ word Cnf_CutDeriveTruth( Aig_Man_t * p, Vec_Ptr_t * vLeaves, Vec_Ptr_t * vNodes
     return S[pObj->iData];
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Collects nodes inside the cone without using traversal IDs.]
+
+  Description [Marks the objects in the array of stamps. After the call,
+  the stamp of each leaf and node minus Stamp is its index in the cone,
+  the leaves coming first. Returns the stamp to be used for the next cone.
+  This version can be called by several threads on the same AIG.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cnf_CollectVolumeStamp_rec( Aig_Obj_t * pObj, Vec_Ptr_t * vNodes, int * pStamps, int Stamp )
+{
+    if ( pStamps[Aig_ObjId(pObj)] >= Stamp )
+        return;
+    pStamps[Aig_ObjId(pObj)] = Stamp;
+    assert( Aig_ObjIsNode(pObj) );
+    Cnf_CollectVolumeStamp_rec( Aig_ObjFanin0(pObj), vNodes, pStamps, Stamp );
+    Cnf_CollectVolumeStamp_rec( Aig_ObjFanin1(pObj), vNodes, pStamps, Stamp );
+    Vec_PtrPush( vNodes, pObj );
+}
+int Cnf_CollectVolumeStamp( Aig_Obj_t * pRoot, Vec_Ptr_t * vLeaves, Vec_Ptr_t * vNodes, int * pStamps, int Stamp )
+{
+    Aig_Obj_t * pObj;
+    int i;
+    Vec_PtrForEachEntry( Aig_Obj_t *, vLeaves, pObj, i )
+        pStamps[Aig_ObjId(pObj)] = Stamp + i;
+    Vec_PtrClear( vNodes );
+    Cnf_CollectVolumeStamp_rec( pRoot, vNodes, pStamps, Stamp );
+    Vec_PtrForEachEntry( Aig_Obj_t *, vNodes, pObj, i )
+        pStamps[Aig_ObjId(pObj)] = Stamp + Vec_PtrSize(vLeaves) + i;
+    return Stamp + Vec_PtrSize(vLeaves) + Vec_PtrSize(vNodes) + 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derive truth table without using the data field of the objects.]
+
+  Description [Expects the indexes of the cone assigned by
+  Cnf_CollectVolumeStamp() with the same Stamp.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+word Cnf_CutDeriveTruthStamp( Vec_Ptr_t * vLeaves, Vec_Ptr_t * vNodes, int * pStamps, int Stamp )
+{
+    static word Truth6[6] = {
+        ABC_CONST(0xAAAAAAAAAAAAAAAA),
+        ABC_CONST(0xCCCCCCCCCCCCCCCC),
+        ABC_CONST(0xF0F0F0F0F0F0F0F0),
+        ABC_CONST(0xFF00FF00FF00FF00),
+        ABC_CONST(0xFFFF0000FFFF0000),
+        ABC_CONST(0xFFFFFFFF00000000)
+    };
+    static word C[2] = { 0, ~(word)0 };
+    word S[256];
+    Aig_Obj_t * pObj = NULL;
+    int i, nLeaves = Vec_PtrSize(vLeaves);
+    assert( Vec_PtrSize(vLeaves) <= 6 && Vec_PtrSize(vNodes) > 0 );
+    assert( Vec_PtrSize(vLeaves) + Vec_PtrSize(vNodes) <= 256 );
+    for ( i = 0; i < nLeaves; i++ )
+        S[i] = Truth6[i];
+    Vec_PtrForEachEntry( Aig_Obj_t *, vNodes, pObj, i )
+        S[nLeaves + i] = (S[pStamps[Aig_ObjFaninId0(pObj)] - Stamp] ^ C[Aig_ObjFaninC0(pObj)]) & 
+                         (S[pStamps[Aig_ObjFaninId1(pObj)] - Stamp] ^ C[Aig_ObjFaninC1(pObj)]);
+    return S[nLeaves + Vec_PtrSize(vNodes) - 1];
+}
+
 
 /**Function*************************************************************
 
@@ -195,11 +291,11 @@ static inline int Cnf_ObjGetLit( Vec_Int_t * vMap, Aig_Obj_t * pObj, int fCompl
   SeeAlso     []
 
 ***********************************************************************/
-void Cnf_ComputeClauses( Aig_Man_t * p, Aig_Obj_t * pRoot, 
-    Vec_Ptr_t * vLeaves, Vec_Ptr_t * vNodes, Vec_Int_t * vMap, Vec_Int_t * vCover, Vec_Int_t * vClauses )
+static void Cnf_ComputeClausesInt( Aig_Man_t * p, Aig_Obj_t * pRoot, 
+    Vec_Ptr_t * vLeaves, Vec_Ptr_t * vNodes, Vec_Int_t * vMap, Vec_Int_t * vCover, Vec_Int_t * vClauses, int * pStamps, int * pStamp )
 {
     Aig_Obj_t * pLeaf;
-    int c, k, Cube, OutLit, RetValue;
+    int c, k, Cube, OutLit, RetValue, Stamp = pStamp ? *pStamp : 0;
     word Truth;
     assert( pRoot->fMarkA );
 
@@ -208,7 +304,10 @@ void Cnf_ComputeClauses( Aig_Man_t * p, Aig_Obj_t * pRoot,
     OutLit = Cnf_ObjGetLit( vMap, pRoot, 0 );
     // detect cone
     Cnf_CollectLeaves( pRoot, vLeaves, 0 );
-    Cnf_CollectVolume( p, pRoot, vLeaves, vNodes );
+    if ( pStamps )
+        *pStamp = Cnf_CollectVolumeStamp( pRoot, vLeaves, vNodes, pStamps, Stamp );
+    else
+        Cnf_CollectVolume( p, pRoot, vLeaves, vNodes );
     assert( pRoot == Vec_PtrEntryLast(vNodes) );
     // check if this is an AND-gate
     Vec_PtrForEachEntry( Aig_Obj_t *, vNodes, pLeaf, k )
@@ -239,7 +338,10 @@ void Cnf_ComputeClauses( Aig_Man_t * p, Aig_Obj_t * pRoot,
         printf( "FastCnfGeneration:  Internal error!!!\n" );
     assert( Vec_PtrSize(vLeaves) <= 6 );
 
-    Truth = Cnf_CutDeriveTruth( p, vLeaves, vNodes );
+    if ( pStamps )
+        Truth = Cnf_CutDeriveTruthStamp( vLeaves, vNodes, pStamps, Stamp );
+    else
+        Truth = Cnf_CutDeriveTruth( p, vLeaves, vNodes );
     if ( Truth == 0 || Truth == ~(word)0 )
     {
         Vec_IntPush( vClauses, 0 );
@@ -280,6 +382,22 @@ void Cnf_ComputeClauses( Aig_Man_t * p, Aig_Obj_t * pRoot,
         }
     }
 }
+/**Function*************************************************************
+
+  Synopsis    [Derives the clauses of the node.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cnf_ComputeClauses( Aig_Man_t * p, Aig_Obj_t * pRoot, 
+    Vec_Ptr_t * vLeaves, Vec_Ptr_t * vNodes, Vec_Int_t * vMap, Vec_Int_t * vCover, Vec_Int_t * vClauses )
+{
+    Cnf_ComputeClausesInt( p, pRoot, vLeaves, vNodes, vMap, vCover, vClauses, NULL, NULL );
+}
 
 
 
@@ -530,6 +648,121 @@ int Cnf_CountCnfSize( Aig_Man_t * p )
     return nClauses;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Derives the clauses of a range of marked nodes.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cnf_DeriveFastTask( void * pArg, int iThread, void * pScratch )
+{
+    Cnf_FastThData_t * pThData = (Cnf_FastThData_t *)pArg;
+    Aig_Obj_t * pObj;
+    int i, k, Entry;
+    for ( i = pThData->iBeg; i < pThData->iEnd; i++ )
+    {
+        pObj = (Aig_Obj_t *)Vec_PtrEntry( pThData->vRoots, i );
+        // restart the stamps before they overflow
+        if ( pThData->Stamp > ABC_INFINITY )
+        {
+            memset( pThData->pStamps, 0, sizeof(int) * Aig_ManObjNumMax(pThData->p) );
+            pThData->Stamp = 1;
+        }
+        Cnf_ComputeClausesInt( pThData->p, pObj, pThData->vLeaves, pThData->vNodes, pThData->vMap, 
+            pThData->vCover, pThData->vTemp, pThData->pStamps, &pThData->Stamp );
+        Vec_IntForEachEntry( pThData->vTemp, Entry, k )
+        {
+            if ( Entry == 0 )
+                Vec_IntPush( pThData->vClas, Vec_IntSize(pThData->vLits) );
+            else
+                Vec_IntPush( pThData->vLits, Entry );
+        }
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the clauses of the marked nodes using several threads.]
+
+  Description [The marked nodes are divided into contiguous ranges in the
+  order used by the serial computation. Each thread writes the clauses of
+  its range into its own arrays, which are then concatenated in the order
+  of the ranges. The resulting clauses are the same as those derived by
+  one thread.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cnf_DeriveFastClausesPar( Aig_Man_t * p, Vec_Int_t * vMap, int nProcs, Vec_Int_t ** pvLits, Vec_Int_t ** pvClas )
+{
+    Cnf_FastThData_t * pThData;
+    Util_Pool_t * pPool;
+    Vec_Ptr_t * vRoots;
+    Vec_Int_t * vLits, * vClas;
+    Aig_Obj_t * pObj;
+    int i, k, Entry, nLits = 0, nClas = 0;
+    // collect the marked nodes in the order of the clauses
+    vRoots = Vec_PtrAlloc( Aig_ManNodeNum(p) );
+    Aig_ManForEachNodeReverse( p, pObj, i )
+        if ( pObj->fMarkA )
+            Vec_PtrPush( vRoots, pObj );
+    nProcs = Abc_MaxInt( 1, Abc_MinInt(nProcs, Vec_PtrSize(vRoots) / CNF_FAST_PAR_MIN) );
+    // derive the clauses of the ranges
+    pThData = ABC_CALLOC( Cnf_FastThData_t, nProcs );
+    pPool = Util_PoolStart( nProcs, 0 );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        pThData[i].p       = p;
+        pThData[i].vMap    = vMap;
+        pThData[i].vRoots  = vRoots;
+        pThData[i].iBeg    = (int)((ABC_INT64_T)Vec_PtrSize(vRoots) * i / nProcs);
+        pThData[i].iEnd    = (int)((ABC_INT64_T)Vec_PtrSize(vRoots) * (i+1) / nProcs);
+        pThData[i].pStamps = ABC_CALLOC( int, Aig_ManObjNumMax(p) );
+        pThData[i].Stamp   = 1;
+        pThData[i].vLeaves = Vec_PtrAlloc( 100 );
+        pThData[i].vNodes  = Vec_PtrAlloc( 100 );
+        pThData[i].vCover  = Vec_IntAlloc( 1 << 16 );
+        pThData[i].vTemp   = Vec_IntAlloc( 100 );
+        pThData[i].vLits   = Vec_IntAlloc( 1 << 16 );
+        pThData[i].vClas   = Vec_IntAlloc( 1 << 12 );
+        Util_PoolAssign( pPool, i, Cnf_DeriveFastTask, (void *)(pThData + i) );
+    }
+    Util_PoolWaitAll( pPool );
+    Util_PoolStop( pPool );
+    // concatenate the clauses, leaving room for the clauses of the outputs
+    for ( i = 0; i < nProcs; i++ )
+    {
+        nLits += Vec_IntSize( pThData[i].vLits );
+        nClas += Vec_IntSize( pThData[i].vClas );
+    }
+    vLits = Vec_IntAlloc( nLits + 2 * Aig_ManCoNum(p) + 1 );
+    vClas = Vec_IntAlloc( nClas + 2 * Aig_ManCoNum(p) + 1 );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        Vec_IntForEachEntry( pThData[i].vClas, Entry, k )
+            Vec_IntPush( vClas, Vec_IntSize(vLits) + Entry );
+        Vec_IntAppend( vLits, pThData[i].vLits );
+        ABC_FREE( pThData[i].pStamps );
+        Vec_PtrFree( pThData[i].vLeaves );
+        Vec_PtrFree( pThData[i].vNodes );
+        Vec_IntFree( pThData[i].vCover );
+        Vec_IntFree( pThData[i].vTemp );
+        Vec_IntFree( pThData[i].vLits );
+        Vec_IntFree( pThData[i].vClas );
+    }
+    ABC_FREE( pThData );
+    Vec_PtrFree( vRoots );
+    *pvLits = vLits;
+    *pvClas = vClas;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Derives CNF from the marked AIG.]
@@ -542,7 +775,7 @@ int Cnf_CountCnfSize( Aig_Man_t * p )
   SeeAlso     []
 
 ***********************************************************************/
-Cnf_Dat_t * Cnf_DeriveFastClauses( Aig_Man_t * p, int nOutputs )
+Cnf_Dat_t * Cnf_DeriveFastClauses( Aig_Man_t * p, int nOutputs, int nProcs )
 {
     Cnf_Dat_t * pCnf;
     Vec_Int_t * vLits, * vClas, * vMap, * vTemp;
@@ -551,8 +784,6 @@ Cnf_Dat_t * Cnf_DeriveFastClauses( Aig_Man_t * p, int nOutputs )
     Aig_Obj_t * pObj;
     int i, k, nVars, Entry, OutLit, DriLit;
 
-    vLits = Vec_IntAlloc( 1 << 16 );
-    vClas = Vec_IntAlloc( 1 << 12 );
     vMap  = Vec_IntStartFull( Aig_ManObjNumMax(p) );
 
     // assign variables for the outputs
@@ -582,27 +813,34 @@ Cnf_Dat_t * Cnf_DeriveFastClauses( Aig_Man_t * p, int nOutputs )
     Vec_IntWriteEntry( vMap, Aig_ObjId(Aig_ManConst1(p)), nVars++ );
 
     // create clauses
-    vLeaves = Vec_PtrAlloc( 100 );
-    vNodes  = Vec_PtrAlloc( 100 );
-    vCover  = Vec_IntAlloc( 1 << 16 );
-    vTemp   = Vec_IntAlloc( 100 );
-    Aig_ManForEachNodeReverse( p, pObj, i )
+    if ( nProcs > 1 )
+        Cnf_DeriveFastClausesPar( p, vMap, nProcs, &vLits, &vClas );
+    else
     {
-        if ( !pObj->fMarkA )
-            continue;
-        Cnf_ComputeClauses( p, pObj, vLeaves, vNodes, vMap, vCover, vTemp );
-        Vec_IntForEachEntry( vTemp, Entry, k )
+        vLits = Vec_IntAlloc( 1 << 16 );
+        vClas = Vec_IntAlloc( 1 << 12 );
+        vLeaves = Vec_PtrAlloc( 100 );
+        vNodes  = Vec_PtrAlloc( 100 );
+        vCover  = Vec_IntAlloc( 1 << 16 );
+        vTemp   = Vec_IntAlloc( 100 );
+        Aig_ManForEachNodeReverse( p, pObj, i )
         {
-            if ( Entry == 0 )
-                Vec_IntPush( vClas, Vec_IntSize(vLits) );
-            else
-                Vec_IntPush( vLits, Entry );
-        }       
+            if ( !pObj->fMarkA )
+                continue;
+            Cnf_ComputeClauses( p, pObj, vLeaves, vNodes, vMap, vCover, vTemp );
+            Vec_IntForEachEntry( vTemp, Entry, k )
+            {
+                if ( Entry == 0 )
+                    Vec_IntPush( vClas, Vec_IntSize(vLits) );
+                else
+                    Vec_IntPush( vLits, Entry );
+            }       
+        }
+        Vec_PtrFree( vLeaves );
+        Vec_PtrFree( vNodes );
+        Vec_IntFree( vCover );
+        Vec_IntFree( vTemp );
     }
-    Vec_PtrFree( vLeaves );
-    Vec_PtrFree( vNodes );
-    Vec_IntFree( vCover );
-    Vec_IntFree( vTemp );
 
     // create clauses for the outputs
     Aig_ManForEachCo( p, pObj, i )
@@ -656,14 +894,15 @@ Cnf_Dat_t * Cnf_DeriveFastClauses( Aig_Man_t * p, int nOutputs )
 
   Synopsis    [Fast CNF computation.]
 
-  Description []
+  Description [Derives the clauses of the marked nodes using nProcs 
+  threads. The result does not depend on the number of threads.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-Cnf_Dat_t * Cnf_DeriveFast( Aig_Man_t * p, int nOutputs )
+Cnf_Dat_t * Cnf_DeriveFastPar( Aig_Man_t * p, int nOutputs, int nProcs )
 {
     Cnf_Dat_t * pCnf = NULL;
     abctime clk;//, clkTotal = Abc_Clock();
@@ -675,7 +914,7 @@ Cnf_Dat_t * Cnf_DeriveFast( Aig_Man_t * p, int nOutputs )
 //    Abc_PrintTime( 1, "Marking", Abc_Clock() - clk );
     // compute CNF size
     clk = Abc_Clock();
-    pCnf = Cnf_DeriveFastClauses( p, nOutputs );
+    pCnf = Cnf_DeriveFastClauses( p, nOutputs, nProcs );
 //    Abc_PrintTime( 1, "Clauses", Abc_Clock() - clk );
     // derive the resulting CNF
     Aig_ManCleanMarkA( p );
@@ -688,6 +927,22 @@ Cnf_Dat_t * Cnf_DeriveFast( Aig_Man_t * p, int nOutputs )
     return pCnf;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Fast CNF computation.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Cnf_Dat_t * Cnf_DeriveFast( Aig_Man_t * p, int nOutputs )
+{
+    return Cnf_DeriveFastPar( p, nOutputs, 1 );
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
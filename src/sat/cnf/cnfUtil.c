@@ -20,6 +20,7 @@
 
 #include "cnf.h"
 #include "sat/bsat/satSolver.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -136,38 +137,22 @@ typedef struct Cnf_ThData_t_
     int Index;
     int Rand;
     int nTimeOut;
-    int fWorking;
     int fVerbose;
 } Cnf_ThData_t;
 
-void *Cnf_WorkerThread(void *pArg)
+void Cnf_WorkerTask(void *pArg, int iThread, void *pScratch)
 {
     Cnf_ThData_t *pThData = (Cnf_ThData_t *)pArg;
-    volatile int *pPlace = &pThData->fWorking;
-    while (1)
-    {
-        while (*pPlace == 0)
-            ;
-        assert(pThData->fWorking);
-        if (pThData->Index == -1)
-        {
-            pthread_exit(NULL);
-            assert(0);
-            return NULL;
-        }
-        pThData->vRes = Cnf_RunSolverOnce(pThData->Index, pThData->Rand, pThData->nTimeOut, pThData->fVerbose);
-        pThData->fWorking = 0;
-    }
-    assert(0);
-    return NULL;
+    assert(pThData->Index >= 0);
+    pThData->vRes = Cnf_RunSolverOnce(pThData->Index, pThData->Rand, pThData->nTimeOut, pThData->fVerbose);
 }
 
 Vec_Int_t *Cnf_RunSolver(int nProcs, int TimeOut, int fVerbose)
 {
     Vec_Int_t *vRes = NULL;
     Cnf_ThData_t ThData[PAR_THR_MAX];
-    pthread_t WorkerThread[PAR_THR_MAX];
-    int i, k, status;
+    Util_Pool_t *pPool;
+    int i;
     if (fVerbose)
         printf("Running concurrent solving with %d processes.\n", nProcs);
     fflush(stdout);
@@ -177,51 +162,27 @@ Vec_Int_t *Cnf_RunSolver(int nProcs, int TimeOut, int fVerbose)
     // nProcs--;
     assert(nProcs >= 1 && nProcs <= PAR_THR_MAX);
     // start threads
+    pPool = Util_PoolStart(nProcs, 0);
     for (i = 0; i < nProcs; i++)
     {
         ThData[i].vRes     = NULL;
-        ThData[i].Index    = -1;
+        ThData[i].Index    = i;
         ThData[i].Rand     = Abc_Random(0) % 0x1000000;
         ThData[i].nTimeOut = TimeOut;
-        ThData[i].fWorking = 0;
         ThData[i].fVerbose = fVerbose;
-        status = pthread_create(WorkerThread + i, NULL, Cnf_WorkerThread, (void *)(ThData + i));
-        assert(status == 0);
-    }
-    // look at the threads
-    for (k = 0; k < nProcs;)
-    {
-        for (i = 0; i < nProcs; i++)
-        {
-            if (ThData[i].fWorking)
-                continue;
-            if (ThData[i].vRes)
-            {
-                k = nProcs;
-                break;
-            }
-            ThData[i].Index = k++;
-            ThData[i].fWorking = 1;
-            break;
-        }
+        Util_PoolAssign(pPool, i, Cnf_WorkerTask, (void *)(ThData + i));
     }
     // wait till threads finish
-    for (i = 0; i < nProcs; i++)
-        if (ThData[i].fWorking)
-            i = -1;
-    // stop threads
+    Util_PoolStop(pPool);
+    // collect the results
     for (i = 0; i < nProcs; i++)
     {
-        assert(!ThData[i].fWorking);
         if (ThData[i].vRes && vRes == NULL)
         {
             vRes = ThData[i].vRes;
             ThData[i].vRes = NULL;
         }
         Vec_IntFreeP(&ThData[i].vRes);
-        // stop
-        ThData[i].Index = -1;
-        ThData[i].fWorking = 1;
     }
     return vRes;
 }
@@ -65,6 +65,11 @@ struct satoko_opts {
     unsigned clause_max_sz_bin_resol;
     unsigned clause_min_lbd_bin_resol;
     float garbage_max_ratio;
+
+    /* Clause sharing (portfolio) */
+    unsigned n_threads;            /* N.of solvers in the portfolio */
+    unsigned clause_max_sz_share;  /* Learnt clauses up to this size are shared */
+    unsigned clause_max_lbd_share; /* Learnt clauses up to this LBD are shared */
     char verbose;
     char no_simplify;
 };
@@ -139,6 +144,15 @@ extern int satoko_conflictnum(satoko_t *);
 extern void satoko_set_stop(satoko_t *, int *);
 extern void satoko_set_stop_func(satoko_t *s, int (*fnct)(int));
 extern void satoko_set_runid(satoko_t *, int);
+/* Clause sharing between the solvers of a portfolio.
+ * - The export function is called with the run ID, the literals and the LBD
+ *   of each learnt clause satisfying the sharing limits of the options.
+ * - The import function is called with the run ID at decision level zero.
+ *   It adds the clauses of other solvers using satoko_add_learnt() and
+ *   returns their number, or -1 if the problem became unsatisfiable.
+ */
+extern void satoko_set_share(satoko_t *, void *, void (*)(void *, int, unsigned *, unsigned, unsigned), int (*)(void *, int, satoko_t *));
+extern int  satoko_add_learnt(satoko_t *, int *, int, int);
 extern int satoko_read_cex_varvalue(satoko_t *, int);
 extern abctime satoko_set_runtime_limit(satoko_t *, abctime);
 extern char satoko_var_polarity(satoko_t *, unsigned);
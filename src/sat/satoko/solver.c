@@ -349,6 +349,9 @@ static inline void solver_handle_conflict(solver_t *s, unsigned confl_cref)
     solver_analyze(s, confl_cref, s->temp_lits, &bt_level, &lbd);
     s->sum_lbd += lbd;
     b_queue_push(s->bq_lbd, lbd);
+    if (s->pFuncExport && (vec_uint_size(s->temp_lits) <= s->opts.clause_max_sz_share ||
+                           lbd <= s->opts.clause_max_lbd_share))
+        s->pFuncExport(s->pShare, s->RunId, vec_uint_data(s->temp_lits), vec_uint_size(s->temp_lits), lbd);
     solver_cancel_until(s, bt_level);
     cref = UNDEF;
     if (vec_uint_size(s->temp_lits) > 1) {
@@ -650,6 +653,14 @@ char solver_search(solver_t *s)
                 solver_cancel_until(s, 0);
                 return SATOKO_UNDEC;
             }
+            /* Add the clauses learnt by other solvers */
+            if (s->pFuncImport && solver_dlevel(s) == 0) {
+                int n_imported = s->pFuncImport(s->pShare, s->RunId, s);
+                if (n_imported < 0)
+                    return SATOKO_UNSAT;
+                if (n_imported > 0)
+                    continue;
+            }
             if (!s->opts.no_simplify && solver_dlevel(s) == 0)
                 satoko_simplify(s);
 
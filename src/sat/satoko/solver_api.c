@@ -188,6 +188,10 @@ void satoko_default_opts(satoko_opts_t *opts)
     opts->clause_min_lbd_bin_resol = 6;
 
     opts->garbage_max_ratio = (float) 0.3;
+    /* Clause sharing */
+    opts->n_threads = 1;
+    opts->clause_max_sz_share = 2;
+    opts->clause_max_lbd_share = 2;
 }
 
 /**
@@ -657,6 +661,43 @@ void satoko_set_runid(satoko_t *s, int id)
     s->RunId = id;
 }
 
+void satoko_set_share(satoko_t *s, void *pshare,
+                      void (*pfunc_export)(void *, int, unsigned *, unsigned, unsigned),
+                      int (*pfunc_import)(void *, int, satoko_t *))
+{
+    s->pShare = pshare;
+    s->pFuncExport = pfunc_export;
+    s->pFuncImport = pfunc_import;
+}
+
+/* Adds the clause learnt by another solver. It must be called at decision
+ * level zero. Returns SATOKO_ERR if the clause is falsified. */
+int satoko_add_learnt(satoko_t *s, int *lits, int size, int lbd)
+{
+    unsigned i, cref;
+
+    assert(solver_dlevel(s) == 0);
+    vec_uint_clear(s->temp_lits);
+    for (i = 0; i < (unsigned)size; i++) {
+        if (lit2var(lits[i]) >= (unsigned)satoko_varnum(s))
+            return SATOKO_OK;
+        if (lit_value(s, lits[i]) == SATOKO_LIT_TRUE)
+            return SATOKO_OK;
+        if (lit_value(s, lits[i]) != SATOKO_LIT_FALSE)
+            vec_uint_push_back(s->temp_lits, lits[i]);
+    }
+    if (vec_uint_size(s->temp_lits) == 0)
+        return SATOKO_ERR;
+    if (vec_uint_size(s->temp_lits) == 1) {
+        solver_enqueue(s, vec_uint_at(s->temp_lits, 0), UNDEF);
+        return SATOKO_OK;
+    }
+    cref = solver_clause_create(s, s->temp_lits, 1);
+    clause_fetch(s, cref)->lbd = lbd;
+    clause_watch(s, cref);
+    return SATOKO_OK;
+}
+
 int satoko_read_cex_varvalue(satoko_t *s, int ivar)
 {
     return satoko_var_polarity(s, ivar) == SATOKO_LIT_TRUE;
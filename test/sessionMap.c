@@ -0,0 +1,297 @@
+/**CFile****************************************************************
+
+  FileName    [sessionMap.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [ABC as a static library.]
+
+  Synopsis    [Test of the technology mapping in concurrent sessions.]
+
+  Author      []
+
+  Affiliation []
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: sessionMap.c,v 1.00 2026/10/18 00:00:00 Exp $]
+
+***********************************************************************/
+
+#include <pthread.h>
+#include "base/abc/abc.h"
+#include "base/main/main.h"
+#include "base/cmd/cmd.h"
+
+ABC_NAMESPACE_IMPL_START
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+typedef struct Test_Job_t_ Test_Job_t;
+struct Test_Job_t_
+{
+    Abc_Frame_t *    pAbc;         // the frame running the script
+    char *           pScript;      // the script
+    int              Status;       // the status returned by the script
+    double           Area;         // the area of the mapped network
+};
+
+#define TEST_ROUNDS      10        // the number of rounds of the isolation test
+
+typedef struct Test_Iso_t_ Test_Iso_t;
+struct Test_Iso_t_
+{
+    Abc_Frame_t *    pAbc;         // the session
+    char *           pFileAig;     // the network of this session
+    char             Owner[16];    // the value of the flag set by this session
+    int              nPis;         // the expected number of PIs
+    double           Area;         // the expected area
+    int              nErrors;      // the number of detected errors
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Runs the script and records the mapped area.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Test_JobRun( Test_Job_t * p )
+{
+    Abc_Ntk_t * pNtk;
+    p->Status = Cmd_CommandExecute( p->pAbc, p->pScript );
+    pNtk = Abc_FrameReadNtk( p->pAbc );
+    p->Area = (pNtk && Abc_NtkHasMapping(pNtk)) ? Abc_NtkGetMappedArea(pNtk) : -1;
+}
+void * Test_JobThread( void * pArg )
+{
+    Test_Job_t * p = (Test_Job_t *)pArg;
+    Test_JobRun( p );
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Maps the same network in two sessions at the same time.]
+
+  Description [The Liberty library is read in the global frame. Two
+  sessions map the network in two threads, then the global frame maps it
+  again. The test fails if a script fails, if the areas differ, or if the
+  sessions can change the shared libraries.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Test_SessionMap( char * pFileLib, char * pFileAig )
+{
+    Test_Job_t Jobs[3];
+    pthread_t Threads[2];
+    Abc_Frame_t * pBase;
+    char Command[1000], Script[1000];
+    int i, nErrors = 0;
+    pBase = Abc_FrameGetGlobalFrame();
+    sprintf( Command, "read_lib %s", pFileLib );
+    if ( Cmd_CommandExecute( pBase, Command ) )
+    {
+        printf( "Cannot read the library \"%s\".\n", pFileLib );
+        return 1;
+    }
+    sprintf( Script, "read %s; strash; map", pFileAig );
+    for ( i = 0; i < 3; i++ )
+    {
+        Jobs[i].pAbc    = i < 2 ? Abc_FrameStartSession( pBase ) : pBase;
+        Jobs[i].pScript = Script;
+        Jobs[i].Status  = -1;
+        Jobs[i].Area    = -1;
+    }
+    // map in the sessions concurrently
+    for ( i = 0; i < 2; i++ )
+        if ( pthread_create( Threads + i, NULL, Test_JobThread, (void *)(Jobs + i) ) )
+        {
+            printf( "Cannot start the thread.\n" );
+            return 1;
+        }
+    for ( i = 0; i < 2; i++ )
+        pthread_join( Threads[i], NULL );
+    // the shared libraries cannot be changed in a session
+    if ( Cmd_CommandExecute( Jobs[0].pAbc, Command ) == 0 )
+        printf( "Session %d has changed the shared library.\n", 0 ), nErrors++;
+    for ( i = 0; i < 2; i++ )
+        Abc_FrameStopSession( Jobs[i].pAbc );
+    // map in the global frame after the sessions are stopped
+    Test_JobRun( Jobs + 2 );
+    for ( i = 0; i < 3; i++ )
+    {
+        printf( "Job %d: status = %d  area = %.2f\n", i, Jobs[i].Status, Jobs[i].Area );
+        if ( Jobs[i].Status != 0 || Jobs[i].Area <= 0 )
+            nErrors++;
+        else if ( i > 0 && Jobs[i].Area != Jobs[0].Area )
+            printf( "The area of job %d differs from job 0.\n", i ), nErrors++;
+    }
+    printf( "%s\n", nErrors ? "FAILED" : "PASSED" );
+    return nErrors > 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Checks the state of a session and runs its rounds.]
+
+  Description [Each command is executed by a separate call, so that the
+  commands of the other session can run in between. After each command,
+  checks that the network and the flag of this session are unchanged.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Test_IsoCheck( Test_Iso_t * p, int fMapped )
+{
+    Abc_Ntk_t * pNtk = Abc_FrameReadNtk( p->pAbc );
+    char * pOwner = Cmd_FlagReadByName( p->pAbc, "test_owner" );
+    if ( pNtk == NULL || Abc_NtkPiNum(pNtk) != p->nPis )
+        return 1;
+    if ( pOwner == NULL || strcmp(pOwner, p->Owner) )
+        return 1;
+    if ( fMapped && (!Abc_NtkHasMapping(pNtk) || Abc_NtkGetMappedArea(pNtk) != p->Area) )
+        return 1;
+    return 0;
+}
+void * Test_IsoThread( void * pArg )
+{
+    Test_Iso_t * p = (Test_Iso_t *)pArg;
+    char Command[1000];
+    int r;
+    for ( r = 0; r < TEST_ROUNDS; r++ )
+    {
+        sprintf( Command, "read %s", p->pFileAig );
+        p->nErrors += Cmd_CommandExecute( p->pAbc, Command ) != 0;
+        sprintf( Command, "set test_owner %s", p->Owner );
+        p->nErrors += Cmd_CommandExecute( p->pAbc, Command ) != 0;
+        p->nErrors += Test_IsoCheck( p, 0 );
+        p->nErrors += Cmd_CommandExecute( p->pAbc, "strash" ) != 0;
+        p->nErrors += Test_IsoCheck( p, 0 );
+        p->nErrors += Cmd_CommandExecute( p->pAbc, "map" ) != 0;
+        p->nErrors += Test_IsoCheck( p, 1 );
+    }
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Checks that two concurrent sessions do not share state.]
+
+  Description [The two networks are mapped in the global frame to get the
+  expected results. Then two sessions in two threads repeatedly read and
+  map different networks and set the same flag to different values. The
+  test fails if a session sees the network, the mapping or the flag of
+  the other session, or if the flag leaks into the global frame.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Test_SessionIsolation( char * pFileLib, char * pFileAig0, char * pFileAig1 )
+{
+    Test_Iso_t Isos[2];
+    pthread_t Threads[2];
+    Abc_Frame_t * pBase = Abc_FrameGetGlobalFrame();
+    char Command[1000];
+    int i, nErrors = 0;
+    sprintf( Command, "read_lib %s", pFileLib );
+    if ( Cmd_CommandExecute( pBase, Command ) )
+    {
+        printf( "Cannot read the library \"%s\".\n", pFileLib );
+        return 1;
+    }
+    // find the expected results
+    for ( i = 0; i < 2; i++ )
+    {
+        Abc_Ntk_t * pNtk;
+        Isos[i].pFileAig = i ? pFileAig1 : pFileAig0;
+        sprintf( Command, "read %s; strash; map", Isos[i].pFileAig );
+        pNtk = Cmd_CommandExecute( pBase, Command ) ? NULL : Abc_FrameReadNtk( pBase );
+        if ( pNtk == NULL || !Abc_NtkHasMapping(pNtk) )
+        {
+            printf( "Cannot map the network \"%s\".\n", Isos[i].pFileAig );
+            return 1;
+        }
+        Isos[i].nPis    = Abc_NtkPiNum( pNtk );
+        Isos[i].Area    = Abc_NtkGetMappedArea( pNtk );
+        Isos[i].nErrors = 0;
+        sprintf( Isos[i].Owner, "session%d", i );
+    }
+    if ( Isos[0].nPis == Isos[1].nPis )
+    {
+        printf( "The networks should have different numbers of PIs.\n" );
+        return 1;
+    }
+    // run the sessions concurrently
+    for ( i = 0; i < 2; i++ )
+        Isos[i].pAbc = Abc_FrameStartSession( pBase );
+    for ( i = 0; i < 2; i++ )
+        if ( pthread_create( Threads + i, NULL, Test_IsoThread, (void *)(Isos + i) ) )
+        {
+            printf( "Cannot start the thread.\n" );
+            return 1;
+        }
+    for ( i = 0; i < 2; i++ )
+        pthread_join( Threads[i], NULL );
+    for ( i = 0; i < 2; i++ )
+    {
+        printf( "Session %d: %d errors in %d rounds\n", i, Isos[i].nErrors, TEST_ROUNDS );
+        nErrors += Isos[i].nErrors;
+        Abc_FrameStopSession( Isos[i].pAbc );
+    }
+    if ( Cmd_FlagReadByName( pBase, "test_owner" ) != NULL )
+        printf( "The flag of a session is visible in the global frame.\n" ), nErrors++;
+    printf( "%s\n", nErrors ? "FAILED" : "PASSED" );
+    return nErrors > 0;
+}
+
+ABC_NAMESPACE_IMPL_END
+
+ABC_NAMESPACE_USING_NAMESPACE
+
+/**Function*************************************************************
+
+  Synopsis    [The main() procedure.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int main( int argc, char * argv[] )
+{
+    int RetValue;
+    if ( argc != 3 && argc != 4 )
+    {
+        printf( "usage: %s <liberty_file> <aig_file> [<aig_file2>]\n", argv[0] );
+        printf( "       maps one network in two sessions, or checks that the sessions\n" );
+        printf( "       mapping two different networks do not share state\n" );
+        return 1;
+    }
+    Abc_Start();
+    if ( argc == 3 )
+        RetValue = Test_SessionMap( argv[1], argv[2] );
+    else
+        RetValue = Test_SessionIsolation( argv[1], argv[2], argv[3] );
+    Abc_Stop();
+    return RetValue;
+}